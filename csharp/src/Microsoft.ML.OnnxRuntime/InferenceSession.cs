@@ -6,6 +6,7 @@ using System.Runtime.InteropServices;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Threading.Tasks;
 
 
 namespace Microsoft.ML.OnnxRuntime
@@ -204,6 +205,82 @@ namespace Microsoft.ML.OnnxRuntime
 
         }
 
+        /// <summary>
+        /// Starts running the loaded model for the given inputs on a thread pool owned by onnxruntime, to fetch all the outputs.
+        /// </summary>
+        /// <param name="inputs">Specify a collection of <see cref="NamedOnnxValue"/> that indicates the input values.</param>
+        /// <returns>A task that completes with the output Tensors in a Collection of NamedOnnxValue. User must dispose the output.</returns>
+        public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> RunAsync(IReadOnlyCollection<NamedOnnxValue> inputs)
+        {
+            string[] outputNames = new string[_outputMetadata.Count];
+            _outputMetadata.Keys.CopyTo(outputNames, 0);
+            return RunAsync(inputs, outputNames);
+        }
+
+        /// <summary>
+        /// Starts running the loaded model for the given inputs on a thread pool owned by onnxruntime, to fetch the outputs specified in <paramref name="outputNames"/>.
+        /// </summary>
+        /// <param name="inputs">Specify a collection of <see cref="NamedOnnxValue"/> that indicates the input values.</param>
+        /// <param name="outputNames">Specify a collection of string that indicates the output names to fetch.</param>
+        /// <returns>A task that completes with the output Tensors in a Collection of NamedOnnxValue. User must dispose the output.</returns>
+        public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> RunAsync(IReadOnlyCollection<NamedOnnxValue> inputs, IReadOnlyCollection<string> outputNames)
+        {
+            return RunAsync(inputs, outputNames, _builtInRunOptions);
+        }
+
+        /// <summary>
+        /// Starts running the loaded model for the given inputs on a thread pool owned by onnxruntime, to fetch the outputs specified in <paramref name="outputNames"/>.
+        /// Uses the given RunOptions for this run. Setting <see cref="RunOptions.Terminate"/> cancels the run, which then faults the task.
+        /// The inputs and <paramref name="options"/> must not be disposed before the task completes.
+        /// </summary>
+        /// <param name="inputs">Specify a collection of <see cref="NamedOnnxValue"/> that indicates the input values.</param>
+        /// <param name="outputNames">Specify a collection of string that indicates the output names to fetch.</param>
+        /// <param name="options"></param>
+        /// <returns>A task that completes with the output Tensors in a Collection of NamedOnnxValue. User must dispose the output.</returns>
+        public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> RunAsync(IReadOnlyCollection<NamedOnnxValue> inputs, IReadOnlyCollection<string> outputNames, RunOptions options)
+        {
+            var state = new RunAsyncState(inputs.Count);
+            state.OutputNames = outputNames as string[] ?? outputNames.ToArray();
+            state.Options = options;
+
+            var inputNamesArray = new string[inputs.Count];
+            int inputIndex = 0;
+            foreach (var input in inputs)
+            {
+                inputNamesArray[inputIndex] = input.Name;
+
+                // create Tensor from the input if feasible, else throw notsupported exception for now
+                input.ToNativeOnnxValue(
+                    out state.InputValues[inputIndex],
+                    out state.PinnedInputBufferHandles[inputIndex],
+                    out state.DisposeInputs[inputIndex]);
+
+                inputIndex++;
+            }
+
+            // the inputs stay pinned, and the state alive, until the callback is invoked
+            var handle = GCHandle.Alloc(state);
+            IntPtr status = NativeMethods.OrtRunAsync(
+                                                _nativeHandle,
+                                                options.Handle,
+                                                inputNamesArray,
+                                                state.InputValues,
+                                                (UIntPtr)inputs.Count,
+                                                state.OutputNames,
+                                                (UIntPtr)state.OutputNames.Length,
+                                                _runAsyncCallback,
+                                                GCHandle.ToIntPtr(handle)
+                                                );
+            if (status != IntPtr.Zero)
+            {
+                handle.Free();
+                state.DisposeInputValues();
+                NativeApiStatus.VerifySuccess(status);
+            }
+
+            return state.Completion.Task;
+        }
+
         /// <summary>
         /// Runs the loaded model for the given inputs, and fetches all the outputs.
         /// </summary>
@@ -701,6 +778,83 @@ namespace Microsoft.ML.OnnxRuntime
 
         #region private methods
 
+        // The state of a RunAsync call until its callback is invoked.
+        private class RunAsyncState
+        {
+            public RunAsyncState(int inputCount)
+            {
+                InputValues = new IntPtr[inputCount];
+                PinnedInputBufferHandles = new System.Buffers.MemoryHandle[inputCount];
+                DisposeInputs = new bool[inputCount];
+            }
+
+            public IntPtr[] InputValues;
+            public System.Buffers.MemoryHandle[] PinnedInputBufferHandles;
+            public bool[] DisposeInputs;
+            public string[] OutputNames;
+            public RunOptions Options;
+            // The continuations of the caller run on the thread pool instead of the thread of the native pool that
+            // completes the run.
+            public TaskCompletionSource<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> Completion =
+                new TaskCompletionSource<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>>(RunContinuationsAsynchronously);
+
+            // TaskCreationOptions.RunContinuationsAsynchronously, which netstandard1.1 doesn't declare
+            private const TaskCreationOptions RunContinuationsAsynchronously = (TaskCreationOptions)64;
+
+            public void DisposeInputValues()
+            {
+                for (int i = 0; i < InputValues.Length; i++)
+                {
+                    if (DisposeInputs[i])
+                    {
+                        NativeMethods.OrtReleaseValue(InputValues[i]);
+                        PinnedInputBufferHandles[i].Dispose();
+                    }
+                }
+            }
+        }
+
+        // a single instance, so that the delegate the native code calls back is never collected
+        private static readonly NativeMethods.DOrtRunAsyncCallback _runAsyncCallback = OnRunAsyncCompleted;
+
+        private static void OnRunAsyncCompleted(IntPtr userData, IntPtr outputs, UIntPtr outputCount, IntPtr status)
+        {
+            var handle = GCHandle.FromIntPtr(userData);
+            var state = (RunAsyncState)handle.Target;
+            handle.Free();
+            state.DisposeInputValues();
+
+            if (status != IntPtr.Zero)
+            {
+                state.Completion.SetException(NativeApiStatus.ToException(status));
+                return;
+            }
+
+            var outputValuesArray = new IntPtr[(int)outputCount];
+            Marshal.Copy(outputs, outputValuesArray, 0, outputValuesArray.Length);
+            var result = new DisposableList<DisposableNamedOnnxValue>(outputValuesArray.Length);
+            try
+            {
+                for (int i = 0; i < outputValuesArray.Length; i++)
+                {
+                    result.Add(DisposableNamedOnnxValue.CreateFromOnnxValue(state.OutputNames[i], outputValuesArray[i]));
+                }
+            }
+            catch (Exception e)
+            {
+                // release the values that were not wrapped yet
+                int wrappedCount = result.Count;
+                result.Dispose();
+                for (int i = wrappedCount; i < outputValuesArray.Length; i++)
+                {
+                    NativeMethods.OrtReleaseValue(outputValuesArray[i]);
+                }
+                state.Completion.SetException(e);
+                return;
+            }
+            state.Completion.SetResult(result);
+        }
+
         private void Init(string modelPath, SessionOptions options)
         {
             var envHandle = OnnxRuntime.Handle;
@@ -979,6 +1133,13 @@ namespace Microsoft.ML.OnnxRuntime
 
         protected virtual void Dispose(bool disposing)
         {
+            // cleanup unmanaged resources. releasing the session waits for the pending RunAsync calls, which may use the built-in RunOptions
+            if (_nativeHandle != IntPtr.Zero)
+            {
+                NativeMethods.OrtReleaseSession(_nativeHandle);
+                _nativeHandle = IntPtr.Zero;
+            }
+
             if (disposing)
             {
                 // cleanup managed resources
@@ -992,12 +1153,6 @@ namespace Microsoft.ML.OnnxRuntime
                     _builtInRunOptions.Dispose();
                 }
             }
-
-            // cleanup unmanaged resources
-            if (_nativeHandle != IntPtr.Zero)
-            {
-                NativeMethods.OrtReleaseSession(_nativeHandle);
-            }
         }
 
         #endregion
@@ -25,11 +25,21 @@ namespace Microsoft.ML.OnnxRuntime
         {
             if (nativeStatus != IntPtr.Zero)
             {
-                ErrorCode statusCode = NativeMethods.OrtGetErrorCode(nativeStatus);
-                string errorMessage = GetErrorMessage(nativeStatus);
-                NativeMethods.OrtReleaseStatus(nativeStatus);
-                throw new OnnxRuntimeException(statusCode, errorMessage);
+                throw ToException(nativeStatus);
             }
         }
+
+        /// <summary>
+        /// Constructs the exception that corresponds to the native error Status and releases it.
+        /// </summary>
+        /// <param name="nativeStatus">a native Status that is not OK/Success</param>
+        /// <returns></returns>
+        public static OnnxRuntimeException ToException(IntPtr nativeStatus)
+        {
+            ErrorCode statusCode = NativeMethods.OrtGetErrorCode(nativeStatus);
+            string errorMessage = GetErrorMessage(nativeStatus);
+            NativeMethods.OrtReleaseStatus(nativeStatus);
+            return new OnnxRuntimeException(statusCode, errorMessage);
+        }
     }
 }
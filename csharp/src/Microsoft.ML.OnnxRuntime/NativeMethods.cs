@@ -127,6 +127,35 @@ namespace Microsoft.ML.OnnxRuntime
         public IntPtr ReleaseTensorTypeAndShapeInfo;
         public IntPtr ReleaseSessionOptions;
         public IntPtr ReleaseCustomOpDomain;
+        public IntPtr GetDenotationFromTypeInfo;
+        public IntPtr CastTypeInfoToMapTypeInfo;
+        public IntPtr CastTypeInfoToSequenceTypeInfo;
+        public IntPtr GetMapKeyType;
+        public IntPtr GetMapValueType;
+        public IntPtr GetSequenceElementType;
+        public IntPtr ReleaseMapTypeInfo;
+        public IntPtr ReleaseSequenceTypeInfo;
+        public IntPtr SessionEndProfiling;
+        public IntPtr SessionGetModelMetadata;
+        public IntPtr ModelMetadataGetProducerName;
+        public IntPtr ModelMetadataGetGraphName;
+        public IntPtr ModelMetadataGetDomain;
+        public IntPtr ModelMetadataGetDescription;
+        public IntPtr ModelMetadataLookupCustomMetadataMap;
+        public IntPtr ModelMetadataGetVersion;
+        public IntPtr ReleaseModelMetadata;
+        public IntPtr CreateEnvWithGlobalThreadPools;
+        public IntPtr DisablePerSessionThreads;
+        public IntPtr CreateThreadingOptions;
+        public IntPtr ReleaseThreadingOptions;
+        public IntPtr ModelMetadataGetCustomMetadataMapKeys;
+        public IntPtr SetCpuMemArenaOptions;
+        public IntPtr RunOptionsSetShrinkMemoryArenas;
+        public IntPtr SessionShrinkMemoryArenas;
+        public IntPtr SessionGetArenaStats;
+        public IntPtr AddSharedInitializer;
+        public IntPtr EnableEnvSharedInitializers;
+        public IntPtr RunAsync;
     }
 
     internal static class NativeMethods
@@ -154,6 +183,7 @@ namespace Microsoft.ML.OnnxRuntime
             OrtCreateSession = (DOrtCreateSession)Marshal.GetDelegateForFunctionPointer(api_.CreateSession, typeof(DOrtCreateSession));
             OrtCreateSessionFromArray = (DOrtCreateSessionFromArray)Marshal.GetDelegateForFunctionPointer(api_.CreateSessionFromArray, typeof(DOrtCreateSessionFromArray));
             OrtRun = (DOrtRun)Marshal.GetDelegateForFunctionPointer(api_.Run, typeof(DOrtRun));
+            OrtRunAsync = (DOrtRunAsync)Marshal.GetDelegateForFunctionPointer(api_.RunAsync, typeof(DOrtRunAsync));
             OrtSessionGetInputCount = (DOrtSessionGetInputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetInputCount, typeof(DOrtSessionGetInputCount));
             OrtSessionGetOutputCount = (DOrtSessionGetOutputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetOutputCount, typeof(DOrtSessionGetOutputCount));
             OrtSessionGetOverridableInitializerCount = (DOrtSessionGetOverridableInitializerCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetOverridableInitializerCount, typeof(DOrtSessionGetOverridableInitializerCount));
@@ -284,6 +314,28 @@ namespace Microsoft.ML.OnnxRuntime
                                                 );
         public static DOrtRun OrtRun;
 
+        // Invoked on a thread owned by onnxruntime when a run enqueued by OrtRunAsync completes. On success status is null
+        // and outputs points to outputCount OrtValue pointers, which the callback must release. Otherwise the callback must
+        // release status.
+        public delegate void DOrtRunAsyncCallback(
+                                                IntPtr userData,
+                                                IntPtr /* (OrtValue**) */ outputs,
+                                                UIntPtr outputCount,
+                                                IntPtr /* (OrtStatus*) */ status);
+
+        public delegate IntPtr /*(ONNStatus*)*/ DOrtRunAsync(
+                                                IntPtr /*(OrtSession*)*/ session,
+                                                IntPtr /*(OrtSessionRunOptions*)*/ runOptions,  // must stay valid until the callback is invoked
+                                                string[] inputNames,
+                                                IntPtr[] /* (OrtValue*[])*/ inputValues,
+                                                UIntPtr inputCount,
+                                                string[] outputNames,
+                                                UIntPtr outputCount,
+                                                DOrtRunAsyncCallback callback,
+                                                IntPtr userData
+                                                );
+        public static DOrtRunAsync OrtRunAsync;
+
         public delegate IntPtr /*(OrtStatus*)*/ DOrtSessionGetInputCount(
                                                 IntPtr /*(OrtSession*)*/ session,
                                                 out UIntPtr count);
@@ -210,6 +210,21 @@ namespace Microsoft.ML.OnnxRuntime.Tests
                     }
                 }
 
+                // Run inference asynchronously, with outputs created with in RunAsync()
+                using (var results = session.RunAsync(container).Result)
+                {
+                    validateRunResults(results);
+                }
+
+                // Cancel an asynchronous run through its RunOptions
+                using (var runOptions = new RunOptions())
+                {
+                    runOptions.Terminate = true;
+                    IReadOnlyCollection<string> outputNames = session.OutputMetadata.Keys.ToList();
+                    var ex = Assert.Throws<AggregateException>(() => session.RunAsync(container, outputNames, runOptions).Wait());
+                    Assert.IsType<OnnxRuntimeException>(ex.InnerException);
+                }
+
                 // Run inference with pinned inputs and outputs created with in Run()
                 using (var pinnedInputs = new DisposableList<FixedBufferOnnxValue>())
                 {
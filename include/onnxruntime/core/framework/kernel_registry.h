@@ -26,7 +26,7 @@ class KernelRegistry {
   Status TryCreateKernel(const onnxruntime::Node& node, const IExecutionProvider& execution_provider,
                          const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                          const OrtValueNameIdxMap& mlvalue_name_idx_map, const FuncManager& funcs_mgr,
-                         const DataTransferManager& data_transfer_mgr,
+                         const DataTransferManager& data_transfer_mgr, SharedWeights* shared_weights,
                          std::unique_ptr<OpKernel>& op_kernel) const ORT_MUST_USE_RESULT;
 
   // Check if an execution provider can create kernel for a node and return
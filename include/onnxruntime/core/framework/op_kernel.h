@@ -171,6 +171,11 @@ class OpKernelContext {
   _Ret_maybenull_ onnxruntime::concurrency::ThreadPool* GetOperatorThreadPool() const { return threadpool_; }
 
  protected:
+  // Construct with the offset of the node's values in the execution frame already resolved,
+  // skipping the lookup of the node in the frame's NodeIndexInfo.
+  OpKernelContext(_Inout_ IExecutionFrame* frame, _In_ const OpKernel* kernel, int node_offset,
+                  _In_opt_ concurrency::ThreadPool* threadpool, _In_ const logging::Logger& logger);
+
   onnxruntime::NodeIndex GetNodeIndex() const;
 
   const OrtValue* GetInputMLValue(int index) const;
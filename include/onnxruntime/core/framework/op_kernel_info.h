@@ -15,6 +15,7 @@ namespace onnxruntime {
 class OrtValueNameIdxMap;
 class FuncManager;
 class DataTransferManager;
+class SharedWeights;
 
 // A very light-weight class, which works as an aggregated
 // view of all data needed for constructing a Kernel instance.
@@ -27,7 +28,8 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
                         const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                         const OrtValueNameIdxMap& mlvalue_name_idx_map,
                         const FuncManager& funcs_mgr,
-                        const DataTransferManager& data_transfer_mgr);
+                        const DataTransferManager& data_transfer_mgr,
+                        SharedWeights* shared_weights = nullptr);
 
   OpKernelInfo(const OpKernelInfo& other);
 
@@ -45,6 +47,10 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
 
   bool TryGetConstantInput(int input_index, const Tensor** constant_input_value) const;
 
+  // The initializers shared with other sessions through the environment, whose prepacked forms kernels can share
+  // too. nullptr if the session doesn't use them.
+  SharedWeights* GetSharedWeights() const noexcept;
+
   common::Status GetFusedFuncs(ComputeFunc* compute,
                                CreateFunctionStateFunc* create,
                                DestroyFunctionStateFunc* release) const;
@@ -62,6 +68,7 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
   const OrtValueNameIdxMap& ort_value_name_idx_map_;
   const FuncManager& funcs_mgr_;
   const DataTransferManager& data_transfer_mgr_;
+  SharedWeights* shared_weights_;
   ProtoHelperNodeContext proto_helper_context_;
 };
 
@@ -22,6 +22,10 @@ struct OrtRunOptions {
   // be forced to terminate with an error status.
   bool terminate = false;
 
+  // Set to 'true' to return the memory the arenas of the session don't use to the system once the Run() call
+  // completes.
+  bool shrink_memory_arenas = false;
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 
@@ -580,6 +580,26 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     ec_.Notify(true);
   }
 
+  // Runs one of the tasks waiting in the queues of the pool on the calling thread. Returns false
+  // if there was none. A thread waiting for work it scheduled in this pool calls it instead of
+  // blocking, so that work nested in the pool (e.g. a node run on the pool splitting its kernel
+  // between the same threads) cannot end up with every thread waiting on queued tasks.
+  bool RunPendingTask() {
+    PerThread* pt = GetPerThread();
+    Task t;
+    if (pt->pool == this) {
+      t = thread_data_[pt->thread_id].queue.PopFront();
+    }
+    if (!t.f) {
+      t = GlobalSteal();
+    }
+    if (!t.f) {
+      return false;
+    }
+    env_.ExecuteTask(t);
+    return true;
+  }
+
   int NumThreads() const EIGEN_FINAL {
     return num_threads_;
   }
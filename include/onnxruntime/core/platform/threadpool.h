@@ -187,6 +187,10 @@ class ThreadPool {
     }
     tp->ParallelFor(total, scheduling_params, fn);
   }
+  // Runs one of the tasks queued in the pool on the calling thread, returns false if there is none.
+  // Threads waiting for work scheduled in the pool use it to help rather than to sit idle.
+  bool RunPendingTask();
+
   // Returns the number of threads in the pool.
   int NumThreads() const;
 
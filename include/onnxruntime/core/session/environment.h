@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include "core/common/common.h"
 #include "core/common/status.h"
 #include "core/platform/threadpool.h"
@@ -12,6 +13,8 @@
 
 struct OrtThreadingOptions;
 namespace onnxruntime {
+class SharedWeights;
+
 /** TODO: remove this class
    Provides the runtime environment for onnxruntime.
    Create one instance for the duration of execution.
@@ -54,6 +57,23 @@ class Environment {
     return create_global_thread_pools_;
   }
 
+  /**
+     The thread pool that InferenceSession::RunAsync runs the requests of all the sessions on. It's created the
+     first time it's requested, with a thread per physical core (at least 2), and it's distinct from the thread pools
+     used within a Run so that the runs it drives don't compete with their own intra/inter op work.
+  */
+  onnxruntime::concurrency::ThreadPool* GetRunAsyncThreadPool() const;
+
+  /**
+     The initializers, and the forms of them prepacked by kernels, that are shared by the sessions created with
+     SessionOptions::use_env_shared_initializers. The sessions keep them alive after the environment is released.
+  */
+  const std::shared_ptr<SharedWeights>& GetSharedWeights() const {
+    return shared_weights_;
+  }
+
+  ~Environment();
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
 
@@ -66,5 +86,8 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> intra_op_thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
+  mutable std::once_flag run_async_thread_pool_once_;
+  mutable std::unique_ptr<onnxruntime::concurrency::ThreadPool> run_async_thread_pool_;
+  std::shared_ptr<SharedWeights> shared_weights_;
 };
 }  // namespace onnxruntime
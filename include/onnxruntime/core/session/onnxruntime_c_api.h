@@ -190,6 +190,13 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+// Invoked by RunAsync when the run completes. On success status is nullptr and outputs holds num_outputs values,
+// in the order of the requested output names. On failure status holds the error and outputs is nullptr.
+// The callback owns the values and status and must release them, but not the outputs array itself, which is only
+// valid during the call.
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(
+    void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status);
+
 // Set Graph optimization level.
 // Refer https://github.com/microsoft/onnxruntime/blob/master/docs/ONNX_Runtime_Graph_Optimizations.md
 // for in-depth undersrtanding of Graph Optimizations in ORT
@@ -205,6 +212,25 @@ typedef enum ExecutionMode {
   ORT_PARALLEL = 1,
 } ExecutionMode;
 
+// How a memory arena grows when it runs out of memory.
+typedef enum OrtArenaExtendStrategy {
+  ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO = 0,  // regions of increasing power of 2 sizes
+  ORT_ARENA_EXTEND_SAME_AS_REQUESTED = 1,  // a region of the size of the allocation that doesn't fit
+} OrtArenaExtendStrategy;
+
+// Statistics of a memory arena, in bytes unless stated otherwise.
+typedef struct OrtArenaStats {
+  int64_t num_allocs;                // number of allocations served
+  int64_t bytes_in_use;              // size of the allocations in use
+  int64_t total_allocated_bytes;     // memory held by the arena
+  int64_t max_bytes_in_use;          // peak of bytes_in_use
+  int64_t max_alloc_size;            // largest allocation served
+  int64_t bytes_limit;               // memory the arena may hold, 0 if unknown
+  int64_t num_regions;               // number of memory regions held by the arena
+  int64_t largest_free_block_bytes;  // largest free block. the free memory is fragmented when this is much
+                                     // less than total_allocated_bytes - bytes_in_use
+} OrtArenaStats;
+
 struct OrtKernelInfo;
 typedef struct OrtKernelInfo OrtKernelInfo;
 struct OrtKernelContext;
@@ -340,7 +366,7 @@ struct OrtApi {
 
   // Sets the number of threads used to parallelize the execution of the graph (across nodes)
   // If sequential execution is enabled this value is ignored
-  // A value of 0 means ORT will pick a default
+  // A value of 0 means ORT will pick a default: nodes are then run on the intra-op thread pool
   ORT_API2_STATUS(SetInterOpNumThreads, _Inout_ OrtSessionOptions* options, int inter_op_num_threads);
 
   /*
@@ -809,6 +835,72 @@ struct OrtApi {
    */
   ORT_API2_STATUS(ModelMetadataGetCustomMetadataMapKeys, _In_ const OrtModelMetadata* model_metadata,
                                                                   _Inout_ OrtAllocator* allocator, _Outptr_result_buffer_maybenull_(*num_keys) char*** keys, _Out_ int64_t* num_keys);
+
+  /**
+   * Configure the memory arena on CPU of the session.
+   * \param max_mem maximum number of bytes held by the arena, 0 for no limit.
+   * \param extend_strategy how the arena grows when it runs out of memory.
+   * \param shrink_interval_runs return the memory the arenas of the session don't use to the system after every
+   * this many Run calls, 0 to never do it.
+   * \param shrink_above_bytes after a Run call, return the memory an arena of the session doesn't use to the system
+   * when the arena holds more than this many bytes, 0 to never do it. The memory of the chunks a thread keeps
+   * cached for its next allocations isn't returned by this policy.
+   * The growth options only apply to the arena of the CPU execution provider that the session adds by default.
+   */
+  ORT_API2_STATUS(SetCpuMemArenaOptions, _Inout_ OrtSessionOptions* options, size_t max_mem,
+                  OrtArenaExtendStrategy extend_strategy, int shrink_interval_runs, size_t shrink_above_bytes);
+
+  /**
+   * Return the memory the arenas of the session hold but don't use to the system once the Run calls using these
+   * run options complete. 'shrink' is 0 or 1.
+   */
+  ORT_API2_STATUS(RunOptionsSetShrinkMemoryArenas, _Inout_ OrtRunOptions* options, int shrink);
+
+  /**
+   * Return the memory the arenas of the session hold but don't use to the system now.
+   */
+  ORT_API2_STATUS(SessionShrinkMemoryArenas, _Inout_ OrtSession* sess);
+
+  /**
+   * Get the statistics of the arena of the session that allocates the memory described by 'mem_info'.
+   * Arenas that don't collect statistics report zeros.
+   * Returns ORT_INVALID_ARGUMENT if the session has no arena for 'mem_info'.
+   */
+  ORT_API2_STATUS(SessionGetArenaStats, _In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                  _Out_ OrtArenaStats* out);
+
+  /**
+   * Register 'val' as the initializer 'name' with the env, for the sessions created with
+   * EnableEnvSharedInitializers to use in place of the initializer with that name in their model, so that they
+   * share a single copy of it and of the forms of it prepacked by kernels.
+   * 'val' must be a CPU tensor and it is immutable once added. Its data is referenced, not copied: a buffer that
+   * was passed to CreateTensorWithDataAsOrtValue must outlive the env and the sessions using it.
+   * Returns ORT_INVALID_ARGUMENT if an initializer with this name was already added.
+   */
+  ORT_API2_STATUS(AddSharedInitializer, _Inout_ OrtEnv* env, _In_z_ const char* name, _In_ const OrtValue* val);
+
+  /**
+   * Use the initializers added to the env with AddSharedInitializer in place of the initializers with the same
+   * name in the model. Their type and shape must match the ones in the model.
+   */
+  ORT_API2_STATUS(EnableEnvSharedInitializers, _Inout_ OrtSessionOptions* options);
+
+  /**
+   * Enqueue a run of the session on a thread pool owned by the env and return without waiting for it.
+   * 'callback' is invoked with 'user_data' and the outputs on a thread of that pool when the run completes.
+   * The names and the OrtValue handles of the inputs are copied, but not the data of the inputs: buffers owned by
+   * the caller, such as the ones of values created with CreateTensorWithDataAsOrtValue, must stay valid until
+   * 'callback' is invoked. The outputs are always allocated by the session.
+   * 'run_options' must stay valid until 'callback' is invoked. RunOptionsSetTerminate on it cancels the run, which
+   * then completes with an error status.
+   * ReleaseSession waits for the pending runs of the session, and may be called from 'callback'.
+   * If this returns an error 'callback' is not invoked.
+   */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
 };
 
 /*
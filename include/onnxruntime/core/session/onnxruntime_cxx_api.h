@@ -131,6 +131,8 @@ struct Env : Base<OrtEnv> {
   Env& EnableTelemetryEvents();
   Env& DisableTelemetryEvents();
 
+  Env& AddSharedInitializer(const char* name, const Value& value);
+
   static const OrtApi* s_api;
 };
 
@@ -158,6 +160,9 @@ struct RunOptions : Base<OrtRunOptions> {
   RunOptions& SetTerminate();
   // unset the terminate flag so this RunOptions instance can be used in a new Session::Run call
   RunOptions& UnsetTerminate();
+
+  // return the memory the session arenas don't use to the system once Session::Run calls using this instance complete
+  RunOptions& SetShrinkMemoryArenas(bool shrink);
 };
 
 struct SessionOptions : Base<OrtSessionOptions> {
@@ -173,6 +178,8 @@ struct SessionOptions : Base<OrtSessionOptions> {
 
   SessionOptions& EnableCpuMemArena();
   SessionOptions& DisableCpuMemArena();
+  SessionOptions& SetCpuMemArenaOptions(size_t max_mem, OrtArenaExtendStrategy extend_strategy,
+                                        int shrink_interval_runs, size_t shrink_above_bytes);
 
   SessionOptions& SetOptimizedModelFilePath(const ORTCHAR_T* optimized_model_file);
 
@@ -189,6 +196,7 @@ struct SessionOptions : Base<OrtSessionOptions> {
   SessionOptions& Add(OrtCustomOpDomain* custom_op_domain);
 
   SessionOptions& DisablePerSessionThreads();
+  SessionOptions& EnableEnvSharedInitializers();
 };
 
 struct ModelMetadata : Base<OrtModelMetadata> {
@@ -215,6 +223,10 @@ struct Session : Base<OrtSession> {
   // Run for when there is a list of prealloated outputs
   void Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
            const char* const* output_names, Value* output_values, size_t output_count);
+  // Run that is enqueued on a thread pool of the env and invokes callback with the output values when it completes.
+  // run_options must stay valid until then. See OrtApi::RunAsync.
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, size_t output_count, RunAsyncCallbackFn callback, void* user_data);
 
   size_t GetInputCount() const;
   size_t GetOutputCount() const;
@@ -225,6 +237,8 @@ struct Session : Base<OrtSession> {
   char* GetOverridableInitializerName(size_t index, OrtAllocator* allocator) const;
   char* EndProfiling(OrtAllocator* allocator) const;
   ModelMetadata GetModelMetadata() const;
+  void ShrinkMemoryArenas();
+  OrtArenaStats GetArenaStats(const OrtMemoryInfo* mem_info) const;
 
   TypeInfo GetInputTypeInfo(size_t index) const;
   TypeInfo GetOutputTypeInfo(size_t index) const;
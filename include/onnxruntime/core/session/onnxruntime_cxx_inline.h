@@ -98,6 +98,11 @@ inline Env& Env::DisableTelemetryEvents() {
   return *this;
 }
 
+inline Env& Env::AddSharedInitializer(const char* name, const Value& value) {
+  ThrowOnError(Global<void>::api_.AddSharedInitializer(p_, name, value));
+  return *this;
+}
+
 inline CustomOpDomain::CustomOpDomain(const char* domain) {
   ThrowOnError(Global<void>::api_.CreateCustomOpDomain(domain, &p_));
 }
@@ -147,6 +152,11 @@ inline RunOptions& RunOptions::UnsetTerminate() {
   return *this;
 }
 
+inline RunOptions& RunOptions::SetShrinkMemoryArenas(bool shrink) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetShrinkMemoryArenas(p_, shrink ? 1 : 0));
+  return *this;
+}
+
 inline SessionOptions::SessionOptions() {
   ThrowOnError(Global<void>::api_.CreateSessionOptions(&p_));
 }
@@ -207,6 +217,13 @@ inline SessionOptions& SessionOptions::DisableCpuMemArena() {
   return *this;
 }
 
+inline SessionOptions& SessionOptions::SetCpuMemArenaOptions(size_t max_mem, OrtArenaExtendStrategy extend_strategy,
+                                                             int shrink_interval_runs, size_t shrink_above_bytes) {
+  ThrowOnError(Global<void>::api_.SetCpuMemArenaOptions(p_, max_mem, extend_strategy, shrink_interval_runs,
+                                                        shrink_above_bytes));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::SetExecutionMode(ExecutionMode execution_mode) {
   ThrowOnError(Global<void>::api_.SetSessionExecutionMode(p_, execution_mode));
   return *this;
@@ -246,6 +263,13 @@ inline void Session::Run(const RunOptions& run_options, const char* const* input
   ThrowOnError(Global<void>::api_.Run(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count, ort_output_values));
 }
 
+inline void Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                              const char* const* output_names, size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  ThrowOnError(Global<void>::api_.RunAsync(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count,
+                                           callback, user_data));
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(Global<void>::api_.SessionGetInputCount(p_, &out));
@@ -294,6 +318,16 @@ inline ModelMetadata Session::GetModelMetadata() const {
   return ModelMetadata{out};
 }
 
+inline void Session::ShrinkMemoryArenas() {
+  ThrowOnError(Global<void>::api_.SessionShrinkMemoryArenas(p_));
+}
+
+inline OrtArenaStats Session::GetArenaStats(const OrtMemoryInfo* mem_info) const {
+  OrtArenaStats out;
+  ThrowOnError(Global<void>::api_.SessionGetArenaStats(p_, mem_info, &out));
+  return out;
+}
+
 inline char* ModelMetadata::GetProducerName(OrtAllocator* allocator) const {
   char* out;
   ThrowOnError(Global<void>::api_.ModelMetadataGetProducerName(p_, allocator, &out));
@@ -615,4 +649,9 @@ inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
   ThrowOnError(Global<void>::api_.DisablePerSessionThreads(p_));
   return *this;
 }
+
+inline SessionOptions& SessionOptions::EnableEnvSharedInitializers() {
+  ThrowOnError(Global<void>::api_.EnableEnvSharedInitializers(p_));
+  return *this;
+}
 }  // namespace Ort
\ No newline at end of file
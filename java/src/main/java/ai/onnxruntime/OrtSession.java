@@ -14,6 +14,7 @@ import java.util.List;
 import java.util.Map;
 import java.util.Optional;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
 import java.util.logging.Logger;
 
 /**
@@ -212,6 +213,89 @@ public class OrtSession implements AutoCloseable {
   public Result run(Map<String, OnnxTensor> inputs, Set<String> requestedOutputs)
       throws OrtException {
     if (!closed) {
+      RunArguments args = new RunArguments(inputs, requestedOutputs);
+      OnnxValue[] outputValues =
+          run(
+              OnnxRuntime.ortApiHandle,
+              nativeHandle,
+              allocator.handle,
+              args.inputNamesArray,
+              args.inputHandles,
+              args.inputNamesArray.length,
+              args.outputNamesArray,
+              args.outputNamesArray.length);
+      return new Result(args.outputNamesArray, outputValues);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Starts scoring an input feed dict on a thread pool owned by onnxruntime, returning a future of
+   * the map of all inferred outputs.
+   *
+   * <p>The outputs are sorted based on their id number.
+   *
+   * @param inputs The inputs to score.
+   * @return A future of the inferred outputs.
+   * @throws OrtException If there was an error in native code, the input names are invalid, or if
+   *     there are zero or too many inputs.
+   */
+  public CompletableFuture<Result> runAsync(Map<String, OnnxTensor> inputs) throws OrtException {
+    return runAsync(inputs, outputNames);
+  }
+
+  /**
+   * Starts scoring an input feed dict on a thread pool owned by onnxruntime, returning a future of
+   * the map of requested inferred outputs.
+   *
+   * <p>The outputs are sorted based on the supplied set traveral order. The future is completed on
+   * a thread of the pool, and cancelling it terminates the run. The inputs must not be closed
+   * before the future is done.
+   *
+   * @param inputs The inputs to score.
+   * @param requestedOutputs The requested outputs.
+   * @return A future of the inferred outputs, which completes exceptionally with an {@link
+   *     OrtException} if the run fails.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public CompletableFuture<Result> runAsync(
+      Map<String, OnnxTensor> inputs, Set<String> requestedOutputs) throws OrtException {
+    if (!closed) {
+      RunArguments args = new RunArguments(inputs, requestedOutputs);
+      RunFuture future =
+          new RunFuture(args.outputNamesArray, inputs, createRunOptions(OnnxRuntime.ortApiHandle));
+      try {
+        runAsync(
+            OnnxRuntime.ortApiHandle,
+            nativeHandle,
+            allocator.handle,
+            args.inputNamesArray,
+            args.inputHandles,
+            args.inputNamesArray.length,
+            args.outputNamesArray,
+            args.outputNamesArray.length,
+            future.runOptionsHandle,
+            future);
+      } catch (OrtException e) {
+        future.releaseRunOptions();
+        throw e;
+      }
+      return future;
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /** The validated names and handles of the inputs and outputs of a run. */
+  private final class RunArguments {
+    final String[] inputNamesArray;
+    final long[] inputHandles;
+    final String[] outputNamesArray;
+
+    RunArguments(Map<String, OnnxTensor> inputs, Set<String> requestedOutputs)
+        throws OrtException {
       if (inputs.isEmpty() || (inputs.size() > numInputs)) {
         throw new OrtException(
             "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
@@ -223,8 +307,8 @@ public class OrtSession implements AutoCloseable {
                 + ") found "
                 + requestedOutputs.size());
       }
-      String[] inputNamesArray = new String[inputs.size()];
-      long[] inputHandles = new long[inputs.size()];
+      inputNamesArray = new String[inputs.size()];
+      inputHandles = new long[inputs.size()];
       int i = 0;
       for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
         if (inputNames.contains(t.getKey())) {
@@ -236,7 +320,7 @@ public class OrtSession implements AutoCloseable {
               "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
         }
       }
-      String[] outputNamesArray = new String[requestedOutputs.size()];
+      outputNamesArray = new String[requestedOutputs.size()];
       i = 0;
       for (String s : requestedOutputs) {
         if (outputNames.contains(s)) {
@@ -247,19 +331,65 @@ public class OrtSession implements AutoCloseable {
               "Unknown output name " + s + ", expected one of " + outputNames.toString());
         }
       }
-      OnnxValue[] outputValues =
-          run(
-              OnnxRuntime.ortApiHandle,
-              nativeHandle,
-              allocator.handle,
-              inputNamesArray,
-              inputHandles,
-              inputNamesArray.length,
-              outputNamesArray,
-              outputNamesArray.length);
-      return new Result(outputNamesArray, outputValues);
-    } else {
-      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /**
+   * The future of a {@link #runAsync(Map, Set)} call, which native code completes. It owns the
+   * native run options of the call until then, and keeps the inputs reachable.
+   */
+  private static final class RunFuture extends CompletableFuture<Result> {
+    private final String[] outputNamesArray;
+
+    private Map<String, OnnxTensor> inputs;
+
+    private long runOptionsHandle;
+
+    RunFuture(String[] outputNamesArray, Map<String, OnnxTensor> inputs, long runOptionsHandle) {
+      this.outputNamesArray = outputNamesArray;
+      this.inputs = inputs;
+      this.runOptionsHandle = runOptionsHandle;
+    }
+
+    @Override
+    public synchronized boolean cancel(boolean mayInterruptIfRunning) {
+      if (runOptionsHandle != 0) {
+        terminate(OnnxRuntime.ortApiHandle, runOptionsHandle);
+      }
+      return super.cancel(mayInterruptIfRunning);
+    }
+
+    /**
+     * Called from native code when the run succeeds.
+     *
+     * @param outputValues The outputs.
+     */
+    synchronized void onComplete(OnnxValue[] outputValues) {
+      releaseRunOptions();
+      Result result = new Result(outputNamesArray, outputValues);
+      if (!complete(result)) {
+        // cancelled
+        result.close();
+      }
+    }
+
+    /**
+     * Called from native code when the run fails.
+     *
+     * @param code The error code.
+     * @param message The error message.
+     */
+    synchronized void onError(int code, String message) {
+      releaseRunOptions();
+      completeExceptionally(new OrtException(code, message));
+    }
+
+    synchronized void releaseRunOptions() {
+      if (runOptionsHandle != 0) {
+        closeRunOptions(OnnxRuntime.ortApiHandle, runOptionsHandle);
+        runOptionsHandle = 0;
+        inputs = null;
+      }
     }
   }
 
@@ -332,6 +462,25 @@ public class OrtSession implements AutoCloseable {
       long numOutputs)
       throws OrtException;
 
+  private native void runAsync(
+      long apiHandle,
+      long nativeHandle,
+      long allocatorHandle,
+      String[] inputNamesArray,
+      long[] inputs,
+      long numInputs,
+      String[] outputNamesArray,
+      long numOutputs,
+      long runOptionsHandle,
+      RunFuture future)
+      throws OrtException;
+
+  private static native long createRunOptions(long apiHandle) throws OrtException;
+
+  private static native void terminate(long apiHandle, long runOptionsHandle);
+
+  private static native void closeRunOptions(long apiHandle, long runOptionsHandle);
+
   private native void closeSession(long apiHandle, long nativeHandle) throws OrtException;
 
   /**
@@ -6,10 +6,13 @@
 #include <stdio.h>
 #include "OrtJniUtil.h"
 
+JavaVM* ortJavaVM = NULL;
+
 jint JNI_OnLoad(JavaVM *vm, void *reserved) {
     // To silence unused-parameter error.
-    // This function must exist according to the JNI spec, but the arguments aren't necessary for the library to request a specific version.
-    (void)vm; (void) reserved;
+    // This function must exist according to the JNI spec, but the argument isn't necessary for the library to request a specific version.
+    (void) reserved;
+    ortJavaVM = vm;
     // Requesting 1.6 to support Android. Will need to be bumped to a later version to call interface default methods
     // from native code, or to access other new Java features.
     return JNI_VERSION_1_6;
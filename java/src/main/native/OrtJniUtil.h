@@ -13,6 +13,11 @@ extern "C" {
 
 jint JNI_OnLoad(JavaVM *vm, void *reserved);
 
+/**
+ * The VM the library is loaded in, which native threads attach to in order to call back into Java.
+ */
+extern JavaVM* ortJavaVM;
+
 OrtLoggingLevel convertLoggingLevel(jint level);
 
 GraphOptimizationLevel convertOptimizationLevel(jint level);
@@ -3,6 +3,7 @@
  * Licensed under the MIT License.
  */
 #include <jni.h>
+#include <stdlib.h>
 #include <string.h>
 #include "onnxruntime/core/session/onnxruntime_c_api.h"
 #include "OrtJniUtil.h"
@@ -309,6 +310,175 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
     return outputArray;
 }
 
+/*
+ * The state of a runAsync call, which the callback releases.
+ */
+typedef struct RunAsyncContext {
+    const OrtApi* api;
+    OrtAllocator* allocator;
+    jobject future; // global reference to the RunFuture to complete
+} RunAsyncContext;
+
+/*
+ * Completes the RunFuture of a runAsync call. It's invoked on a thread owned by onnxruntime, which is attached to the
+ * VM as a daemon the first time, and stays attached.
+ */
+static void ORT_API_CALL runAsyncCallback(void* userData, OrtValue** outputs, size_t numOutputs, OrtStatus* status) {
+    RunAsyncContext* context = (RunAsyncContext*) userData;
+    const OrtApi* api = context->api;
+    JNIEnv* jniEnv = NULL;
+    if ((*ortJavaVM)->GetEnv(ortJavaVM, (void**)&jniEnv, JNI_VERSION_1_6) != JNI_OK) {
+#ifdef __ANDROID__
+        jint attached = (*ortJavaVM)->AttachCurrentThreadAsDaemon(ortJavaVM, &jniEnv, NULL);
+#else
+        jint attached = (*ortJavaVM)->AttachCurrentThreadAsDaemon(ortJavaVM, (void**)&jniEnv, NULL);
+#endif
+        if (attached != JNI_OK) {
+            // There is no way to reach the future, release what the run produced. The future is leaked.
+            for (size_t i = 0; i < numOutputs; i++) {
+                api->ReleaseValue(outputs[i]);
+            }
+            if (status != NULL) {
+                api->ReleaseStatus(status);
+            }
+            free(context);
+            return;
+        }
+    }
+
+    // The thread is never detached, so the local references must be released explicitly.
+    (*jniEnv)->PushLocalFrame(jniEnv, 16);
+    jclass futureClass = (*jniEnv)->GetObjectClass(jniEnv, context->future);
+    jmethodID onComplete = (*jniEnv)->GetMethodID(jniEnv, futureClass, "onComplete", "([Lai/onnxruntime/OnnxValue;)V");
+    jmethodID onError = (*jniEnv)->GetMethodID(jniEnv, futureClass, "onError", "(ILjava/lang/String;)V");
+    if (status == NULL) {
+        jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, "ai/onnxruntime/OnnxValue");
+        jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv, (jsize) numOutputs, onnxValueClass, NULL);
+        size_t i = 0;
+        for (; i < numOutputs && !(*jniEnv)->ExceptionCheck(jniEnv); i++) {
+            jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, context->allocator, outputs[i]);
+            (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, (jsize) i, onnxValue);
+            (*jniEnv)->DeleteLocalRef(jniEnv, onnxValue);
+        }
+        if ((*jniEnv)->ExceptionCheck(jniEnv)) {
+            (*jniEnv)->ExceptionClear(jniEnv);
+            for (; i < numOutputs; i++) {
+                api->ReleaseValue(outputs[i]);
+            }
+            jstring message = (*jniEnv)->NewStringUTF(jniEnv, "Failed to convert the outputs of the run");
+            (*jniEnv)->CallVoidMethod(jniEnv, context->future, onError, convertErrorCode(ORT_FAIL), message);
+        } else {
+            (*jniEnv)->CallVoidMethod(jniEnv, context->future, onComplete, outputArray);
+        }
+    } else {
+        jstring message = (*jniEnv)->NewStringUTF(jniEnv, api->GetErrorMessage(status));
+        jint code = convertErrorCode(api->GetErrorCode(status));
+        api->ReleaseStatus(status);
+        (*jniEnv)->CallVoidMethod(jniEnv, context->future, onError, code, message);
+    }
+    if ((*jniEnv)->ExceptionCheck(jniEnv)) {
+        // there is no Java caller to propagate it to
+        (*jniEnv)->ExceptionDescribe(jniEnv);
+        (*jniEnv)->ExceptionClear(jniEnv);
+    }
+    (*jniEnv)->PopLocalFrame(jniEnv, NULL);
+
+    (*jniEnv)->DeleteGlobalRef(jniEnv, context->future);
+    free(context);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    runAsync
+ * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;JJLai/onnxruntime/OrtSession$RunFuture;)V
+ * private native void runAsync(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs, long runOptionsHandle, RunFuture future)
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_runAsync
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlong numOutputs, jlong runOptionsHandle, jobject future) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+    RunAsyncContext* context = malloc(sizeof(RunAsyncContext));
+    context->api = api;
+    context->allocator = allocator;
+    context->future = (*jniEnv)->NewGlobalRef(jniEnv, future);
+
+    // The names and input values are copied by RunAsync, so they're released once it returns.
+    const char** inputNames = malloc(sizeof(char*)*numInputs);
+    jobject* javaInputStrings = malloc(sizeof(jobject)*numInputs);
+    for (int i = 0; i < numInputs; i++) {
+        javaInputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,inputNamesArr,i);
+        inputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaInputStrings[i],NULL);
+    }
+    const char** outputNames = malloc(sizeof(char*)*numOutputs);
+    jobject* javaOutputStrings = malloc(sizeof(jobject)*numOutputs);
+    for (int i = 0; i < numOutputs; i++) {
+        javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,outputNamesArr,i);
+        outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaOutputStrings[i],NULL);
+    }
+    jlong* inputTensors = (*jniEnv)->GetLongArrayElements(jniEnv,tensorArr,NULL);
+
+    OrtStatus* status = api->RunAsync((OrtSession*)sessionHandle, (OrtRunOptions*)runOptionsHandle, (const char* const*) inputNames, (const OrtValue* const*) inputTensors, numInputs, (const char* const*) outputNames, numOutputs, runAsyncCallback, context);
+
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv,tensorArr,inputTensors,JNI_ABORT);
+    for (int i = 0; i < numInputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaInputStrings[i],inputNames[i]);
+    }
+    for (int i = 0; i < numOutputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaOutputStrings[i],outputNames[i]);
+    }
+    free(inputNames);
+    free(javaInputStrings);
+    free(outputNames);
+    free(javaOutputStrings);
+
+    if (status != NULL) {
+        // the callback won't be invoked
+        (*jniEnv)->DeleteGlobalRef(jniEnv, context->future);
+        free(context);
+        checkOrtStatus(jniEnv,api,status);
+    }
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    createRunOptions
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtSession_createRunOptions
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle) {
+    (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtRunOptions* runOptions = NULL;
+    checkOrtStatus(jniEnv,api,api->CreateRunOptions(&runOptions));
+    return (jlong) runOptions;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    terminate
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_terminate
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong runOptionsHandle) {
+    (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    checkOrtStatus(jniEnv,api,api->RunOptionsSetTerminate((OrtRunOptions*) runOptionsHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    closeRunOptions
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_closeRunOptions
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong runOptionsHandle) {
+    (void) jniEnv; (void) jclazz; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ReleaseRunOptions((OrtRunOptions*) runOptionsHandle);
+}
+
 /*
  * Class:     ai_onnxruntime_OrtSession
  * Method:    closeSession
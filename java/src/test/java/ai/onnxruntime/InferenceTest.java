@@ -37,6 +37,8 @@ import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
 import java.util.concurrent.TimeUnit;
@@ -197,6 +199,44 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void runAsyncTest() throws Exception {
+    String modelPath = getResourcePath("/partial-inputs-test-2.onnx").toString();
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("runAsync");
+        OrtSession.SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options)) {
+      // Graph has three scalar inputs, a, b, c, and a single output, ab.
+      OnnxTensor a = OnnxTensor.createTensor(env, new float[] {2.0f});
+      OnnxTensor b = OnnxTensor.createTensor(env, new float[] {3.0f});
+      OnnxTensor c = OnnxTensor.createTensor(env, new float[] {5.0f});
+      Map<String, OnnxTensor> inputMap = new HashMap<>();
+      inputMap.put("a:0", a);
+      inputMap.put("b:0", b);
+      inputMap.put("c:0", c);
+
+      List<CompletableFuture<Result>> futures = new ArrayList<>();
+      for (int i = 0; i < 8; i++) {
+        futures.add(session.runAsync(inputMap));
+      }
+      for (CompletableFuture<Result> future : futures) {
+        try (Result r = future.get()) {
+          assertEquals(1, r.size());
+          assertEquals(6.0f, ((float[]) r.get("ab:0").get().getValue())[0], 1e-10);
+        }
+      }
+
+      // The run fails in native code as input b isn't supplied.
+      inputMap.remove("b:0");
+      CompletableFuture<Result> future = session.runAsync(inputMap);
+      try {
+        future.get();
+        fail("Expected to throw OrtException due to incorrect inputs");
+      } catch (ExecutionException e) {
+        assertTrue(e.getCause() instanceof OrtException);
+      }
+    }
+  }
+
   @Test
   public void partialInputsTest() throws OrtException {
     String modelPath = getResourcePath("/partial-inputs-test.onnx").toString();
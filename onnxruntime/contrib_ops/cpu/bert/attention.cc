@@ -8,9 +8,12 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/math/gemm_helper.h"
-#include "core/providers/cpu/math/softmax.h"
 #include "core/providers/cpu/tensor/transpose.h"
 #include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+
+#include <algorithm>
+#include <numeric>
 
 using onnxruntime::concurrency::ThreadPool;
 
@@ -24,6 +27,11 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 
+// Number of queries and keys processed together by the fused attention loop. A block of queries, a tile of keys and
+// values and the scores between them stay resident in the L2 cache.
+static constexpr int kAttentionQueryBlockSize = 64;
+static constexpr int kAttentionKeyBlockSize = 64;
+
 AttentionBase::AttentionBase(const OpKernelInfo& info) {
   int64_t num_heads = 0;
   ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
@@ -140,203 +148,148 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     const auto weights_data = weights->template Data<T>();
     const auto bias_data = bias->template Data<T>();
 
-    const double cost =
-        static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(hidden_size);
-    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    // broadcast 3NH -> (3.B.N.S.H) so that the GEMMs below can accumulate onto the bias
+    const double broadcast_cost = static_cast<double>(sequence_length) * static_cast<double>(head_size);
+    ThreadPool::TryParallelFor(tp, loop_len, broadcast_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
         const int batch_index = static_cast<int>((i / 3) / num_heads_);
         const int head_index = static_cast<int>((i / 3) % num_heads_);
         const int qkv_index = static_cast<int>(i % 3);
 
-        int input_offset = batch_index * sequence_length * hidden_size;
-        int weights_offset = qkv_index * hidden_size + head_index * head_size;
-        T* qkv_dest = QKV[qkv_index];
-        int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
-
-        // broadcast 3NH -> (3.B.N.S.H)
-        const T* broadcast_data_src = bias_data + weights_offset;
-        T* broadcast_data_dest = QKV[qkv_index] + qkv_offset;
+        const T* broadcast_data_src = bias_data + qkv_index * hidden_size + head_index * head_size;
+        T* broadcast_data_dest = QKV[qkv_index] + (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
         for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
           memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
           broadcast_data_dest += head_size;
         }
-
-        //                   original           transposed            iteration
-        // A: input          (BxSxNxH)          (B.)S x NH            S x NH
-        // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
-        // C: QKV[qkv_index] (3xBxNxSxH)        (3.B.N.)S x H         S x H
-
-        math::GemmEx<float, ThreadPool>(CblasNoTrans,                   // TransA = no
-                                        CblasNoTrans,                   // TransB = no
-                                        sequence_length,                // M      = S
-                                        head_size,                      // N      = H
-                                        hidden_size,                    // K      = NH
-                                        1.0f,                           // alpha
-                                        input_data + input_offset,      // A
-                                        hidden_size,                    // lda    = NH
-                                        weights_data + weights_offset,  // B
-                                        3 * hidden_size,                // ldb    = 3NH
-                                        1.0f,                           // beta
-                                        qkv_dest + qkv_offset,          // C
-                                        head_size,                      // ldc
-                                        nullptr                         // use single-thread
-        );
       }
     });
-  }
-
-  // STEP.2: scratch(B, N, S, S) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S, H -> B, N, H, S) + 1 x mask_index(B -> B, 1,
-  // 1, 1)
-  size_t scratch_data_bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * sequence_length * element_size;
-  auto scratch_data = allocator->Alloc(scratch_data_bytes);
-  BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
-
-  {
-    size_t mask_data_bytes = 0;
-    if (mask_index != nullptr) {
-      mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * sequence_length * element_size;
-    } else if (is_unidirectional_) {
-      mask_data_bytes = SafeInt<size_t>(sequence_length) * sequence_length * element_size;
-    }
 
-    void* mask_data = nullptr;
-    if (mask_data_bytes > 0) {
-      mask_data = allocator->Alloc(mask_data_bytes);
-      memset(mask_data, 0, mask_data_bytes);
+    //                   original           transposed            iteration
+    // A: input          (BxSxNxH)          (B.)S x NH            S x NH
+    // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
+    // C: QKV[qkv_index] (3xBxNxSxH)        (3.B.N.)S x H         S x H
+    std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(loop_len);
+    for (int i = 0; i < loop_len; i++) {
+      const int batch_index = (i / 3) / num_heads_;
+      const int head_index = (i / 3) % num_heads_;
+      const int qkv_index = i % 3;
+
+      auto& params = gemm_params[i];
+      params.A = input_data + batch_index * sequence_length * hidden_size;
+      params.lda = hidden_size;                                                // lda = NH
+      params.B = weights_data + qkv_index * hidden_size + head_index * head_size;
+      params.ldb = 3 * hidden_size;                                            // ldb = 3NH
+      params.C = QKV[qkv_index] + (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
+      params.ldc = head_size;
+      params.alpha = 1.0f;
+      params.beta = 1.0f;
     }
-    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
-
-    if (mask_index != nullptr && mask_data != nullptr) {
-      T* p_mask = reinterpret_cast<T*>(mask_data);
-      for (int b_i = 0; b_i < batch_size; b_i++) {
-        // TODO: mask_index can be used in softmax to save some calculation.
-        // Convert mask_index to mask (-10000 means out of range, which will be 0 after softmax): B => BxS
-        int valid_length = mask_index->template Data<int32_t>()[b_i];
-        for (int m_i = valid_length; m_i < sequence_length; m_i++) {
-          p_mask[m_i] = static_cast<T>(-10000.0);
-        }
 
-        // Broadcast mask from BxS to BxSxS
-        for (int s_i = 1; s_i < sequence_length; s_i++) {
-          memcpy(p_mask + s_i * sequence_length, p_mask, sequence_length * sizeof(T));
-        }
-        p_mask += sequence_length * sequence_length;
-      }
-    } else if (is_unidirectional_ && mask_data != nullptr) {  // unidirectional mask
-      T* p_mask = reinterpret_cast<T*>(mask_data);
-      for (int s_i = 0; s_i < sequence_length - 1; s_i++) {
-        for (int m_i = s_i + 1; m_i < sequence_length; m_i++) {
-          p_mask[s_i * sequence_length + m_i] = static_cast<T>(-10000.0);
-        }
-      }
-    } else {  // no any mask
-      memset(scratch_data, 0, scratch_data_bytes);
-    }
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, sequence_length, head_size, hidden_size,
+                  gemm_params.data(), gemm_params.size(), tp);
+  }
 
-    const int loop_len = batch_size * num_heads_;
+  // STEP.2: out(B, S, N, H) = Softmax(1/sqrt(H) x Q(B, N, S, H) x K'(B, N, H, S) + mask) x V(B, N, S, H)
+  // Each work item takes a block of queries of one head and walks the keys and values a tile at a time, keeping a
+  // running maximum and sum per query (online softmax). The scores only ever exist for one block and tile, so the
+  // (B, N, S, S) tensor is never materialized. The unnormalized result is accumulated directly into the output with
+  // a row stride of NH, which also performs the transpose from (B, N, S, H) to (B, S, N, H).
+  {
+    const int query_blocks = (sequence_length + kAttentionQueryBlockSize - 1) / kAttentionQueryBlockSize;
+    const int loop_len = batch_size * num_heads_ * query_blocks;
     const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
+    T* output_data = output->template MutableData<T>();
 
-    // The cost of Gemm
-    const double cost =
-        static_cast<double>(head_size) * static_cast<double>(sequence_length) * static_cast<double>(sequence_length);
+    // two GEMMs of a query block against every key, plus the exponentials of the scores
+    const double cost = static_cast<double>(kAttentionQueryBlockSize) * sequence_length * (4.0 * head_size + 16.0);
     ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      for (std::ptrdiff_t i = begin; i != end; ++i) {
-        const std::ptrdiff_t batch_index = i / num_heads_;
-
-        // broadcast mask data: SxS or (Bx)SxS -> (BxNx)SxS
-        if (mask_data != nullptr) {
-          const T* broadcast_data_src = is_unidirectional_ ? reinterpret_cast<T*>(mask_data) : reinterpret_cast<T*>(mask_data) + batch_index * sequence_length * sequence_length;
-          T* broadcast_data_dest = reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i;
-          memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * sequence_length * sizeof(T));
-        }
-
-        // gemm
-
-        //                   original           transposed            iteration
-        // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
-        // B: K'             (BxNxSxH)          (B.N.)H x S            H x S
-        // C: scratch_data   (BxNxSxS)          (B.N.)S x S            S x S
-
-        math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, sequence_length, head_size, alpha,
-                                  Q + sequence_length * head_size * i, K + sequence_length * head_size * i, 1.0,
-                                  reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i, nullptr);
-      }
-    });
-  }
+      std::vector<T> scores(kAttentionQueryBlockSize * kAttentionKeyBlockSize);
+      std::vector<T> row_max(kAttentionQueryBlockSize);
+      std::vector<T> row_sum(kAttentionQueryBlockSize);
 
-  // STEP.3: P(B, N, S, S) = Softmax(scratch)
-  {
-    const int N = batch_size * num_heads_ * sequence_length;
-    const int D = sequence_length;
-
-    ThreadPool::TryParallelFor(tp, N, sequence_length * 2.0, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      for (std::ptrdiff_t j = begin; j != end; ++j) {
-        float* x = reinterpret_cast<T*>(scratch_data) + j * D;
-        float* y = x;
-
-        // e^x is represented as infinity if x is large enough, like 100.f.
-        // Infinity divided by Infinity is a NAN. Thus, softmax gets a NAN if
-        // one or more item are large enough. a math transform as below is
-        // leveraged to get a stable softmax: e^xi/(e^x1 + ...e^xn) = e^(xi -
-        // max) / (e^(x1 - max) + ... + e^(xn - max))
-        float max = -std::numeric_limits<float>::infinity();
-        for (int i = 0; i < D; i++) {
-          if (max < x[i])
-            max = x[i];
-        }
-        for (int i = 0; i < D; i++) {
-          y[i] = expf(x[i] - max);
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const int batch_head_index = static_cast<int>(i / query_blocks);
+        const int batch_index = batch_head_index / num_heads_;
+        const int head_index = batch_head_index % num_heads_;
+        const int query_start = static_cast<int>(i % query_blocks) * kAttentionQueryBlockSize;
+        const int query_count = std::min(kAttentionQueryBlockSize, sequence_length - query_start);
+
+        const T* q = Q + (batch_head_index * sequence_length + query_start) * head_size;
+        const T* k = K + batch_head_index * sequence_length * head_size;
+        const T* v = V + batch_head_index * sequence_length * head_size;
+        T* out = output_data + ((batch_index * sequence_length + query_start) * num_heads_ + head_index) * head_size;
+
+        // Keys at or past key_end are masked (-10000) for every query in the block. Their weights underflow to zero,
+        // so those tiles are skipped. When every key of a batch is masked the mask is a constant shift of the scores
+        // and is ignored.
+        int key_end = sequence_length;
+        if (mask_index_data != nullptr) {
+          const int valid_length = mask_index_data[batch_index];
+          if (valid_length > 0 && valid_length < sequence_length) {
+            key_end = valid_length;
+          }
+        } else if (is_unidirectional_) {
+          key_end = query_start + query_count;
         }
 
-        double sum = 0.0;
+        for (int key_start = 0; key_start < key_end; key_start += kAttentionKeyBlockSize) {
+          const int key_count = std::min(kAttentionKeyBlockSize, key_end - key_start);
+
+          MlasGemm(CblasNoTrans, CblasTrans, query_count, key_count, head_size,
+                   alpha, q, head_size, k + key_start * head_size, head_size,
+                   0.0f, scores.data(), key_count, nullptr);
+
+          for (int r = 0; r < query_count; r++) {
+            T* row = scores.data() + r * key_count;
+
+            // unidirectional: the keys after the query are masked
+            if (is_unidirectional_) {
+              for (int c = std::max(0, query_start + r + 1 - key_start); c < key_count; c++) {
+                row[c] += static_cast<T>(-10000.0);
+              }
+            }
+
+            const T tile_max = *std::max_element(row, row + key_count);
+            const T new_max = (key_start == 0) ? tile_max : std::max(row_max[r], tile_max);
+
+            for (int c = 0; c < key_count; c++) {
+              row[c] -= new_max;
+            }
+            MlasComputeExp(row, row, key_count);
+            const T tile_sum = std::accumulate(row, row + key_count, static_cast<T>(0));
+
+            if (key_start == 0) {
+              row_sum[r] = tile_sum;
+            } else {
+              // rescale the sum and the output accumulated so far to the new maximum
+              const T scale = std::exp(row_max[r] - new_max);
+              row_sum[r] = row_sum[r] * scale + tile_sum;
+              T* out_row = out + r * hidden_size;
+              for (int h = 0; h < head_size; h++) {
+                out_row[h] *= scale;
+              }
+            }
+            row_max[r] = new_max;
+          }
 
-        for (int i = 0; i < D; i++) {
-          sum += x[i];
+          MlasGemm(CblasNoTrans, CblasNoTrans, query_count, head_size, key_count,
+                   1.0f, scores.data(), key_count, v + key_start * head_size, head_size,
+                   (key_start == 0) ? 0.0f : 1.0f, out, hidden_size, nullptr);
         }
 
-        if (sum == 0) {
-          for (int i = 0; i < D; i++) {
-            y[i] = 1.0f / (float)D;
-          }
-        } else {
-          for (int i = 0; i < D; i++) {
-            y[i] = x[i] / (float)sum;
+        for (int r = 0; r < query_count; r++) {
+          const T scale = static_cast<T>(1) / row_sum[r];
+          T* out_row = out + r * hidden_size;
+          for (int h = 0; h < head_size; h++) {
+            out_row[h] *= scale;
           }
         }
       }
     });
   }
 
-  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, S) x V(B, N, S, H)
-  auto out_tmp_data =
-      allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * head_size * element_size);
-  BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
-  // cost of MatMul
-  const double cost =
-      static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(sequence_length);
-  ThreadPool::TryParallelFor(tp, batch_size * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-    const int sequence_length_mul_head_size = sequence_length * head_size;
-    for (std::ptrdiff_t i = begin; i != end; ++i) {
-      T* current_tmp_data = reinterpret_cast<T*>(out_tmp_data) + sequence_length_mul_head_size * i;
-      math::MatMul<T>(sequence_length, head_size, sequence_length,
-                      reinterpret_cast<T*>(scratch_data) + sequence_length_mul_head_size * i,
-                      V + sequence_length_mul_head_size * i, current_tmp_data, nullptr);
-
-      // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-      const int batch_index = static_cast<int>(i / num_heads_);
-      const int head_index = static_cast<int>(i % num_heads_);
-      T* src = current_tmp_data;
-      T* dest =
-          output->template MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-      const auto bytes_to_copy = SafeInt<size_t>(head_size) * sizeof(T);
-      for (int j = 0; j < sequence_length; j++) {
-        memcpy(dest, src, bytes_to_copy);
-        src += head_size;
-        dest += hidden_size;
-      }
-    }
-  });
-
   return Status::OK();
 }
 
@@ -35,6 +35,10 @@ class BlockingCounter {
 
   ~BlockingCounter() = default;
 
+  inline bool Done() const {
+    return (state_.load(std::memory_order_acquire) >> 1) == 0;
+  }
+
   inline void DecrementCount() {
     unsigned int v = state_.fetch_sub(2, std::memory_order_acq_rel) - 2;
     if (v != 1) {
@@ -82,6 +86,19 @@ class BlockingCounter {
 }  // namespace
 namespace concurrency {
 
+// Waits for the counter while running the tasks queued in the pool. The waiting thread may be a
+// worker of the pool itself, e.g. when the parallel executor runs a node on the intra-op pool and
+// its kernel splits the work between the threads of that same pool. Blocking only once nothing is
+// left in the queues guarantees the shards it waits for are running on some thread.
+static void WaitRunningPendingTasks(ThreadPool& pool, BlockingCounter& counter) {
+  while (!counter.Done()) {
+    if (!pool.RunPendingTask()) {
+      counter.Wait();
+      return;
+    }
+  }
+}
+
 ThreadPool::ThreadPool(Env* env, const ThreadOptions& thread_options, const NAME_CHAR_TYPE* name, int num_threads,
                        bool low_latency_hint, Eigen::Allocator* allocator)
     : thread_options_(thread_options) {
@@ -118,17 +135,17 @@ void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, std::function<void(std:
     return;
   }
 
-  Barrier barrier(static_cast<unsigned int>(total));
-  std::function<void(std::ptrdiff_t)> handle_iteration = [&barrier, &fn](std::ptrdiff_t iteration) {
+  BlockingCounter counter(static_cast<int>(total));
+  std::function<void(std::ptrdiff_t)> handle_iteration = [&counter, &fn](std::ptrdiff_t iteration) {
     fn(iteration);
-    barrier.Notify();
+    counter.DecrementCount();
   };
 
   for (std::ptrdiff_t id = 0; id < total; ++id) {
     Schedule([=, &handle_iteration]() { handle_iteration(id); });
   }
 
-  barrier.Wait();
+  WaitRunningPendingTasks(*this, counter);
 }
 
 void ThreadPool::Schedule(std::function<void()> fn) {
@@ -190,7 +207,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   // Execute the root in the thread pool to avoid running work on more than
   // numThreads() threads.
   Schedule([=, &handle_range]() { handle_range(0, total); });
-  counter.Wait();
+  WaitRunningPendingTasks(*this, counter);
 }
 
 struct ParallelForBlock {
@@ -276,9 +293,9 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
   // Recursively divide size into halves until we reach block_size.
   // Division code rounds mid to block_size, so we are guaranteed to get
   // block_count leaves that do actual computations.
-  Barrier barrier(static_cast<unsigned int>(block.count));
+  BlockingCounter counter(static_cast<int>(block.count));
   std::function<void(ptrdiff_t, ptrdiff_t)> handleRange;
-  handleRange = [=, &handleRange, &barrier, &f](ptrdiff_t firstIdx, ptrdiff_t lastIdx) {
+  handleRange = [=, &handleRange, &counter, &f](ptrdiff_t firstIdx, ptrdiff_t lastIdx) {
     while (lastIdx - firstIdx > block.size) {
       // Split into halves and schedule the second half on a different thread.
       const ptrdiff_t midIdx = firstIdx + Eigen::divup((lastIdx - firstIdx) / 2, block.size) * block.size;
@@ -287,17 +304,22 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
     }
     // Single block or less, execute directly.
     f(firstIdx, lastIdx);
-    barrier.Notify();
+    counter.DecrementCount();
   };
 
   underlying_threadpool_->Schedule([=, &handleRange]() { handleRange(0, n); });
-  barrier.Wait();
+  WaitRunningPendingTasks(*this, counter);
 }
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn) {
   ParallelFor(total, TensorOpCost{0, 0, static_cast<double>(cost_per_unit)}, fn);
 }
 
+bool ThreadPool::RunPendingTask() {
+  // pools wrapping a user provided Eigen::ThreadPoolInterface do not expose their queues
+  return eigen_threadpool_ != nullptr && eigen_threadpool_->RunPendingTask();
+}
+
 int ThreadPool::NumThreads() const {
   return underlying_threadpool_->NumThreads();
 }
@@ -3,6 +3,7 @@
 
 #include "core/framework/allocation_planner.h"
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <algorithm>
 #include <sstream>
@@ -10,6 +11,7 @@
 #include "core/platform/env.h"
 #include "core/framework/data_types.h"
 #include "core/framework/kernel_def_builder.h"
+#include "core/framework/mem_pattern_planner.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
@@ -699,6 +701,77 @@ class PlannerImpl {
       plan_.execution_plan[prev_dealloc_point].free_to_index = current - 1;
   }
 
+  // Size of the buffer the execution frame allocates for a tensor, if its shape is static.
+  bool GetStaticTensorSize(const onnxruntime::NodeArg& arg, size_t& size) {
+    const auto* shape = context_.GetShape(arg);
+    if (nullptr == shape) return false;
+
+    int64_t num_elements = 1;
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) return false;
+      num_elements = SafeInt<int64_t>(num_elements) * dim.dim_value();
+    }
+
+    return IAllocator::CalcMemSizeForArrayWithAlignment<64>(static_cast<size_t>(num_elements),
+                                                            GetElementSize(arg.Type()), &size);
+  }
+
+  // If the sizes of all the tensors allocated by the plan are static, lay out their buffers now so that the
+  // first run already uses a single block per location rather than tracing the pattern.
+  Status ComputeStaticMemoryPatterns() {
+    // cached memory patterns are looked up by the shapes of the graph inputs
+    for (auto graph_input : graph_viewer_.GetInputs()) {
+      size_t size;
+      if (IsNonTensor(*graph_input) || !GetStaticTensorSize(*graph_input, size)) return Status::OK();
+    }
+
+    // freelist_ is ordered from the last freed buffer to the first, a buffer is only in it once
+    std::unordered_map<OrtValueIndex, size_t> free_steps;
+    for (const auto& free_buffer : freelist_) {
+      free_steps.emplace(free_buffer.ml_value, free_buffer.deallocate_point);
+    }
+
+    const auto& execution_plan = plan_.execution_plan;
+    std::map<OrtMemoryInfo, StaticMemPatternPlanner> planners;
+    for (size_t step = 0; step < execution_plan.size(); ++step) {
+      auto pnode = graph_viewer_.GetNode(execution_plan[step].node_index);
+      for (auto node_output : pnode->OutputDefs()) {
+        if (!node_output->Exists()) continue;
+        auto index = Index(node_output->Name());
+        const auto& alloc_plan = AllocPlan(index);
+        // buffers that are reused, outputs, non-tensors and strings are not part of memory patterns
+        if (alloc_plan.alloc_kind != AllocKind::kAllocate || IsNonTensor(*node_output) ||
+            node_output->TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+          continue;
+        }
+
+        size_t size;
+        if (!GetStaticTensorSize(*node_output, size)) return Status::OK();
+        auto free_step = free_steps.find(index);
+        planners[alloc_plan.location].AddAllocation(
+            index, size, step, free_step != free_steps.cend() ? free_step->second : execution_plan.size());
+      }
+    }
+
+    if (planners.empty()) return Status::OK();
+
+    auto mem_patterns = std::make_shared<MemoryPatternGroup>();
+    for (auto& location_planner : planners) {
+      // the trace order layout is what tracing the first run would produce, keep it if it happens to be smaller
+      MemoryPattern trace_order = location_planner.second.GenerateTraceOrderMemPattern();
+      MemoryPattern greedy_by_size = location_planner.second.GenerateGreedyBySizeMemPattern();
+      LOGS_DEFAULT(INFO) << "Static memory pattern for " << location_planner.first.ToString()
+                         << ": peak size " << greedy_by_size.PeakSize() << " bytes, "
+                         << trace_order.PeakSize() << " bytes in trace order";
+      mem_patterns->locations.push_back(location_planner.first);
+      mem_patterns->patterns.push_back(greedy_by_size.PeakSize() <= trace_order.PeakSize() ? std::move(greedy_by_size)
+                                                                                            : std::move(trace_order));
+    }
+
+    plan_.static_mem_patterns = std::move(mem_patterns);
+    return Status::OK();
+  }
+
   static bool IsNonTensor(const onnxruntime::NodeArg& nodearg) {
     // TODO: unclear why we should go through a string-representation of type
     auto ptype = nodearg.Type();
@@ -732,6 +805,11 @@ Status PlannerImpl::CreatePlan() {
   // convert information in the freelist_ into a deallocation plan in required format
   GenerateDeallocationPlan();
 
+  // memory patterns are only used by the sequential executor, and subgraphs are fed by their parent node
+  if (!context_.IsParallelExecutionEnabled() && parent_node_ == nullptr) {
+    ORT_RETURN_IF_ERROR(ComputeStaticMemoryPatterns());
+  }
+
   return Status::OK();
 }
 
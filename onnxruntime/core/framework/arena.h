@@ -9,6 +9,14 @@
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
+struct AllocatorStats;
+
+// How an arena grows when it runs out of memory.
+enum class ArenaExtendStrategy : int32_t {
+  kNextPowerOfTwo = 0,   // add regions of increasing power of 2 sizes, the first being at most 1MiB
+  kSameAsRequested = 1,  // add a region of the size of the allocation that doesn't fit
+};
+
 // The interface for arena which manage memory allocations
 // Arena will hold a pool of pre-allocate memories and manage their lifecycle.
 // Need an underline IResourceAllocator to allocate memories.
@@ -26,6 +34,22 @@ class IArenaAllocator : public IAllocator {
   void Free(void* p) override = 0;
   virtual size_t Used() const = 0;
   virtual size_t Max() const = 0;
+  // Returns the memory held by the arena that isn't used by any allocation to the device, as long as the arena
+  // holds more than keep_bytes. Returns the number of bytes released. Unless return_cached_chunks is set, the
+  // chunks cached for reuse by a thread are kept, and the memory they belong to isn't released.
+  // Shrink call need to be thread safe.
+  virtual size_t Shrink(size_t keep_bytes = 0, bool return_cached_chunks = true) {
+    ORT_UNUSED_PARAMETER(keep_bytes);
+    ORT_UNUSED_PARAMETER(return_cached_chunks);
+    return 0;
+  }
+  // The memory held by the arena, read without blocking its allocations. An arena that can't shrink returns 0.
+  virtual size_t AllocatedBytes() const {
+    return 0;
+  }
+  // Fills stats with the statistics collected by the arena, the default is an arena that collects none.
+  // GetStats call need to be thread safe.
+  virtual void GetStats(AllocatorStats* stats);
   const OrtMemoryInfo& Info() const override = 0;
   // allocate host pinned memory?
 };
@@ -90,6 +114,9 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_regions;               // Number of memory regions held by the allocator.
+  int64_t largest_free_block_bytes;  // The largest block that is free. Compared with total_allocated_bytes -
+                                     // bytes_in_use, it tells how fragmented the free memory is.
 
   AllocatorStats() { Clear(); }
 
@@ -100,6 +127,8 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_regions = 0;
+    this->largest_free_block_bytes = 0;
   }
 
   std::string DebugString() const {
@@ -109,8 +138,14 @@ struct AllocatorStats {
        << "TotalAllocated: " << this->total_allocated_bytes << "\n"
        << "MaxInUse:       " << this->max_bytes_in_use << "\n"
        << "NumAllocs:      " << this->num_allocs << "\n"
-       << "MaxAllocSize:   " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:   " << this->max_alloc_size << "\n"
+       << "NumRegions:     " << this->num_regions << "\n"
+       << "LargestFree:    " << this->largest_free_block_bytes << "\n";
     return ss.str();
   }
 };
+
+inline void IArenaAllocator::GetStats(AllocatorStats* stats) {
+  stats->Clear();
+}
 }  // namespace onnxruntime
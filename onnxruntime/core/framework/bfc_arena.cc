@@ -3,16 +3,32 @@
 
 #include "core/framework/bfc_arena.h"
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+
 namespace onnxruntime {
+namespace {
+void UpdateMax(std::atomic<int64_t>& max, int64_t value) {
+  int64_t current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+}  // namespace
+
 BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
-                   size_t total_memory)
-    : device_allocator_(std::move(resource_allocator)),
+                   size_t total_memory,
+                   ArenaExtendStrategy extend_strategy,
+                   bool enable_thread_caches)
+    : extend_strategy_(extend_strategy),
+      device_allocator_(std::move(resource_allocator)),
       free_chunks_list_(kInvalidChunkHandle),
       next_allocation_id_(1),
       info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator,
             device_allocator_->Info().device, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name;
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, size_t{1048576}));
+  initial_region_allocation_bytes_ = curr_region_allocation_bytes_;
 
   // Allocate the requested amount of memory.
   memory_limit_ = total_memory;
@@ -34,6 +50,23 @@ BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+  ORT_ENFORCE(BinNumForSize(kMaxCachedChunkSize) + 1 == kNumCachedBins);
+
+  if (enable_thread_caches) {
+    // a power of 2 number of shards, about one per hardware thread
+    size_t num_shards = 1;
+    while (num_shards < std::thread::hardware_concurrency() && num_shards < 64) {
+      num_shards *= 2;
+    }
+    cache_shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+      auto shard = onnxruntime::make_unique<CacheShard>();
+      for (auto& bin : shard->bins) {
+        bin.reserve(kMaxCachedChunksPerBin);
+      }
+      cache_shards_.push_back(std::move(shard));
+    }
+  }
 }
 
 BFCArena::~BFCArena() {
@@ -56,7 +89,7 @@ BFCArena::Chunk* BFCArena::ChunkFromHandle(ChunkHandle h) {
 }
 
 bool BFCArena::Extend(size_t rounded_bytes) {
-  size_t available_bytes = memory_limit_ - static_cast<size_t>(stats_.total_allocated_bytes);
+  size_t available_bytes = memory_limit_ - static_cast<size_t>(total_allocated_bytes_.load(std::memory_order_relaxed));
   // Rounds available_bytes down to the nearest multiple of kMinAllocationSize.
   available_bytes = (available_bytes / kMinAllocationSize) * kMinAllocationSize;
 
@@ -70,13 +103,15 @@ bool BFCArena::Extend(size_t rounded_bytes) {
   // allocation, keep multiplying by a power of two until that is
   // sufficient.
   bool increased_allocation = false;
-  while (rounded_bytes > curr_region_allocation_bytes_) {
+  while (extend_strategy_ == ArenaExtendStrategy::kNextPowerOfTwo && rounded_bytes > curr_region_allocation_bytes_) {
     curr_region_allocation_bytes_ *= 2;
     increased_allocation = true;
   }
 
   // Try allocating.
-  size_t bytes = std::min(curr_region_allocation_bytes_, available_bytes);
+  size_t bytes = extend_strategy_ == ArenaExtendStrategy::kNextPowerOfTwo
+                     ? std::min(curr_region_allocation_bytes_, available_bytes)
+                     : rounded_bytes;
   auto safe_alloc = [this](size_t alloc_bytes) {
     void* new_mem = nullptr;
     try {
@@ -115,20 +150,21 @@ bool BFCArena::Extend(size_t rounded_bytes) {
   }
 
   // we allocated the same number of bytes as the current region, so we have 2x that now
-  if (!increased_allocation) {
+  if (extend_strategy_ == ArenaExtendStrategy::kNextPowerOfTwo && !increased_allocation) {
     curr_region_allocation_bytes_ *= 2;
   }
 
   LOGS_DEFAULT(INFO) << "Extended allocation by " << bytes
                      << " bytes.";
 
-  stats_.total_allocated_bytes += bytes;
+  total_allocated_bytes_.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
   LOGS_DEFAULT(INFO) << "Total allocated bytes: "
-                     << stats_.total_allocated_bytes;
+                     << total_allocated_bytes_.load(std::memory_order_relaxed);
 
   LOGS_DEFAULT(INFO) << "Allocated memory at " << mem_addr << " to "
                      << static_cast<void*>(static_cast<char*>(mem_addr) + bytes);
   region_manager_.AddAllocationRegion(mem_addr, bytes);
+  ReleaseRetiredRegionViews();
 
   // Create one large chunk for the whole memory space that will
   // be chunked later.
@@ -191,14 +227,62 @@ void* BFCArena::Reserve(size_t size) {
   void* ptr = device_allocator_->Alloc(size);
   ORT_ENFORCE(reserved_chunks_.find(ptr) == reserved_chunks_.end());
   reserved_chunks_.insert(std::pair<void*, size_t>(ptr, size));
-  stats_.bytes_in_use += size;
-  stats_.num_allocs += 1;
-  stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), size);
-  stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
-  stats_.total_allocated_bytes += size;
+  RecordAllocation(size);
+  total_allocated_bytes_.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
   return ptr;
 }
 
+size_t BFCArena::Shrink(size_t keep_bytes, bool return_cached_chunks) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  if (static_cast<size_t>(total_allocated_bytes_.load(std::memory_order_relaxed)) <= keep_bytes) {
+    return 0;
+  }
+
+  // the chunks held by the thread caches are free as far as the client is concerned
+  if (return_cached_chunks) {
+    ReturnCachedChunks();
+  }
+
+  // a region is unused when it is a single free chunk
+  std::vector<std::pair<size_t, void*>> unused_regions;
+  for (const auto& region : region_manager_.regions()) {
+    const Chunk* c = ChunkFromHandle(region_manager_.get_handle(region.ptr()));
+    if (!c->in_use() && c->size == region.memory_size()) {
+      unused_regions.emplace_back(region.memory_size(), region.ptr());
+    }
+  }
+  std::sort(unused_regions.begin(), unused_regions.end(), std::greater<std::pair<size_t, void*>>());
+
+  size_t released_bytes = 0;
+  for (const auto& unused_region : unused_regions) {
+    if (static_cast<size_t>(total_allocated_bytes_.load(std::memory_order_relaxed)) <= keep_bytes) {
+      break;
+    }
+
+    ChunkHandle h = region_manager_.get_handle(unused_region.second);
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    region_manager_.RemoveAllocationRegion(unused_region.second);
+    device_allocator_->Free(unused_region.second);
+    total_allocated_bytes_.fetch_sub(static_cast<int64_t>(unused_region.first), std::memory_order_relaxed);
+    released_bytes += unused_region.first;
+  }
+
+  if (released_bytes > 0) {
+    ReleaseRetiredRegionViews();
+  }
+
+  if (region_manager_.regions().empty()) {
+    curr_region_allocation_bytes_ = initial_region_allocation_bytes_;
+  }
+
+  if (released_bytes > 0) {
+    LOGS_DEFAULT(INFO) << "Shrank BFCArena for " << device_allocator_->Info().name << " by " << released_bytes
+                       << " bytes. Total allocated bytes: " << total_allocated_bytes_.load(std::memory_order_relaxed);
+  }
+  return released_bytes;
+}
+
 size_t BFCArena::RequestedSize(const void* ptr) {
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
@@ -226,6 +310,13 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  if (rounded_bytes <= kMaxCachedChunkSize && !cache_shards_.empty()) {
+    void* ptr = AllocateFromCache(rounded_bytes);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+  }
+
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
@@ -235,6 +326,15 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
     return ptr;
   }
 
+  // Give the chunks held by the thread caches back before asking the device for more memory.
+  if (!cache_shards_.empty()) {
+    ReturnCachedChunks();
+    ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+  }
+
   LOGS_DEFAULT(INFO) << "Extending BFCArena for " << device_allocator_->Info().name
                      << ". bin_num:" << bin_num << " rounded_bytes:" << rounded_bytes;
 
@@ -261,7 +361,122 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
+  FillStats(stats);
+}
+
+void BFCArena::FillStats(AllocatorStats* stats) {
   *stats = stats_;
+  stats->num_allocs = num_allocs_.load(std::memory_order_relaxed);
+  stats->bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+  stats->max_bytes_in_use = max_bytes_in_use_.load(std::memory_order_relaxed);
+  stats->max_alloc_size = max_alloc_size_.load(std::memory_order_relaxed);
+  stats->total_allocated_bytes = total_allocated_bytes_.load(std::memory_order_relaxed);
+  stats->num_regions = static_cast<int64_t>(region_manager_.regions().size());
+
+  // the free chunks of a bin are sorted by size, so the largest one is the last of the largest non-empty bin
+  stats->largest_free_block_bytes = 0;
+  for (BinNum b = kNumBins; b > 0; --b) {
+    Bin* bin = BinFromIndex(b - 1);
+    if (!bin->free_chunks.empty()) {
+      stats->largest_free_block_bytes = static_cast<int64_t>(ChunkFromHandle(*bin->free_chunks.rbegin())->size);
+      break;
+    }
+  }
+}
+
+void BFCArena::RecordAllocation(size_t chunk_size) {
+  const auto size = static_cast<int64_t>(chunk_size);
+  num_allocs_.fetch_add(1, std::memory_order_relaxed);
+  UpdateMax(max_bytes_in_use_, bytes_in_use_.fetch_add(size, std::memory_order_relaxed) + size);
+  UpdateMax(max_alloc_size_, size);
+}
+
+void BFCArena::RecordFree(size_t chunk_size) {
+  bytes_in_use_.fetch_sub(static_cast<int64_t>(chunk_size), std::memory_order_relaxed);
+}
+
+BFCArena::CacheShard& BFCArena::CurrentCacheShard() {
+  // threads are given consecutive indices so that they spread evenly over the shards
+  static std::atomic<size_t> next_thread_index{0};
+  static thread_local const size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return *cache_shards_[thread_index & (cache_shards_.size() - 1)];
+}
+
+void* BFCArena::AllocateFromCache(size_t rounded_bytes) {
+  CacheShard& shard = CurrentCacheShard();
+  CachedChunk chunk{nullptr, 0};
+  {
+    std::lock_guard<OrtMutex> lock(shard.mutex);
+    auto& bin = shard.bins[BinNumForSize(rounded_bytes)];
+    // the most recently freed chunks are at the back and the most likely to still be in the cpu caches
+    for (auto it = bin.rbegin(); it != bin.rend(); ++it) {
+      if (it->size >= rounded_bytes) {
+        chunk = *it;
+        bin.erase(std::next(it).base());
+        break;
+      }
+    }
+  }
+
+  if (chunk.ptr != nullptr) {
+    RecordAllocation(chunk.size);
+  }
+  return chunk.ptr;
+}
+
+bool BFCArena::FreeToCache(void* p) {
+  // when the bin is full the older half of it is returned to the shared bins under a single lock_
+  std::array<CachedChunk, kMaxCachedChunksPerBin / 2> overflow;
+  size_t num_overflow = 0;
+  {
+    CacheShard& shard = CurrentCacheShard();
+    // the region views are read under the shard mutex, see ReleaseRetiredRegionViews
+    std::lock_guard<OrtMutex> lock(shard.mutex);
+    const uint16_t* cached_units = region_manager_.FindCachedUnits(p);
+    if (cached_units == nullptr || *cached_units == 0) {
+      return false;
+    }
+
+    const size_t size = *cached_units * kMinAllocationSize;
+    RecordFree(size);
+    auto& bin = shard.bins[BinNumForSize(size)];
+    if (bin.size() == kMaxCachedChunksPerBin) {
+      num_overflow = overflow.size();
+      std::copy(bin.begin(), bin.begin() + num_overflow, overflow.begin());
+      bin.erase(bin.begin(), bin.begin() + num_overflow);
+    }
+    bin.push_back({p, size});
+  }
+
+  if (num_overflow > 0) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    for (size_t i = 0; i < num_overflow; ++i) {
+      FreeAndMaybeCoalesce(region_manager_.get_handle(overflow[i].ptr));
+    }
+  }
+  return true;
+}
+
+void BFCArena::ReturnCachedChunks() {
+  for (auto& shard : cache_shards_) {
+    std::lock_guard<OrtMutex> shard_lock(shard->mutex);
+    for (auto& bin : shard->bins) {
+      for (const auto& chunk : bin) {
+        FreeAndMaybeCoalesce(region_manager_.get_handle(chunk.ptr));
+      }
+      bin.clear();
+    }
+  }
+}
+
+void BFCArena::ReleaseRetiredRegionViews() {
+  // The threads without lock_ only read the region views under the mutex of their cache shard, and the ones that
+  // take it after the new views were published read those. Once each shard mutex was taken, no thread can still
+  // hold one of the retired views.
+  for (auto& shard : cache_shards_) {
+    std::lock_guard<OrtMutex> shard_lock(shard->mutex);
+  }
+  region_manager_.ReleaseRetiredRegionViews();
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -298,13 +513,12 @@ void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         // Assign a unique id and increment the id counter, marking the
         // chunk as being in use.
         chunk->allocation_id = next_allocation_id_++;
+        if (!cache_shards_.empty()) {
+          *region_manager_.FindCachedUnits(chunk->ptr) =
+              chunk->size <= kMaxCachedChunkSize ? static_cast<uint16_t>(chunk->size / kMinAllocationSize) : 0;
+        }
         // Update stats.
-        ++stats_.num_allocs;
-        stats_.bytes_in_use += chunk->size;
-        stats_.max_bytes_in_use =
-            std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
-        stats_.max_alloc_size =
-            std::max<int64_t>(stats_.max_alloc_size, static_cast<int64_t>(chunk->size));
+        RecordAllocation(chunk->size);
         return chunk->ptr;
       }
     }
@@ -351,12 +565,15 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (!cache_shards_.empty() && FreeToCache(p)) {
+    return;
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
     device_allocator_->Free(it->first);
-    stats_.bytes_in_use -= it->second;
-    stats_.total_allocated_bytes -= it->second;
+    RecordFree(it->second);
+    total_allocated_bytes_.fetch_sub(static_cast<int64_t>(it->second), std::memory_order_relaxed);
     reserved_chunks_.erase(it);
   } else {
     DeallocateRawInternal(p);
@@ -367,6 +584,7 @@ void BFCArena::DeallocateRawInternal(void* ptr) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
+  RecordFree(ChunkFromHandle(h)->size);
 
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
@@ -445,9 +663,6 @@ void BFCArena::FreeAndMaybeCoalesce(BFCArena::ChunkHandle h) {
   // Mark the chunk as no longer in use
   c->allocation_id = -1;
 
-  // Updates the stats.
-  stats_.bytes_in_use -= c->size;
-
   // This chunk is no longer in-use, consider coalescing the chunk
   // with adjacent chunks.
   ChunkHandle chunk_to_reassign = h;
@@ -578,7 +793,9 @@ void BFCArena::DumpMemoryLog(size_t num_bytes) {
   }
 
   LOGS_DEFAULT(INFO) << "Sum Total of in-use chunks: " << total_bytes;
+  AllocatorStats stats;
+  FillStats(&stats);
   LOGS_DEFAULT(INFO) << "Stats: \n"
-                     << stats_.DebugString();
+                     << stats.DebugString();
 }
 }  // namespace onnxruntime
@@ -16,6 +16,7 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -46,9 +47,18 @@ namespace onnxruntime {
 // coalescing.  One assumption we make is that the process using this
 // allocator owns pretty much all of the memory, and that nearly
 // all requests to allocate memory go through this interface.
+//
+// Chunks of up to kMaxCachedChunkSize bytes that are freed are kept in one
+// of several cache shards, picked by the id of the freeing thread, and
+// reused by the next allocations of the threads using that shard without
+// taking the arena lock. A cached chunk stays in use as far as the bins are
+// concerned, the caches are returned to the bins in batches when they are
+// full and entirely before the arena is extended.
 class BFCArena : public IArenaAllocator {
  public:
-  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory);
+  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory,
+           ArenaExtendStrategy extend_strategy = ArenaExtendStrategy::kNextPowerOfTwo,
+           bool enable_thread_caches = true);
 
   ~BFCArena() override;
 
@@ -62,8 +72,15 @@ class BFCArena : public IArenaAllocator {
 
   void* Reserve(size_t size) override;
 
+  // Frees the regions without any allocation, largest first.
+  size_t Shrink(size_t keep_bytes = 0, bool return_cached_chunks = true) override;
+
+  size_t AllocatedBytes() const override {
+    return static_cast<size_t>(total_allocated_bytes_.load(std::memory_order_relaxed));
+  }
+
   size_t Used() const override {
-    return static_cast<size_t>(stats_.bytes_in_use);
+    return static_cast<size_t>(bytes_in_use_.load(std::memory_order_relaxed));
   }
 
   size_t Max() const override {
@@ -79,8 +96,10 @@ class BFCArena : public IArenaAllocator {
     return device_allocator_->CreateFence(session_state);
   }
 
-  void GetStats(AllocatorStats* stats);
+  void GetStats(AllocatorStats* stats) override;
 
+  // For a chunk reused from a thread cache this is the size requested when the chunk was last allocated
+  // from the bins.
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
@@ -200,14 +219,19 @@ class BFCArena : public IArenaAllocator {
       const size_t n_handles =
           (memory_size + kMinAllocationSize - 1) / kMinAllocationSize;
       handles_ = new ChunkHandle[n_handles];
+      cached_units_ = new uint16_t[n_handles];
       for (size_t i = 0; i < n_handles; i++) {
         handles_[i] = kInvalidChunkHandle;
+        cached_units_[i] = 0;
       }
     }
 
     AllocationRegion() = default;
 
-    ~AllocationRegion() { delete[] handles_; }
+    ~AllocationRegion() {
+      delete[] handles_;
+      delete[] cached_units_;
+    }
 
     AllocationRegion(AllocationRegion&& other) noexcept { Swap(other); }
 
@@ -225,12 +249,17 @@ class BFCArena : public IArenaAllocator {
     void set_handle(const void* p, ChunkHandle h) { handles_[IndexFor(p)] = h; }
     void erase(const void* p) { set_handle(p, kInvalidChunkHandle); }
 
+    // Size in units of kMinAllocationSize of the in use chunk at p if it can be kept in a thread cache, 0 otherwise.
+    // Only written when a chunk is handed out, so the owner of the chunk can read it without the arena lock.
+    uint16_t* cached_units() const { return cached_units_; }
+
    private:
     void Swap(AllocationRegion& other) {
       std::swap(ptr_, other.ptr_);
       std::swap(memory_size_, other.memory_size_);
       std::swap(end_ptr_, other.end_ptr_);
       std::swap(handles_, other.handles_);
+      std::swap(cached_units_, other.cached_units_);
     }
 
     int IndexFor(const void* p) const {
@@ -250,6 +279,7 @@ class BFCArena : public IArenaAllocator {
     // indexed by (p-base) / kMinAllocationSize, contains ChunkHandle
     // for the memory allocation represented by "p"
     ChunkHandle* handles_ = nullptr;
+    uint16_t* cached_units_ = nullptr;
 
     ORT_DISALLOW_ASSIGNMENT(AllocationRegion);
   };
@@ -269,6 +299,32 @@ class BFCArena : public IArenaAllocator {
       auto entry =
           std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
       regions_.insert(entry, AllocationRegion(ptr, memory_size));
+      PublishRegionViews();
+    }
+
+    void RemoveAllocationRegion(void* ptr) {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
+      ORT_ENFORCE(entry != regions_.end() && entry->ptr() == ptr, "Could not find Region for ", ptr);
+      regions_.erase(entry);
+      PublishRegionViews();
+    }
+
+    // Returns the cached_units() entry for p, or nullptr if p is not in a region. Unlike the other methods this
+    // may be called without holding the arena lock, as long as the caller holds the mutex of its cache shard.
+    uint16_t* FindCachedUnits(const void* p) const {
+      const auto* views = region_views_.load(std::memory_order_acquire);
+      if (views == nullptr) {
+        return nullptr;
+      }
+      auto entry = std::upper_bound(views->begin(), views->end(), p,
+                                    [](const void* ptr, const RegionView& view) { return ptr < view.end_ptr; });
+      if (entry == views->end() || p < entry->ptr) {
+        return nullptr;
+      }
+      auto index = (reinterpret_cast<std::uintptr_t>(p) - reinterpret_cast<std::uintptr_t>(entry->ptr)) >>
+                   kMinAllocationBits;
+      return entry->cached_units + index;
     }
 
     ChunkHandle get_handle(const void* p) const {
@@ -282,6 +338,10 @@ class BFCArena : public IArenaAllocator {
 
     const std::vector<AllocationRegion>& regions() const { return regions_; }
 
+    // Frees the copies of the region bounds replaced since the last call. The caller must make sure that no reader
+    // without the arena lock still holds one of them.
+    void ReleaseRetiredRegionViews() { retired_region_views_.clear(); }
+
    private:
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RegionManager);
 
@@ -293,6 +353,27 @@ class BFCArena : public IArenaAllocator {
       return const_cast<AllocationRegion*>(RegionFor(p));
     }
 
+    // The AllocationRegion instances move when regions_ grows, the arrays they own don't. Readers without the
+    // arena lock see an immutable copy of the region bounds, older copies are kept alive until they are released.
+    struct RegionView {
+      void* ptr;
+      void* end_ptr;
+      uint16_t* cached_units;
+    };
+
+    void PublishRegionViews() {
+      auto views = onnxruntime::make_unique<std::vector<RegionView>>();
+      views->reserve(regions_.size());
+      for (const auto& region : regions_) {
+        views->push_back({region.ptr(), region.end_ptr(), region.cached_units()});
+      }
+      region_views_.store(views.get(), std::memory_order_release);
+      if (current_region_views_ != nullptr) {
+        retired_region_views_.push_back(std::move(current_region_views_));
+      }
+      current_region_views_ = std::move(views);
+    }
+
     const AllocationRegion* RegionFor(const void* p) const {
       auto entry =
           std::upper_bound(regions_.begin(), regions_.end(), p, &Comparator);
@@ -307,6 +388,9 @@ class BFCArena : public IArenaAllocator {
 
    private:
     std::vector<AllocationRegion> regions_;
+    std::atomic<const std::vector<RegionView>*> region_views_{nullptr};
+    std::unique_ptr<std::vector<RegionView>> current_region_views_;
+    std::vector<std::unique_ptr<std::vector<RegionView>>> retired_region_views_;
   };
 
   // Returns 'bytes' rounded up to the next highest kMinAllocationSize.
@@ -348,6 +432,42 @@ class BFCArena : public IArenaAllocator {
 
   void DumpMemoryLog(size_t num_bytes);
 
+  // Copies the statistics to stats. Requires lock_.
+  void FillStats(AllocatorStats* stats);
+
+  // Records that a chunk of chunk_size bytes was handed out or given back by the client.
+  void RecordAllocation(size_t chunk_size);
+  void RecordFree(size_t chunk_size);
+
+  // Thread cache of freed chunks.
+  static const size_t kMaxCachedChunkSize = 64 << 10;
+  static const size_t kMaxCachedChunksPerBin = 16;
+  static const int kNumCachedBins = 9;  // BinNumForSize(kMaxCachedChunkSize) + 1
+
+  struct CachedChunk {
+    void* ptr;
+    size_t size;
+  };
+
+  struct CacheShard {
+    OrtMutex mutex;
+    std::array<std::vector<CachedChunk>, kNumCachedBins> bins;
+  };
+
+  CacheShard& CurrentCacheShard();
+
+  // Takes a cached chunk of at least rounded_bytes from the cache shard of the calling thread.
+  void* AllocateFromCache(size_t rounded_bytes);
+
+  // Keeps the freed chunk at p in the cache shard of the calling thread. Returns false if it can't be cached.
+  bool FreeToCache(void* p);
+
+  // Returns the chunks in all the cache shards to the bins. Requires lock_.
+  void ReturnCachedChunks();
+
+  // Frees the region views replaced by adding or removing regions once no thread can still read them. Requires lock_.
+  void ReleaseRetiredRegionViews();
+
   ChunkHandle AllocateChunk();
   void DeallocateChunk(ChunkHandle h);
 
@@ -421,6 +541,10 @@ class BFCArena : public IArenaAllocator {
 
   // The size of the current region allocation.
   size_t curr_region_allocation_bytes_;
+  // The size of the first region allocation, the size of the next one once all the regions are freed.
+  size_t initial_region_allocation_bytes_;
+
+  ArenaExtendStrategy extend_strategy_;
 
   std::unique_ptr<IDeviceAllocator> device_allocator_;
 
@@ -441,6 +565,16 @@ class BFCArena : public IArenaAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  // The statistics changed without lock_ by allocations from and frees to the thread caches.
+  std::atomic<int64_t> num_allocs_{0};
+  std::atomic<int64_t> bytes_in_use_{0};
+  std::atomic<int64_t> max_bytes_in_use_{0};
+  std::atomic<int64_t> max_alloc_size_{0};
+  // Changed under lock_, and read without it by AllocatedBytes.
+  std::atomic<int64_t> total_allocated_bytes_{0};
+
+  std::vector<std::unique_ptr<CacheShard>> cache_shards_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
@@ -207,11 +207,14 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
 
     //if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
-      // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
+      bool needs_trace = false;
+      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes, needs_trace);
+      // if no existing patterns, or the existing one is too small, generate one in this executionframe
+      if (needs_trace) {
         planner_ = onnxruntime::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
+      }
+
+      if (mem_patterns_) {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
@@ -277,19 +280,22 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       // if block not found, fall back to default behavior
       if (block) {
         auto it = buffers_.find(location);
-        // if the block is not correct, log message then fall back to default behavior
-        if (it != buffers_.end() && block->size_ == size) {
+        // if the block is not correct, log message then fall back to default behavior.
+        // a smaller tensor fits in the block, which is what lets a pattern serve a bucket of input shapes.
+        if (it != buffers_.end() && size <= block->size_) {
           void* buffer = it->second.get();
           auto status = AllocateTensorWithPreAllocateBufferHelper(
               ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
               shape);
+          // the pattern may be retraced while in use
+          TraceAllocate(ort_value_index, size);
+          AccountAllocate(ort_value_index, size);
           return status;
         }
-        if (block->size_ != size) {
+        if (block->size_ < size) {
           // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
           // fed in, so use VERBOSE as the log level as it's expected.
-          // TODO: Should we re-use the block if the size is large enough? Would probably need to allow it
-          // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
+          mem_pattern_outgrown_ = true;
           LOGS(session_state_.Logger(), VERBOSE) << "For ort_value with index: " << ort_value_index
                                                  << ", block in memory pattern size is: " << block->size_
                                                  << " but the actually size is: " << size
@@ -315,6 +321,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   if (!utils::IsDataTypeString(element_type)) {
     TraceAllocate(ort_value_index, size);
   }
+  AccountAllocate(ort_value_index, size);
 
   return Status::OK();
 }
@@ -489,6 +496,7 @@ Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  AccountFree(ort_value_idx);
   return Status::OK();
 }
 
@@ -536,6 +544,29 @@ void ExecutionFrame::TraceFree(int ort_value_idx) {
   }
 }
 
+void ExecutionFrame::EnableMemoryAccounting() {
+  value_allocated_bytes_.resize(static_cast<size_t>(session_state_.GetOrtValueNameIdxMap().MaxIdx()) + 1);
+}
+
+void ExecutionFrame::AccountAllocate(int ort_value_idx, size_t size) {
+  if (value_allocated_bytes_.empty()) return;
+
+  value_allocated_bytes_[ort_value_idx] = size;
+  allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
+  const size_t live_bytes = live_bytes_.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak_live_bytes = peak_live_bytes_.load(std::memory_order_relaxed);
+  while (live_bytes > peak_live_bytes &&
+         !peak_live_bytes_.compare_exchange_weak(peak_live_bytes, live_bytes, std::memory_order_relaxed)) {
+  }
+}
+
+void ExecutionFrame::AccountFree(int ort_value_idx) {
+  if (value_allocated_bytes_.empty()) return;
+
+  live_bytes_.fetch_sub(value_allocated_bytes_[ort_value_idx], std::memory_order_relaxed);
+  value_allocated_bytes_[ort_value_idx] = 0;
+}
+
 // generate memory pattern based on the tracing of memory allocation/free in current execution
 // return error if the planner is not setup.
 Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup* out) const {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "core/common/common.h"
@@ -125,6 +126,25 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_ != nullptr;
   }
 
+  // true if a tensor did not fit in its block of the cached memory pattern
+  bool MemoryPatternOutgrown() const {
+    return mem_pattern_outgrown_;
+  }
+
+  // Starts the accounting of the memory of the tensors this frame allocates for node outputs, the executors do it
+  // when the session profiler is enabled. Buffers reused from other values aren't counted.
+  void EnableMemoryAccounting();
+
+  // total bytes allocated so far
+  size_t AllocatedBytes() const {
+    return allocated_bytes_.load(std::memory_order_relaxed);
+  }
+
+  // the most bytes that were allocated and not yet released at the same time
+  size_t PeakLiveBytes() const {
+    return peak_live_bytes_.load(std::memory_order_relaxed);
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
@@ -145,6 +165,9 @@ class ExecutionFrame final : public IExecutionFrame {
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
+  void AccountAllocate(int ort_value_idx, size_t size);
+  void AccountFree(int ort_value_idx);
+
   const AllocPlanPerValue& GetAllocationPlan(int ort_value_idx);
 
   const SessionState& session_state_;
@@ -155,13 +178,21 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
+  bool mem_pattern_outgrown_ = false;
 
-  // If no cached memory pattern, and we enable the memory pattern optimization
-  // use this planner_ to trace the memory allocation in current executor.
+  // If no cached memory pattern, or the cached one was outgrown, and we enable the memory pattern
+  // optimization use this planner_ to trace the memory allocation in current executor.
   std::unique_ptr<OrtValuePatternPlanner> planner_;
 
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtMemoryInfo, BufferUniquePtr> buffers_;
+
+  // bytes allocated for each ort_value_idx that wasn't released yet, empty if memory accounting is disabled.
+  // the parallel executor allocates and releases distinct values concurrently, hence the atomic totals.
+  std::vector<size_t> value_allocated_bytes_;
+  std::atomic<size_t> allocated_bytes_{0};
+  std::atomic<size_t> live_bytes_{0};
+  std::atomic<size_t> peak_live_bytes_{0};
 };
 }  // namespace onnxruntime
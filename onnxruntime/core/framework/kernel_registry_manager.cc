@@ -33,7 +33,8 @@ Status KernelRegistryManager::CreateKernel(const onnxruntime::Node& node,
   {
     for (auto& registry : custom_kernel_registries_) {
       status = registry->TryCreateKernel(node, execution_provider, session_state.GetConstantInitializedTensors(),
-                                         session_state.GetOrtValueNameIdxMap(), session_state.GetFuncMgr(), session_state.GetDataTransferMgr(), op_kernel);
+                                         session_state.GetOrtValueNameIdxMap(), session_state.GetFuncMgr(), session_state.GetDataTransferMgr(),
+                                         session_state.GetSharedWeights(), op_kernel);
       if (status.IsOK()) {
         return status;
       }
@@ -45,7 +46,8 @@ Status KernelRegistryManager::CreateKernel(const onnxruntime::Node& node,
   if (iter != provider_type_to_registry_.end()) p = iter->second.get();
   if (p != nullptr) {
     status = p->TryCreateKernel(node, execution_provider, session_state.GetConstantInitializedTensors(),
-                                session_state.GetOrtValueNameIdxMap(), session_state.GetFuncMgr(), session_state.GetDataTransferMgr(), op_kernel);
+                                session_state.GetOrtValueNameIdxMap(), session_state.GetFuncMgr(), session_state.GetDataTransferMgr(),
+                                session_state.GetSharedWeights(), op_kernel);
     if (status.IsOK()) {
       return status;
     }
@@ -16,7 +16,10 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <limits>
 #include <list>
+#include <numeric>
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/allocation_planner.h"
@@ -106,4 +109,105 @@ class MemPatternPlanner {
   mutable OrtMutex lock_;
 };
 
+// StaticMemPatternPlanner lays out tensors whose sizes and lifetimes are known before the first run, with the
+// lifetime given as the first and last steps of the execution plan the tensor is alive in.
+// Tensors are placed from the largest to the smallest, each in the smallest gap between the tensors already
+// placed that are alive at the same time as it, or after all of them if no gap is large enough.
+// Not thread-safe.
+class StaticMemPatternPlanner {
+ public:
+  StaticMemPatternPlanner() = default;
+
+  void AddAllocation(int ml_value_idx, size_t size, size_t alloc_step, size_t free_step) {
+    allocs_.push_back({ml_value_idx, size, alloc_step, free_step});
+  }
+
+  // Layout of the tensors in the order AddAllocation was called, which for a model executed in the order of the
+  // execution plan is the order in which MemPatternPlanner would see them.
+  MemoryPattern GenerateTraceOrderMemPattern() const {
+    MemPatternPlanner planner;
+    std::vector<size_t> order(allocs_.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return allocs_[a].free_step < allocs_[b].free_step;
+    });
+
+    size_t next_free = 0;
+    for (const auto& alloc : allocs_) {
+      // free the tensors that died before this one is allocated
+      for (; next_free < order.size() && allocs_[order[next_free]].free_step < alloc.alloc_step; ++next_free) {
+        planner.TraceFree(allocs_[order[next_free]].index);
+      }
+      planner.TraceAllocation(alloc.index, alloc.size);
+    }
+
+    return planner.GenerateMemPattern();
+  }
+
+  // Layout placing the largest tensors first, each one in the best fitting gap between the tensors that are
+  // alive at the same time.
+  MemoryPattern GenerateGreedyBySizeMemPattern() const {
+    std::vector<size_t> order(allocs_.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return allocs_[a].size > allocs_[b].size;
+    });
+
+    MemoryPattern pattern;
+    SafeInt<size_t> peak_size{0};
+    // tensors already placed, sorted by offset
+    std::vector<std::pair<size_t, MemoryBlock>> placed;
+    for (auto i : order) {
+      const auto& alloc = allocs_[i];
+      size_t current = 0;
+      size_t best_offset = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      bool found_gap = false;
+      for (const auto& entry : placed) {
+        const auto& other = allocs_[entry.first];
+        if (other.free_step < alloc.alloc_step || alloc.free_step < other.alloc_step) {
+          continue;  // lifetimes don't intersect
+        }
+
+        const auto& block = entry.second;
+        if (block.offset_ >= current) {
+          auto gap = block.offset_ - current;
+          if (gap >= alloc.size && gap - alloc.size < waste_bytes) {
+            best_offset = current;
+            waste_bytes = gap - alloc.size;
+            found_gap = true;
+          }
+        }
+        current = std::max(current, block.offset_ + block.size_);
+      }
+
+      if (!found_gap) {
+        best_offset = current;
+      }
+
+      peak_size = std::max(peak_size, SafeInt<size_t>(best_offset) + alloc.size);
+      MemoryBlock block(best_offset, alloc.size);
+      pattern.patterns_[alloc.index] = block;
+      auto position = std::upper_bound(placed.begin(), placed.end(), best_offset,
+                                       [](size_t offset, const std::pair<size_t, MemoryBlock>& entry) {
+                                         return offset < entry.second.offset_;
+                                       });
+      placed.insert(position, std::make_pair(i, block));
+    }
+
+    pattern.peak_size_ = peak_size;
+    return pattern;
+  }
+
+ private:
+  struct Allocation {
+    int index;
+    size_t size;
+    size_t alloc_step;
+    size_t free_step;
+  };
+
+  std::vector<Allocation> allocs_;
+};
+
 }  // namespace onnxruntime
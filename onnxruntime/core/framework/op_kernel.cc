@@ -20,6 +20,14 @@ OpKernelContext::OpKernelContext(_Inout_ IExecutionFrame* frame, _In_ const OpKe
   node_output_start_index_ = node_implicit_input_start_index_ + ImplicitInputCount();
 }
 
+OpKernelContext::OpKernelContext(_Inout_ IExecutionFrame* frame, _In_ const OpKernel* kernel, int node_offset,
+                                 _In_opt_ concurrency::ThreadPool* threadpool, _In_ const logging::Logger& logger)
+    : execution_frame_(frame), kernel_(kernel), threadpool_(threadpool), logger_(&logger) {
+  node_input_start_index_ = node_offset;
+  node_implicit_input_start_index_ = node_input_start_index_ + InputCount();
+  node_output_start_index_ = node_implicit_input_start_index_ + ImplicitInputCount();
+}
+
 Tensor* OpKernelContext::Output(int index, const TensorShape& shape) {
   auto p_ml_value = OutputMLValue(index, shape);
   return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
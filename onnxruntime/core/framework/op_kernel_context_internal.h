@@ -25,16 +25,20 @@ class OpKernelContextInternal : public OpKernelContext {
       : OpKernelContext(&frame, &kernel, session_state.GetThreadPool(), logger),
         session_state_(session_state),
         terminate_flag_(terminate_flag) {
-    const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
-    int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
-    implicit_input_values_.reserve(num_implicit_inputs);
+    SetImplicitInputValues(kernel);
+  }
 
-    for (int i = 0; i < num_implicit_inputs; ++i) {
-      const auto* entry = GetImplicitInputMLValue(i);
-      ORT_ENFORCE(entry != nullptr, "All implicit inputs should have OrtValue instances by now. ",
-                  implicit_inputs[i]->Name(), " does not.");
-      implicit_input_values_.push_back(entry);
-    }
+  // node_offset is the node's offset in the NodeIndexInfo of the session, see NodeExecutionRecord
+  explicit OpKernelContextInternal(const SessionState& session_state,
+                                   IExecutionFrame& frame,
+                                   const OpKernel& kernel,
+                                   int node_offset,
+                                   const logging::Logger& logger,
+                                   const bool& terminate_flag)
+      : OpKernelContext(&frame, &kernel, node_offset, session_state.GetThreadPool(), logger),
+        session_state_(session_state),
+        terminate_flag_(terminate_flag) {
+    SetImplicitInputValues(kernel);
   }
 
   const SessionState* SubgraphSessionState(const std::string& attribute_name) {
@@ -61,6 +65,22 @@ class OpKernelContextInternal : public OpKernelContext {
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
  private:
+  void SetImplicitInputValues(const OpKernel& kernel) {
+    const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
+    int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
+    if (num_implicit_inputs == 0) {
+      return;
+    }
+
+    implicit_input_values_.reserve(num_implicit_inputs);
+    for (int i = 0; i < num_implicit_inputs; ++i) {
+      const auto* entry = GetImplicitInputMLValue(i);
+      ORT_ENFORCE(entry != nullptr, "All implicit inputs should have OrtValue instances by now. ",
+                  implicit_inputs[i]->Name(), " does not.");
+      implicit_input_values_.push_back(entry);
+    }
+  }
+
   const SessionState& session_state_;
   const bool& terminate_flag_;
   std::vector<const OrtValue*> implicit_input_values_;
@@ -3,7 +3,9 @@
 
 #include "core/framework/parallel_executor.h"
 
+#include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -19,11 +21,15 @@
 namespace onnxruntime {
 
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
+    : out_standings_(0),
+      has_errors_(false),
+      completed_(false),
+      terminate_flag_(terminate_flag),
+      executor_pool_(session_state.GetInterOpThreadPool()) {
   auto graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer->MaxNodeIndex());
+  node_refs_.reset(new std::atomic<size_t>[graph_viewer->MaxNodeIndex()]);
   for (auto& node : graph_viewer->Nodes()) {
-    node_refs_[node.Index()] = node.GetInputEdgesCount();
+    node_refs_[node.Index()].store(node.GetInputEdgesCount(), std::memory_order_relaxed);
   }
 }
 
@@ -40,20 +46,43 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
 
   root_frame_ = onnxruntime::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                  fetch_allocators, session_state);
-  //std::cout << "start nodes:" << std::endl;
-  for (auto node_index : session_state.GetGraphViewer()->GetRootNodes()) {
-    auto p_op_kernel = session_state.GetKernel(node_index);
-    if (!p_op_kernel)
-      continue;
-
-    //std::cout << "\t" << p_op_kernel->Node().Name() << std::endl;
-    EnqueueNode(node_index, session_state, logger);
+  if (is_profiler_enabled) {
+    root_frame_->EnableMemoryAccounting();
+  }
+  // The calling thread runs the first root chain itself, the others go to the thread pool.
+  // out_standings_ accounts for the inline chain before anything is scheduled so that it can't
+  // drop to zero while roots are still being enqueued.
+  const auto& root_nodes = session_state.GetGraphViewer()->GetRootNodes();
+  auto first_root = std::find_if(root_nodes.cbegin(), root_nodes.cend(), [&session_state](NodeIndex node_index) {
+    return session_state.GetKernel(node_index) != nullptr;
+  });
+
+  if (first_root == root_nodes.cend()) {
+    completed_ = true;
+  } else {
+    out_standings_.fetch_add(1, std::memory_order_relaxed);
+    for (auto it = std::next(first_root); it != root_nodes.cend(); ++it) {
+      if (session_state.GetKernel(*it) != nullptr) {
+        EnqueueNode(*it, session_state, logger);
+      }
+    }
+
+    RunNode(*first_root, session_state, logger);
   }
 
-  // Wait for finish.
+  // Wait for finish. Rather than blocking while other chains are queued, the calling thread runs
+  // them, and only sleeps once every remaining chain is already running on a worker.
+  while (out_standings_.load(std::memory_order_acquire) > 0) {
+    if (!executor_pool_->RunPendingTask()) {
+      break;
+    }
+  }
+
+  // Always synchronize with FinishNodeRun through complete_mutex_, the thread finishing the last
+  // chain may still be touching this object after out_standings_ reached zero.
   {
     std::unique_lock<OrtMutex> lock(complete_mutex_);
-    while (out_standings_ > 0) complete_cv_.wait(lock);
+    while (!completed_) complete_cv_.wait(lock);
   }
 
   Status status = Status::OK();
@@ -81,7 +110,7 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
   ORT_RETURN_IF_ERROR(root_frame_->GetOutputs(fetches));
   VLOGS(logger, 1) << "Done execution.";
 
-  if (root_frame_->HasMemoryPatternPlanner()) {
+  if (root_frame_->HasMemoryPatternPlanner() || root_frame_->MemoryPatternOutgrown()) {
     std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -93,15 +122,19 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
       input_shapes.push_back(std::cref(tensor.Shape()));
     }
 
-    if (all_tensors) {
+    if (all_tensors && root_frame_->HasMemoryPatternPlanner()) {
       auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
       ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
       ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+    } else if (all_tensors) {
+      session_state.MarkMemoryPatternGroupOutgrown(input_shapes);
     }
   }
 
   if (is_profiler_enabled) {
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp);
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp,
+                                                   {{"allocated_bytes", std::to_string(root_frame_->AllocatedBytes())},
+                                                    {"peak_live_bytes", std::to_string(root_frame_->PeakLiveBytes())}});
   }
 
   return Status::OK();
@@ -249,63 +282,78 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
 
     keep_running = false;
 
-    // Checking which output nodes ready for running.
-    {
-      auto begin = node.OutputEdgesBegin();
-      auto end = node.OutputEdgesEnd();
-
-      std::lock_guard<OrtMutex> lock(ref_mutex_);
-      for (auto it = begin; it != end; it++) {
-        auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
-          if (!keep_running) {
-            node_index = idx;
-            keep_running = true;
-          } else {
-            EnqueueNode(idx, session_state, logger);
-          }
+    // Checking which output nodes ready for running. The last producer of a node to finish makes
+    // it ready, the acq_rel decrement publishes the outputs of every producer to the thread that
+    // runs the node. The first ready node continues on this thread, the others are scheduled.
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      auto idx = (*it).GetNode().Index();
+      if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (!keep_running) {
+          node_index = idx;
+          keep_running = true;
+        } else {
+          EnqueueNode(idx, session_state, logger);
         }
-
-        // std::cout << "handle output, current name: " << node.Name() << ", current index: "
-        // << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: "
-        // << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
       }
     }
+
+    // stop early if another chain failed
+    if (has_errors_.load(std::memory_order_relaxed)) {
+      break;
+    }
   }
 
   return status;
 }
 
 void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
-  {
-    std::unique_lock<OrtMutex> lock(complete_mutex_);
-    // if there are errors there's no point queuing more work
-    if (!errors_.empty())
-      return;
+  // if there are errors there's no point queuing more work
+  if (has_errors_.load(std::memory_order_relaxed))
+    return;
 
-    out_standings_++;
-  }
+  out_standings_.fetch_add(1, std::memory_order_relaxed);
 
+  // When called from a worker of executor_pool_ the node goes to the front of that worker's own
+  // queue, idle workers steal from the back of it.
   executor_pool_->Schedule([this, p_node_index, &session_state, &logger]() {
-    auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
-      const auto* node = session_state.GetGraphViewer()->GetNode(p_node_index);
+    RunNode(p_node_index, session_state, logger);
+  });
+}
 
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
-                             " node '", node->Name(), "'. ",
-                             ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
-    };
+void ParallelExecutor::RunNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
+  auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
+    const auto* node = session_state.GetGraphViewer()->GetNode(p_node_index);
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
+                           " node '", node->Name(), "'. ",
+                           ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
+  };
+
+  Status status;
+  try {
+    status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
+  } catch (const std::exception& ex) {
+    status = create_exception_message(&ex);
+  } catch (...) {
+    // catch node processing failure exceptions here to prevent app crash.
+    status = create_exception_message(nullptr);
+  }
 
-    Status status;
-    try {
-      status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
-    } catch (const std::exception& ex) {
-      status = create_exception_message(&ex);
-    } catch (...) {
-      // catch node processing failure exceptions here to prevent app crash.
-      status = create_exception_message(nullptr);
-    }
+  FinishNodeRun(status);
+}
 
-    FinishNodeRun(status);
-  });
+void ParallelExecutor::FinishNodeRun(const Status& status) {
+  if (!status.IsOK()) {
+    std::lock_guard<OrtMutex> lock(errors_mutex_);
+    errors_.push_back(status);
+    has_errors_.store(true, std::memory_order_relaxed);
+  }
+
+  if (out_standings_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // notify while holding the lock, Execute may destroy this object as soon as it can reacquire it
+    std::lock_guard<OrtMutex> lock(complete_mutex_);
+    completed_ = true;
+    complete_cv_.notify_all();
+  }
 }
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -35,32 +37,25 @@ class ParallelExecutor : public IExecutor {
 
   void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
-  void FinishNodeRun(const Status& status) {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
-      std::lock_guard<OrtMutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-      if (!status.IsOK())
-        errors_.push_back(status);
-    }
+  void RunNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
-      complete_cv_.notify_all();
-    }
-  }
+  void FinishNodeRun(const Status& status);
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  OrtMutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
+  // number of input edges of each node whose producer has not run yet, the node is ready at 0
+  std::unique_ptr<std::atomic<size_t>[]> node_refs_;
+  // number of node chains queued or running
+  std::atomic<int> out_standings_;
+  std::atomic<bool> has_errors_;
+  OrtMutex errors_mutex_;
+  std::vector<Status> errors_;  //protected by errors_mutex_
+
+  // only used to wake up Execute once the last node chain finished
+  bool completed_;  //protected by complete_mutex_
   OrtMutex complete_mutex_;
   OrtCondVar complete_cv_;
-  std::vector<Status> errors_;
 
   const bool& terminate_flag_;
-  // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
   onnxruntime::concurrency::ThreadPool* const executor_pool_{};
 };
 }  // namespace onnxruntime
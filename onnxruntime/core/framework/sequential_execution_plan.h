@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "core/graph/basic_types.h"
 #include "core/framework/alloc_kind.h"
 #include "core/framework/data_types.h"
@@ -18,6 +20,7 @@ using OrtValueIndex = int;
 using OrtValueName = std::string;
 
 class SessionState;
+struct MemoryPatternGroup;
 
 // AllocPlanPerValue: (a simplified form of AllocationPlanPerValue above)
 // Captures information required to allocate/reuse buffer for a ml-value
@@ -72,6 +75,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
+  // Memory pattern of the tensors allocated by the plan, computed ahead of time when the shapes of the graph
+  // inputs and of all those tensors are static. nullptr otherwise, the pattern is then traced by the first run.
+  std::shared_ptr<const MemoryPatternGroup> static_mem_patterns;
+
   const OrtMemoryInfo& GetLocation(size_t ort_value_index) const override {
     return allocation_plan[ort_value_index].location;
   }
@@ -45,7 +45,7 @@ namespace onnxruntime {
 
 static Status ReleaseNodeMLValues(ExecutionFrame& frame,
                                   const SequentialExecutionPlan& seq_exec_plan,
-                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const NodeExecutionRecord& node_record,
                                   const logging::Logger& logger);
 
 Status SequentialExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
@@ -57,18 +57,27 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   TimePoint tp;
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
+  size_t allocated_bytes_before_kernel = 0;
 
   if (is_profiler_enabled) {
     tp = session_state.Profiler().StartTime();
   }
 
   ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
+  if (is_profiler_enabled) {
+    frame.EnableMemoryAccounting();
+  }
 
   LOGS(logger, INFO) << "Begin execution";
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
   const auto& exec_plan_vec = seq_exec_plan.execution_plan;
   VLOGS(logger, 1) << "Size of execution plan vector: " << exec_plan_vec.size();
 
+  // kernels, value offsets and release ranges of the nodes were resolved when the session was initialized
+  const auto& node_records = session_state.GetNodeExecutionRecords();
+  ORT_ENFORCE(node_records.size() == exec_plan_vec.size(),
+              "Node execution records were not created for the execution plan.");
+
   // uncomment the line below to dump execution plan
   //std::cout << std::make_pair(p_seq_exec_plan, &session_state) << "\n";
   const auto* graph_viewer = session_state.GetGraphViewer();
@@ -84,32 +93,32 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   diagnostic::marker_series series(series_name);
 #endif
 
-  for (const auto& node_exec_plan : exec_plan_vec) {
+  for (const auto& node_record : node_records) {
     if (terminate_flag_) {
       LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
     }
 
-    auto node_index = node_exec_plan.node_index;
-    const auto& node = *graph_viewer->GetNode(node_exec_plan.node_index);
-
-#ifdef CONCURRENCY_VISUALIZER
-    series.write_flag(node.Name().c_str());
-#endif
-
-    auto p_op_kernel = session_state.GetKernel(node_index);
+    const auto* p_op_kernel = node_record.kernel;
 
     // if a kernel has been added in the session state, it better be NON-null.
     if (p_op_kernel == nullptr)
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
-                             node.Name());
+                             graph_viewer->GetNode(node_record.node_index)->Name());
+
+    const auto& node = p_op_kernel->Node();
+
+#ifdef CONCURRENCY_VISUALIZER
+    series.write_flag(node.Name().c_str());
+#endif
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     LARGE_INTEGER kernel_start;
     QueryPerformanceCounter(&kernel_start);
 #endif
     // construct OpKernelContext
     // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
+    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, node_record.node_offset, logger,
+                                              terminate_flag_);
     // TODO: log kernel outputs?
     if (is_profiler_enabled) {
       sync_time_begin = session_state.Profiler().StartTime();
@@ -117,7 +126,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 
     // sync before compute
     int queue_id = p_op_kernel->KernelDef().ExecQueueId();
-    if (seq_exec_plan.NodeHasFence(node_index)) {
+    if (node_record.has_fence) {
       for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
         Fence_t fence = op_kernel_context.InputFence(input_index);
         if (fence) {
@@ -161,6 +170,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
 
       kernel_begin_time = session_state.Profiler().StartTime();
+      allocated_bytes_before_kernel = frame.AllocatedBytes();
     }
 
 #ifdef CONCURRENCY_VISUALIZER
@@ -192,13 +202,15 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      p_op_kernel->Node().Name() + "_kernel_time",
                                                      kernel_begin_time,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}, {"provider", p_op_kernel->KernelDef().Provider()}});
+                                                     {{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                      {"provider", p_op_kernel->KernelDef().Provider()},
+                                                      {"allocated_bytes", std::to_string(frame.AllocatedBytes() - allocated_bytes_before_kernel)}});
 
       sync_time_begin = session_state.Profiler().StartTime();
     }
 
     // sync after compute for outputs
-    if (seq_exec_plan.NodeHasFence(node_index)) {
+    if (node_record.has_fence) {
       for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
         Fence_t fence = op_kernel_context.InputFence(input_index);
         if (fence) {
@@ -246,7 +258,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 
     // free ml-values corresponding to this node
     VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
-    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_record, logger));
   }
 
   VLOGS(logger, 1) << "Fetching output.";
@@ -254,7 +266,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
   VLOGS(logger, 1) << "Done with execution.";
 
-  if (frame.HasMemoryPatternPlanner()) {
+  if (frame.HasMemoryPatternPlanner() || frame.MemoryPatternOutgrown()) {
     std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -266,15 +278,19 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       input_shapes.push_back(std::cref(tensor.Shape()));
     }
 
-    if (all_tensors) {
+    if (all_tensors && frame.HasMemoryPatternPlanner()) {
       auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
       ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
       ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+    } else if (all_tensors) {
+      session_state.MarkMemoryPatternGroupOutgrown(input_shapes);
     }
   }
 
   if (is_profiler_enabled) {
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp,
+                                                   {{"allocated_bytes", std::to_string(frame.AllocatedBytes())},
+                                                    {"peak_live_bytes", std::to_string(frame.PeakLiveBytes())}});
   }
 
   return Status::OK();
@@ -282,9 +298,9 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 
 static Status ReleaseNodeMLValues(ExecutionFrame& frame,
                                   const SequentialExecutionPlan& seq_exec_plan,
-                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const NodeExecutionRecord& node_record,
                                   const logging::Logger& logger) {
-  for (auto i = node_exec_plan.free_from_index; i <= node_exec_plan.free_to_index; ++i) {
+  for (auto i = node_record.free_from_index; i <= node_record.free_to_index; ++i) {
     auto ort_value_idx = seq_exec_plan.to_be_freed[i];
     VLOGS(logger, 1) << "Releasing ort_value with index: " << ort_value_idx;
     ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(ort_value_idx));
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include "core/session/onnxruntime_c_api.h"
+#include "core/framework/arena.h"
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/util/thread_utils.h"
 
@@ -15,6 +16,39 @@ struct FreeDimensionOverride {
   int64_t dimension_override;
 };
 
+// Controls the cache of memory patterns generated when enable_mem_pattern is set.
+// Patterns are cached per set of input shapes. With bucketing each input dimension is rounded up when
+// looking up the cache, so that one pattern serves every shape in the bucket, e.g. all the sequence
+// lengths from 65 to 128 when rounding up to powers of 2.
+struct MemoryPatternCacheOptions {
+  // round the input dimensions up to the next power of 2
+  bool bucket_dims_to_power_of_2 = false;
+
+  // round the input dimensions up to the first of these bounds that is not smaller. dimensions larger than
+  // all the bounds are used as is. takes precedence over bucket_dims_to_power_of_2 when not empty.
+  std::vector<int64_t> dim_buckets;
+
+  // maximum number of patterns cached per graph, the least recently used one is evicted. 0 means no limit.
+  size_t max_num_patterns = 128;
+};
+
+// Controls the growth of the memory arena on CPU and when it returns the memory it doesn't use to the system.
+// The growth options only apply to the arena of the CPU execution provider that the session adds by default.
+struct CpuMemArenaOptions {
+  // maximum number of bytes held by the arena, 0 means no limit.
+  size_t max_mem = 0;
+
+  ArenaExtendStrategy extend_strategy = ArenaExtendStrategy::kNextPowerOfTwo;
+
+  // release the unused memory of the arenas of the session after every this many Run calls. 0 means never.
+  int shrink_interval_runs = 0;
+
+  // release the unused memory of the arenas of the session after a Run call when an arena holds more than this
+  // many bytes, largest regions first, until it holds no more than that. 0 means never. The regions holding the
+  // chunks cached by the threads are kept.
+  size_t shrink_above_bytes = 0;
+};
+
 /**
   * Configuration information for a session.
   */
@@ -34,11 +68,17 @@ struct SessionOptions {
   // See class 'OrtValuePatternPlanner'.
   bool enable_mem_pattern = true;
 
+  // bucketing and size of the memory pattern cache
+  MemoryPatternCacheOptions mem_pattern_cache;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
   bool enable_cpu_mem_arena = true;
 
+  // growth and shrinking of the memory arenas
+  CpuMemArenaOptions cpu_mem_arena;
+
   // the prefix of the profile file. The current time will be appended to the file name.
   std::basic_string<ORTCHAR_T> profile_file_prefix = ORT_TSTR("onnxruntime_profile_");
 
@@ -60,6 +100,7 @@ struct SessionOptions {
 
   // controls the size of the thread pool used to parallelize the execution of nodes (ops)
   // configuring this makes sense only when you're using parallel executor
+  // with the default size of 0 and per session threads, nodes are scheduled on the intra-op thread pool
   OrtThreadPoolParams inter_op_param;
 
   // For models with free input dimensions (most commonly batch size), specifies a set of values to override those
@@ -70,5 +111,10 @@ struct SessionOptions {
   // Use this in conjunction with the CreateEnvWithGlobalThreadPools API.
   bool use_per_session_threads = true;
   bool thread_pool_allow_spinning = true;
+
+  // Use the initializers added to the environment with AddSharedInitializer in place of the model initializers
+  // with the same name, and share the forms of them prepacked by kernels with the other sessions doing so, instead
+  // of the session holding its own copy. The shared initializers must match the type and shape in the model.
+  bool use_env_shared_initializers = false;
 };
 }  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 
 using namespace ::onnxruntime::common;
@@ -100,11 +101,59 @@ Status SessionState::CreateKernels(const KernelRegistryManager& custom_registry_
     }
   }
   node_index_info_ = onnxruntime::make_unique<NodeIndexInfo>(*graph_viewer_, ort_value_name_idx_map_);
+  CreateNodeExecutionRecords();
   return Status::OK();
 }
 
 void SessionState::SetExecutionPlan(std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan) {
   p_seq_exec_plan_ = std::move(p_seq_exec_plan);
+  CreateNodeExecutionRecords();
+  SeedStaticMemoryPatterns();
+}
+
+void SessionState::SeedStaticMemoryPatterns() {
+  if (!enable_mem_pattern_ || p_seq_exec_plan_ == nullptr || p_seq_exec_plan_->static_mem_patterns == nullptr ||
+      graph_viewer_ == nullptr) {
+    return;
+  }
+
+  // the planner only computes the patterns when the shapes of all the graph inputs are static
+  std::vector<TensorShape> shapes;
+  for (const auto* graph_input : graph_viewer_->GetInputs()) {
+    shapes.push_back(utils::GetTensorShapeFromTensorShapeProto(*graph_input->Shape()));
+  }
+  std::vector<std::reference_wrapper<const TensorShape>> input_shapes(shapes.cbegin(), shapes.cend());
+  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  if (mem_patterns_.find(key) == mem_patterns_.end()) {
+    mem_patterns_lru_.push_front(key);
+    mem_patterns_.emplace(key, MemoryPatternCacheEntry{p_seq_exec_plan_->static_mem_patterns, false,
+                                                       mem_patterns_lru_.begin()});
+  }
+}
+
+void SessionState::CreateNodeExecutionRecords() {
+  node_execution_records_.clear();
+  // the kernels may be created before or after the execution plan is set
+  if (p_seq_exec_plan_ == nullptr || node_index_info_ == nullptr) {
+    return;
+  }
+
+  const auto& exec_plan_vec = p_seq_exec_plan_->execution_plan;
+  node_execution_records_.reserve(exec_plan_vec.size());
+  for (const auto& node_exec_plan : exec_plan_vec) {
+    const auto node_index = node_exec_plan.node_index;
+    const OpKernel* kernel = GetKernel(node_index);
+    NodeExecutionRecord record;
+    record.kernel = kernel;
+    record.node_index = node_index;
+    record.node_offset = kernel != nullptr ? node_index_info_->GetNodeOffset(node_index) : NodeIndexInfo::kInvalidEntry;
+    record.free_from_index = node_exec_plan.free_from_index;
+    record.free_to_index = node_exec_plan.free_to_index;
+    record.has_fence = p_seq_exec_plan_->NodeHasFence(node_index);
+    node_execution_records_.push_back(record);
+  }
 }
 
 const SequentialExecutionPlan* SessionState::GetExecutionPlan() const { return p_seq_exec_plan_.get(); }
@@ -148,23 +197,60 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) { profiler_ = &pro
 
 ::onnxruntime::profiling::Profiler& SessionState::Profiler() const { return *profiler_; }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
+static int64_t BucketMemoryPatternDim(int64_t dim, const MemoryPatternCacheOptions& options) {
+  if (!options.dim_buckets.empty()) {
+    auto bucket = std::lower_bound(options.dim_buckets.cbegin(), options.dim_buckets.cend(), dim);
+    return bucket != options.dim_buckets.cend() ? *bucket : dim;
+  }
+
+  if (options.bucket_dims_to_power_of_2 && dim > 1) {
+    int64_t bucket = 1;
+    while (bucket < dim) bucket <<= 1;
+    return bucket;
+  }
+
+  return dim;
+}
+
+int64_t SessionState::CalculateMemoryPatternsKey(
+    const std::vector<std::reference_wrapper<const TensorShape>>& shapes) const {
+  // the feeds are in the order the caller passed them in, so the key must not depend on the order of the shapes
+  uint64_t key = 0;
   for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
+    uint64_t shape_key = 0;
+    auto combine = [&shape_key](int64_t value) {
+      shape_key ^= static_cast<uint64_t>(value) + 0x9e3779b97f4a7c15ULL + (shape_key << 6) + (shape_key >> 2);
+    };
+    const auto& dims = shape.get().GetDims();
+    combine(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) combine(BucketMemoryPatternDim(dim, mem_patterns_options_));
+    key += shape_key;
   }
-  return key;
+  return static_cast<int64_t>(key);
 }
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
-    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
+static size_t TotalPeakSize(const MemoryPatternGroup& mem_patterns) {
+  size_t total = 0;
+  for (const auto& pattern : mem_patterns.patterns) total += pattern.PeakSize();
+  return total;
+}
+
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes, bool& needs_trace) const {
   int64_t key = CalculateMemoryPatternsKey(input_shapes);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) return nullptr;
+  if (it == mem_patterns_.end()) {
+    ++mem_patterns_stats_.misses;
+    needs_trace = true;
+    return nullptr;
+  }
 
-  return it->second.get();
+  ++mem_patterns_stats_.hits;
+  mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+  needs_trace = it->second.outgrown;
+  return it->second.patterns;
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(
@@ -175,12 +261,53 @@ Status SessionState::UpdateMemoryPatternGroupCache(
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
+    if (mem_patterns_options_.max_num_patterns > 0 && mem_patterns_.size() >= mem_patterns_options_.max_num_patterns) {
+      mem_patterns_.erase(mem_patterns_lru_.back());
+      mem_patterns_lru_.pop_back();
+      ++mem_patterns_stats_.evictions;
+    }
+
+    mem_patterns_lru_.push_front(key);
+    mem_patterns_.emplace(key, MemoryPatternCacheEntry{std::move(mem_patterns), false, mem_patterns_lru_.begin()});
+  } else if (it->second.outgrown) {
+    // keep the larger of the two so that the pattern of a bucket grows towards the shapes needing the most memory.
+    // a run that still does not fit marks the pattern as outgrown again.
+    if (TotalPeakSize(*mem_patterns) > TotalPeakSize(*it->second.patterns)) {
+      it->second.patterns = std::move(mem_patterns);
+    }
+    it->second.outgrown = false;
   }
 
   return Status::OK();
 }
 
+void SessionState::MarkMemoryPatternGroupOutgrown(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
+  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  auto it = mem_patterns_.find(key);
+  if (it != mem_patterns_.end()) {
+    it->second.outgrown = true;
+  }
+}
+
+void SessionState::SetMemoryPatternCacheOptions(const MemoryPatternCacheOptions& options) {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  mem_patterns_options_ = options;
+  std::sort(mem_patterns_options_.dim_buckets.begin(), mem_patterns_options_.dim_buckets.end());
+  // the keys depend on the bucketing
+  mem_patterns_.clear();
+  mem_patterns_lru_.clear();
+}
+
+SessionState::MemoryPatternCacheStats SessionState::GetMemoryPatternCacheStats() const {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  MemoryPatternCacheStats stats = mem_patterns_stats_;
+  stats.num_patterns = mem_patterns_.size();
+  return stats;
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 common::Status SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
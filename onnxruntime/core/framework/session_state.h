@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -21,6 +22,8 @@
 #include "core/framework/ml_value.h"
 #include "core/framework/callback.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/session_options.h"
+#include "core/framework/shared_weights.h"
 #include "core/framework/node_index_info.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/fuse_nodes_funcs.h"
@@ -36,6 +39,19 @@ class NodeIndexInfo;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
 
+// Execution data of a node in the sequential execution plan, resolved once when the plan and the kernels of the
+// session are available so that running a node only reads one record. Records are stored in execution order.
+struct NodeExecutionRecord {
+  const OpKernel* kernel;
+  onnxruntime::NodeIndex node_index;
+  // offset of the node's input, implicit input and output value indices in the NodeIndexInfo
+  int node_offset;
+  // values to be freed after the node ran are SequentialExecutionPlan::to_be_freed[free_from_index..free_to_index]
+  int free_from_index;
+  int free_to_index;
+  bool has_fence;
+};
+
 /**
  * SessionState should be modified by the inference session class only.
  * It is supposed to be passed by const-ref only to all the executors.
@@ -119,6 +135,10 @@ class SessionState {
   void SetExecutionPlan(std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan);
   const SequentialExecutionPlan* GetExecutionPlan() const;
 
+  // Get the records of the nodes in the execution plan, in execution order.
+  // Empty until both the execution plan was set and the kernels were created.
+  const std::vector<NodeExecutionRecord>& GetNodeExecutionRecords() const { return node_execution_records_; }
+
   /**
   Set the logger to use for this session.
   */
@@ -142,10 +162,12 @@ class SessionState {
   profiling::Profiler& Profiler() const;
 
   /**
-  Get cached memory pattern based on input shapes
+  Get cached memory pattern based on input shapes, nullptr if there is none.
+  needs_trace is set if the caller should trace its allocations and pass the generated pattern to
+  UpdateMemoryPatternGroupCache, either because there is no pattern or because a run outgrew it.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
-      const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
+      const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes, bool& needs_trace) const;
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -154,6 +176,35 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  /**
+  Record that a run with the given input shapes needed blocks larger than the ones in the cached pattern.
+  The next run with these shapes traces a new pattern.
+  */
+  void MarkMemoryPatternGroupOutgrown(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
+
+  void SetMemoryPatternCacheOptions(const MemoryPatternCacheOptions& options);
+  const MemoryPatternCacheOptions& GetMemoryPatternCacheOptions() const { return mem_patterns_options_; }
+
+  struct MemoryPatternCacheStats {
+    // lookups that found a pattern
+    size_t hits = 0;
+    // lookups that did not find a pattern
+    size_t misses = 0;
+    // patterns dropped because the cache was full
+    size_t evictions = 0;
+    // patterns currently cached
+    size_t num_patterns = 0;
+  };
+
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const;
+
+  /**
+  Set the initializers shared with other sessions through the environment, which the session uses in place of its
+  own initializers with the same name. nullptr if the session doesn't use them.
+  */
+  void SetSharedWeights(SharedWeights* shared_weights) { shared_weights_ = shared_weights; }
+  SharedWeights* GetSharedWeights() const { return shared_weights_; }
+
   /**
   Get enable memory pattern flag
   */
@@ -220,6 +271,11 @@ class SessionState {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
+  void CreateNodeExecutionRecords();
+
+  // Adds the memory pattern the planner computed for the static input shapes of the graph to the cache.
+  void SeedStaticMemoryPatterns();
+
   // cache of the constructed kernels to avoid spending construction
   // time per executor
   std::vector<OpKernel*> session_kernels_;
@@ -238,16 +294,33 @@ class SessionState {
   std::unordered_map<int, OrtCallback> deleter_for_initialized_tensors_;
   std::vector<BufferUniquePtr> weights_buffers_;
   std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan_ = nullptr;
+  std::vector<NodeExecutionRecord> node_execution_records_;
 
   const logging::Logger* logger_ = nullptr;
   profiling::Profiler* profiler_ = nullptr;
 
   // switch for enable memory pattern optimization or not.
   const bool enable_mem_pattern_;
-  // lock for the mem_patterns_
+  // lock for the mem_patterns_, mem_patterns_lru_ and mem_patterns_stats_
   mutable OrtMutex mem_patterns_lock_;
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  struct MemoryPatternCacheEntry {
+    // shared with the execution frames using it, an evicted pattern stays valid until their runs finish
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+    // a run with these input shapes did not fit in the pattern
+    bool outgrown;
+    std::list<int64_t>::iterator lru_position;
+  };
+  // cache for the generated mem_patterns. key is calculated based on the bucketed input shapes.
+  mutable std::unordered_map<int64_t, MemoryPatternCacheEntry> mem_patterns_;
+  // keys of mem_patterns_, most recently used first
+  mutable std::list<int64_t> mem_patterns_lru_;
+  mutable MemoryPatternCacheStats mem_patterns_stats_;
+  MemoryPatternCacheOptions mem_patterns_options_;
+
+  // not owned. outlives the session state
+  SharedWeights* shared_weights_ = nullptr;
+
+  int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) const;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <limits>
+#include <unordered_set>
 #include <core/common/status.h>
 
 #include "core/common/common.h"
@@ -32,6 +33,7 @@ template <typename T>
 static common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                              const onnxruntime::Graph& graph, const ExecutionProviders& exec_providers,
                                              const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                             const ExecutionPlanBase& exec_plan, const SharedWeights* shared_weights,
                                              ITensorAllocator* planner, const T& save_tensor_func,
                                              const logging::Logger& logger,
                                              const DataTransferManager& data_transfer_mgr);
@@ -92,14 +94,14 @@ common::Status SessionStateInitializer::CreatePlan(
   // lambda to save initialized tensors into SessionState directly
   const Env& env = Env::Default();
   ORT_RETURN_IF_ERROR(SaveInitializedTensors(
-      env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, tensor_allocator_.get(),
+      env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, *exec_plan_ptr,
+      session_state_.GetSharedWeights(), tensor_allocator_.get(),
       [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant) -> Status {
         return session_state_.AddInitializedTensor(idx, value, &d, constant);
       },
       logger_, session_state_.GetDataTransferMgr()));
-  // remove weights from the graph now to save memory but in many cases it won't save memory, if the tensor was
-  // preallocated with the some other tensors in a single 'allocate' call, which is very common.
-  // TODO: make it better
+  // remove weights from the graph now to save memory. initializers that were not used in place were copied into
+  // buffers preallocated by the planner, so the graph's copy of them is no longer needed either.
   graph_.CleanAllInitializedTensors();
 
   ORT_RETURN_IF_ERROR(session_state_.CreateKernels(kernel_registry_manager_));
@@ -169,24 +171,75 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   return common::Status::OK();
 }
 
+// Finds the initializer shared through the environment that the session uses in place of tensor_proto.
+// shared_initializer is left null if there is none, or if the session needs it at a location other than CPU.
+static common::Status GetSharedInitializer(const SharedWeights* shared_weights,
+                                           const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                           const OrtMemoryInfo& location, const logging::Logger& logger,
+                                           const OrtValue*& shared_initializer) {
+  shared_initializer = nullptr;
+  if (shared_weights == nullptr) {
+    return Status::OK();
+  }
+  const OrtValue* value = shared_weights->GetInitializer(tensor_proto.name());
+  if (value == nullptr) {
+    return Status::OK();
+  }
+
+  const Tensor& tensor = value->Get<Tensor>();
+  if (strcmp(location.name, CPU) != 0 || strcmp(tensor.Location().name, CPU) != 0) {
+    LOGS(logger, INFO) << "Not using the shared initializer " << tensor_proto.name() << " located at "
+                       << tensor.Location().ToString() << " for a tensor located at " << location.ToString();
+    return Status::OK();
+  }
+
+  const auto* type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  const TensorShape shape{std::vector<int64_t>(tensor_proto.dims().begin(), tensor_proto.dims().end())};
+  if (tensor.DataType() != type || tensor.Shape() != shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The shared initializer ", tensor_proto.name(),
+                           " with shape ", tensor.Shape(),
+                           " does not match the type or shape of the initializer in the model with shape ", shape);
+  }
+  shared_initializer = value;
+  return Status::OK();
+}
+
 template <typename T>
 common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                       const Graph& graph, const ExecutionProviders& exec_providers,
-                                      const OrtValueNameIdxMap& ort_value_name_idx_map, ITensorAllocator* planner,
-                                      const T& save_tensor_func, const logging::Logger& logger,
-                                      const DataTransferManager& data_transfer_mgr) {
+                                      const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                      const ExecutionPlanBase& exec_plan, const SharedWeights* shared_weights,
+                                      ITensorAllocator* planner, const T& save_tensor_func,
+                                      const logging::Logger& logger, const DataTransferManager& data_transfer_mgr) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
+  std::unordered_set<int> in_place_ids;
+  std::unordered_map<int, const OrtValue*> id_to_shared_initializer;
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
   for (const auto& entry : id_to_initialized_tensor) {
+    // initializers shared through the environment need no buffer at all
+    const OrtValue* shared_initializer = nullptr;
+    ORT_RETURN_IF_ERROR(GetSharedInitializer(shared_weights, *entry.second, exec_plan.GetLocation(entry.first),
+                                             logger, shared_initializer));
+    if (shared_initializer != nullptr) {
+      id_to_shared_initializer[entry.first] = shared_initializer;
+      continue;
+    }
+    // CPU tensors with external data or raw_data use that data in place: external data is memory-mapped and
+    // raw_data is moved out of the graph. they don't need a preallocated buffer.
+    const OrtMemoryInfo& location = exec_plan.GetLocation(entry.first);
+    if (strcmp(location.name, CPU) == 0 && utils::CanUseTensorProtoDataInPlace(*entry.second)) {
+      in_place_ids.insert(entry.first);
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner->Trace(entry.first, entry.second));
   }
 
@@ -199,22 +252,41 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
     const char* name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
     const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
-    std::unique_ptr<MemBuffer> m;
-    // TODO: if the tensor need be copied, does it have enough room?
-    ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
+    bool constant = graph_utils::IsConstantInitializer(graph, name, /* check_outer_scope */ false);
+    auto shared_entry = id_to_shared_initializer.find(ort_value_index);
+    if (shared_entry != id_to_shared_initializer.end()) {
+      // the shared value is owned by the environment's SharedWeights, so there's nothing to release
+      ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, *shared_entry->second, OrtCallback{nullptr, nullptr},
+                                           constant));
+      VLOGS(logger, 1) << "Using shared initializer with name : " << name << " for index: " << ort_value_index;
+      continue;
+    }
+
+    OrtValue ort_value;
+    Status st;
+    if (in_place_ids.count(ort_value_index) != 0) {
+      // the graph's initializers are released by CleanAllInitializedTensors once they are saved, so taking over
+      // the raw_data buffer of tensor_proto is safe.
+      st = utils::TensorProtoToMLValueInPlace(env, graph_loc.c_str(),
+                                              const_cast<ONNX_NAMESPACE::TensorProto&>(tensor_proto),
+                                              exec_plan.GetLocation(ort_value_index), ort_value, deleter);
+    } else {
+      std::unique_ptr<MemBuffer> m;
+      // TODO: if the tensor need be copied, does it have enough room?
+      ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
 #ifndef NDEBUG
-    ORT_ENFORCE(m != nullptr);
-    ORT_ENFORCE(m->GetBuffer() != nullptr || m->GetLen() == 0);
+      ORT_ENFORCE(m != nullptr);
+      ORT_ENFORCE(m->GetBuffer() != nullptr || m->GetLen() == 0);
 #endif
-    OrtValue ort_value;
-    Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, *m, exec_providers, ort_value, deleter, data_transfer_mgr);
+      st = DeserializeTensorProto(env, graph_loc, tensor_proto, *m, exec_providers, ort_value, deleter,
+                                  data_transfer_mgr);
+    }
     if (!st.IsOK()) {
       std::ostringstream oss;
       oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
       return Status(st.Category(), st.Code(), oss.str());
     }
 
-    bool constant = graph_utils::IsConstantInitializer(graph, name, /* check_outer_scope */ false);
     ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant));
 
     VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
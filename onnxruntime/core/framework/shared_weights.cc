@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_weights.h"
+
+#include <sstream>
+
+namespace onnxruntime {
+
+SharedWeights::SharedWeights() : allocator_(std::make_shared<CPUAllocator>()) {}
+
+common::Status SharedWeights::AddInitializer(const std::string& name, const OrtValue& value) {
+  if (name.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The name of a shared initializer can not be empty");
+  }
+  if (!value.IsAllocated() || !value.IsTensor()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The shared initializer '", name, "' must be a tensor");
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!initializers_.insert({name, value}).second) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "A shared initializer named '", name,
+                           "' has already been added");
+  }
+  const Tensor& tensor = value.Get<Tensor>();
+  if (tensor.DataRaw() != nullptr) {
+    initializer_data_.insert(tensor.DataRaw());
+  }
+  return Status::OK();
+}
+
+const OrtValue* SharedWeights::GetInitializer(const std::string& name) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = initializers_.find(name);
+  // the values are never removed or replaced, so the pointer stays valid after the lock is released
+  return it != initializers_.end() ? &it->second : nullptr;
+}
+
+size_t SharedWeights::NumInitializers() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return initializers_.size();
+}
+
+const void* SharedWeights::GetOrPackInitializer(const Tensor& tensor, const std::string& kind, size_t size,
+                                                const std::function<void(void* packed)>& pack) {
+  const void* data = tensor.DataRaw();
+  std::ostringstream key;
+  key << kind << '@' << data;
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (data == nullptr || initializer_data_.count(data) == 0) {
+      return nullptr;
+    }
+    auto it = prepacked_buffers_.find(key.str());
+    if (it != prepacked_buffers_.end()) {
+      return it->second.get();
+    }
+  }
+
+  // Pack without holding the lock, so that packing a large weight doesn't block the sessions loading other models.
+  // If another session packs the same weight meanwhile, the buffer that is inserted first is kept.
+  BufferUniquePtr packed(allocator_->Alloc(size), BufferDeleter(allocator_));
+  pack(packed.get());
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return prepacked_buffers_.emplace(key.str(), std::move(packed)).first->second.get();
+}
+
+size_t SharedWeights::NumPrepackedBuffers() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return prepacked_buffers_.size();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/tensor.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// Initializers registered with the Environment that the sessions created with
+// SessionOptions::use_env_shared_initializers use in place of the initializers with the same name in their model,
+// along with the forms of them that kernels prepack, so that N sessions of a model hold a single copy of its weights.
+// The registered values are immutable and live as long as the SharedWeights instance, which the Environment and
+// the sessions using it share. It's thread-safe.
+class SharedWeights {
+ public:
+  SharedWeights();
+
+  // Registers value as the initializer name. value must be a tensor, which is shared and not copied.
+  common::Status AddInitializer(const std::string& name, const OrtValue& value);
+
+  // Returns the initializer registered as name, or nullptr if there is none.
+  const OrtValue* GetInitializer(const std::string& name) const;
+
+  size_t NumInitializers() const;
+
+  // Returns the form of the registered initializer tensor that a kernel packs with pack into a buffer of size
+  // bytes, packing it the first time it is requested with kind. kind identifies the packing, e.g. the packing
+  // routine and its parameters. Returns nullptr if tensor isn't the data of a registered initializer, in which case
+  // the kernel should pack its own copy.
+  const void* GetOrPackInitializer(const Tensor& tensor, const std::string& kind, size_t size,
+                                   const std::function<void(void* packed)>& pack);
+
+  size_t NumPrepackedBuffers() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedWeights);
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, OrtValue> initializers_;
+  // the data of the registered initializers, which the prepacked buffers are keyed by
+  std::unordered_set<const void*> initializer_data_;
+  AllocatorPtr allocator_;
+  std::unordered_map<std::string, BufferUniquePtr> prepacked_buffers_;
+};
+
+}  // namespace onnxruntime
@@ -351,6 +351,30 @@ static Status GetFileContent(
   return Status::OK();
 }
 
+// Loads the external data of tensor_proto, preferably by memory-mapping it from its file.
+// length is the length of the data, or 0 to read to the end of the file.
+static Status GetExternalDataContent(const Env& env, const ORTCHAR_T* tensor_proto_path,
+                                     const ONNX_NAMESPACE::TensorProto& tensor_proto, size_t length,
+                                     void*& raw_buffer, size_t& raw_buffer_len, OrtCallback& deleter) {
+  std::unique_ptr<ExternalDataInfo> external_data_info;
+  ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info));
+  std::basic_string<ORTCHAR_T> full_path;
+  if (tensor_proto_path != nullptr) {
+    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(tensor_proto_path, full_path));
+    full_path = ConcatPathComponent<ORTCHAR_T>(full_path, external_data_info->GetRelPath());
+  } else {
+    full_path = external_data_info->GetRelPath();
+  }
+  raw_buffer_len = external_data_info->GetLength() != 0 ? external_data_info->GetLength() : length;
+  // load the file
+  return GetFileContent(env, full_path.c_str(), external_data_info->GetOffset(), raw_buffer_len, raw_buffer, deleter);
+}
+
+static void DeleteString(void* param) noexcept {
+  auto str = reinterpret_cast<std::string*>(param);
+  delete str;
+}
+
 static void MoveOrtCallback(OrtCallback& from, OrtCallback& to) {
   to.f = from.f;
   to.param = from.param;
@@ -378,20 +402,8 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
       if (ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING)
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "string tensor can not have raw data");
 
-      std::unique_ptr<ExternalDataInfo> external_data_info;
-      ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info));
-      std::basic_string<ORTCHAR_T> full_path;
-      if (tensor_proto_path != nullptr) {
-        ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(tensor_proto_path, full_path));
-        full_path = ConcatPathComponent<ORTCHAR_T>(full_path, external_data_info->GetRelPath());
-      } else {
-        full_path = external_data_info->GetRelPath();
-      }
-      raw_data_len = external_data_info->GetLength();
-      // load the file
-      ORT_RETURN_IF_ERROR(GetFileContent(
-          env, full_path.c_str(), external_data_info->GetOffset(), raw_data_len,
-          raw_data, deleter_for_file_data.d));
+      ORT_RETURN_IF_ERROR(GetExternalDataContent(env, tensor_proto_path, tensor_proto, 0,
+                                                 raw_data, raw_data_len, deleter_for_file_data.d));
     } else if (utils::HasRawData(tensor_proto)) {
       if (ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING)
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "string tensor can not have raw data");
@@ -482,6 +494,56 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
 #pragma warning(pop)
 #pragma warning(disable : 6239)
 #endif
+
+bool CanUseTensorProtoDataInPlace(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  return endian::native == endian::little &&
+         tensor_proto.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+         (tensor_proto.data_location() == TensorProto_DataLocation_EXTERNAL || HasRawData(tensor_proto));
+}
+
+Status TensorProtoToMLValueInPlace(const Env& env, const ORTCHAR_T* tensor_proto_path,
+                                   ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtMemoryInfo& location,
+                                   OrtValue& value, OrtCallback& deleter) {
+  deleter.f = nullptr;
+  deleter.param = nullptr;
+  if (!CanUseTensorProtoDataInPlace(tensor_proto)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The data of tensor '", tensor_proto.name(),
+                           "' can not be used in place");
+  }
+  size_t expected_size;
+  ORT_RETURN_IF_ERROR(GetSizeInBytesFromTensorProto<0>(tensor_proto, &expected_size));
+
+  AutoDelete deleter_for_data;
+  void* tensor_data = nullptr;
+  size_t tensor_data_len = 0;
+  if (tensor_proto.data_location() == TensorProto_DataLocation_EXTERNAL) {
+    if (expected_size != 0) {
+      ORT_RETURN_IF_ERROR(GetExternalDataContent(env, tensor_proto_path, tensor_proto, expected_size,
+                                                 tensor_data, tensor_data_len, deleter_for_data.d));
+    }
+  } else if (tensor_proto.raw_data().size() == expected_size) {
+    // take over the buffer of raw_data instead of copying it. tensor_proto is left with an empty raw_data.
+    auto* buffer = new std::string();
+    deleter_for_data.d = OrtCallback{DeleteString, buffer};
+    buffer->swap(*tensor_proto.mutable_raw_data());
+    tensor_data = buffer->empty() ? nullptr : &(*buffer)[0];
+    tensor_data_len = buffer->size();
+  } else {
+    tensor_data_len = tensor_proto.raw_data().size();
+  }
+  if (tensor_data_len != expected_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The data size of tensor '", tensor_proto.name(),
+                           "' does not match its shape, expected ", expected_size, ", got ", tensor_data_len);
+  }
+
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  TensorShape tensor_shape{GetTensorShapeFromTensorProto(tensor_proto)};
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value.Init(new Tensor(type, tensor_shape, tensor_data, location), ml_tensor, ml_tensor->GetDeleteFunc());
+  MoveOrtCallback(deleter_for_data.d, deleter);
+  return Status::OK();
+}
+
 #define CASE_TYPE(X)                             \
   case ONNX_NAMESPACE::TensorProto_DataType_##X: \
     return ONNX_TENSOR_ELEMENT_DATA_TYPE_##X;
@@ -34,6 +34,22 @@ common::Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_prot
                                     const ONNX_NAMESPACE::TensorProto& input, const MemBuffer& m, OrtValue& value,
                                     OrtCallback& deleter);
 
+/**
+ * Returns true if TensorProtoToMLValueInPlace can create a CPU tensor that uses the data of tensor_proto in place.
+ * That requires non-string external data or raw_data in the native (little-endian) byte order.
+ */
+bool CanUseTensorProtoDataInPlace(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+/**
+ * Creates a CPU tensor that uses the data of tensor_proto in place instead of copying it into a preallocated buffer.
+ * External data is memory-mapped from its file, or read into a buffer if the platform can't map it.
+ * raw_data is moved out of tensor_proto, which is left without data.
+ * \param deleter Releases the mapping or buffer. The tensor is valid until it is invoked.
+ */
+common::Status TensorProtoToMLValueInPlace(const Env& env, const ORTCHAR_T* tensor_proto_path,
+                                           ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtMemoryInfo& location,
+                                           OrtValue& value, OrtCallback& deleter);
+
 /** Creates a TensorProto from a Tensor.
     @param[in] tensor the Tensor whose data and shape will be used to create the TensorProto.
     @param[in] tensor_proto_name the name of the TensorProto.
@@ -147,6 +147,23 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasGemm(
@@ -181,6 +198,206 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Batched matrix/matrix multiply routines.
+//
+// Each element of the batch supplies its own matrix addresses and leading
+// dimensions, which allows both strided and broadcasted batches to be
+// described. All elements of a batch share the same dimensions.
+//
+
+struct MLAS_SGEMM_DATA_PARAMS {
+    const float* A;
+    size_t lda;
+    const float* B;
+    size_t ldb;
+    float* C;
+    size_t ldc;
+    float alpha;
+    float beta;
+};
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Quantized integer matrix/matrix multiply output processors.
+//
+// An output processor is invoked for each block of matrix C as soon as the
+// block has been fully accumulated, while the block is still resident in the
+// cache. StartM and StartN are the coordinates of the block within matrix C.
+//
+
+class MLAS_QGEMM_OUTPUT_PROCESSOR {
+public:
+    virtual
+    void
+    Process(
+        const int32_t* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const = 0;
+
+    virtual ~MLAS_QGEMM_OUTPUT_PROCESSOR() = default;
+};
+
+void
+MLASCALL
+MlasRequantizeOutputColumns(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    uint8_t ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    );
+
+//
+// Requantizes blocks of matrix C to an unsigned 8-bit output matrix with an
+// optional bias per column and a scale that is either shared by the whole
+// matrix or supplied per column.
+//
+
+class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+public:
+    MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR(
+        uint8_t* Output,
+        size_t OutputLeadingDimension,
+        const int32_t* Bias,
+        const float* Scale,
+        bool PerColumnScale,
+        uint8_t ZeroPoint
+        )
+        : Output_(Output),
+          OutputLeadingDimension_(OutputLeadingDimension),
+          Bias_(Bias),
+          Scale_(Scale),
+          PerColumnScale_(PerColumnScale),
+          ZeroPoint_(ZeroPoint)
+    {
+    }
+
+    void
+    Process(
+        const int32_t* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const override
+    {
+        MlasRequantizeOutputColumns(C, ldc, Output_, OutputLeadingDimension_,
+            Bias_, Scale_, PerColumnScale_, ZeroPoint_, StartM, StartN,
+            CountM, CountN);
+    }
+
+private:
+    uint8_t* Output_;
+    size_t OutputLeadingDimension_;
+    const int32_t* Bias_;
+    const float* Scale_;
+    bool PerColumnScale_;
+    uint8_t ZeroPoint_;
+};
+
+//
+// B is either a row major matrix with leading dimension ldb or, if BIsPacked
+// is true, a buffer produced by MlasGemmPackB (ldb is then ignored).
+//
+// If ZeroPointB is not nullptr, it supplies a zero point offset for each of
+// the N columns of matrix B and the scalar offb argument is ignored.
+//
+// If OutputProcessor is not nullptr, it is invoked for each completed block
+// of matrix C.
+//
+
+struct MLAS_GEMM_U8X8_DATA_PARAMS {
+    const uint8_t* A = nullptr;
+    size_t lda = 0;
+    const void* B = nullptr;
+    size_t ldb = 0;
+    int32_t* C = nullptr;
+    size_t ldc = 0;
+    const uint8_t* ZeroPointB = nullptr;
+    bool BIsPacked = false;
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr;
+};
+
+void
+MLASCALL
+MlasGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* Data,
+    size_t BatchSize,
+    uint8_t offa,
+    uint8_t offb,
+    bool BIsSigned,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Buffer packing routines.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K,
+    bool BIsSigned
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    void* PackedB
+    );
+
 //
 // Convolution routines.
 //
@@ -306,6 +523,25 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -319,6 +555,32 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+//
+// Transpose routines.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -0,0 +1,716 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.cpp
+
+Abstract:
+
+    This module implements miscellaneous computation routines.
+
+    Our usage requires building platform specific versions of the algorithm to
+    target different instruction sets. The implementation below targets the
+    base instruction set (typically SSE2 or NEON).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the constants for use by the exponential function.
+//
+// The exponential is computed by range reducing the input to x = n * ln(2) + r
+// where |r| <= ln(2)/2, evaluating a polynomial approximation of exp(r), and
+// then scaling the result by 2^n. The range is limited so that n fits in the
+// normalized exponent range of a single precision value.
+//
+
+MLAS_INTERNAL_DATA const struct {
+    float LowerRange;
+    float UpperRange;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_56;
+    float RoundingBias;
+} MlasExpConstants = {
+    -87.3365478515625f,
+    88.02969360351562f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.00000000e+0f,
+    1.25829120e+7f,
+};
+
+//
+// Define the number of elements of a softmax operation to process per thread.
+//
+
+#define MLAS_SOFTMAX_THREAD_COMPLEXITY      (16 * 1024)
+
+//
+// Define the parameters to execute a softmax operation on worker threads.
+//
+
+struct MLAS_SOFTMAX_WORK_BLOCK {
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+    bool LogSoftmax;
+    int32_t ThreadCountN;
+};
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeExpVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of elements.
+
+    Elements below the lower range are flushed to zero and elements above the
+    upper range saturate.
+
+Arguments:
+
+    Vector - Supplies the input vector.
+
+Return Value:
+
+    Returns the exponential of each element of the input vector.
+
+--*/
+{
+    const MLAS_FLOAT32X4 LowerRange = MlasBroadcastFloat32x4(MlasExpConstants.LowerRange);
+    const MLAS_FLOAT32X4 InRangeMask = MlasGreaterThanFloat32x4(Vector, LowerRange);
+
+    Vector = MlasMaximumFloat32x4(LowerRange, Vector);
+    Vector = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Vector);
+
+    //
+    // Compute n = round(x / ln(2)) using the rounding bias trick and the range
+    // reduced value r = x - n * ln(2).
+    //
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+
+    MLAS_FLOAT32X4 n = MlasMultiplyAddFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    n = MlasSubtractFloat32x4(n, RoundingBias);
+
+    MLAS_FLOAT32X4 r = MlasMultiplyAddFloat32x4(n, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Vector);
+    r = MlasMultiplyAddFloat32x4(n, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), r);
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasExpConstants.poly_0);
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+
+    p = MlasMultiplyFloat32x4(p, MlasPowerOf2Float32x4(n));
+
+    return MlasAndFloat32x4(p, InRangeMask);
+}
+
+MLAS_FORCEINLINE
+float
+MlasComputeExpScalar(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a single element using
+    the same algorithm as MlasComputeExpVector.
+
+Arguments:
+
+    Value - Supplies the input value.
+
+Return Value:
+
+    Returns the exponential of the input value.
+
+--*/
+{
+    MLAS_FLOAT32X4 Vector = MlasComputeExpVector(MlasBroadcastFloat32x4(Value));
+
+    return MlasExtractLaneFloat32x4<0>(Vector);
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceAddFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vaddvq_f32(Vector);
+#else
+    return MlasExtractLaneFloat32x4<0>(Vector) + MlasExtractLaneFloat32x4<1>(Vector) +
+        MlasExtractLaneFloat32x4<2>(Vector) + MlasExtractLaneFloat32x4<3>(Vector);
+#endif
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceMaximumFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vmaxvq_f32(Vector);
+#else
+    return (std::max)((std::max)(MlasExtractLaneFloat32x4<0>(Vector), MlasExtractLaneFloat32x4<1>(Vector)),
+        (std::max)(MlasExtractLaneFloat32x4<2>(Vector), MlasExtractLaneFloat32x4<3>(Vector)));
+#endif
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasComputeExpVector(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = MlasComputeExpScalar(*Input++);
+
+        N -= 1;
+    }
+}
+
+float
+MlasReduceMaximumKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to find the maximum value of
+    the supplied buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the supplied buffer.
+
+--*/
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(Maximum);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector2 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector3 = MaximumVector0;
+
+            while (N >= 16) {
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, MlasLoadFloat32x4(Input + 4));
+                MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MlasLoadFloat32x4(Input + 8));
+                MaximumVector3 = MlasMaximumFloat32x4(MaximumVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector1);
+            MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MaximumVector3);
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector2);
+        }
+
+        while (N >= 4) {
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Maximum = MlasReduceMaximumFloat32x4(MaximumVector0);
+    }
+
+    while (N > 0) {
+
+        Maximum = (std::max)(Maximum, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+float
+MlasComputeSumExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the exponential of
+    each element biased by the negative maximum and to accumulate the sum of
+    the exponentials.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer to receive the exponentials, else
+        nullptr if only the sum is required.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the bias added to each element before computing
+        the exponential.
+
+Return Value:
+
+    Returns the sum of the exponentials.
+
+--*/
+{
+    const MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+
+    MLAS_FLOAT32X4 AccumulatorVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 AccumulatorVector1 = MlasZeroFloat32x4();
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+        MLAS_FLOAT32X4 Vector1 = MlasAddFloat32x4(MlasLoadFloat32x4(Input + 4), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVector(Vector0);
+        Vector1 = MlasComputeExpVector(Vector1);
+
+        AccumulatorVector0 = MlasAddFloat32x4(AccumulatorVector0, Vector0);
+        AccumulatorVector1 = MlasAddFloat32x4(AccumulatorVector1, Vector1);
+
+        if (Output != nullptr) {
+            MlasStoreFloat32x4(Output, Vector0);
+            MlasStoreFloat32x4(Output + 4, Vector1);
+            Output += 8;
+        }
+
+        Input += 8;
+        N -= 8;
+    }
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVector(Vector0);
+
+        AccumulatorVector0 = MlasAddFloat32x4(AccumulatorVector0, Vector0);
+
+        if (Output != nullptr) {
+            MlasStoreFloat32x4(Output, Vector0);
+            Output += 4;
+        }
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float Accumulator = MlasReduceAddFloat32x4(MlasAddFloat32x4(AccumulatorVector0, AccumulatorVector1));
+
+    while (N > 0) {
+
+        float Value = MlasComputeExpScalar(*Input + NegativeMaximum);
+
+        Accumulator += Value;
+
+        if (Output != nullptr) {
+            *Output++ = Value;
+        }
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+void
+MlasComputeSoftmaxOutputKernel(
+    float* Output,
+    size_t N,
+    float Scale
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to scale the exponentials of a
+    softmax operation by the reciprocal of their sum.
+
+Arguments:
+
+    Output - Supplies the output buffer containing the exponentials.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the reciprocal of the sum of the exponentials.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output));
+        MLAS_FLOAT32X4 Vector1 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 4));
+        MLAS_FLOAT32X4 Vector2 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 8));
+        MLAS_FLOAT32X4 Vector3 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 12));
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+        MlasStoreFloat32x4(Output + 8, Vector2);
+        MlasStoreFloat32x4(Output + 12, Vector3);
+
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output)));
+
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output = *Output * Scale;
+
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasComputeLogSoftmaxOutputKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum,
+    float Logarithm
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the output of a log
+    softmax operation.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative maximum value of the input buffer.
+
+    Logarithm - Supplies the logarithm of the sum of the exponentials.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+    const MLAS_FLOAT32X4 LogarithmVector = MlasBroadcastFloat32x4(Logarithm);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasAddFloat32x4(NegativeMaximumVector, MlasLoadFloat32x4(Input));
+        MLAS_FLOAT32X4 Vector1 = MlasAddFloat32x4(NegativeMaximumVector, MlasLoadFloat32x4(Input + 4));
+        MLAS_FLOAT32X4 Vector2 = MlasAddFloat32x4(NegativeMaximumVector, MlasLoadFloat32x4(Input + 8));
+        MLAS_FLOAT32X4 Vector3 = MlasAddFloat32x4(NegativeMaximumVector, MlasLoadFloat32x4(Input + 12));
+
+        Vector0 = MlasSubtractFloat32x4(Vector0, LogarithmVector);
+        Vector1 = MlasSubtractFloat32x4(Vector1, LogarithmVector);
+        Vector2 = MlasSubtractFloat32x4(Vector2, LogarithmVector);
+        Vector3 = MlasSubtractFloat32x4(Vector3, LogarithmVector);
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+        MlasStoreFloat32x4(Output + 8, Vector2);
+        MlasStoreFloat32x4(Output + 12, Vector3);
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasAddFloat32x4(NegativeMaximumVector, MlasLoadFloat32x4(Input));
+        Vector0 = MlasSubtractFloat32x4(Vector0, LogarithmVector);
+        MlasStoreFloat32x4(Output, Vector0);
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output = *Input + NegativeMaximum - Logarithm;
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasComputeSoftmaxThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+
+    const float* Input = WorkBlock->Input + n * D;
+    float* Output = WorkBlock->Output + n * D;
+
+    while (CountN > 0) {
+
+        //
+        // Find the maximum value for the row.
+        //
+
+        const float Maximum = MlasReduceMaximumKernel(Input, D);
+        const float NegativeMaximum = -Maximum;
+
+        if (WorkBlock->LogSoftmax) {
+
+            //
+            // Compute the sum of the exponential functions for the row.
+            //
+
+            const float Accumulation = MlasComputeSumExpKernel(Input, nullptr, D, NegativeMaximum);
+
+            //
+            // Compute the log softmax output.
+            //
+
+            const float Logarithm = std::log(Accumulation);
+
+            MlasComputeLogSoftmaxOutputKernel(Input, Output, D, NegativeMaximum, Logarithm);
+
+        } else {
+
+            //
+            // Compute the exponential function for each element of the row and
+            // compute the sum of these exponential functions.
+            //
+
+            const float Accumulation = MlasComputeSumExpKernel(Input, Output, D, NegativeMaximum);
+
+            //
+            // Normalize the softmax output.
+            //
+
+            const float Scale = 1.0f / Accumulation;
+
+            MlasComputeSoftmaxOutputKernel(Output, D, Scale);
+        }
+
+        Input += D;
+        Output += D;
+        CountN--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function for each row of
+    the supplied matrix.
+
+    N.B. The softmax is computed in place if the input and output buffers are
+    the same.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the softmax parameters to the work block.
+    //
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    int32_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = int32_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = MLAS_SOFTMAX_THREAD_COMPLEXITY;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = int32_t(BlockCount);
+    }
+
+    if (ThreadCountN == 0) {
+        return;
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
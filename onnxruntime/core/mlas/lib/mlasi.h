@@ -121,6 +121,14 @@ Abstract:
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
 
+//
+// Define the strides to step through slices of a packed B matrix. The packed
+// buffer is divided into slices of MLAS_SGEMM_PACKED_STRIDEK rows.
+//
+
+#define MLAS_SGEMM_PACKED_STRIDEN                   128
+#define MLAS_SGEMM_PACKED_STRIDEK                   256
+
 //
 // Define the alignment for segmenting a GEMM operation across multiple
 // threads.
@@ -335,20 +343,17 @@ size_t
 
 typedef MLAS_GEMM_U8U8_KERNEL* PMLAS_GEMM_U8U8_KERNEL;
 
+struct MLAS_GEMM_X8X8_WORK_BLOCK;
+
 typedef
 void
 (MLASCALL MLAS_GEMM_X8X8_OPERATION)(
-    size_t M,
-    size_t N,
-    size_t K,
-    const uint8_t* A,
-    size_t lda,
-    int16_t offa,
-    const uint8_t* B,
-    size_t ldb,
-    int16_t offb,
-    int32_t* C,
-    size_t ldc
+    const MLAS_GEMM_X8X8_WORK_BLOCK* WorkBlock,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* Data,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
     );
 
 typedef MLAS_GEMM_X8X8_OPERATION* PMLAS_GEMM_X8X8_OPERATION;
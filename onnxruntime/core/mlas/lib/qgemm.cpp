@@ -35,18 +35,14 @@ struct MLAS_GEMM_X8X8_WORK_BLOCK {
     size_t M;
     size_t N;
     size_t K;
-    const uint8_t* A;
-    size_t lda;
-    const uint8_t* B;
-    size_t ldb;
-    int32_t* C;
-    size_t ldc;
+    const MLAS_GEMM_U8X8_DATA_PARAMS* Data;
+    size_t BatchSize;
+    int32_t ThreadCountBatch;
     int32_t ThreadCountM;
     int32_t ThreadCountN;
-    size_t StrideM;
-    size_t StrideN;
     int16_t offa;
     int16_t offb;
+    bool BIsSigned;
 };
 
 #ifdef MLAS_TARGET_AMD64_IX86
@@ -1120,52 +1116,228 @@ Return Value:
     return 1;
 }
 
-void
-MLASCALL
-MlasGemmU8S8Operation(
-    size_t M,
-    size_t N,
-    size_t K,
-    const uint8_t* A,
-    size_t lda,
-    int16_t offa,
-    const uint8_t* B,
-    size_t ldb,
-    int16_t offb,
-    int32_t* C,
-    size_t ldc
+MLAS_FORCEINLINE
+size_t
+MlasGemmX8X8AlignedCountK(
+    size_t CountK,
+    bool BIsSigned
     )
 /*++
 
 Routine Description:
 
-    This module implements the quantized integer matrix/matrix multiply
-    operation (QGEMM).
+    This routine returns the number of rows of a slice of matrix B after it
+    has been copied to a packed buffer.
 
 Arguments:
 
-    M - Supplies the number of rows of matrix A and matrix C.
+    CountK - Supplies the number of rows of the slice of matrix B.
 
-    N - Supplies the number of columns of matrix B and matrix C.
+    BIsSigned - Supplies true if matrix B contains signed values, else false
+        if matrix B contains unsigned values.
 
-    K - Supplies the number of columns of matrix A and the number of rows of
-        matrix B.
+Return Value:
 
-    A - Supplies the address of matrix A.
+    Returns the number of padded rows.
 
-    lda - Supplies the first dimension of matrix A.
+--*/
+{
+    //
+    // The U8S8 kernels consume quads of rows and the U8U8 kernels consume
+    // pairs of rows.
+    //
+
+    if (BIsSigned) {
+        return (CountK + 3) & ~size_t(3);
+    } else {
+        return (CountK + 1) & ~size_t(1);
+    }
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasGemmX8X8AlignedN(
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of columns of a packed matrix B.
+
+    N.B. The packed panels are padded to a multiple of the thread partition
+    alignment, so that each thread can address its range of columns directly.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+Return Value:
+
+    Returns the number of padded columns.
+
+--*/
+{
+    return (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~size_t(MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1);
+}
+
+void
+MlasGemmX8X8ScaleColumnSums(
+    int32_t* ColumnSumVector,
+    const int32_t* PackedColumnSums,
+    size_t CountN,
+    int16_t offa
+    )
+/*++
+
+Routine Description:
+
+    This routine scales the column sums stored in a packed matrix B by the
+    zero point offset of matrix A, producing the same values that the copy
+    routines produce when matrix B is packed on the fly.
+
+Arguments:
+
+    ColumnSumVector - Supplies the address of the buffer to receive the
+        scaled column sums.
+
+    PackedColumnSums - Supplies the address of the column sums of the packed
+        matrix B.
+
+    CountN - Supplies the number of columns.
 
     offa - Supplies the zero point offset of matrix A.
 
-    B - Supplies the address of matrix B.
+Return Value:
 
-    ldb - Supplies the first dimension of matrix B.
+    None.
 
-    offb - Supplies the zero point offset of matrix B.
+--*/
+{
+    //
+    // Round up to the thread partition alignment so that kernels that process
+    // a full column block read initialized values.
+    //
 
-    C - Supplies the address of matrix C.
+    CountN = MlasGemmX8X8AlignedN(CountN);
 
-    ldc - Supplies the first dimension of matrix C.
+    const int32_t Scale = -int32_t(offa);
+
+    for (size_t n = 0; n < CountN; n++) {
+        ColumnSumVector[n] = PackedColumnSums[n] * Scale;
+    }
+}
+
+void
+MlasGemmX8X8OutputBlock(
+    const MLAS_GEMM_X8X8_WORK_BLOCK* WorkBlock,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* Data,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine completes a block of matrix C once all slices along the K
+    dimension have been accumulated.
+
+    If matrix B has per column zero point offsets, the block was computed with
+    a zero point offset of zero for matrix B, so the product of each column's
+    offset and the row sums of matrix A is subtracted here. The output
+    processor is then invoked while the block is still in the cache.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    Data - Supplies the matrices of the operation.
+
+    StartM - Supplies the first row of the block.
+
+    StartN - Supplies the first column of the block.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t K = WorkBlock->K;
+    const size_t lda = Data->lda;
+    const size_t ldc = Data->ldc;
+
+    if (Data->ZeroPointB != nullptr) {
+
+        const uint8_t* a = Data->A + StartM * lda;
+        int32_t* c = Data->C + StartM * ldc + StartN;
+        const uint8_t* ZeroPointB = Data->ZeroPointB + StartN;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            int32_t RowSum = -int32_t(K) * WorkBlock->offa;
+
+            for (size_t k = 0; k < K; k++) {
+                RowSum += a[k];
+            }
+
+            if (WorkBlock->BIsSigned) {
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] -= RowSum * int32_t(int8_t(ZeroPointB[n]));
+                }
+            } else {
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] -= RowSum * int32_t(ZeroPointB[n]);
+                }
+            }
+
+            a += lda;
+            c += ldc;
+        }
+    }
+
+    if (Data->OutputProcessor != nullptr) {
+        Data->OutputProcessor->Process(Data->C, StartM, StartN, CountM, CountN, ldc);
+    }
+}
+
+void
+MLASCALL
+MlasGemmU8S8Operation(
+    const MLAS_GEMM_X8X8_WORK_BLOCK* WorkBlock,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* Data,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This module implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    Data - Supplies the matrices of the operation.
+
+    RangeStartM - Supplies the starting row index to output.
+
+    RangeCountM - Supplies the number of rows to output.
+
+    RangeStartN - Supplies the starting column index to output.
+
+    RangeCountN - Supplies the number of columns to output.
 
 Return Value:
 
@@ -1183,12 +1355,38 @@ Return Value:
     size_t StrideN = MLAS_GEMM_X8X8_STRIDEN;
     size_t StrideK = MLAS_GEMM_X8X8_STRIDEK;
 
+    const size_t K = WorkBlock->K;
+    const size_t lda = Data->lda;
+    const size_t ldb = Data->ldb;
+    const size_t ldc = Data->ldc;
+
+    const uint8_t* A = Data->A + RangeStartM * lda;
+    int32_t* C = Data->C + RangeStartM * ldc + RangeStartN;
+
+    //
+    // Per column zero point offsets are applied after the block has been
+    // accumulated, so compute the block with a zero offset for matrix B.
+    //
+
+    const int16_t offa = WorkBlock->offa;
+    const int16_t offb = (Data->ZeroPointB != nullptr) ? 0 : WorkBlock->offb;
+
 #if defined(MLAS_TARGET_AMD64)
 
-    if (M == 1 && offa == 0 && offb == 0) {
+    if (RangeCountM == 1 && offa == 0 && offb == 0 && Data->ZeroPointB == nullptr &&
+        !Data->BIsPacked) {
 
         if (MlasPlatform.GemvU8S8Kernel != nullptr) {
-            MlasPlatform.GemvU8S8Kernel(A, (const int8_t*)B, C, K, N, ldb);
+
+            const int8_t* b = (const int8_t*)Data->B + RangeStartN;
+
+            MlasPlatform.GemvU8S8Kernel(A, b, C, K, RangeCountN, ldb);
+
+            if (Data->OutputProcessor != nullptr) {
+                Data->OutputProcessor->Process(Data->C, RangeStartM, RangeStartN,
+                    RangeCountM, RangeCountN, ldc);
+            }
+
             return;
         }
     }
@@ -1199,6 +1397,9 @@ Return Value:
     // Step through each slice of matrix B along the K dimension.
     //
 
+    const size_t AlignedN = MlasGemmX8X8AlignedN(WorkBlock->N);
+    const uint8_t* PackedB = (const uint8_t*)Data->B;
+
     size_t CountK;
 
     for (size_t k = 0; k < K; k += CountK) {
@@ -1209,33 +1410,61 @@ Return Value:
             CountK = K - k;
         }
 
+        //
+        // Locate the slice of the packed matrix B, if any. Each slice stores
+        // the packed panel for all columns followed by the column sums.
+        //
+
+        const size_t AlignedCountK = MlasGemmX8X8AlignedCountK(CountK, true);
+
+        const int8_t* PackedPanelB = (const int8_t*)PackedB;
+        const int32_t* PackedColumnSums = (const int32_t*)(PackedB + AlignedN * AlignedCountK);
+
+        if (Data->BIsPacked) {
+            PackedB += AlignedN * (AlignedCountK + sizeof(int32_t));
+        }
+
         //
         // Step through each slice of matrix B along the N dimension.
         //
 
         size_t CountN;
 
-        for (size_t n = 0; n < N; n += CountN) {
+        for (size_t n = 0; n < RangeCountN; n += CountN) {
 
             CountN = StrideN;
 
-            if (CountN > (N - n)) {
-                CountN = N - n;
+            if (CountN > (RangeCountN - n)) {
+                CountN = RangeCountN - n;
             }
 
-            const int8_t* b = (const int8_t*)B + n + k * ldb;
+            const int8_t* pb;
 
-            MlasPlatform.GemmU8S8CopyPackBRoutine(PanelB, b, ldb, CountN,
-                CountK, ColumnSumVector, -int16_t(offa));
+            if (Data->BIsPacked) {
+
+                pb = PackedPanelB + (RangeStartN + n) * AlignedCountK;
+
+                MlasGemmX8X8ScaleColumnSums(ColumnSumVector,
+                    PackedColumnSums + RangeStartN + n, CountN, offa);
+
+            } else {
+
+                const int8_t* b = (const int8_t*)Data->B + RangeStartN + n + k * ldb;
+
+                MlasPlatform.GemmU8S8CopyPackBRoutine(PanelB, b, ldb, CountN,
+                    CountK, ColumnSumVector, -int16_t(offa));
+
+                pb = PanelB;
+            }
 
             size_t CountM;
 
-            for (size_t m = 0; m < M; m += CountM) {
+            for (size_t m = 0; m < RangeCountM; m += CountM) {
 
                 CountM = StrideM;
 
-                if (CountM > (M - m)) {
-                    CountM = M - m;
+                if (CountM > (RangeCountM - m)) {
+                    CountM = RangeCountM - m;
                 }
 
                 MlasPlatform.GemmU8S8CopyPackARoutine(PanelA, A + k + m * lda,
@@ -1253,7 +1482,7 @@ Return Value:
 
                 while (RowsRemaining > 0) {
 
-                    RowsHandled = MlasPlatform.GemmU8S8Kernel(pa, PanelB, c,
+                    RowsHandled = MlasPlatform.GemmU8S8Kernel(pa, pb, c,
                         QuadCountK, RowsRemaining, CountN, ldc, RowSums,
                         ColumnSumVector, int32_t(CountK) * offa * offb, k == 0);
 
@@ -1262,6 +1491,11 @@ Return Value:
                     pa += 4 * QuadCountK * RowsHandled;
                     RowSums += RowsHandled;
                 }
+
+                if (k + CountK == K) {
+                    MlasGemmX8X8OutputBlock(WorkBlock, Data, RangeStartM + m,
+                        RangeStartN + n, CountM, CountN);
+                }
             }
         }
     }
@@ -1270,17 +1504,12 @@ Return Value:
 void
 MLASCALL
 MlasGemmU8U8Operation(
-    size_t M,
-    size_t N,
-    size_t K,
-    const uint8_t* A,
-    size_t lda,
-    int16_t offa,
-    const uint8_t* B,
-    size_t ldb,
-    int16_t offb,
-    int32_t* C,
-    size_t ldc
+    const MLAS_GEMM_X8X8_WORK_BLOCK* WorkBlock,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* Data,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
     )
 /*++
 
@@ -1291,28 +1520,17 @@ Routine Description:
 
 Arguments:
 
-    M - Supplies the number of rows of matrix A and matrix C.
-
-    N - Supplies the number of columns of matrix B and matrix C.
-
-    K - Supplies the number of columns of matrix A and the number of rows of
-        matrix B.
-
-    A - Supplies the address of matrix A.
-
-    lda - Supplies the first dimension of matrix A.
-
-    offa - Supplies the zero point offset of matrix A.
+    WorkBlock - Supplies the structure containing the GEMM parameters.
 
-    B - Supplies the address of matrix B.
+    Data - Supplies the matrices of the operation.
 
-    ldb - Supplies the first dimension of matrix B.
+    RangeStartM - Supplies the starting row index to output.
 
-    offb - Supplies the zero point offset of matrix B.
+    RangeCountM - Supplies the number of rows to output.
 
-    C - Supplies the address of matrix C.
+    RangeStartN - Supplies the starting column index to output.
 
-    ldc - Supplies the first dimension of matrix C.
+    RangeCountN - Supplies the number of columns to output.
 
 Return Value:
 
@@ -1330,10 +1548,29 @@ Return Value:
     size_t StrideN = MLAS_GEMM_X8X8_STRIDEN;
     size_t StrideK = MLAS_GEMM_X8X8_STRIDEK;
 
+    const size_t K = WorkBlock->K;
+    const size_t lda = Data->lda;
+    const size_t ldb = Data->ldb;
+    const size_t ldc = Data->ldc;
+
+    const uint8_t* A = Data->A + RangeStartM * lda;
+    int32_t* C = Data->C + RangeStartM * ldc + RangeStartN;
+
+    //
+    // Per column zero point offsets are applied after the block has been
+    // accumulated, so compute the block with a zero offset for matrix B.
+    //
+
+    const int16_t offa = WorkBlock->offa;
+    const int16_t offb = (Data->ZeroPointB != nullptr) ? 0 : WorkBlock->offb;
+
     //
     // Step through each slice of matrix B along the K dimension.
     //
 
+    const size_t AlignedN = MlasGemmX8X8AlignedN(WorkBlock->N);
+    const uint8_t* PackedB = (const uint8_t*)Data->B;
+
     size_t CountK;
 
     for (size_t k = 0; k < K; k += CountK) {
@@ -1344,33 +1581,61 @@ Return Value:
             CountK = K - k;
         }
 
+        //
+        // Locate the slice of the packed matrix B, if any. Each slice stores
+        // the packed panel for all columns followed by the column sums.
+        //
+
+        const size_t AlignedCountK = MlasGemmX8X8AlignedCountK(CountK, false);
+
+        const uint8_t* PackedPanelB = PackedB;
+        const int32_t* PackedColumnSums = (const int32_t*)(PackedB + AlignedN * AlignedCountK);
+
+        if (Data->BIsPacked) {
+            PackedB += AlignedN * (AlignedCountK + sizeof(int32_t));
+        }
+
         //
         // Step through each slice of matrix B along the N dimension.
         //
 
         size_t CountN;
 
-        for (size_t n = 0; n < N; n += CountN) {
+        for (size_t n = 0; n < RangeCountN; n += CountN) {
 
             CountN = StrideN;
 
-            if (CountN > (N - n)) {
-                CountN = N - n;
+            if (CountN > (RangeCountN - n)) {
+                CountN = RangeCountN - n;
             }
 
-            const uint8_t* b = (const uint8_t*)B + n + k * ldb;
+            const uint8_t* pb;
+
+            if (Data->BIsPacked) {
+
+                pb = PackedPanelB + (RangeStartN + n) * AlignedCountK;
+
+                MlasGemmX8X8ScaleColumnSums(ColumnSumVector,
+                    PackedColumnSums + RangeStartN + n, CountN, offa);
+
+            } else {
+
+                const uint8_t* b = (const uint8_t*)Data->B + RangeStartN + n + k * ldb;
 
-            MlasPlatform.GemmU8U8CopyPackBRoutine(PanelB, b, ldb, CountN,
-                CountK, ColumnSumVector, -int16_t(offa));
+                MlasPlatform.GemmU8U8CopyPackBRoutine(PanelB, b, ldb, CountN,
+                    CountK, ColumnSumVector, -int16_t(offa));
+
+                pb = PanelB;
+            }
 
             size_t CountM;
 
-            for (size_t m = 0; m < M; m += CountM) {
+            for (size_t m = 0; m < RangeCountM; m += CountM) {
 
                 CountM = StrideM;
 
-                if (CountM > (M - m)) {
-                    CountM = M - m;
+                if (CountM > (RangeCountM - m)) {
+                    CountM = RangeCountM - m;
                 }
 
                 MlasPlatform.GemmU8U8CopyPackARoutine(PanelA, A + k + m * lda,
@@ -1388,7 +1653,7 @@ Return Value:
 
                 while (RowsRemaining > 0) {
 
-                    RowsHandled = MlasPlatform.GemmU8U8Kernel(pa, PanelB, c,
+                    RowsHandled = MlasPlatform.GemmU8U8Kernel(pa, pb, c,
                         PairCountK, RowsRemaining, CountN, ldc, RowSums,
                         ColumnSumVector, int32_t(CountK) * offa * offb, k == 0);
 
@@ -1397,6 +1662,11 @@ Return Value:
                     pa += 2 * PairCountK * RowsHandled;
                     RowSums += RowsHandled;
                 }
+
+                if (k + CountK == K) {
+                    MlasGemmX8X8OutputBlock(WorkBlock, Data, RangeStartM + m,
+                        RangeStartN + n, CountM, CountN);
+                }
             }
         }
     }
@@ -1430,9 +1700,21 @@ Return Value:
 
     const int32_t ThreadCountM = WorkBlock->ThreadCountM;
     const int32_t ThreadCountN = WorkBlock->ThreadCountN;
+    const int32_t ThreadCountGemm = ThreadCountM * ThreadCountN;
 
-    const int32_t ThreadIdM = ThreadId / ThreadCountN;
-    const int32_t ThreadIdN = ThreadId % ThreadCountN;
+    const int32_t ThreadIdBatch = ThreadId / ThreadCountGemm;
+    const int32_t ThreadIdM = (ThreadId % ThreadCountGemm) / ThreadCountN;
+    const int32_t ThreadIdN = (ThreadId % ThreadCountGemm) % ThreadCountN;
+
+    //
+    // Partition the operation along the batch dimension.
+    //
+
+    size_t BatchIndex;
+    size_t BatchCount;
+
+    MlasPartitionWork(ThreadIdBatch, WorkBlock->ThreadCountBatch,
+        WorkBlock->BatchSize, &BatchIndex, &BatchCount);
 
     //
     // Partition the operation along the M dimension.
@@ -1465,19 +1747,14 @@ Return Value:
     }
 
     //
-    // Dispatch the partitioned operation.
+    // Dispatch the partitioned operation for each matrix of the batch.
     //
 
-    const size_t lda = WorkBlock->lda;
-    const size_t ldb = WorkBlock->ldb;
-    const size_t ldc = WorkBlock->ldc;
+    for (; BatchCount > 0; BatchIndex++, BatchCount--) {
 
-    const uint8_t* a = WorkBlock->A + m * lda;
-    const uint8_t* b = WorkBlock->B + n;
-    int32_t* c = WorkBlock->C + n + m * ldc;
-
-    WorkBlock->GemmX8X8Operation(CountM, CountN, WorkBlock->K, a, lda,
-        WorkBlock->offa, b, ldb, WorkBlock->offb, c, ldc);
+        WorkBlock->GemmX8X8Operation(WorkBlock, &WorkBlock->Data[BatchIndex],
+            m, CountM, n, CountN);
+    }
 }
 
 void
@@ -1508,30 +1785,55 @@ Return Value:
     const size_t M = WorkBlock->M;
     const size_t N = WorkBlock->N;
     const size_t K = WorkBlock->K;
+    const size_t BatchSize = WorkBlock->BatchSize;
+
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
 
     //
-    // Compute the number of target threads given the complexity of the SGEMM
+    // Compute the number of target threads given the complexity of the QGEMM
     // operation. Small requests should run using the single threaded path.
     //
 
-    double Complexity = double(M) * double(N) * double(K);
+    double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
 
     int32_t TargetThreadCount;
 
-    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (BatchSize == 1 && MaximumThreadCount > MLAS_MAXIMUM_THREAD_COUNT) {
+        MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY) * double(MaximumThreadCount)) {
         TargetThreadCount = int32_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
     } else {
-        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        TargetThreadCount = MaximumThreadCount;
     }
 
-    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
-
     if (TargetThreadCount >= MaximumThreadCount) {
         TargetThreadCount = MaximumThreadCount;
     }
 
     //
-    // Segment the operation across multiple threads.
+    // Distribute the threads across the batch first and then use any
+    // remaining threads to segment each individual operation.
+    //
+
+    int32_t ThreadCountBatch;
+    int32_t ThreadCountGemm;
+
+    if (size_t(TargetThreadCount) >= BatchSize) {
+        ThreadCountBatch = int32_t(BatchSize);
+        ThreadCountGemm = TargetThreadCount / ThreadCountBatch;
+    } else {
+        ThreadCountBatch = TargetThreadCount;
+        ThreadCountGemm = 1;
+    }
+
+    //
+    // Segment each operation across multiple threads.
     //
     // N.B. Currently, the operation is segmented as a 1D partition, which
     // works okay for operations involving skinny matrices.
@@ -1542,24 +1844,27 @@ Return Value:
         const size_t BlockedN = (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) /
             MLAS_QGEMM_STRIDEN_THREAD_ALIGN;
 
-        if (size_t(TargetThreadCount) > BlockedN) {
-            TargetThreadCount = int32_t(BlockedN);
+        if (size_t(ThreadCountGemm) > BlockedN) {
+            ThreadCountGemm = int32_t(BlockedN);
         }
 
         WorkBlock->ThreadCountM = 1;
-        WorkBlock->ThreadCountN = TargetThreadCount;
+        WorkBlock->ThreadCountN = ThreadCountGemm;
 
     } else {
 
-        if (size_t(TargetThreadCount) > M) {
-            TargetThreadCount = int32_t(M);
+        if (size_t(ThreadCountGemm) > M) {
+            ThreadCountGemm = int32_t(M);
         }
 
-        WorkBlock->ThreadCountM = TargetThreadCount;
+        WorkBlock->ThreadCountM = ThreadCountGemm;
         WorkBlock->ThreadCountN = 1;
     }
 
-    MlasExecuteThreaded(MlasGemmX8X8Threaded, WorkBlock, TargetThreadCount, ThreadPool);
+    WorkBlock->ThreadCountBatch = ThreadCountBatch;
+
+    MlasExecuteThreaded(MlasGemmX8X8Threaded, WorkBlock,
+        ThreadCountBatch * ThreadCountGemm, ThreadPool);
 }
 
 void
@@ -1619,30 +1924,16 @@ Return Value:
 
 --*/
 {
-    MLAS_GEMM_X8X8_WORK_BLOCK WorkBlock;
-
-    //
-    // Capture the GEMM parameters to the work block.
-    //
+    MLAS_GEMM_U8X8_DATA_PARAMS Data;
 
-    WorkBlock.M = M;
-    WorkBlock.N = N;
-    WorkBlock.K = K;
-    WorkBlock.A = A;
-    WorkBlock.lda = lda;
-    WorkBlock.B = (const uint8_t*)B;
-    WorkBlock.ldb = ldb;
-    WorkBlock.C = C;
-    WorkBlock.ldc = ldc;
-    WorkBlock.offa = int16_t(offa);
-    WorkBlock.offb = int16_t(offb);
-    WorkBlock.GemmX8X8Operation = MlasGemmU8S8Operation;
+    Data.A = A;
+    Data.lda = lda;
+    Data.B = B;
+    Data.ldb = ldb;
+    Data.C = C;
+    Data.ldc = ldc;
 
-    //
-    // Schedule the operation across a set of worker threads.
-    //
-
-    MlasGemmX8X8Schedule(&WorkBlock, ThreadPool);
+    MlasGemmBatch(M, N, K, &Data, 1, offa, uint8_t(offb), true, ThreadPool);
 }
 
 void
@@ -1700,6 +1991,70 @@ Return Value:
 
     None.
 
+--*/
+{
+    MLAS_GEMM_U8X8_DATA_PARAMS Data;
+
+    Data.A = A;
+    Data.lda = lda;
+    Data.B = B;
+    Data.ldb = ldb;
+    Data.C = C;
+    Data.ldc = ldc;
+
+    MlasGemmBatch(M, N, K, &Data, 1, offa, offb, false, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* Data,
+    size_t BatchSize,
+    uint8_t offa,
+    uint8_t offb,
+    bool BIsSigned,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This module implements a batch of quantized integer matrix/matrix multiply
+    operations (QGEMM) that share the same dimensions and zero point offsets.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies an array of BatchSize elements describing the matrices
+        for each operation of the batch.
+
+    BatchSize - Supplies the number of operations in the batch.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    offb - Supplies the zero point offset of matrix B. The value is
+        interpreted as a signed value if BIsSigned is true. The value is
+        ignored for elements of the batch that supply per column zero points.
+
+    BIsSigned - Supplies true if matrix B contains signed values, else false
+        if matrix B contains unsigned values.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
 --*/
 {
     MLAS_GEMM_X8X8_WORK_BLOCK WorkBlock;
@@ -1711,15 +2066,18 @@ Return Value:
     WorkBlock.M = M;
     WorkBlock.N = N;
     WorkBlock.K = K;
-    WorkBlock.A = A;
-    WorkBlock.lda = lda;
-    WorkBlock.B = B;
-    WorkBlock.ldb = ldb;
-    WorkBlock.C = C;
-    WorkBlock.ldc = ldc;
+    WorkBlock.Data = Data;
+    WorkBlock.BatchSize = BatchSize;
     WorkBlock.offa = int16_t(offa);
-    WorkBlock.offb = int16_t(offb);
-    WorkBlock.GemmX8X8Operation = MlasGemmU8U8Operation;
+    WorkBlock.BIsSigned = BIsSigned;
+
+    if (BIsSigned) {
+        WorkBlock.offb = int16_t(int8_t(offb));
+        WorkBlock.GemmX8X8Operation = MlasGemmU8S8Operation;
+    } else {
+        WorkBlock.offb = int16_t(offb);
+        WorkBlock.GemmX8X8Operation = MlasGemmU8U8Operation;
+    }
 
     //
     // Schedule the operation across a set of worker threads.
@@ -1728,4 +2086,136 @@ Return Value:
     MlasGemmX8X8Schedule(&WorkBlock, ThreadPool);
 }
 
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack a matrix with
+    the supplied shape and type.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BIsSigned - Supplies true if matrix B contains signed values, else false
+        if matrix B contains unsigned values.
+
+Return Value:
+
+    Returns the number of bytes required to pack the matrix.
+
+--*/
+{
+    const size_t AlignedN = MlasGemmX8X8AlignedN(N);
+
+    size_t BytesRequired = 0;
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_GEMM_X8X8_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        BytesRequired += AlignedN *
+            (MlasGemmX8X8AlignedCountK(CountK, BIsSigned) + sizeof(int32_t));
+    }
+
+    return BytesRequired;
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the supplied matrix B to the supplied packed matrix B
+    buffer. The size of the packed buffer was obtained from MlasGemmPackBSize.
+
+    Each slice of StrideK rows is stored as the packed panel of all N columns
+    followed by the sums of each column. The sums are stored without the zero
+    point offset of matrix A applied, so the packed buffer can be used with
+    any offset.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    BIsSigned - Supplies true if matrix B contains signed values, else false
+        if matrix B contains unsigned values.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN = MlasGemmX8X8AlignedN(N);
+
+    //
+    // Clear the buffer so that the padding columns are deterministic.
+    //
+
+    memset(PackedB, 0, MlasGemmPackBSize(N, K, BIsSigned));
+
+    uint8_t* pb = (uint8_t*)PackedB;
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_GEMM_X8X8_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        const size_t AlignedCountK = MlasGemmX8X8AlignedCountK(CountK, BIsSigned);
+
+        int32_t* ColumnSumVector = (int32_t*)(pb + AlignedN * AlignedCountK);
+
+        //
+        // An offset of one for matrix A stores the unscaled column sums.
+        //
+
+        if (BIsSigned) {
+            MlasPlatform.GemmU8S8CopyPackBRoutine((int8_t*)pb,
+                (const int8_t*)B + k * ldb, ldb, N, CountK, ColumnSumVector, 1);
+        } else {
+            MlasPlatform.GemmU8U8CopyPackBRoutine(pb, B + k * ldb, ldb, N,
+                CountK, ColumnSumVector, 1);
+        }
+
+        pb += AlignedN * (AlignedCountK + sizeof(int32_t));
+    }
+}
+
 #endif
@@ -421,4 +421,133 @@ Return Value:
     }
 }
 
+void
+MLASCALL
+MlasRequantizeOutputColumns(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    uint8_t ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes a block of the intermediate buffer to the output
+    buffer optionally adding the supplied bias.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    InputLeadingDimension - Supplies the first dimension of the input matrix.
+
+    Output - Supplies the output matrix.
+
+    OutputLeadingDimension - Supplies the first dimension of the output
+        matrix.
+
+    Bias - Supplies the optional bias vector to be added to the input buffer
+        before requantization. The vector has an element for each column of
+        the output matrix.
+
+    Scale - Supplies the quantization scale.
+
+    PerColumnScale - Supplies true if Scale has an element for each column of
+        the output matrix, else false if Scale is a single value.
+
+    ZeroPoint - Supplies the quantization zero point value.
+
+    StartM - Supplies the first row of the block.
+
+    StartN - Supplies the first column of the block.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 MinimumValueVector = MlasBroadcastFloat32x4(float(0 - ZeroPoint));
+    MLAS_FLOAT32X4 MaximumValueVector = MlasBroadcastFloat32x4(float(255 - ZeroPoint));
+    MLAS_INT32X4 ZeroPointVector = MlasBroadcastInt32x4(ZeroPoint);
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale[0]);
+    MLAS_INT32X4 BiasVector = _mm_setzero_si128();
+
+    if (Bias != nullptr) {
+        Bias += StartN;
+    }
+
+    if (PerColumnScale) {
+        Scale += StartN;
+    }
+
+    Input += StartM * InputLeadingDimension + StartN;
+    Output += StartM * OutputLeadingDimension + StartN;
+
+    //
+    // Step through each row of the output matrix.
+    //
+
+    while (CountM-- > 0) {
+
+        const int32_t* bias = Bias;
+        const float* scale = Scale;
+
+        size_t n = 0;
+
+        for (; n + 4 <= CountN; n += 4) {
+
+            if (bias != nullptr) {
+                BiasVector = _mm_loadu_si128((const __m128i *)&bias[n]);
+            }
+
+            if (PerColumnScale) {
+                ScaleVector = MlasLoadFloat32x4(&scale[n]);
+            }
+
+            MLAS_INT32X4 IntegerVector = _mm_loadu_si128((const __m128i *)&Input[n]);
+            IntegerVector = MlasRequantizeOutputVector(IntegerVector, BiasVector,
+                ScaleVector, MinimumValueVector, MaximumValueVector, ZeroPointVector);
+
+            IntegerVector = _mm_packus_epi16(IntegerVector, IntegerVector);
+            IntegerVector = _mm_packus_epi16(IntegerVector, IntegerVector);
+
+            *((int32_t*)&Output[n]) = _mm_cvtsi128_si32(IntegerVector);
+        }
+
+        for (; n < CountN; n++) {
+
+            if (bias != nullptr) {
+                BiasVector = _mm_cvtsi32_si128(bias[n]);
+            }
+
+            if (PerColumnScale) {
+                ScaleVector = _mm_load_ss(&scale[n]);
+            }
+
+            MLAS_INT32X4 IntegerVector = _mm_cvtsi32_si128(Input[n]);
+            IntegerVector = MlasRequantizeOutputVector(IntegerVector, BiasVector,
+                ScaleVector, MinimumValueVector, MaximumValueVector, ZeroPointVector);
+
+            Output[n] = (uint8_t)_mm_cvtsi128_si32(IntegerVector);
+        }
+
+        Input += InputLeadingDimension;
+        Output += OutputLeadingDimension;
+    }
+}
+
 #endif
@@ -40,15 +40,36 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    const float* PackedB;
+    size_t PackedCountN;
     struct SEGMENT {
         size_t M;
         size_t N;
+        size_t StartN;
         const float* A;
         const float* B;
         float* C;
     } Segments[MLAS_MAXIMUM_THREAD_COUNT];
 };
 
+//
+// Define the parameters to execute a batch of SGEMM operations on a worker
+// thread.
+//
+
+struct MLAS_SGEMM_BATCH_WORK_BLOCK {
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    const MLAS_SGEMM_DATA_PARAMS* Data;
+    size_t BatchSize;
+    int32_t ThreadCountBatch;
+    int32_t ThreadCountM;
+    int32_t ThreadCountN;
+};
+
 void
 MlasSgemmMultiplyBeta(
     float* C,
@@ -762,6 +783,141 @@ Return Value:
     }
 }
 
+void
+MlasSgemmComputeBlock(
+    CBLAS_TRANSPOSE TransA,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    const float* A,
+    size_t lda,
+    float* PanelA,
+    const float* PanelB,
+    float* C,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies all rows of matrix A by a packed panel of matrix B
+    and accumulates the result into matrix C.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of the packed panel and matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of rows
+        of the packed panel.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first element of matrix A for this slice
+        of the K dimension.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PanelA - Supplies the address of a local buffer used to transpose rows of
+        matrix A. The buffer must hold MLAS_SGEMM_TRANSA_ROWS * CountK elements.
+
+    PanelB - Supplies the address of the packed panel of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t RowsRemaining = CountM;
+    size_t RowsHandled;
+
+    if (TransA == CblasNoTrans) {
+
+        //
+        // Step through the rows of matrix A.
+        //
+
+        do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+            RowsHandled = MlasPlatform.GemmFloatKernel(A, PanelB, C, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
+#else
+            if (ZeroMode) {
+                RowsHandled = MlasSgemmKernelZero(A, PanelB, C, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            } else {
+                RowsHandled = MlasSgemmKernelAdd(A, PanelB, C, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            }
+#endif
+
+            C += ldc * RowsHandled;
+            A += lda * RowsHandled;
+
+            RowsRemaining -= RowsHandled;
+
+        } while (RowsRemaining > 0);
+
+    } else {
+
+        do {
+
+            //
+            // Transpose elements from matrix A into a local buffer.
+            //
+
+            size_t RowsTransposed = RowsRemaining;
+
+            if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
+                RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
+            }
+
+            RowsRemaining -= RowsTransposed;
+
+            MlasSgemmTransposeA(PanelA, A, lda, RowsTransposed, CountK);
+
+            A += RowsTransposed;
+
+            //
+            // Step through the rows of the local buffer.
+            //
+
+            const float* pa = PanelA;
+
+            do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, C, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+#else
+                if (ZeroMode) {
+                    RowsHandled = MlasSgemmKernelZero(pa, PanelB, C, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                } else {
+                    RowsHandled = MlasSgemmKernelAdd(pa, PanelB, C, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                }
+#endif
+
+                C += ldc * RowsHandled;
+                pa += CountK * RowsHandled;
+
+                RowsTransposed -= RowsHandled;
+
+            } while (RowsTransposed > 0);
+
+        } while (RowsRemaining > 0);
+    }
+}
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -955,87 +1111,125 @@ Return Value:
             // Step through each slice of matrix A along the M dimension.
             //
 
-            float* c = C + n;
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
 
-            size_t RowsRemaining = M;
-            size_t RowsHandled;
+            MlasSgemmComputeBlock(TransA, M, CountN, CountK, alpha, a, lda,
+                PanelA, PanelB, C + n, ldc, ZeroMode);
+        }
+    }
+}
 
-            if (TransA == CblasNoTrans) {
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PackedB,
+    size_t PackedCountN,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
 
-                const float* a = A + k;
+Routine Description:
 
-                //
-                // Step through the rows of matrix A.
-                //
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) using a matrix B that was previously packed by
+    MlasGemmPackB.
 
-                do {
+Arguments:
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                    RowsHandled = MlasPlatform.GemmFloatKernel(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
-#else
-                    if (ZeroMode) {
-                        RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    } else {
-                        RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    }
-#endif
+    TransA - Supplies the transpose operation for matrix A.
 
-                    c += ldc * RowsHandled;
-                    a += lda * RowsHandled;
+    M - Supplies the number of rows of matrix A and matrix C.
 
-                    RowsRemaining -= RowsHandled;
+    RangeStartN - Supplies the starting column from the packed matrix B. This
+        value must be a multiple of MLAS_SGEMM_STRIDEN_THREAD_ALIGN.
 
-                } while (RowsRemaining > 0);
+    RangeCountN - Supplies the number of columns from the packed matrix B and
+        matrix C.
 
-            } else {
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
 
-                const float* a = A + k * lda;
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
 
-                do {
+    A - Supplies the address of matrix A.
 
-                    //
-                    // Transpose elements from matrix A into a local buffer.
-                    //
+    lda - Supplies the first dimension of matrix A.
 
-                    size_t RowsTransposed = RowsRemaining;
+    PackedB - Supplies the address of the packed matrix B.
 
-                    if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
-                        RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
-                    }
+    PackedCountN - Supplies the number of columns of the packed matrix B
+        including any padding.
 
-                    RowsRemaining -= RowsTransposed;
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
-                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+    C - Supplies the address of matrix C for the starting column.
 
-                    a += RowsTransposed;
+    ldc - Supplies the first dimension of matrix C.
 
-                    //
-                    // Step through the rows of the local buffer.
-                    //
+Return Value:
 
-                    const float* pa = PanelA;
+    None.
 
-                    do {
+--*/
+{
+    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                        RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
-#else
-                        if (ZeroMode) {
-                            RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        } else {
-                            RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        }
-#endif
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+    size_t CountK;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = MLAS_SGEMM_PACKED_STRIDEN;
+
+        if (CountN > (RangeCountN - n)) {
+            CountN = RangeCountN - n;
+        }
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
 
-                        c += ldc * RowsHandled;
-                        pa += CountK * RowsHandled;
+        for (size_t k = 0; k < K; k += CountK) {
 
-                        RowsTransposed -= RowsHandled;
+            bool ZeroMode = (k == 0 && beta == 0.0f);
 
-                    } while (RowsTransposed > 0);
+            CountK = MLAS_SGEMM_PACKED_STRIDEK;
 
-                } while (RowsRemaining > 0);
+            if (CountK > (K - k)) {
+                CountK = K - k;
             }
+
+            //
+            // The packed panel for this slice is already laid out in the
+            // format expected by the kernels, so reference it in place.
+            //
+
+            const float* pb = PackedB + PackedCountN * k + CountK * (RangeStartN + n);
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
+
+            MlasSgemmComputeBlock(TransA, M, CountN, CountK, alpha, a, lda,
+                PanelA, pb, C + n, ldc, ZeroMode);
         }
     }
 }
@@ -1068,28 +1262,129 @@ Return Value:
 
     MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
-    MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
-        Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
-        Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
-        WorkBlock->ldc);
+    if (WorkBlock->PackedB != nullptr) {
+
+        MlasSgemmPackedOperation(WorkBlock->TransA, Segment->M, Segment->StartN,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            WorkBlock->PackedB, WorkBlock->PackedCountN, WorkBlock->beta,
+            Segment->C, WorkBlock->ldc);
+
+    } else {
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
+            WorkBlock->ldc);
+    }
+}
+
+void
+MlasSgemmBatchThreaded(
+    void* Context,
+    int32_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    batched SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SGEMM_BATCH_WORK_BLOCK*)Context;
+
+    const int32_t ThreadCountM = WorkBlock->ThreadCountM;
+    const int32_t ThreadCountN = WorkBlock->ThreadCountN;
+    const int32_t ThreadCountGemm = ThreadCountM * ThreadCountN;
+
+    const int32_t ThreadIdBatch = ThreadId / ThreadCountGemm;
+    const int32_t ThreadIdM = (ThreadId % ThreadCountGemm) / ThreadCountN;
+    const int32_t ThreadIdN = (ThreadId % ThreadCountGemm) % ThreadCountN;
+
+    //
+    // Partition the operation along the batch dimension.
+    //
+
+    size_t BatchIndex;
+    size_t BatchCount;
+
+    MlasPartitionWork(ThreadIdBatch, WorkBlock->ThreadCountBatch,
+        WorkBlock->BatchSize, &BatchIndex, &BatchCount);
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    const size_t M = WorkBlock->M;
+    size_t m;
+    size_t CountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &m, &CountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    const size_t N = WorkBlock->N;
+    size_t n;
+    size_t CountN;
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &n, &CountN);
+
+    n *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    CountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    if (CountN > N - n) {
+        CountN = N - n;
+    }
+
+    if (CountM == 0 || CountN == 0) {
+        return;
+    }
+
+    //
+    // Dispatch the partitioned operation for each matrix of the batch.
+    //
+
+    for (; BatchCount > 0; BatchIndex++, BatchCount--) {
+
+        const MLAS_SGEMM_DATA_PARAMS* Data = &WorkBlock->Data[BatchIndex];
+
+        const size_t lda = Data->lda;
+        const size_t ldb = Data->ldb;
+        const size_t ldc = Data->ldc;
+
+        const float* a = Data->A + ((WorkBlock->TransA == CblasNoTrans) ? m * lda : m);
+        const float* b = Data->B + ((WorkBlock->TransB == CblasNoTrans) ? n : n * ldb);
+        float* c = Data->C + n + m * ldc;
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, CountM, CountN,
+            WorkBlock->K, Data->alpha, a, lda, b, ldb, Data->beta, c, ldc);
+    }
 }
 
-inline
 bool
 MlasSgemmTryMultithread(
-    CBLAS_TRANSPOSE TransA,
-    CBLAS_TRANSPOSE TransB,
+    MLAS_SGEMM_WORK_BLOCK* WorkBlock,
     size_t M,
     size_t N,
-    size_t K,
-    float alpha,
     const float* A,
-    size_t lda,
     const float* B,
-    size_t ldb,
-    float beta,
     float* C,
-    size_t ldc,
     MLAS_THREADPOOL* ThreadPool
     )
 /*++
@@ -1101,33 +1396,20 @@ Routine Description:
 
 Arguments:
 
-    TransA - Supplies the transpose operation for matrix A.
-
-    TransB - Supplies the transpose operation for matrix B.
+    WorkBlock - Supplies the work block with the common fields of the
+        operation initialized.
 
     M - Supplies the number of rows of matrix A and matrix C.
 
     N - Supplies the number of columns of matrix B and matrix C.
 
-    K - Supplies the number of columns of matrix A and the number of rows of
-        matrix B.
-
-    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
-
     A - Supplies the address of matrix A.
 
-    lda - Supplies the first dimension of matrix A.
-
-    B - Supplies the address of matrix B.
-
-    ldb - Supplies the first dimension of matrix B.
-
-    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+    B - Supplies the address of matrix B, else nullptr if the work block
+        references a packed matrix B.
 
     C - Supplies the address of matrix C.
 
-    ldc - Supplies the first dimension of matrix C.
-
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
@@ -1138,7 +1420,6 @@ Return Value:
 
 --*/
 {
-    MLAS_SGEMM_WORK_BLOCK WorkBlock;
     int32_t TargetThreadCount;
 
     //
@@ -1146,7 +1427,7 @@ Return Value:
     // operation. Small requests should run using the single threaded path.
     //
 
-    double Complexity = double(M) * double(N) * double(K);
+    double Complexity = double(M) * double(N) * double(WorkBlock->K);
 
     if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
         TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
@@ -1164,19 +1445,6 @@ Return Value:
         return false;
     }
 
-    //
-    // Initialize the common fields of the work block.
-    //
-
-    WorkBlock.TransA = TransA;
-    WorkBlock.TransB = TransB;
-    WorkBlock.K = K;
-    WorkBlock.lda = lda;
-    WorkBlock.ldb = ldb;
-    WorkBlock.ldc = ldc;
-    WorkBlock.alpha = alpha;
-    WorkBlock.beta = beta;
-
     //
     // Segment the operation across multiple threads.
     //
@@ -1194,7 +1462,7 @@ Return Value:
         StrideN =
             (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
 
-        size_t pldb = (TransB == CblasNoTrans) ? 1 : ldb;
+        size_t pldb = (WorkBlock->TransB == CblasNoTrans) ? 1 : WorkBlock->ldb;
 
         for (size_t CountN, n = 0; n < N; n += CountN) {
 
@@ -1204,11 +1472,12 @@ Return Value:
                 CountN = N - n;
             }
 
-            WorkBlock.Segments[Index].M = M;
-            WorkBlock.Segments[Index].N = CountN;
-            WorkBlock.Segments[Index].A = A;
-            WorkBlock.Segments[Index].B = B + n * pldb;
-            WorkBlock.Segments[Index].C = C + n;
+            WorkBlock->Segments[Index].M = M;
+            WorkBlock->Segments[Index].N = CountN;
+            WorkBlock->Segments[Index].StartN = n;
+            WorkBlock->Segments[Index].A = A;
+            WorkBlock->Segments[Index].B = (B != nullptr) ? B + n * pldb : nullptr;
+            WorkBlock->Segments[Index].C = C + n;
 
             Index++;
         }
@@ -1221,7 +1490,7 @@ Return Value:
             StrideM++;
         }
 
-        size_t plda = (TransA == CblasNoTrans) ? lda : 1;
+        size_t plda = (WorkBlock->TransA == CblasNoTrans) ? WorkBlock->lda : 1;
 
         for (size_t CountM, m = 0; m < M; m += CountM) {
 
@@ -1231,17 +1500,18 @@ Return Value:
                 CountM = M - m;
             }
 
-            WorkBlock.Segments[Index].M = CountM;
-            WorkBlock.Segments[Index].N = N;
-            WorkBlock.Segments[Index].A = A + m * plda;
-            WorkBlock.Segments[Index].B = B;
-            WorkBlock.Segments[Index].C = C + m * ldc;
+            WorkBlock->Segments[Index].M = CountM;
+            WorkBlock->Segments[Index].N = N;
+            WorkBlock->Segments[Index].StartN = 0;
+            WorkBlock->Segments[Index].A = A + m * plda;
+            WorkBlock->Segments[Index].B = B;
+            WorkBlock->Segments[Index].C = C + m * WorkBlock->ldc;
 
             Index++;
         }
     }
 
-    MlasExecuteThreaded(MlasSgemmOperationThreaded, &WorkBlock, Index, ThreadPool);
+    MlasExecuteThreaded(MlasSgemmOperationThreaded, WorkBlock, Index, ThreadPool);
 
     return true;
 }
@@ -1309,12 +1579,354 @@ Return Value:
 
 --*/
 {
+    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = ldb;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.PackedB = nullptr;
+    WorkBlock.PackedCountN = 0;
+
     //
     // Try to run the operation across multiple threads or fall back to a
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, ThreadPool)) {
+    if (!MlasSgemmTryMultithread(&WorkBlock, M, N, A, B, C, ThreadPool)) {
         MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
     }
 }
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) using a matrix B that was previously packed by
+    MlasGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+
+    const size_t PackedCountN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = CblasNoTrans;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = 0;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.PackedB = (const float*)PackedB;
+    WorkBlock.PackedCountN = PackedCountN;
+
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the GEMM parameters and system configuration.
+    //
+
+    if (!MlasSgemmTryMultithread(&WorkBlock, M, N, A, nullptr, C, ThreadPool)) {
+        MlasSgemmPackedOperation(TransA, M, 0, N, K, alpha, A, lda,
+            WorkBlock.PackedB, PackedCountN, beta, C, ldc);
+    }
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) that share the same dimensions and transpose
+    operations.
+
+    The batch is distributed across the available threads first, and any
+    remaining threads are used to segment the individual operations.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies an array of BatchSize elements describing the matrices
+        and scalar multipliers for each operation of the batch.
+
+    BatchSize - Supplies the number of operations in the batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the batch
+    // of SGEMM operations. Small requests should run using the single threaded
+    // path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
+
+    int32_t TargetThreadCount;
+
+    const int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY) * double(MaximumThreadCount)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount == 1) {
+
+        for (size_t BatchIndex = 0; BatchIndex < BatchSize; BatchIndex++) {
+
+            const MLAS_SGEMM_DATA_PARAMS* Params = &Data[BatchIndex];
+
+            MlasSgemmOperation(TransA, TransB, M, N, K, Params->alpha, Params->A,
+                Params->lda, Params->B, Params->ldb, Params->beta, Params->C,
+                Params->ldc);
+        }
+
+        return;
+    }
+
+    //
+    // Distribute the threads across the batch first and then use any
+    // remaining threads to segment each individual operation.
+    //
+
+    int32_t ThreadCountBatch;
+    int32_t ThreadCountGemm;
+
+    if (size_t(TargetThreadCount) >= BatchSize) {
+        ThreadCountBatch = int32_t(BatchSize);
+        ThreadCountGemm = TargetThreadCount / ThreadCountBatch;
+    } else {
+        ThreadCountBatch = TargetThreadCount;
+        ThreadCountGemm = 1;
+    }
+
+    MLAS_SGEMM_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.Data = Data;
+    WorkBlock.BatchSize = BatchSize;
+    WorkBlock.ThreadCountBatch = ThreadCountBatch;
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+            MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+        if (size_t(ThreadCountGemm) > BlockedN) {
+            ThreadCountGemm = int32_t(BlockedN);
+        }
+
+        WorkBlock.ThreadCountM = 1;
+        WorkBlock.ThreadCountN = ThreadCountGemm;
+
+    } else {
+
+        if (size_t(ThreadCountGemm) > M) {
+            ThreadCountGemm = int32_t(M);
+        }
+
+        WorkBlock.ThreadCountM = ThreadCountGemm;
+        WorkBlock.ThreadCountN = 1;
+    }
+
+    MlasExecuteThreaded(MlasSgemmBatchThreaded, &WorkBlock,
+        ThreadCountBatch * ThreadCountGemm, ThreadPool);
+}
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    //
+    // Columns of matrix B are padded to a multiple of the kernel block width
+    // so that any thread segment of the N dimension starts on a block.
+    //
+
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    return AlignedN * K * sizeof(float);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the destination buffer. The
+    destination buffer should be sized based on MlasGemmPackBSize(). For best
+    performance, the destination buffer should be aligned to the value returned
+    from MlasGetPreferredBufferAlignment().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension. Each slice is
+    // packed using the same panel format as the local buffer used by
+    // MlasSgemmOperation, so the kernels can consume the panels directly.
+    //
+
+    float* D = (float*)PackedB;
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_SGEMM_PACKED_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        if (TransB == CblasNoTrans) {
+            MlasSgemmCopyPackB(D, B + k * ldb, ldb, N, CountK);
+        } else {
+            MlasSgemmTransposePackB(D, B + k, ldb, N, CountK);
+        }
+
+        D += AlignedN * CountK;
+    }
+}
@@ -0,0 +1,333 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements the matrix transpose routines.
+
+    The routines transpose the matrix in register blocks (4x4 for 32-bit
+    elements and 8x8 for 8-bit elements) using the vector shuffle instructions
+    of the base instruction set. The caller is responsible for tiling larger
+    matrices so that the source and destination stay resident in the cache.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+void
+MlasTranspose4x4Block(
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 4x4 block of 32-bit elements.
+
+Arguments:
+
+    Input - Supplies the address of the source block.
+
+    ldInput - Supplies the number of elements per row of the source matrix.
+
+    Output - Supplies the address of the destination block.
+
+    ldOutput - Supplies the number of elements per row of the destination
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 1]);
+    __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 2]);
+    __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 3]);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi32(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi32(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+
+    _mm_storeu_si128((__m128i*)&Output[ldOutput * 0], _mm_unpacklo_epi64(b0, b2));
+    _mm_storeu_si128((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(b0, b2));
+    _mm_storeu_si128((__m128i*)&Output[ldOutput * 2], _mm_unpacklo_epi64(b1, b3));
+    _mm_storeu_si128((__m128i*)&Output[ldOutput * 3], _mm_unpackhi_epi64(b1, b3));
+#elif defined(MLAS_NEON_INTRINSICS)
+    uint32x4_t a0 = vld1q_u32(&Input[ldInput * 0]);
+    uint32x4_t a1 = vld1q_u32(&Input[ldInput * 1]);
+    uint32x4_t a2 = vld1q_u32(&Input[ldInput * 2]);
+    uint32x4_t a3 = vld1q_u32(&Input[ldInput * 3]);
+
+    uint32x4x2_t z0 = vzipq_u32(a0, a2);
+    uint32x4x2_t z1 = vzipq_u32(a1, a3);
+    uint32x4x2_t o0 = vzipq_u32(z0.val[0], z1.val[0]);
+    uint32x4x2_t o1 = vzipq_u32(z0.val[1], z1.val[1]);
+
+    vst1q_u32(&Output[ldOutput * 0], o0.val[0]);
+    vst1q_u32(&Output[ldOutput * 1], o0.val[1]);
+    vst1q_u32(&Output[ldOutput * 2], o1.val[0]);
+    vst1q_u32(&Output[ldOutput * 3], o1.val[1]);
+#else
+    for (size_t n = 0; n < 4; n++) {
+        for (size_t m = 0; m < 4; m++) {
+            Output[ldOutput * n + m] = Input[ldInput * m + n];
+        }
+    }
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasTranspose8x8Block(
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes an 8x8 block of 8-bit elements.
+
+Arguments:
+
+    Input - Supplies the address of the source block.
+
+    ldInput - Supplies the number of elements per row of the source matrix.
+
+    Output - Supplies the address of the destination block.
+
+    ldOutput - Supplies the number of elements per row of the destination
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    __m128i a0 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 0]);
+    __m128i a1 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 1]);
+    __m128i a2 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 2]);
+    __m128i a3 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 3]);
+    __m128i a4 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 4]);
+    __m128i a5 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 5]);
+    __m128i a6 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 6]);
+    __m128i a7 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 7]);
+
+    __m128i b0 = _mm_unpacklo_epi8(a0, a1);
+    __m128i b1 = _mm_unpacklo_epi8(a2, a3);
+    __m128i b2 = _mm_unpacklo_epi8(a4, a5);
+    __m128i b3 = _mm_unpacklo_epi8(a6, a7);
+
+    __m128i c0 = _mm_unpacklo_epi16(b0, b1);
+    __m128i c1 = _mm_unpackhi_epi16(b0, b1);
+    __m128i c2 = _mm_unpacklo_epi16(b2, b3);
+    __m128i c3 = _mm_unpackhi_epi16(b2, b3);
+
+    __m128i d0 = _mm_unpacklo_epi32(c0, c2);
+    __m128i d1 = _mm_unpackhi_epi32(c0, c2);
+    __m128i d2 = _mm_unpacklo_epi32(c1, c3);
+    __m128i d3 = _mm_unpackhi_epi32(c1, c3);
+
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 0], d0);
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(d0, d0));
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 2], d1);
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 3], _mm_unpackhi_epi64(d1, d1));
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 4], d2);
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 5], _mm_unpackhi_epi64(d2, d2));
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 6], d3);
+    _mm_storel_epi64((__m128i*)&Output[ldOutput * 7], _mm_unpackhi_epi64(d3, d3));
+#elif defined(MLAS_NEON_INTRINSICS)
+    uint8x8x2_t b0 = vtrn_u8(vld1_u8(&Input[ldInput * 0]), vld1_u8(&Input[ldInput * 1]));
+    uint8x8x2_t b1 = vtrn_u8(vld1_u8(&Input[ldInput * 2]), vld1_u8(&Input[ldInput * 3]));
+    uint8x8x2_t b2 = vtrn_u8(vld1_u8(&Input[ldInput * 4]), vld1_u8(&Input[ldInput * 5]));
+    uint8x8x2_t b3 = vtrn_u8(vld1_u8(&Input[ldInput * 6]), vld1_u8(&Input[ldInput * 7]));
+
+    uint16x4x2_t c0 = vtrn_u16(vreinterpret_u16_u8(b0.val[0]), vreinterpret_u16_u8(b1.val[0]));
+    uint16x4x2_t c1 = vtrn_u16(vreinterpret_u16_u8(b0.val[1]), vreinterpret_u16_u8(b1.val[1]));
+    uint16x4x2_t c2 = vtrn_u16(vreinterpret_u16_u8(b2.val[0]), vreinterpret_u16_u8(b3.val[0]));
+    uint16x4x2_t c3 = vtrn_u16(vreinterpret_u16_u8(b2.val[1]), vreinterpret_u16_u8(b3.val[1]));
+
+    uint32x2x2_t d0 = vtrn_u32(vreinterpret_u32_u16(c0.val[0]), vreinterpret_u32_u16(c2.val[0]));
+    uint32x2x2_t d1 = vtrn_u32(vreinterpret_u32_u16(c1.val[0]), vreinterpret_u32_u16(c3.val[0]));
+    uint32x2x2_t d2 = vtrn_u32(vreinterpret_u32_u16(c0.val[1]), vreinterpret_u32_u16(c2.val[1]));
+    uint32x2x2_t d3 = vtrn_u32(vreinterpret_u32_u16(c1.val[1]), vreinterpret_u32_u16(c3.val[1]));
+
+    vst1_u8(&Output[ldOutput * 0], vreinterpret_u8_u32(d0.val[0]));
+    vst1_u8(&Output[ldOutput * 1], vreinterpret_u8_u32(d1.val[0]));
+    vst1_u8(&Output[ldOutput * 2], vreinterpret_u8_u32(d2.val[0]));
+    vst1_u8(&Output[ldOutput * 3], vreinterpret_u8_u32(d3.val[0]));
+    vst1_u8(&Output[ldOutput * 4], vreinterpret_u8_u32(d0.val[1]));
+    vst1_u8(&Output[ldOutput * 5], vreinterpret_u8_u32(d1.val[1]));
+    vst1_u8(&Output[ldOutput * 6], vreinterpret_u8_u32(d2.val[1]));
+    vst1_u8(&Output[ldOutput * 7], vreinterpret_u8_u32(d3.val[1]));
+#else
+    for (size_t n = 0; n < 8; n++) {
+        for (size_t m = 0; m < 8; m++) {
+            Output[ldOutput * n + m] = Input[ldInput * m + n];
+        }
+    }
+#endif
+}
+
+template<typename ElementType, size_t BlockSize, void (*TransposeBlock)(const ElementType*, size_t, ElementType*, size_t)>
+void
+MlasTransposeBlocked(
+    size_t M,
+    size_t N,
+    const ElementType* Input,
+    size_t ldInput,
+    ElementType* Output,
+    size_t ldOutput
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a matrix using the supplied register block kernel
+    and handles the partial blocks at the matrix edges with scalar copies.
+
+Arguments:
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    Input - Supplies the address of the source matrix.
+
+    ldInput - Supplies the number of elements per row of the source matrix.
+
+    Output - Supplies the address of the destination matrix.
+
+    ldOutput - Supplies the number of elements per row of the destination
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t m = 0;
+
+    for (; m + BlockSize <= M; m += BlockSize) {
+
+        size_t n = 0;
+
+        for (; n + BlockSize <= N; n += BlockSize) {
+            TransposeBlock(&Input[ldInput * m + n], ldInput, &Output[ldOutput * n + m], ldOutput);
+        }
+
+        for (; n < N; n++) {
+            for (size_t mm = m; mm < m + BlockSize; mm++) {
+                Output[ldOutput * n + mm] = Input[ldInput * mm + n];
+            }
+        }
+    }
+
+    for (; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+            Output[ldOutput * n + m] = Input[ldInput * m + n];
+        }
+    }
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a matrix of 32-bit elements.
+
+Arguments:
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    Input - Supplies the address of the source matrix.
+
+    ldInput - Supplies the number of elements per row of the source matrix.
+
+    Output - Supplies the address of the destination matrix, which has N rows
+        and M columns.
+
+    ldOutput - Supplies the number of elements per row of the destination
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeBlocked<uint32_t, 4, MlasTranspose4x4Block>(M, N, Input, ldInput, Output, ldOutput);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a matrix of 8-bit elements.
+
+Arguments:
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    Input - Supplies the address of the source matrix.
+
+    ldInput - Supplies the number of elements per row of the source matrix.
+
+    Output - Supplies the address of the destination matrix, which has N rows
+        and M columns.
+
+    ldOutput - Supplies the number of elements per row of the destination
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeBlocked<uint8_t, 8, MlasTranspose8x8Block>(M, N, Input, ldInput, Output, ldOutput);
+}
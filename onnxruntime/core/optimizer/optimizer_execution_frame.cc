@@ -70,7 +70,7 @@ OptimizerExecutionFrame::Info::Info(const std::vector<const Node*>& nodes,
     std::shared_ptr<KernelRegistry> kernel_registry = cpu_execution_provider_->GetKernelRegistry();
     ORT_THROW_IF_ERROR(kernel_registry->TryCreateKernel(*node, *cpu_execution_provider_, initializers_,
                                                         ort_value_name_idx_map_, FuncManager(), data_transfer_mgr_,
-                                                        op_kernel));
+                                                        nullptr, op_kernel));
     kernels_[node->Index()] = std::move(op_kernel);
   }
 }
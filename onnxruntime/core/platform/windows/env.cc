@@ -98,6 +98,13 @@ class WindowsThread : public EnvThread {
   wil::unique_handle hThread;
 };
 
+static void UnmapFile(void* param) noexcept {
+  if (!UnmapViewOfFile(param)) {
+    const int err = GetLastError();
+    LOGS_DEFAULT(ERROR) << "UnmapViewOfFile failed. error code: " << err;
+  }
+}
+
 class WindowsEnv : public Env {
  public:
   EnvThread* CreateThread(_In_opt_z_ const ORTCHAR_T* name_prefix, int index,
@@ -212,8 +219,53 @@ class WindowsEnv : public Env {
     return Status::OK();
   }
 
-  Status MapFileIntoMemory(_In_z_ const ORTCHAR_T*, FileOffsetType, size_t, MappedMemoryPtr&) const override {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MapFileIntoMemory is not implemented on Windows.");
+  Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
+                           MappedMemoryPtr& mapped_memory) const override {
+    ORT_RETURN_IF_NOT(file_path);
+    ORT_RETURN_IF_NOT(offset >= 0);
+
+    wil::unique_hfile file_handle{
+        CreateFileW(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)};
+    if (file_handle.get() == INVALID_HANDLE_VALUE) {
+      const int err = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "open file ", ToMBString(file_path), " fail, errcode = ", err);
+    }
+
+    if (length == 0) {
+      mapped_memory = MappedMemoryPtr{};
+      return Status::OK();
+    }
+
+    // the view must start at a multiple of the allocation granularity
+    static const DWORD allocation_granularity = [] {
+      SYSTEM_INFO sys_info;
+      GetSystemInfo(&sys_info);
+      return sys_info.dwAllocationGranularity;
+    }();
+    const FileOffsetType offset_to_granularity = offset % static_cast<FileOffsetType>(allocation_granularity);
+    const size_t mapped_length = length + static_cast<size_t>(offset_to_granularity);
+    const uint64_t mapped_offset = static_cast<uint64_t>(offset - offset_to_granularity);
+
+    // a copy-on-write mapping of the whole file. the view keeps the mapping alive after its handle is closed.
+    wil::unique_handle file_mapping{CreateFileMappingW(file_handle.get(), NULL, PAGE_WRITECOPY, 0, 0, NULL)};
+    if (!file_mapping) {
+      const int err = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CreateFileMappingW ", ToMBString(file_path), " fail, errcode = ", err);
+    }
+
+    void* const mapped_base = MapViewOfFile(file_mapping.get(), FILE_MAP_COPY,
+                                            static_cast<DWORD>(mapped_offset >> 32),
+                                            static_cast<DWORD>(mapped_offset & 0xFFFFFFFF), mapped_length);
+    if (mapped_base == nullptr) {
+      const int err = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "MapViewOfFile ", ToMBString(file_path), " fail, errcode = ", err);
+    }
+
+    mapped_memory =
+        MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_granularity,
+                        OrtCallbackInvoker{OrtCallback{UnmapFile, mapped_base}}};
+
+    return Status::OK();
   }
 
   common::Status FileOpenRd(const std::wstring& path, /*out*/ int& fd) const override {
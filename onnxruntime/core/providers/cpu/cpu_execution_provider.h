@@ -12,6 +12,9 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // maximum number of bytes held by the arena, 0 for no limit
+  size_t arena_max_mem{0};
+  ArenaExtendStrategy arena_extend_strategy{ArenaExtendStrategy::kNextPowerOfTwo};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -29,7 +32,9 @@ class CPUExecutionProvider : public IExecutionProvider {
       : IExecutionProvider{onnxruntime::kCpuExecutionProvider} {
     DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
                                                 [](int) { return onnxruntime::make_unique<TAllocator>(); },
-                                                std::numeric_limits<size_t>::max()};
+                                                info.arena_max_mem != 0 ? info.arena_max_mem
+                                                                        : std::numeric_limits<size_t>::max(),
+                                                info.arena_extend_strategy};
 
 #ifdef USE_JEMALLOC
 #if defined(USE_MIMALLOC_ARENA_ALLOCATOR) || defined(USE_MIMALLOC_STL_ALLOCATOR)
@@ -10,22 +10,26 @@
 namespace onnxruntime {
 
 struct CpuProviderFactory : IExecutionProviderFactory {
-  CpuProviderFactory(bool create_arena) : create_arena_(create_arena) {}
+  CpuProviderFactory(const CPUExecutionProviderInfo& info) : info_(info) {}
   ~CpuProviderFactory() override = default;
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
 
  private:
-  bool create_arena_;
+  CPUExecutionProviderInfo info_;
 };
 
 std::unique_ptr<IExecutionProvider> CpuProviderFactory::CreateProvider() {
-  CPUExecutionProviderInfo info;
-  info.create_arena = create_arena_;
-  return onnxruntime::make_unique<CPUExecutionProvider>(info);
+  return onnxruntime::make_unique<CPUExecutionProvider>(info_);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena) {
-  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0);
+  CPUExecutionProviderInfo info;
+  info.create_arena = use_arena != 0;
+  return std::make_shared<onnxruntime::CpuProviderFactory>(info);
+}
+
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(const CPUExecutionProviderInfo& info) {
+  return std::make_shared<onnxruntime::CpuProviderFactory>(info);
 }
 
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -343,6 +344,18 @@ struct BroadcastIterator {
     return index;
   }
 
+  // Returns the input index for an arbitrary output offset without changing the iterator state.
+  // Each counter level after the first advances once per product of the lower counts.
+  ptrdiff_t IndexAt(ptrdiff_t offset) const {
+    ptrdiff_t index = deltas_[0] * offset;
+    ptrdiff_t period = 1;
+    for (size_t counterIndex = 1; counterIndex < deltas_.size(); counterIndex++) {
+      period *= counts_[counterIndex - 1];
+      index += deltas_[counterIndex] * (offset / period);
+    }
+    return index;
+  }
+
   void Reserve(int64_t max_dims) {
     deltas_.reserve(static_cast<size_t>(max_dims));
     counts_.reserve(static_cast<size_t>(max_dims));
@@ -522,6 +535,10 @@ struct TBroadcaster {
   ConstEigenVectorMap<T0> NextEigen0() { return ConstEigenVectorMap<T0>(Next0(), span_size_); }
   ConstEigenVectorMap<T1> NextEigen1() { return ConstEigenVectorMap<T1>(Next1(), span_size_); }
 
+  // Random access to the inputs for a given output offset, used when the loop is split across threads.
+  const T0* Input0At(ptrdiff_t offset) const { return input0_ + broadcaster_.iterator1_.IndexAt(offset); }
+  const T1* Input1At(ptrdiff_t offset) const { return input1_ + broadcaster_.iterator2_.IndexAt(offset); }
+
  private:
   const T0* Next0() { return input0_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
   const T1* Next1() { return input1_ + broadcaster_.iterator2_.AdvanceBy(span_size_); }
@@ -623,11 +640,57 @@ void BroadcastLoopSpan(TBroadcaster& bc, Output& output, Input0Scalar input0scal
   }
 }
 
+// Largest number of output elements handed to a single function call by ParallelBroadcastLoop. Spans
+// longer than this are split so that same-shaped inputs, which form a single span, still run in parallel.
+constexpr std::ptrdiff_t kParallelBroadcastPieceSize = 16384;
+
+// Same as BroadcastLoop, but the output is divided into pieces that are processed on the thread pool.
+// A piece never crosses a span boundary, so it maps to either a contiguous run or a single scalar of
+// each input. The functions are in the same form as for BroadcastLoop and may be called concurrently.
+template <typename TOutput, typename TInput0, typename TInput1, typename Input0Scalar, typename Input1Scalar, typename General>
+void ParallelBroadcastLoop(const TBroadcaster<TInput0, TInput1>& bc, Tensor& output_tensor, concurrency::ThreadPool* tp,
+                           Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  const std::ptrdiff_t output_size = output_tensor.Shape().Size();
+  if (output_size == 0) {
+    return;
+  }
+
+  TOutput* output = output_tensor.template MutableData<TOutput>();
+  const std::ptrdiff_t span_size = static_cast<std::ptrdiff_t>(bc.GetSpanSize());
+  const std::ptrdiff_t piece_size = std::min(span_size, kParallelBroadcastPieceSize);
+  const std::ptrdiff_t pieces_per_span = (span_size + piece_size - 1) / piece_size;
+  const std::ptrdiff_t pieces = (output_size / span_size) * pieces_per_span;
+  const bool input0_scalar = bc.IsInput0Scalar();
+  const bool input1_scalar = bc.IsInput1Scalar();
+
+  const TensorOpCost cost{static_cast<double>(piece_size * (sizeof(TInput0) + sizeof(TInput1))),
+                          static_cast<double>(piece_size * sizeof(TOutput)),
+                          static_cast<double>(piece_size)};
+
+  concurrency::ThreadPool::TryParallelFor(tp, pieces, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t piece = first; piece < last; piece++) {
+      const std::ptrdiff_t span_offset = (piece / pieces_per_span) * span_size;
+      const std::ptrdiff_t offset = span_offset + (piece % pieces_per_span) * piece_size;
+      const std::ptrdiff_t count = std::min(piece_size, span_offset + span_size - offset);
+
+      EigenVectorMap<TOutput> output_map(output + offset, count);
+      if (input0_scalar) {
+        input0scalar(output_map, *bc.Input0At(offset), ConstEigenVectorMap<TInput1>(bc.Input1At(offset), count));
+      } else if (input1_scalar) {
+        input1scalar(output_map, ConstEigenVectorMap<TInput0>(bc.Input0At(offset), count), *bc.Input1At(offset));
+      } else {
+        general(output_map, ConstEigenVectorMap<TInput0>(bc.Input0At(offset), count),
+                ConstEigenVectorMap<TInput1>(bc.Input1At(offset), count));
+      }
+    }
+  });
+}
+
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
 Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
   TBroadcaster<TInput, TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
-  TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
-  BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+  Tensor& output = *context.Output(0, bc.GetOutputShape());
+  ParallelBroadcastLoop<TOutput>(bc, output, context.GetOperatorThreadPool(), input0scalar, input1scalar, general);
 
   return Status::OK();
 }
@@ -664,9 +727,7 @@ Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scala
       p_output = tempOutput.get();
     }
 
-    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *p_output);
-
-    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    ParallelBroadcastLoop<TOutput>(bc, *p_output, context.GetOperatorThreadPool(), input0scalar, input1scalar, general);
 
     tempInput = std::move(tempOutput);
   }
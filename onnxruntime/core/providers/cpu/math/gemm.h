@@ -7,7 +7,9 @@
 #include "core/framework/op_kernel.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 #include "gemm_helper.h"
+#include "gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -24,6 +26,11 @@ class Gemm : public OpKernel {
 
     ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+    const Tensor* B;
+    if (std::is_same<T, float>::value && info.TryGetConstantInput(1, &B)) {
+      GemmPackBFp32(info, *B, trans_B_ != CblasNoTrans, packed_b_);
+    }
   }
 
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
@@ -38,7 +45,24 @@ class Gemm : public OpKernel {
     if (M == 0 || N == 0)
       return;
 
-    // Broadcast the bias as needed if bias is given
+    ComputeBias(M, N, beta, c_data, c_shape, y_data);
+
+    math::Gemm<T>(trans_a, trans_b,
+                  M, N, K,
+                  alpha,
+                  a_data,
+                  b_data,
+                  // ideally we need to set the output buffer contents to 0 if bias is missing,
+                  // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
+                  c_data != nullptr ? beta : 0,
+                  y_data,
+                  thread_pool);
+  }
+
+  // Broadcast the bias into the output buffer as needed if bias is given
+  static void ComputeBias(int64_t M, int64_t N, float beta,
+                          const T* c_data, const TensorShape* c_shape,
+                          T* y_data) {
     if (beta != 0 && c_data != nullptr) {
       ORT_ENFORCE(c_shape != nullptr, "c_shape is required if c_data is provided");
       auto output_mat = EigenMatrixMapRowMajor<T>(y_data, M, N);
@@ -56,17 +80,6 @@ class Gemm : public OpKernel {
         output_mat = ConstEigenMatrixMapRowMajor<T>(c_data, M, N);
       }
     }
-
-    math::Gemm<T>(trans_a, trans_b,
-                  M, N, K,
-                  alpha,
-                  a_data,
-                  b_data,
-                  // ideally we need to set the output buffer contents to 0 if bias is missing,
-                  // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
-                  c_data != nullptr ? beta : 0,
-                  y_data,
-                  thread_pool);
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -97,10 +110,27 @@ class Gemm : public OpKernel {
 
     T* y_data = Y->MutableData<T>();
 
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, X->Data<T>(), W->Data<T>(), beta_,
-                b_data, b_shape,
-                y_data,
-                thread_pool);
+    if (packed_b_) {
+      ComputeBias(M, N, beta_, b_data, b_shape, y_data);
+
+      MlasGemm(trans_A_,
+               static_cast<size_t>(M),
+               static_cast<size_t>(N),
+               static_cast<size_t>(K),
+               alpha_,
+               X->Data<T>(),
+               static_cast<size_t>(trans_A_ == CblasNoTrans ? K : M),
+               packed_b_.get(),
+               b_data != nullptr ? beta_ : 0,
+               y_data,
+               static_cast<size_t>(N),
+               thread_pool);
+    } else {
+      ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, X->Data<T>(), W->Data<T>(), beta_,
+                  b_data, b_shape,
+                  y_data,
+                  thread_pool);
+    }
 
     FuseActivation<T>(activation_, y_data, M * N, leaky_relu_alpha_);
 
@@ -113,6 +143,9 @@ class Gemm : public OpKernel {
   float alpha_;
   float beta_;
 
+  // B packed into the MLAS SGEMM panel layout when it is a constant initializer
+  BufferUniquePtr packed_b_;
+
  protected:
   // For fused gemm + activation
   std::string activation_;
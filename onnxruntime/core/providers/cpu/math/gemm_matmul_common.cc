@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/framework/shared_weights.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/util/qmath.h"
+
+namespace onnxruntime {
+
+#if !defined(USE_MKLML_FOR_BLAS) || defined(MLAS_SUPPORTS_GEMM_U8X8)
+// Packs tensor_b with pack into a buffer of packed_b_size bytes. When tensor_b is an initializer shared through the
+// environment, it's packed once for all the sessions using it and packed_b references the shared buffer.
+static void PackB(const OpKernelInfo& info,
+                  const Tensor& tensor_b,
+                  const std::string& kind,
+                  size_t packed_b_size,
+                  const std::function<void(void*)>& pack,
+                  BufferUniquePtr& packed_b) {
+  SharedWeights* shared_weights = info.GetSharedWeights();
+  if (shared_weights != nullptr) {
+    const void* shared_packed_b = shared_weights->GetOrPackInitializer(tensor_b, kind, packed_b_size, pack);
+    if (shared_packed_b != nullptr) {
+      // owned by shared_weights, which outlives the kernel
+      packed_b = BufferUniquePtr(const_cast<void*>(shared_packed_b), BufferDeleter());
+      return;
+    }
+  }
+
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  pack(packed_b_data);
+}
+#endif
+
+bool GemmPackBFp32(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b) {
+#if defined(USE_MKLML_FOR_BLAS)
+  // math::Gemm dispatches to the external BLAS library, so keep using it for consistency.
+  ORT_UNUSED_PARAMETER(info);
+  ORT_UNUSED_PARAMETER(tensor_b);
+  ORT_UNUSED_PARAMETER(trans_b);
+  ORT_UNUSED_PARAMETER(packed_b);
+  return false;
+#else
+  // Only handle the common case of a 2D weight tensor.
+  if (tensor_b.Shape().NumDimensions() != 2 || !tensor_b.IsDataType<float>()) {
+    return false;
+  }
+
+  const auto& b_shape = tensor_b.Shape();
+  const size_t K = static_cast<size_t>(trans_b ? b_shape[1] : b_shape[0]);
+  const size_t N = static_cast<size_t>(trans_b ? b_shape[0] : b_shape[1]);
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  const std::string kind = "MlasGemmPackB:float:" + std::to_string(trans_b) + ":" + std::to_string(K) + "x" +
+                           std::to_string(N);
+  auto pack = [&](void* packed_b_data) {
+    MlasGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                  N,
+                  K,
+                  tensor_b.Data<float>(),
+                  trans_b ? K : N,
+                  packed_b_data);
+  };
+  PackB(info, tensor_b, kind, packed_b_size, pack, packed_b);
+  return true;
+#endif
+}
+
+bool GemmPackBU8X8(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   BufferUniquePtr& packed_b) {
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  if (tensor_b.Shape().NumDimensions() != 2 ||
+      !(tensor_b.IsDataType<uint8_t>() || tensor_b.IsDataType<int8_t>())) {
+    return false;
+  }
+
+  const auto& b_shape = tensor_b.Shape();
+  const size_t K = static_cast<size_t>(b_shape[0]);
+  const size_t N = static_cast<size_t>(b_shape[1]);
+  const bool b_is_signed = tensor_b.IsDataType<int8_t>();
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K, b_is_signed);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  const std::string kind = "MlasGemmPackB:" + std::string(b_is_signed ? "int8:" : "uint8:") + std::to_string(K) +
+                           "x" + std::to_string(N);
+  auto pack = [&](void* packed_b_data) {
+    MlasGemmPackB(N,
+                  K,
+                  static_cast<const uint8_t*>(tensor_b.DataRaw()),
+                  N,
+                  b_is_signed,
+                  packed_b_data);
+  };
+  PackB(info, tensor_b, kind, packed_b_size, pack, packed_b);
+  return true;
+#else
+  ORT_UNUSED_PARAMETER(info);
+  ORT_UNUSED_PARAMETER(tensor_b);
+  ORT_UNUSED_PARAMETER(packed_b);
+  return false;
+#endif
+}
+
+}  // namespace onnxruntime
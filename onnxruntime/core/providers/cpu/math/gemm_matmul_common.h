@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+
+// Packs a constant 2D B matrix into the MLAS SGEMM panel layout once, when the Gemm/MatMul kernel
+// is created, so that each Compute can skip repacking B. As only a 2D B is packed, every slice of
+// a batched MatMul shares the same packed B. Returns false if the tensor is not eligible for
+// packing. On success, packed_b holds the packed buffer.
+bool GemmPackBFp32(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b);
+
+// Packs a constant 2D uint8/int8 B matrix into the MLAS quantized GEMM panel layout once, when the
+// MatMulInteger/QLinearMatMul kernel is created, so that each Compute can skip repacking B and every
+// slice of a batched MatMul shares it. Returns false if the tensor is not eligible for packing or the
+// platform has no MLAS quantized GEMM kernels. On success, packed_b holds the packed buffer.
+bool GemmPackBU8X8(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   BufferUniquePtr& packed_b);
+
+}  // namespace onnxruntime
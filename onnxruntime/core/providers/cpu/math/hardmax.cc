@@ -5,6 +5,9 @@
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/math.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -18,7 +21,7 @@ Status Hardmax<float>::Compute(OpKernelContext* ctx) const {
   size_t tmpN = input_shape.SizeToDimension(axis);
   size_t tmpD = input_shape.SizeFromDimension(axis);
 
-  // Math::RowwiseMax expects int N and D.
+  // The row loop below indexes with int N and D.
   if (tmpN * tmpD > INT32_MAX || tmpN > INT32_MAX || tmpD > INT32_MAX) {
     std::ostringstream ss;
     ss << "Hardmax inputs N, D and N * D must be < " << INT32_MAX << ". N=" << tmpN << ", D=" << tmpD;
@@ -30,23 +33,26 @@ Status Hardmax<float>::Compute(OpKernelContext* ctx) const {
   const int N = gsl::narrow_cast<int>(tmpN);
   const int D = gsl::narrow_cast<int>(tmpD);
 
-  std::vector<float> rowmax_(N);
-  float* rowmax_data = rowmax_.data();
-  math::RowwiseMax<float, CPUMathUtil>(N, D, Xdata, rowmax_data, nullptr);
-
   Tensor* Y = ctx->Output(0, input_shape);
   auto* Ydata = Y->template MutableData<float>();
   math::Set<float, CPUMathUtil>(input_shape.Size(), 0.f, Ydata, &CPUMathUtil::Instance());
 
-  for (int i = 0; i < N; ++i) {
-    for (int j = 0; j < D; ++j) {
-      if (Xdata[i * D + j] == rowmax_data[i]) {
-        Ydata[i * D + j] = 1;
-        break;
-      }
-    }
+  // An empty row has no maximum to set
+  if (N == 0 || D == 0) {
+    return Status::OK();
   }
 
+  // Each row is independent: find the first occurrence of the row maximum and set it to 1.
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), N, static_cast<double>(D),
+      [Xdata, Ydata, D](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const float* x = Xdata + i * D;
+          const float* rowmax = std::max_element(x, x + D);
+          Ydata[i * D + (rowmax - x)] = 1;
+        }
+      });
+
   return Status::OK();
 }
 
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "matmul_helper.h"
@@ -92,4 +93,68 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+Status MatMul<float>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* left_X = ctx->Input<Tensor>(0);
+  const auto* right_X = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (Y->Shape().Size() == 0)
+    return Status::OK();
+
+  const float* a_data = left_X->Data<float>();
+  const float* b_data = right_X->Data<float>();
+  float* y_data = Y->MutableData<float>();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  const size_t max_len = helper.OutputOffsets().size();
+
+#if defined(USE_MKLML_FOR_BLAS)
+  // math::MatMul dispatches to the external BLAS library, which B isn't packed for
+  for (size_t i = 0; i < max_len; i++) {
+    math::MatMul<float>(static_cast<int>(M), static_cast<int>(N), static_cast<int>(K),
+                        a_data + helper.LeftOffsets()[i],
+                        b_data + helper.RightOffsets()[i],
+                        y_data + helper.OutputOffsets()[i], thread_pool);
+  }
+#else
+  if (packed_b_) {
+    for (size_t i = 0; i < max_len; i++) {
+      MlasGemm(CblasNoTrans, M, N, K, 1.f,
+               a_data + helper.LeftOffsets()[i], K,
+               packed_b_.get(), 0.f,
+               y_data + helper.OutputOffsets()[i], N,
+               thread_pool);
+    }
+    return Status::OK();
+  }
+
+  // Issue the broadcasted slices as a single batch so that the threads are
+  // distributed across the batch instead of only within each small GEMM.
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+    data[i].alpha = 1.f;
+    data[i].beta = 0.f;
+  }
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, data.data(), max_len, thread_pool);
+#endif
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -18,4 +19,22 @@ class MatMul final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
+template <>
+class MatMul<float> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info)
+      : OpKernel(info) {
+    const Tensor* B;
+    if (info.TryGetConstantInput(1, &B)) {
+      GemmPackBFp32(info, *B, false, packed_b_);
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // B packed into the MLAS SGEMM panel layout when it is a 2D constant initializer
+  BufferUniquePtr packed_b_;
+};
+
 }  // namespace onnxruntime
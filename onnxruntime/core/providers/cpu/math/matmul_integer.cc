@@ -6,6 +6,7 @@
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/util/qmath.h"
 #include "core/providers/common.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -34,16 +35,87 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger<uint8_t, int8_t>);
 
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+// Computes MatMulInteger with MLAS, which supports a scalar zero point for A and either a scalar
+// or per column (1D of size N) zero point for B with both uint8_t and int8_t B. packed_b is the
+// prepacked constant B or nullptr.
+template <typename T2>
+static Status ComputeMatMulIntegerMlas(OpKernelContext* ctx,
+                                       const MatMulComputeHelper& helper,
+                                       const void* packed_b,
+                                       bool has_a_zero_point,
+                                       bool has_b_zero_point) {
+  const auto* a = ctx->Input<Tensor>(0);
+  const auto* b = ctx->Input<Tensor>(1);
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  uint8_t a_offset = 0;
+  if (has_a_zero_point) {
+    auto a_zero_point = ctx->Input<Tensor>(2);
+    ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point),
+                "MatmulInteger : input1 zero point must be a scalar or 1D tensor of size 1");
+    a_offset = *a_zero_point->template Data<uint8_t>();
+  }
+
+  uint8_t b_offset = 0;
+  const uint8_t* b_offset_per_column = nullptr;
+  if (has_b_zero_point) {
+    auto b_zero_point = ctx->Input<Tensor>(3);
+    if (IsScalarOr1ElementVector(b_zero_point)) {
+      b_offset = static_cast<uint8_t>(*b_zero_point->template Data<T2>());
+    } else {
+      ORT_ENFORCE(b_zero_point->Shape().NumDimensions() == 1 &&
+                      static_cast<size_t>(b_zero_point->Shape()[0]) == N,
+                  "MatmulInteger : input2 zero point must be a scalar or 1D tensor of size 1 or N");
+      b_offset_per_column = reinterpret_cast<const uint8_t*>(b_zero_point->template Data<T2>());
+    }
+  }
+
+  const auto* a_data = a->template Data<uint8_t>();
+  const auto* b_data = b->template Data<T2>();
+  auto* y_data = y->template MutableData<int32_t>();
+
+  const size_t batch_size = helper.OutputOffsets().size();
+  std::vector<MLAS_GEMM_U8X8_DATA_PARAMS> gemm_params(batch_size);
+  for (size_t i = 0; i < batch_size; i++) {
+    auto& params = gemm_params[i];
+    params.A = a_data + helper.LeftOffsets()[i];
+    params.lda = K;
+    if (packed_b != nullptr) {
+      params.B = packed_b;
+      params.BIsPacked = true;
+    } else {
+      params.B = b_data + helper.RightOffsets()[i];
+      params.ldb = N;
+    }
+    params.C = y_data + helper.OutputOffsets()[i];
+    params.ldc = N;
+    params.ZeroPointB = b_offset_per_column;
+  }
+
+  MlasGemmBatch(M, N, K, gemm_params.data(), batch_size, a_offset, b_offset,
+                std::is_signed<T2>::value, ctx->GetOperatorThreadPool());
+  return Status::OK();
+}
+#endif
+
 template <>
 Status MatMulInteger<uint8_t, uint8_t>::Compute(OpKernelContext* ctx) const {
-  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
-
   auto a = ctx->Input<Tensor>(0);
   auto b = ctx->Input<Tensor>(1);
   ORT_ENFORCE(a != nullptr && b != nullptr);
 
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  return ComputeMatMulIntegerMlas<uint8_t>(ctx, helper, packed_b_.get(), has_a_zero_point_, has_b_zero_point_);
+#else
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   // validate zero points
@@ -62,43 +134,44 @@ Status MatMulInteger<uint8_t, uint8_t>::Compute(OpKernelContext* ctx) const {
     b_offset = static_cast<int32_t>(*b_zero_point->template Data<uint8_t>());
   }
 
-  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-    QGemmu8u8_s32(static_cast<int>(helper.M()),
-                  static_cast<int>(helper.N()),
-                  static_cast<int>(helper.K()),
-                  a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                  static_cast<int>(helper.K()),
-                  a_offset,
-                  b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                  static_cast<int>(helper.N()),
-                  b_offset,
-                  y->template MutableData<int32_t>() + helper.OutputOffsets()[i],
-                  static_cast<int>(helper.N()),
-                  thread_pool);
-  }
+  QGemmBatchu8u8_s32(static_cast<int>(helper.M()),
+                     static_cast<int>(helper.N()),
+                     static_cast<int>(helper.K()),
+                     a->template Data<uint8_t>(),
+                     helper.LeftOffsets(),
+                     a_offset,
+                     b->template Data<uint8_t>(),
+                     helper.RightOffsets(),
+                     b_offset,
+                     y->template MutableData<int32_t>(),
+                     helper.OutputOffsets(),
+                     thread_pool);
   return Status::OK();
+#endif
 }
 
 template <>
 Status MatMulInteger<uint8_t, int8_t>::Compute(OpKernelContext* ctx) const {
-  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
-
   auto a = ctx->Input<Tensor>(0);
   auto b = ctx->Input<Tensor>(1);
   ORT_ENFORCE(a != nullptr && b != nullptr);
 
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  return ComputeMatMulIntegerMlas<int8_t>(ctx, helper, packed_b_.get(), has_a_zero_point_, has_b_zero_point_);
+#else
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   if (has_a_zero_point_ || has_b_zero_point_) {
-    // currently zero point is only supported in Gemmlowp path above
-    // in future, the selection of Eigen/Gemmlowp/mklml/etc. should be in a common math library like SGEMM
+    // without MLAS, the int8_t B path goes through Eigen which has no zero point support
 
     auto IsZeroPointTensorAllZero = [](OpKernelContext* ctx, int input_idx) -> bool {
       auto t = ctx->Input<Tensor>(input_idx);
       ORT_ENFORCE(t->Shape().NumDimensions() <= 1 && t->Shape().Size() == 1,
-                  "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
+                  "Currently only scalar zero_point is supported without MLAS.");
       ORT_ENFORCE(t->IsDataType<int8_t>() || t->IsDataType<uint8_t>());
       auto data = reinterpret_cast<const int8_t*>(t->DataRaw());
       auto vec = std::vector<int8_t>(data, data + t->Shape().Size());
@@ -111,20 +184,19 @@ Status MatMulInteger<uint8_t, int8_t>::Compute(OpKernelContext* ctx) const {
     }
   }
 
-  for (int i = 0; i < static_cast<int>(helper.OutputOffsets().size()); i++) {
-    QGemmu8s8_s32(static_cast<int>(helper.M()),
-                  static_cast<int>(helper.N()),
-                  static_cast<int>(helper.K()),
-                  a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                  static_cast<int>(helper.K()),
-                  0,
-                  b->template Data<int8_t>() + helper.RightOffsets()[i],
-                  static_cast<int>(helper.N()),
-                  0,
-                  y->template MutableData<int32_t>() + helper.OutputOffsets()[i],
-                  static_cast<int>(helper.N()),
-                  thread_pool);
-  }
+  QGemmBatchu8s8_s32(static_cast<int>(helper.M()),
+                     static_cast<int>(helper.N()),
+                     static_cast<int>(helper.K()),
+                     a->template Data<uint8_t>(),
+                     helper.LeftOffsets(),
+                     0,
+                     b->template Data<int8_t>(),
+                     helper.RightOffsets(),
+                     0,
+                     y->template MutableData<int32_t>(),
+                     helper.OutputOffsets(),
+                     thread_pool);
   return Status::OK();
+#endif
 }
 }  // namespace onnxruntime
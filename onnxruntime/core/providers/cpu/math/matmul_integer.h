@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -21,6 +22,11 @@ class MatMulInteger final : public OpKernel {
     if (info.GetInputCount() > 3) {
       has_b_zero_point_ = true;
     }
+
+    const Tensor* B;
+    if (info.TryGetConstantInput(1, &B)) {
+      GemmPackBU8X8(info, *B, packed_b_);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -28,5 +34,7 @@ class MatMulInteger final : public OpKernel {
  private:
   bool has_a_zero_point_;
   bool has_b_zero_point_;
+  // B packed into the MLAS quantized GEMM panel layout when it is a 2D constant initializer
+  BufferUniquePtr packed_b_;
 };
 }  // namespace onnxruntime
@@ -34,14 +34,32 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
   ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  // The weight scale and zero point are either scalars or have an element for
+  // each column of B. Per column values are only supported by the MLAS path.
+  auto IsScalarOrPerColumn = [N](const Tensor* t) {
+    return IsScalarOr1ElementVector(t) ||
+           (t->Shape().NumDimensions() == 1 && static_cast<size_t>(t->Shape()[0]) == N);
+  };
+#endif
+
   // validate offsets
   auto a_offset = ctx->Input<Tensor>(2);
   auto b_offset = ctx->Input<Tensor>(5);
   auto y_offset = ctx->Input<Tensor>(7);
   ORT_ENFORCE(IsScalarOr1ElementVector(a_offset),
               "QLinearMatmul : input zero point must be a scalar or 1D tensor of size 1");
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  ORT_ENFORCE(IsScalarOrPerColumn(b_offset),
+              "QLinearMatmul : weight zero point must be a scalar or 1D tensor of size 1 or N");
+#else
   ORT_ENFORCE(IsScalarOr1ElementVector(b_offset),
               "QLinearMatmul : weight zero point must be a scalar or 1D tensor of size 1");
+#endif
   ORT_ENFORCE(IsScalarOr1ElementVector(y_offset),
               "QLinearMatmul : result zero point must be a scalar or 1D tensor of size 1");
 
@@ -51,67 +69,95 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
   auto y_scale = ctx->Input<Tensor>(6);
   ORT_ENFORCE(IsScalarOr1ElementVector(a_scale),
               "QLinearMatmul : input scale must be a scalar or 1D tensor of size 1");
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  ORT_ENFORCE(IsScalarOrPerColumn(b_scale),
+              "QLinearMatmul : weight scale must be a scalar or 1D tensor of size 1 or N");
+#else
   ORT_ENFORCE(IsScalarOr1ElementVector(b_scale),
               "QLinearMatmul : weight scale must be a scalar or 1D tensor of size 1");
+#endif
   ORT_ENFORCE(IsScalarOr1ElementVector(y_scale),
               "QLinearMatmul : result scale must be a scalar or 1D tensor of size 1");
 
   auto a_scale_data = *(a_scale->template Data<float>());
-  auto b_scale_data = *(b_scale->template Data<float>());
   auto y_scale_data = *(y_scale->template Data<float>());
 
-  const float real_multiplier = (a_scale_data * b_scale_data) / y_scale_data;
-
 #ifdef MLAS_SUPPORTS_GEMM_U8X8
+  // Fold the scales into a single multiplier, or one multiplier per column of B.
+  const bool per_column_scale = !IsScalarOr1ElementVector(b_scale);
+  std::vector<float> real_multiplier(per_column_scale ? N : 1);
+  const auto* b_scale_data = b_scale->template Data<float>();
+  for (size_t n = 0; n < real_multiplier.size(); n++) {
+    real_multiplier[n] = (a_scale_data * b_scale_data[n]) / y_scale_data;
+  }
+
+  const uint8_t* b_offset_per_column = nullptr;
+  if (!IsScalarOr1ElementVector(b_offset)) {
+    b_offset_per_column = b_offset->template Data<uint8_t>();
+  }
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
-  auto gemm_output_data = alloc->Alloc(SafeInt<size_t>(sizeof(int32_t)) *
-                                       static_cast<size_t>(helper.M()) * static_cast<size_t>(helper.N()));
+  auto gemm_output_data = alloc->Alloc(SafeInt<size_t>(sizeof(int32_t)) * M * N);
   BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
   auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    // Requantize each block of the intermediate buffer as soon as MLAS has
+    // finished accumulating it instead of making a second pass over the buffer.
+    MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_processor(
+        y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
+        N,
+        nullptr,
+        real_multiplier.data(),
+        per_column_scale,
+        *y_offset->template Data<uint8_t>());
+
+    MLAS_GEMM_U8X8_DATA_PARAMS gemm_params;
+    gemm_params.A = a->template Data<uint8_t>() + helper.LeftOffsets()[i];
+    gemm_params.lda = K;
+    if (packed_b_) {
+      gemm_params.B = packed_b_.get();
+      gemm_params.BIsPacked = true;
+    } else {
+      gemm_params.B = b->template Data<uint8_t>() + helper.RightOffsets()[i];
+      gemm_params.ldb = N;
+    }
+    gemm_params.C = gemm_output;
+    gemm_params.ldc = N;
+    gemm_params.ZeroPointB = b_offset_per_column;
+    gemm_params.OutputProcessor = &requant_processor;
+
+    MlasGemmBatch(M, N, K, &gemm_params, 1,
+                  *a_offset->template Data<uint8_t>(),
+                  *b_offset->template Data<uint8_t>(),
+                  false,
+                  ctx->GetOperatorThreadPool());
+  }
 #else
+  auto b_scale_data = *(b_scale->template Data<float>());
+
+  const float real_multiplier = (a_scale_data * b_scale_data) / y_scale_data;
+
   // Compute the fixed point multiplier and shift for requantizing with GEMMLOWP.
   int32_t integer_multiplier;
   int right_shift;
   QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
-#endif
 
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-#ifdef MLAS_SUPPORTS_GEMM_U8X8
-    QGemmu8u8_s32(static_cast<int>(helper.M()),
-                  static_cast<int>(helper.N()),
-                  static_cast<int>(helper.K()),
-                  a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                  static_cast<int>(helper.K()),
-                  *a_offset->template Data<uint8_t>(),
-                  b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                  static_cast<int>(helper.N()),
-                  *b_offset->template Data<uint8_t>(),
-                  gemm_output,
-                  static_cast<int>(helper.N()),
-                  ctx->GetOperatorThreadPool());
-
-    MlasRequantizeOutput(gemm_output,
-                         y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
-                         nullptr,
-                         static_cast<size_t>(helper.M()),
-                         static_cast<size_t>(helper.N()),
-                         real_multiplier,
-                         *y_offset->template Data<uint8_t>());
-#else
     GemmlowpMultiplyu8u8_u8(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
                             b->template Data<uint8_t>() + helper.RightOffsets()[i],
                             y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
                             *a_offset->template Data<uint8_t>(),
                             *b_offset->template Data<uint8_t>(),
                             *y_offset->template Data<uint8_t>(),
-                            static_cast<int>(helper.M()),
-                            static_cast<int>(helper.N()),
-                            static_cast<int>(helper.K()),
+                            static_cast<int>(M),
+                            static_cast<int>(N),
+                            static_cast<int>(K),
                             integer_multiplier,
                             right_shift);
-#endif
   }
+#endif
 
   return Status::OK();
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -11,9 +12,16 @@ template <typename T1, typename T2, typename T3>
 class QLinearMatMul final : public OpKernel {
  public:
   QLinearMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    const Tensor* B;
+    if (info.TryGetConstantInput(3, &B)) {
+      GemmPackBU8X8(info, *B, packed_b_);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
 
+ private:
+  // B packed into the MLAS quantized GEMM panel layout when it is a 2D constant initializer
+  BufferUniquePtr packed_b_;
 };
 }  // namespace onnxruntime
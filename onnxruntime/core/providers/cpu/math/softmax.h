@@ -22,6 +22,7 @@ limitations under the License.
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/softmax.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 
 namespace onnxruntime {
@@ -39,9 +40,6 @@ class Softmax final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
-#ifndef _OPENMP
-    concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
-#endif
     const auto* tensor_pointer = ctx->Input<Tensor>(0);
     if (tensor_pointer == nullptr)
       return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
@@ -61,22 +59,37 @@ class Softmax final : public OpKernel {
     int N = static_cast<int>(input_shape.SizeToDimension(axis));
     int D = static_cast<int>(input_shape.SizeFromDimension(axis));
 
-    Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> X_tensor(
-        X.Data<T>(), N, D);
-    Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> Y_tensor(
-        Y->MutableData<T>(), N, D);
+    ComputeImpl(X.Data<T>(), Y->MutableData<T>(), N, D, ctx->GetOperatorThreadPool());
+
+    return Status::OK();
+  }
+
+ private:
+  // The float path uses the vectorized MLAS kernels, which are threaded across the N rows.
+  void ComputeImpl(const float* X, float* Y, int N, int D, concurrency::ThreadPool* tp) const {
+    MlasComputeSoftmax(X, Y, static_cast<size_t>(N), static_cast<size_t>(D), use_log, tp);
+  }
+
+  void ComputeImpl(const double* X, double* Y, int N, int D, concurrency::ThreadPool* tp) const {
+#ifdef _OPENMP
+    ORT_UNUSED_PARAMETER(tp);
+#endif
+    Eigen::TensorMap<Eigen::Tensor<const double, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> X_tensor(
+        X, N, D);
+    Eigen::TensorMap<Eigen::Tensor<double, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> Y_tensor(
+        Y, N, D);
 #ifndef _OPENMP
-    if (tp == nullptr)
+    // The Eigen device blocks without running the tasks queued in the pool, so a kernel that is
+    // already running on one of its threads (parallel executor) computes on its own thread.
+    if (tp == nullptr || tp->CurrentThreadId() != -1)
 #endif
       ComputeSoftMax<use_log>(Eigen::DefaultDevice(), X_tensor, Y_tensor, N, D);
 #ifndef _OPENMP
     else
       ComputeSoftMax<use_log>(tp->Device(), X_tensor, Y_tensor, N, D);
 #endif
-    return Status::OK();
   }
 
- private:
   int axis_;
 };
 }  // namespace onnxruntime
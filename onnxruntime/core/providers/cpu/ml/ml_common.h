@@ -19,7 +19,7 @@ enum class OUTPUT_MODE {
   ALL_SCORES
 };
 
-enum class NODE_MODE {
+enum class NODE_MODE : uint8_t {
   BRANCH_LEQ,
   BRANCH_LT,
   BRANCH_GTE,
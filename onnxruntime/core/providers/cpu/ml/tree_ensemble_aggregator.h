@@ -40,28 +40,21 @@ struct ScoreValue {
   }
 };
 
-enum MissingTrack {
-  NONE,
-  TRUE,
-  FALSE
-};
-
+// Nodes of a tree are stored contiguously in depth first order with the false child of a branch
+// right after it, so a branch only records the offset to its true child. A leaf has no children:
+// feature_id is the index of its first weight in the weight table of the ensemble and
+// truenode_inc the number of weights.
 template <typename T>
 struct TreeNodeElement {
-  TreeNodeElementId id;
-  int feature_id;
+  int32_t feature_id;
   T value;
-  T hitrates;
+  int32_t truenode_inc;
   NODE_MODE mode;
-  TreeNodeElement<T>* truenode;
-  TreeNodeElement<T>* falsenode;
-  MissingTrack missing_tracks;
-  std::vector<SparseValue<T>> weights;
-
-  bool is_not_leaf;
   bool is_missing_track_true;
 };
 
+static_assert(sizeof(TreeNodeElement<float>) == 16, "TreeNodeElement<float> is expected to be 16 bytes.");
+
 template <typename ITYPE, typename OTYPE>
 class TreeAggregator {
  protected:
@@ -83,9 +76,9 @@ class TreeAggregator {
 
   // 1 output
 
-  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& /*prediction*/, const TreeNodeElement<OTYPE>& /*root*/) const {}
+  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& /*prediction*/, OTYPE /*weight*/) const {}
 
-  void MergePrediction1(ScoreValue<OTYPE>& /*prediction*/, ScoreValue<OTYPE>& /*prediction2*/) const {}
+  void MergePrediction1(ScoreValue<OTYPE>& /*prediction*/, const ScoreValue<OTYPE>& /*prediction2*/) const {}
 
   void FinalizeScores1(OTYPE* Z, ScoreValue<OTYPE>& prediction, int64_t* /*Y*/) const {
     prediction.score = prediction.has_score ? (prediction.score + origin_) : origin_;
@@ -94,9 +87,9 @@ class TreeAggregator {
 
   // N outputs
 
-  void ProcessTreeNodePrediction(std::vector<ScoreValue<OTYPE>>& /*predictions*/, const TreeNodeElement<OTYPE>& /*root*/) const {}
+  void ProcessTreeNodePrediction(ScoreValue<OTYPE>* /*predictions*/, const SparseValue<OTYPE>* /*weights*/, int64_t /*n_weights*/) const {}
 
-  void MergePrediction(std::vector<ScoreValue<OTYPE>>& /*predictions*/, const std::vector<ScoreValue<OTYPE>>& /*predictions2*/) const {}
+  void MergePrediction(ScoreValue<OTYPE>* /*predictions*/, const ScoreValue<OTYPE>* /*predictions2*/) const {}
 
   void FinalizeScores(std::vector<ScoreValue<OTYPE>>& predictions, OTYPE* Z, int add_second_class, int64_t*) const {
     ORT_ENFORCE(predictions.size() == (size_t)n_targets_or_classes_);
@@ -126,8 +119,8 @@ class TreeAggregatorSum : public TreeAggregator<ITYPE, OTYPE> {
 
   // 1 output
 
-  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& prediction, const TreeNodeElement<OTYPE>& root) const {
-    prediction.score += root.weights[0].value;
+  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& prediction, OTYPE weight) const {
+    prediction.score += weight;
   }
 
   void MergePrediction1(ScoreValue<OTYPE>& prediction, const ScoreValue<OTYPE>& prediction2) const {
@@ -141,17 +134,15 @@ class TreeAggregatorSum : public TreeAggregator<ITYPE, OTYPE> {
 
   // N outputs
 
-  void ProcessTreeNodePrediction(std::vector<ScoreValue<OTYPE>>& predictions, const TreeNodeElement<OTYPE>& root) const {
-    for (auto it = root.weights.cbegin(); it != root.weights.cend(); ++it) {
-      ORT_ENFORCE(it->i < (int64_t)predictions.size());
+  void ProcessTreeNodePrediction(ScoreValue<OTYPE>* predictions, const SparseValue<OTYPE>* weights, int64_t n_weights) const {
+    for (auto it = weights, end = weights + n_weights; it != end; ++it) {
       predictions[it->i].score += it->value;
       predictions[it->i].has_score = 1;
     }
   }
 
-  void MergePrediction(std::vector<ScoreValue<OTYPE>>& predictions, const std::vector<ScoreValue<OTYPE>>& predictions2) const {
-    ORT_ENFORCE(predictions.size() == predictions2.size());
-    for (size_t i = 0; i < predictions.size(); ++i) {
+  void MergePrediction(ScoreValue<OTYPE>* predictions, const ScoreValue<OTYPE>* predictions2) const {
+    for (int64_t i = 0; i < this->n_targets_or_classes_; ++i) {
       if (predictions2[i].has_score) {
         predictions[i].score += predictions2[i].score;
         predictions[i].has_score = 1;
@@ -212,9 +203,9 @@ class TreeAggregatorMin : public TreeAggregator<ITYPE, OTYPE> {
 
   // 1 output
 
-  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& prediction, const TreeNodeElement<OTYPE>& root) const {
-    prediction.score = (!(prediction.has_score) || root.weights[0].value < prediction.score)
-                           ? root.weights[0].value
+  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& prediction, OTYPE weight) const {
+    prediction.score = (!(prediction.has_score) || weight < prediction.score)
+                           ? weight
                            : prediction.score;
     prediction.has_score = 1;
   }
@@ -230,8 +221,8 @@ class TreeAggregatorMin : public TreeAggregator<ITYPE, OTYPE> {
 
   // N outputs
 
-  void ProcessTreeNodePrediction(std::vector<ScoreValue<OTYPE>>& predictions, const TreeNodeElement<OTYPE>& root) const {
-    for (auto it = root.weights.begin(); it != root.weights.end(); ++it) {
+  void ProcessTreeNodePrediction(ScoreValue<OTYPE>* predictions, const SparseValue<OTYPE>* weights, int64_t n_weights) const {
+    for (auto it = weights, end = weights + n_weights; it != end; ++it) {
       predictions[it->i].score = (!predictions[it->i].has_score || it->value < predictions[it->i].score)
                                      ? it->value
                                      : predictions[it->i].score;
@@ -239,9 +230,8 @@ class TreeAggregatorMin : public TreeAggregator<ITYPE, OTYPE> {
     }
   }
 
-  void MergePrediction(std::vector<ScoreValue<OTYPE>>& predictions, const std::vector<ScoreValue<OTYPE>>& predictions2) const {
-    ORT_ENFORCE(predictions.size() == predictions2.size());
-    for (size_t i = 0; i < predictions.size(); ++i) {
+  void MergePrediction(ScoreValue<OTYPE>* predictions, const ScoreValue<OTYPE>* predictions2) const {
+    for (int64_t i = 0; i < this->n_targets_or_classes_; ++i) {
       if (predictions2[i].has_score) {
         predictions[i].score = predictions[i].has_score && (predictions[i].score < predictions2[i].score)
                                    ? predictions[i].score
@@ -263,9 +253,9 @@ class TreeAggregatorMax : public TreeAggregator<ITYPE, OTYPE> {
 
   // 1 output
 
-  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& prediction, const TreeNodeElement<OTYPE>& root) const {
-    prediction.score = (!(prediction.has_score) || root.weights[0].value > prediction.score)
-                           ? root.weights[0].value
+  void ProcessTreeNodePrediction1(ScoreValue<OTYPE>& prediction, OTYPE weight) const {
+    prediction.score = (!(prediction.has_score) || weight > prediction.score)
+                           ? weight
                            : prediction.score;
     prediction.has_score = 1;
   }
@@ -281,8 +271,8 @@ class TreeAggregatorMax : public TreeAggregator<ITYPE, OTYPE> {
 
   // N outputs
 
-  void ProcessTreeNodePrediction(std::vector<ScoreValue<OTYPE>>& predictions, const TreeNodeElement<OTYPE>& root) const {
-    for (auto it = root.weights.begin(); it != root.weights.end(); ++it) {
+  void ProcessTreeNodePrediction(ScoreValue<OTYPE>* predictions, const SparseValue<OTYPE>* weights, int64_t n_weights) const {
+    for (auto it = weights, end = weights + n_weights; it != end; ++it) {
       predictions[it->i].score = (!predictions[it->i].has_score || it->value > predictions[it->i].score)
                                      ? it->value
                                      : predictions[it->i].score;
@@ -290,9 +280,8 @@ class TreeAggregatorMax : public TreeAggregator<ITYPE, OTYPE> {
     }
   }
 
-  void MergePrediction(std::vector<ScoreValue<OTYPE>>& predictions, const std::vector<ScoreValue<OTYPE>>& predictions2) const {
-    ORT_ENFORCE(predictions.size() == predictions2.size());
-    for (size_t i = 0; i < predictions.size(); ++i) {
+  void MergePrediction(ScoreValue<OTYPE>* predictions, const ScoreValue<OTYPE>* predictions2) const {
+    for (int64_t i = 0; i < this->n_targets_or_classes_; ++i) {
       if (predictions2[i].has_score) {
         predictions[i].score = predictions[i].has_score && (predictions[i].score > predictions2[i].score)
                                    ? predictions[i].score
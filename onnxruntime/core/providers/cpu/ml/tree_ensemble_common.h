@@ -3,11 +3,71 @@
 
 #pragma once
 #include "tree_ensemble_aggregator.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace onnxruntime {
 namespace ml {
 namespace detail {
 
+// Number of rows which descend a tree together, see ProcessTreeNodeLeaves.
+constexpr int64_t kTreeRowBlockSize = 8;
+
+inline bool _isnan_(float x) { return std::isnan(x); }
+inline bool _isnan_(double x) { return std::isnan(x); }
+inline bool _isnan_(int64_t) { return false; }
+inline bool _isnan_(int32_t) { return false; }
+
+// Branch conditions used when all the nodes of the ensemble share the same mode.
+struct TreeNodeLeq {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(NODE_MODE, ITYPE val, OTYPE threshold) const { return val <= threshold; }
+};
+struct TreeNodeLt {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(NODE_MODE, ITYPE val, OTYPE threshold) const { return val < threshold; }
+};
+struct TreeNodeGte {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(NODE_MODE, ITYPE val, OTYPE threshold) const { return val >= threshold; }
+};
+struct TreeNodeGt {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(NODE_MODE, ITYPE val, OTYPE threshold) const { return val > threshold; }
+};
+struct TreeNodeEq {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(NODE_MODE, ITYPE val, OTYPE threshold) const { return val == threshold; }
+};
+struct TreeNodeNeq {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(NODE_MODE, ITYPE val, OTYPE threshold) const { return val != threshold; }
+};
+
+// Branch condition for ensembles mixing several modes.
+struct TreeNodeAnyMode {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(NODE_MODE mode, ITYPE val, OTYPE threshold) const {
+    switch (mode) {
+      case NODE_MODE::BRANCH_LEQ:
+        return val <= threshold;
+      case NODE_MODE::BRANCH_LT:
+        return val < threshold;
+      case NODE_MODE::BRANCH_GTE:
+        return val >= threshold;
+      case NODE_MODE::BRANCH_GT:
+        return val > threshold;
+      case NODE_MODE::BRANCH_EQ:
+        return val == threshold;
+      case NODE_MODE::BRANCH_NEQ:
+        return val != threshold;
+      default:
+        return false;
+    }
+  }
+};
+
 template <typename ITYPE, typename OTYPE>
 class TreeEnsembleCommon {
  public:
@@ -19,14 +79,15 @@ class TreeEnsembleCommon {
   AGGREGATE_FUNCTION aggregate_function_;
   int64_t n_nodes_;
   std::vector<TreeNodeElement<OTYPE>> nodes_;
-  std::vector<TreeNodeElement<OTYPE>*> roots_;
+  std::vector<SparseValue<OTYPE>> weights_;
+  std::vector<int32_t> roots_;
 
   int64_t max_tree_depth_;
   int64_t n_trees_;
   bool same_mode_;
-  bool has_missing_tracks_;
-  int parallel_tree_;  // starts parallelizing the computing if n_tree >= parallel_tree_ and n_rows == 1
-  int parallel_N_;     // starts parallelizing the computing if n_rows >= parallel_N_
+  NODE_MODE mode_;     // mode of every branch if same_mode_ is true
+  int parallel_tree_;  // starts splitting the trees between threads if n_tree > parallel_tree_
+  int parallel_N_;     // starts splitting the rows between threads if n_rows > parallel_N_
 
  public:
   TreeEnsembleCommon(int parallel_tree,
@@ -49,14 +110,18 @@ class TreeEnsembleCommon {
                      const std::vector<int64_t>& target_class_treeids,
                      const std::vector<OTYPE>& target_class_weights);
 
-  void compute(const Tensor* X, Tensor* Z, Tensor* label) const;
+  void compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label) const;
 
  protected:
-  TreeNodeElement<OTYPE>* ProcessTreeNodeLeave(
-      TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const;
+  void ProcessTreeNodeLeaves(int32_t root, const ITYPE* x_data, int64_t stride,
+                             int64_t n_rows, int32_t* leaves) const;
+
+  template <typename CMP>
+  void ProcessTreeNodeLeaves(const CMP& cmp, int32_t root, const ITYPE* x_data, int64_t stride,
+                             int64_t n_rows, int32_t* leaves) const;
 
   template <typename AGG>
-  void compute_agg(const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
+  void compute_agg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
 };
 
 template <typename ITYPE, typename OTYPE>
@@ -78,6 +143,7 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
                                                      const std::vector<int64_t>& target_class_nodeids,
                                                      const std::vector<int64_t>& target_class_treeids,
                                                      const std::vector<OTYPE>& target_class_weights) {
+  ORT_UNUSED_PARAMETER(nodes_hitrates);
   parallel_tree_ = parallel_tree;
   parallel_N_ = parallel_N;
 
@@ -90,7 +156,7 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
   ORT_ENFORCE(nodes_falsenodeids.size() == nodes_values.size());
   ORT_ENFORCE(target_class_ids.size() == target_class_nodeids.size());
   ORT_ENFORCE(target_class_ids.size() == target_class_treeids.size());
-  ORT_ENFORCE(target_class_ids.size() == target_class_treeids.size());
+  ORT_ENFORCE(target_class_ids.size() == target_class_weights.size());
 
   aggregate_function_ = MakeAggregateFunction(aggregate_function);
   post_transform_ = MakeTransform(post_transform);
@@ -101,6 +167,7 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
   // additional members
   std::vector<NODE_MODE> cmodes(nodes_modes.size());
   same_mode_ = true;
+  mode_ = NODE_MODE::LEAF;
   int fpos = -1;
   for (size_t i = 0; i < nodes_modes.size(); ++i) {
     cmodes[i] = MakeTreeNodeMode(nodes_modes[i]);
@@ -108,137 +175,141 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
       continue;
     if (fpos == -1) {
       fpos = static_cast<int>(i);
+      mode_ = cmodes[i];
       continue;
     }
     if (cmodes[i] != cmodes[fpos])
       same_mode_ = false;
   }
 
-  // filling nodes
+  // indexing the nodes, every tree starts with its root
 
   n_nodes_ = nodes_treeids.size();
-  nodes_.resize(n_nodes_);
-  roots_.clear();
-  std::map<TreeNodeElementId, TreeNodeElement<OTYPE>*> idi;
+  std::map<TreeNodeElementId, size_t> idi;
+  std::vector<size_t> tree_roots;
+  TreeNodeElementId ind;
   size_t i;
 
   for (i = 0; i < nodes_treeids.size(); ++i) {
-    TreeNodeElement<OTYPE>& node = nodes_[i];
-    node.id.tree_id = static_cast<int>(nodes_treeids[i]);
-    node.id.node_id = static_cast<int>(nodes_nodeids[i]);
-    node.feature_id = static_cast<int>(nodes_featureids[i]);
-    node.value = nodes_values[i];
-    node.hitrates = i < nodes_hitrates.size() ? nodes_hitrates[i] : -1;
-    node.mode = cmodes[i];
-    node.is_not_leaf = node.mode != NODE_MODE::LEAF;
-    node.truenode = NULL;   // nodes_truenodeids[i];
-    node.falsenode = NULL;  // nodes_falsenodeids[i];
-    node.missing_tracks = i < static_cast<size_t>(nodes_missing_value_tracks_true.size())
-                              ? (nodes_missing_value_tracks_true[i] == 1
-                                     ? MissingTrack::TRUE
-                                     : MissingTrack::FALSE)
-                              : MissingTrack::NONE;
-    node.is_missing_track_true = node.missing_tracks == MissingTrack::TRUE;
-    if (idi.find(node.id) != idi.end()) {
-      ORT_THROW("Node ", node.id.node_id, " in tree ", node.id.tree_id, " is already there.");
+    ind.tree_id = static_cast<int>(nodes_treeids[i]);
+    ind.node_id = static_cast<int>(nodes_nodeids[i]);
+    if (!idi.insert(std::pair<TreeNodeElementId, size_t>(ind, i)).second) {
+      ORT_THROW("Node ", ind.node_id, " in tree ", ind.tree_id, " is already there.");
     }
-    idi.insert(std::pair<TreeNodeElementId, TreeNodeElement<OTYPE>*>(node.id, &node));
+    if (i == 0 || nodes_treeids[i] != nodes_treeids[i - 1])
+      tree_roots.push_back(i);
   }
 
-  TreeNodeElementId coor;
-  for (auto it = nodes_.begin(); it != nodes_.end(); ++it, ++i) {
-    if (!it->is_not_leaf)
-      continue;
-    i = std::distance(nodes_.begin(), it);
-    coor.tree_id = it->id.tree_id;
-    coor.node_id = static_cast<int>(nodes_truenodeids[i]);
-
-    auto found = idi.find(coor);
+  std::vector<std::vector<SparseValue<OTYPE>>> node_weights(n_nodes_);
+  SparseValue<OTYPE> w;
+  for (i = 0; i < target_class_nodeids.size(); i++) {
+    ind.tree_id = static_cast<int>(target_class_treeids[i]);
+    ind.node_id = static_cast<int>(target_class_nodeids[i]);
+    auto found = idi.find(ind);
     if (found == idi.end()) {
-      ORT_THROW("Unable to find node ", coor.tree_id, "-", coor.node_id, " (truenode).");
+      ORT_THROW("Unable to find node ", ind.tree_id, "-", ind.node_id, " (weights).");
     }
-    if (coor.node_id >= 0 && coor.node_id < n_nodes_) {
-      it->truenode = found->second;
-      if ((it->truenode->id.tree_id != it->id.tree_id) ||
-          (it->truenode->id.node_id == it->id.node_id)) {
-        ORT_THROW("One falsenode is pointing either to itself, either to another tree.");
-      }
-    } else
-      it->truenode = NULL;
+    if (n_targets_or_classes_ > 1 && (target_class_ids[i] < 0 || target_class_ids[i] >= n_targets_or_classes_)) {
+      ORT_THROW("Target or class id ", target_class_ids[i], " of node ", ind.tree_id, "-", ind.node_id,
+                " is out of range [0, ", n_targets_or_classes_, ").");
+    }
+    w.i = target_class_ids[i];
+    w.value = target_class_weights[i];
+    node_weights[found->second].push_back(w);
+  }
 
-    coor.node_id = static_cast<int>(nodes_falsenodeids[i]);
-    found = idi.find(coor);
+  auto find_child = [&](size_t parent, int64_t child_id, const char* kind) {
+    TreeNodeElementId coor;
+    coor.tree_id = static_cast<int>(nodes_treeids[parent]);
+    coor.node_id = static_cast<int>(child_id);
+    auto found = idi.find(coor);
     if (found == idi.end()) {
-      ORT_THROW("Unable to find node ", coor.tree_id, "-", coor.node_id, " (falsenode).");
+      ORT_THROW("Unable to find node ", coor.tree_id, "-", coor.node_id, " (", kind, ").");
     }
-    if (coor.node_id >= 0 && coor.node_id < n_nodes_) {
-      it->falsenode = found->second;
-      if ((it->falsenode->id.tree_id != it->id.tree_id) ||
-          (it->falsenode->id.node_id == it->id.node_id)) {
-        ORT_THROW("One falsenode is pointing either to itself, either to another tree.");
+    if (found->second == parent) {
+      ORT_THROW("One ", kind, " is pointing to itself.");
+    }
+    return found->second;
+  };
+
+  // Lays out every tree in depth first order, visiting the false child of a branch before the
+  // true child so that the false child immediately follows its parent. The true child patches
+  // the offset stored in its parent once its position is known.
+
+  struct PendingNode {
+    size_t index;
+    int32_t parent;
+    int64_t depth;
+  };
+  std::vector<PendingNode> pending;
+  nodes_.reserve(n_nodes_);
+  roots_.reserve(tree_roots.size());
+  for (size_t root : tree_roots) {
+    roots_.push_back(static_cast<int32_t>(nodes_.size()));
+    pending.push_back({root, -1, 0});
+    while (!pending.empty()) {
+      PendingNode current = pending.back();
+      pending.pop_back();
+      if (current.depth > max_tree_depth_) {
+        ORT_THROW("Tree ", nodes_treeids[root], " is deeper than ", max_tree_depth_, " or contains a cycle.");
       }
-    } else
-      it->falsenode = NULL;
-  }
 
-  int64_t previous = -1;
-  for (i = 0; i < static_cast<size_t>(n_nodes_); ++i) {
-    if ((previous == -1) || (previous != nodes_[i].id.tree_id))
-      roots_.push_back(&(nodes_[i]));
-    previous = nodes_[i].id.tree_id;
-  }
+      const auto position = static_cast<int32_t>(nodes_.size());
+      if (current.parent >= 0)
+        nodes_[current.parent].truenode_inc = position - current.parent;
+
+      i = current.index;
+      TreeNodeElement<OTYPE> node;
+      node.value = nodes_values[i];
+      node.mode = cmodes[i];
+      node.is_missing_track_true = i < nodes_missing_value_tracks_true.size() &&
+                                   nodes_missing_value_tracks_true[i] == 1;
+      if (node.mode == NODE_MODE::LEAF) {
+        node.feature_id = static_cast<int32_t>(weights_.size());
+        node.truenode_inc = static_cast<int32_t>(node_weights[i].size());
+        weights_.insert(weights_.end(), node_weights[i].begin(), node_weights[i].end());
+        nodes_.push_back(node);
+        continue;
+      }
 
-  TreeNodeElementId ind;
-  SparseValue<OTYPE> w;
-  for (i = 0; i < target_class_nodeids.size(); i++) {
-    ind.tree_id = static_cast<int>(target_class_treeids[i]);
-    ind.node_id = static_cast<int>(target_class_nodeids[i]);
-    if (idi.find(ind) == idi.end()) {
-      ORT_THROW("Unable to find node ", coor.tree_id, "-", coor.node_id, " (weights).");
+      node.feature_id = static_cast<int32_t>(nodes_featureids[i]);
+      node.truenode_inc = 0;
+      nodes_.push_back(node);
+      pending.push_back({find_child(i, nodes_truenodeids[i], "truenode"), position, current.depth + 1});
+      pending.push_back({find_child(i, nodes_falsenodeids[i], "falsenode"), -1, current.depth + 1});
     }
-    w.i = target_class_ids[i];
-    w.value = target_class_weights[i];
-    idi[ind]->weights.push_back(w);
   }
 
   n_trees_ = roots_.size();
-  has_missing_tracks_ = false;
-  for (auto itm = nodes_missing_value_tracks_true.begin();
-       itm != nodes_missing_value_tracks_true.end(); ++itm) {
-    if (*itm) {
-      has_missing_tracks_ = true;
-      break;
-    }
-  }
 }
 
 template <typename ITYPE, typename OTYPE>
-void TreeEnsembleCommon<ITYPE, OTYPE>::compute(const Tensor* X, Tensor* Z, Tensor* label) const {
+void TreeEnsembleCommon<ITYPE, OTYPE>::compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label) const {
   switch (aggregate_function_) {
     case AGGREGATE_FUNCTION::AVERAGE:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorAverage<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
       return;
     case AGGREGATE_FUNCTION::SUM:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorSum<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
       return;
     case AGGREGATE_FUNCTION::MIN:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorMin<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
       return;
     case AGGREGATE_FUNCTION::MAX:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorMax<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
@@ -248,232 +319,174 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute(const Tensor* X, Tensor* Z, Tenso
   }
 }
 
+inline int64_t TreeEnsembleDegreeOfParallelism(concurrency::ThreadPool* ttp) {
+#ifdef _OPENMP
+  ORT_UNUSED_PARAMETER(ttp);
+  return omp_get_max_threads();
+#else
+  return ttp == nullptr ? 1 : ttp->NumThreads();
+#endif
+}
+
 template <typename ITYPE, typename OTYPE>
 template <typename AGG>
-void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const {
-  int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
-  int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
+void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z,
+                                                   Tensor* label, const AGG& agg) const {
+  const int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
+  const int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
+  const int64_t n_targets = n_targets_or_classes_;
 
   const ITYPE* x_data = X->template Data<ITYPE>();
   OTYPE* z_data = Z->template MutableData<OTYPE>();
   int64_t* label_data = label == NULL ? NULL : label->template MutableData<int64_t>();
 
-  if (n_targets_or_classes_ == 1) {
-    if (N == 1) {
-      ScoreValue<OTYPE> score = {0, 0};
-      if (n_trees_ <= parallel_tree_) {
-        for (int64_t j = 0; j < n_trees_; ++j)
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data));
-      } else {
-        std::vector<ScoreValue<OTYPE>> scores_t(n_trees_, {0, 0});
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(scores_t[j], *ProcessTreeNodeLeave(roots_[j], x_data));
-        }
-        for (auto it = scores_t.cbegin(); it != scores_t.cend(); ++it)
-          agg.MergePrediction1(score, *it);
-      }
+  // The work is split into blocks of rows times batches of trees. Trees are only split when there
+  // are not enough row blocks to keep the threads busy, each batch of trees then accumulates into
+  // its own copy of the scores which are merged once all the trees are done.
+  const int64_t n_row_blocks = (N + kTreeRowBlockSize - 1) / kTreeRowBlockSize;
+  const bool parallel = N > parallel_N_ || n_trees_ > parallel_tree_;
+  int64_t n_tree_batches = 1;
+  if (parallel && n_trees_ > parallel_tree_) {
+    const int64_t threads = TreeEnsembleDegreeOfParallelism(ttp);
+    if (n_row_blocks < threads)
+      n_tree_batches = std::min(n_trees_, (threads + n_row_blocks - 1) / n_row_blocks);
+  }
 
-      agg.FinalizeScores1(z_data, score, label_data);
-    } else {
-      if (N <= parallel_N_) {
-        ScoreValue<OTYPE> score;
-        size_t j;
-
-        for (int64_t i = 0; i < N; ++i) {
-          score = {0, 0};
-          for (j = 0; j < static_cast<size_t>(n_trees_); ++j)
-            agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores1(z_data + i * n_targets_or_classes_, score,
-                              label_data == NULL ? NULL : (label_data + i));
-        }
-      } else {
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for (int64_t i = 0; i < N; ++i) {
-          ScoreValue<OTYPE> score = {0, 0};
-          for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j)
-            agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores1(z_data + i * n_targets_or_classes_, score,
-                              label_data == NULL ? NULL : (label_data + i));
+  // Adds the leaves reached by rows [first_row, first_row + n_rows) in trees [first_tree, end_tree)
+  // to the scores of these rows.
+  auto process_rows = [&](int64_t first_tree, int64_t end_tree, int64_t first_row, int64_t n_rows,
+                          ScoreValue<OTYPE>* row_scores) {
+    int32_t leaves[kTreeRowBlockSize];
+    for (int64_t j = first_tree; j < end_tree; ++j) {
+      ProcessTreeNodeLeaves(roots_[j], x_data + first_row * stride, stride, n_rows, leaves);
+      for (int64_t r = 0; r < n_rows; ++r) {
+        const TreeNodeElement<OTYPE>& leaf = nodes_[leaves[r]];
+        const SparseValue<OTYPE>* weights = weights_.data() + leaf.feature_id;
+        if (n_targets == 1) {
+          if (leaf.truenode_inc > 0)
+            agg.ProcessTreeNodePrediction1(row_scores[r], weights->value);
+        } else {
+          agg.ProcessTreeNodePrediction(row_scores + r * n_targets, weights, leaf.truenode_inc);
         }
       }
     }
-  } else {
-    if (N == 1) {
-      std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_, {0, 0});
-
-      if (n_trees_ <= parallel_tree_) {
-        for (int64_t j = 0; j < n_trees_; ++j)
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data));
-        agg.FinalizeScores(scores, z_data, -1, label_data);
-      } else {
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-        {
-          std::vector<ScoreValue<OTYPE>> private_scores(n_targets_or_classes_, {0, 0});
-#ifdef _OPENMP
-#pragma omp for
-#endif
-          for (int64_t j = 0; j < n_trees_; ++j) {
-            agg.ProcessTreeNodePrediction(private_scores, *ProcessTreeNodeLeave(roots_[j], x_data));
-          }
+  };
 
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-          agg.MergePrediction(scores, private_scores);
-        }
-
-        agg.FinalizeScores(scores, z_data, -1, label_data);
-      }
+  auto finalize_row = [&](int64_t i, ScoreValue<OTYPE>* row_scores, std::vector<ScoreValue<OTYPE>>& predictions) {
+    int64_t* row_label = label_data == NULL ? NULL : (label_data + i);
+    if (n_targets == 1) {
+      agg.FinalizeScores1(z_data + i, *row_scores, row_label);
     } else {
-      if (N <= parallel_N_) {
-        std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-        size_t j;
-
-        for (int64_t i = 0; i < N; ++i) {
-          std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-          for (j = 0; j < roots_.size(); ++j)
-            agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores(scores,
-                             z_data + i * n_targets_or_classes_, -1,
-                             label_data == NULL ? NULL : (label_data + i));
-          ORT_ENFORCE((int64_t)scores.size() == n_targets_or_classes_);
-        }
-      } else {
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-        {
-          std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-          size_t j;
-
-#ifdef _OPENMP
-#pragma omp for
-#endif
-          for (int64_t i = 0; i < N; ++i) {
-            std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-            for (j = 0; j < roots_.size(); ++j)
-              agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-            agg.FinalizeScores(scores,
-                               z_data + i * n_targets_or_classes_, -1,
-                               label_data == NULL ? NULL : (label_data + i));
-          }
-        }
-      }
+      predictions.assign(row_scores, row_scores + n_targets);
+      agg.FinalizeScores(predictions, z_data + i * n_targets, -1, row_label);
     }
+  };
+
+  if (n_tree_batches == 1) {
+    auto process_block = [&](std::ptrdiff_t block) {
+      const int64_t first_row = block * kTreeRowBlockSize;
+      const int64_t n_rows = std::min(kTreeRowBlockSize, N - first_row);
+      std::vector<ScoreValue<OTYPE>> row_scores(n_rows * n_targets, {0, 0});
+      std::vector<ScoreValue<OTYPE>> predictions;
+      process_rows(0, n_trees_, first_row, n_rows, row_scores.data());
+      for (int64_t r = 0; r < n_rows; ++r)
+        finalize_row(first_row + r, row_scores.data() + r * n_targets, predictions);
+    };
+    if (parallel) {
+      concurrency::ThreadPool::TryBatchParallelFor(ttp, n_row_blocks, process_block, 0);
+    } else {
+      for (int64_t block = 0; block < n_row_blocks; ++block)
+        process_block(block);
+    }
+    return;
   }
+
+  std::vector<ScoreValue<OTYPE>> scores(n_tree_batches * N * n_targets, {0, 0});
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ttp, n_tree_batches * n_row_blocks,
+      [&](std::ptrdiff_t task) {
+        const int64_t batch = task / n_row_blocks;
+        const int64_t first_row = (task % n_row_blocks) * kTreeRowBlockSize;
+        const int64_t n_rows = std::min(kTreeRowBlockSize, N - first_row);
+        process_rows(batch * n_trees_ / n_tree_batches, (batch + 1) * n_trees_ / n_tree_batches,
+                     first_row, n_rows, scores.data() + (batch * N + first_row) * n_targets);
+      },
+      0);
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ttp, N,
+      [&](std::ptrdiff_t i) {
+        ScoreValue<OTYPE>* row_scores = scores.data() + i * n_targets;
+        for (int64_t batch = 1; batch < n_tree_batches; ++batch) {
+          const ScoreValue<OTYPE>* batch_scores = scores.data() + (batch * N + i) * n_targets;
+          if (n_targets == 1)
+            agg.MergePrediction1(*row_scores, *batch_scores);
+          else
+            agg.MergePrediction(row_scores, batch_scores);
+        }
+        std::vector<ScoreValue<OTYPE>> predictions;
+        finalize_row(i, row_scores, predictions);
+      },
+      0);
 }
 
-#define TREE_FIND_VALUE(CMP)                                         \
-  if (has_missing_tracks_) {                                         \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = (val CMP root->value ||                                 \
-              (root->is_missing_track_true && _isnan_(val)))         \
-                 ? root->truenode                                    \
-                 : root->falsenode;                                  \
-    }                                                                \
-  } else {                                                           \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = val CMP root->value ? root->truenode : root->falsenode; \
-    }                                                                \
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeaves(
+    int32_t root, const ITYPE* x_data, int64_t stride, int64_t n_rows, int32_t* leaves) const {
+  if (!same_mode_) {
+    ProcessTreeNodeLeaves(TreeNodeAnyMode(), root, x_data, stride, n_rows, leaves);
+    return;
   }
+  switch (mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      ProcessTreeNodeLeaves(TreeNodeLeq(), root, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_LT:
+      ProcessTreeNodeLeaves(TreeNodeLt(), root, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      ProcessTreeNodeLeaves(TreeNodeGte(), root, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_GT:
+      ProcessTreeNodeLeaves(TreeNodeGt(), root, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      ProcessTreeNodeLeaves(TreeNodeEq(), root, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      ProcessTreeNodeLeaves(TreeNodeNeq(), root, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::LEAF:
+      ProcessTreeNodeLeaves(TreeNodeAnyMode(), root, x_data, stride, n_rows, leaves);
+      break;
+  }
+}
 
-inline bool _isnan_(float x) { return std::isnan(x); }
-inline bool _isnan_(double x) { return std::isnan(x); }
-inline bool _isnan_(int64_t) { return false; }
-inline bool _isnan_(int32_t) { return false; }
-
+// Finds the leaves reached by n_rows rows in the tree starting at root. The rows go down the tree
+// one level at a time in turn: the node each row loads next does not depend on the other rows, so
+// the cache misses of the rows overlap instead of being paid one after the other.
 template <typename ITYPE, typename OTYPE>
-TreeNodeElement<OTYPE>*
-TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeave(
-    TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const {
-  ITYPE val;
-  if (same_mode_) {
-    switch (root->mode) {
-      case NODE_MODE::BRANCH_LEQ:
-        if (has_missing_tracks_) {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = (val <= root->value ||
-                    (root->is_missing_track_true && _isnan_(val)))
-                       ? root->truenode
-                       : root->falsenode;
-          }
-        } else {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = val <= root->value ? root->truenode : root->falsenode;
-          }
-        }
-        break;
-      case NODE_MODE::BRANCH_LT:
-        TREE_FIND_VALUE(<)
-        break;
-      case NODE_MODE::BRANCH_GTE:
-        TREE_FIND_VALUE(>=)
-        break;
-      case NODE_MODE::BRANCH_GT:
-        TREE_FIND_VALUE(>)
-        break;
-      case NODE_MODE::BRANCH_EQ:
-        TREE_FIND_VALUE(==)
-        break;
-      case NODE_MODE::BRANCH_NEQ:
-        TREE_FIND_VALUE(!=)
-        break;
-      case NODE_MODE::LEAF:
-        break;
-    }
-  } else {  // Different rules to compare to node thresholds.
-    OTYPE threshold;
-    while (root->is_not_leaf) {
-      val = x_data[root->feature_id];
-      threshold = root->value;
-      switch (root->mode) {
-        case NODE_MODE::BRANCH_LEQ:
-          root = val <= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_LT:
-          root = val < threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GTE:
-          root = val >= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GT:
-          root = val > threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_EQ:
-          root = val == threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_NEQ:
-          root = val != threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::LEAF:
-          break;
-      }
+template <typename CMP>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeaves(
+    const CMP& cmp, int32_t root, const ITYPE* x_data, int64_t stride, int64_t n_rows, int32_t* leaves) const {
+  const TreeNodeElement<OTYPE>* nodes = nodes_.data();
+  for (int64_t r = 0; r < n_rows; ++r)
+    leaves[r] = root;
+
+  bool descending = true;
+  while (descending) {
+    descending = false;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      const TreeNodeElement<OTYPE>& node = nodes[leaves[r]];
+      if (node.mode == NODE_MODE::LEAF)
+        continue;
+      const ITYPE val = x_data[r * stride + node.feature_id];
+      leaves[r] += (cmp(node.mode, val, node.value) || (node.is_missing_track_true && _isnan_(val)))
+                       ? node.truenode_inc
+                       : 1;
+      descending = true;
     }
   }
-  return root;
 }
 
 template <typename ITYPE, typename OTYPE>
@@ -509,7 +522,7 @@ class TreeEnsembleCommonClassifier : TreeEnsembleCommon<ITYPE, OTYPE> {
 
   int64_t get_class_count() const { return this->n_targets_or_classes_; }
 
-  void compute(const Tensor* X, Tensor* Z, Tensor* label) const;
+  void compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label) const;
 };
 
 template <typename ITYPE, typename OTYPE>
@@ -571,10 +584,10 @@ TreeEnsembleCommonClassifier<ITYPE, OTYPE>::TreeEnsembleCommonClassifier(
 }
 
 template <typename ITYPE, typename OTYPE>
-void TreeEnsembleCommonClassifier<ITYPE, OTYPE>::compute(const Tensor* X, Tensor* Z, Tensor* label) const {
+void TreeEnsembleCommonClassifier<ITYPE, OTYPE>::compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label) const {
   if (classlabels_strings_.size() == 0) {
     this->compute_agg(
-        X, Z, label,
+        ttp, X, Z, label,
         TreeAggregatorClassifier<ITYPE, OTYPE>(
             this->roots_.size(), this->n_targets_or_classes_,
             this->post_transform_, this->base_values_,
@@ -585,7 +598,7 @@ void TreeEnsembleCommonClassifier<ITYPE, OTYPE>::compute(const Tensor* X, Tensor
     std::shared_ptr<IAllocator> allocator = std::make_shared<CPUAllocator>();
     Tensor label_int64(DataTypeImpl::GetType<int64_t>(), TensorShape({N}), allocator);
     this->compute_agg(
-        X, Z, &label_int64,
+        ttp, X, Z, &label_int64,
         TreeAggregatorClassifier<ITYPE, OTYPE>(
             this->roots_.size(), this->n_targets_or_classes_,
             this->post_transform_, this->base_values_,
@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/nn/qlinearconv.h"
 
+#include <algorithm>
+
 #include "core/common/safeint.h"
 #include "core/providers/common.h"
 #include "core/util/math.h"
@@ -25,18 +27,86 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),
     QLinearConv);
 
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+// Requantizes blocks of the output channel by output image GEMM result as soon
+// as MLAS has finished accumulating them. Each row of the GEMM result is an
+// output channel, so the bias and the optional per channel scale apply per row.
+class QLinearConvOutputProcessor : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  QLinearConvOutputProcessor(uint8_t* output,
+                             const int32_t* bias,
+                             const float* scale,
+                             bool per_channel_scale,
+                             uint8_t zero_point)
+      : output_(output),
+        bias_(bias),
+        scale_(scale),
+        per_channel_scale_(per_channel_scale),
+        zero_point_(zero_point) {
+  }
+
+  void Process(const int32_t* C,
+               size_t StartM,
+               size_t StartN,
+               size_t CountM,
+               size_t CountN,
+               size_t ldc) const override {
+    for (size_t m = StartM; m < StartM + CountM; m++) {
+      MlasRequantizeOutput(C + m * ldc + StartN,
+                           output_ + m * ldc + StartN,
+                           bias_ != nullptr ? bias_ + m : nullptr,
+                           1,
+                           CountN,
+                           scale_[per_channel_scale_ ? m : 0],
+                           zero_point_);
+    }
+  }
+
+ private:
+  uint8_t* output_;
+  const int32_t* bias_;
+  const float* scale_;
+  bool per_channel_scale_;
+  uint8_t zero_point_;
+};
+#endif
+
 Status QLinearConv::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const auto* W = context->Input<Tensor>(3);
 
+  const int64_t M = W->Shape()[0];
+
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  // The filter scale may have an element for each output channel. The filter
+  // is the left hand side of the GEMM, so a per channel zero point is only
+  // accepted if every channel uses the same value.
+  auto IsScalarOrPerChannel = [M](const Tensor* t) {
+    return IsScalarOr1ElementVector(t) ||
+           (t->Shape().NumDimensions() == 1 && t->Shape()[0] == M);
+  };
+#endif
+
   // validate offsets
   auto X_zero_point = context->Input<Tensor>(2);
   auto W_zero_point = context->Input<Tensor>(5);
   auto Y_zero_point = context->Input<Tensor>(7);
   ORT_ENFORCE(IsScalarOr1ElementVector(X_zero_point),
               "QLinearConv : input zero point must be a scalar or 1D tensor of size 1");
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  ORT_ENFORCE(IsScalarOrPerChannel(W_zero_point),
+              "QLinearConv : filter zero point must be a scalar or 1D tensor of size 1 or M");
+  {
+    const auto* W_zero_point_data = W_zero_point->template Data<uint8_t>();
+    const auto W_zero_point_size = W_zero_point->Shape().Size();
+    ORT_ENFORCE(std::all_of(W_zero_point_data, W_zero_point_data + W_zero_point_size,
+                            [W_zero_point_data](uint8_t v) { return v == W_zero_point_data[0]; }),
+                "QLinearConv : filter zero point must be the same for all output channels");
+  }
+#else
   ORT_ENFORCE(IsScalarOr1ElementVector(W_zero_point),
               "QLinearConv : filter zero point must be a scalar or 1D tensor of size 1");
+#endif
   ORT_ENFORCE(IsScalarOr1ElementVector(Y_zero_point),
               "QLinearConv : result zero point must be a scalar or 1D tensor of size 1");
 
@@ -50,13 +120,17 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   auto Y_scale = context->Input<Tensor>(6);
   ORT_ENFORCE(IsScalarOr1ElementVector(X_scale),
               "QLinearConv : input scale must be a scalar or 1D tensor of size 1");
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  ORT_ENFORCE(IsScalarOrPerChannel(W_scale),
+              "QLinearConv : filter scale must be a scalar or 1D tensor of size 1 or M");
+#else
   ORT_ENFORCE(IsScalarOr1ElementVector(W_scale),
               "QLinearConv : filter scale must be a scalar or 1D tensor of size 1");
+#endif
   ORT_ENFORCE(IsScalarOr1ElementVector(Y_scale),
               "QLinearConv : result scale must be a scalar or 1D tensor of size 1");
 
   auto X_scale_value = *(X_scale->template Data<float>());
-  auto W_scale_value = *(W_scale->template Data<float>());
   auto Y_scale_value = *(Y_scale->template Data<float>());
 
   size_t num_inputs = OpKernel::Node().InputDefs().size();
@@ -67,7 +141,6 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
 
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
   ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
 
   std::vector<int64_t> kernel_shape;
@@ -132,15 +205,24 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
 
   auto* col_buffer_data = static_cast<uint8_t*>(col_buffer.get());
 
-  const float real_multiplier = (X_scale_value * W_scale_value) / Y_scale_value;
-
 #ifdef MLAS_SUPPORTS_GEMM_U8X8
+  // Fold the scales into a single multiplier, or one multiplier per output channel.
+  const bool per_channel_scale = !IsScalarOr1ElementVector(W_scale);
+  std::vector<float> real_multiplier(per_channel_scale ? static_cast<size_t>(M) : 1);
+  const auto* W_scale_data = W_scale->template Data<float>();
+  for (size_t m = 0; m < real_multiplier.size(); m++) {
+    real_multiplier[m] = (X_scale_value * W_scale_data[m]) / Y_scale_value;
+  }
+
   // Use an intermediate int32_t buffer for the GEMM computation before
   // requantizing to the output type.
   auto gemm_output_data = alloc->Alloc(SafeInt<size_t>(sizeof(int32_t)) * Y_offset);
   BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
   auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
 #else
+  auto W_scale_value = *(W_scale->template Data<float>());
+  const float real_multiplier = (X_scale_value * W_scale_value) / Y_scale_value;
+
   // Compute the fixed point multiplier and shift for requantizing with GEMMLOWP.
   int32_t integer_multiplier;
   int right_shift;
@@ -192,26 +274,31 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
       }
 
 #ifdef MLAS_SUPPORTS_GEMM_U8X8
-      QGemmu8u8_s32(static_cast<int>(M / conv_attrs_.group),
-                    static_cast<int>(output_image_size),
-                    static_cast<int>(kernel_dim),
-                    Wdata + group_id * W_offset,
-                    static_cast<int>(kernel_dim),
+      QLinearConvOutputProcessor requant_processor(
+          Ydata,
+          Bdata != nullptr ? Bdata + group_id * B_offset : nullptr,
+          per_channel_scale ? real_multiplier.data() + group_id * B_offset : real_multiplier.data(),
+          per_channel_scale,
+          Y_zero_point_value);
+
+      MLAS_GEMM_U8X8_DATA_PARAMS gemm_params;
+      gemm_params.A = Wdata + group_id * W_offset;
+      gemm_params.lda = static_cast<size_t>(kernel_dim);
+      gemm_params.B = col_buffer_data == nullptr ? Xdata : col_buffer_data;
+      gemm_params.ldb = static_cast<size_t>(output_image_size);
+      gemm_params.C = gemm_output;
+      gemm_params.ldc = static_cast<size_t>(output_image_size);
+      gemm_params.OutputProcessor = &requant_processor;
+
+      MlasGemmBatch(static_cast<size_t>(M / conv_attrs_.group),
+                    static_cast<size_t>(output_image_size),
+                    static_cast<size_t>(kernel_dim),
+                    &gemm_params,
+                    1,
                     W_zero_point_value,
-                    col_buffer_data == nullptr ? Xdata : col_buffer_data,
-                    static_cast<int>(output_image_size),
                     X_zero_point_value,
-                    gemm_output,
-                    static_cast<int>(output_image_size),
+                    false,
                     context->GetOperatorThreadPool());
-
-      MlasRequantizeOutput(gemm_output,
-                           Ydata,
-                           Bdata != nullptr ? Bdata + group_id * B_offset : nullptr,
-                           static_cast<size_t>(M / conv_attrs_.group),
-                           static_cast<size_t>(output_image_size),
-                           real_multiplier,
-                           Y_zero_point_value);
 #else
       GemmlowpMultiplyu8u8_u8(Wdata + group_id * W_offset,
                               col_buffer_data == nullptr ? Xdata : col_buffer_data,
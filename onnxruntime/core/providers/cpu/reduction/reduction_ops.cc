@@ -151,578 +151,524 @@ REGISTER_UNARY_ELEMENTWISE_VERSIONED_KERNEL(ArgMin, 1, 10);
 REGISTER_UNARY_ELEMENTWISE_VERSIONED_KERNEL(ArgMin, 11, 11);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 12);
 
-// When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
-// copy could be skipped to improve performance. If required by check_no_transpose = true, then
-// the calling code will check if the data was transposed and act accordingly.
-// return value: true means transposedInputData is not created/copied, input tensor data could
-//               be direct use as row major matrix [block_size, blocks], where blocks is the
-//               size of each reduce.
-template <typename T>
-bool PrepareForReduce(OpKernelContext* ctx,
-                      FastAllocVector<T>& transposedInputData,
+namespace {
+
+// Describes how to walk the input of a reduction in place. Adjacent axes that are both kept or
+// both reduced are merged and axes of size 1 are dropped, so any set of axes collapses into an
+// alternating sequence of kept and reduced segments. The innermost segment selects the kernel:
+//  - reduced: each output is accumulated from runs of inner_size contiguous input elements.
+//  - kept: inner_size adjacent outputs are accumulated together from contiguous input vectors,
+//    which covers both reducing the leading axes and reducing strided axes in the middle.
+// Neither case needs a transposed copy of the input.
+struct ReducePlan {
+  struct Segment {
+    int64_t size;
+    int64_t stride;
+  };
+
+  int64_t output_size = 0;
+  int64_t reduce_size = 0;  // number of input elements contributing to each output
+  bool inner_reduced = true;
+  int64_t inner_size = 1;
+  std::vector<Segment> kept;     // kept segments, outermost first, excluding the innermost segment
+  std::vector<Segment> reduced;  // reduced segments, outermost first, excluding the innermost segment
+  int64_t kept_count = 1;
+  int64_t reduced_count = 1;
+
+  // Maps a linear index over the given segments to an offset into the input.
+  static int64_t Offset(const std::vector<Segment>& segments, int64_t index) {
+    int64_t offset = 0;
+    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+      offset += (index % it->size) * it->stride;
+      index /= it->size;
+    }
+    return offset;
+  }
+};
+
+// Number of adjacent outputs accumulated together when the innermost segment is kept. Keeps the
+// accumulators resident in L1 and gives the thread pool enough units of work when there are only
+// a few outer groups.
+constexpr int64_t kReduceColumnBlock = 1024;
+
+// Creates the output tensor and fills in the plan used to reduce the input in place.
+void PrepareForReduce(OpKernelContext* ctx,
+                      ReducePlan& plan,
                       Tensor** reducedTensor,
-                      int64_t& block_size,
-                      int64_t& blocks,
                       const std::vector<int64_t>& axes_,
-                      bool keepdims_,
-                      bool check_no_transpose = false) {
+                      bool keepdims_) {
   const auto* input_tensor_ptr = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   const Tensor& input = *input_tensor_ptr;
 
-  size_t ndim = input.Shape().NumDimensions();
+  const auto& in_dims = input.Shape().GetDims();
+  const size_t ndim = in_dims.size();
 
   // Scalar tensor
   if (ndim == 0) {
-    if (!check_no_transpose) {
-      auto size = input.Shape().Size();
-      assert(size == 1);
-      transposedInputData.resize(size, 0);
-      T* to_data = &transposedInputData[0];
-      *to_data = *input.Data<T>();
-    }
-    block_size = blocks = 1;
     *reducedTensor = ctx->Output(0, input.Shape());
-    return true;
+    plan.output_size = plan.reduce_size = 1;
+    return;
   }
 
-  std::vector<int64_t> axes;
-  axes.reserve(axes_.size());
+  // No axes is the default case for non-arg kind reductions. Reduce on all dimensions.
+  std::vector<bool> keep_axis(ndim, !axes_.empty());
   for (int64_t axis : axes_) {
-    axes.push_back(HandleNegativeAxis(axis, static_cast<int64_t>(ndim)));
-  }
-
-  if (axes.empty()) {
-    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
-    for (size_t i = 0; i < ndim; i++) {
-      axes.push_back(i);
-    }
-  }
-
-  std::sort(axes.begin(), axes.end());
-
-  // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
-  bool need_copy = true;
-  if (axes.size() <= ndim &&
-      axes.front() == static_cast<int64_t>(ndim - axes.size()) &&
-      axes.back() == static_cast<int64_t>(ndim) - 1) {
-    need_copy = false;
-  }
-
-  std::vector<bool> keep_axis(ndim, true);
-  for (auto i : axes) {
-    keep_axis[i] = false;
-  }
-
-  //transpose the input so that all to-be-reduced axes are at the head
-  std::vector<int64_t> transposed_axes(axes.begin(), axes.end());
-  for (size_t i = 0; i < ndim; ++i) {
-    if (keep_axis[i]) {
-      transposed_axes.push_back(i);
-    }
-  }
-
-  std::vector<int64_t> new_dims(transposed_axes.size());
-  for (size_t i = 0; i < transposed_axes.size(); ++i) {
-    new_dims[i] = input.Shape().GetDims().at(transposed_axes[i]);
-  }
-
-  int num_axes = static_cast<int>(transposed_axes.size());
-  auto in_dims = input.Shape().GetDims();
-
-  // Measure amount of contiguous data we can copy at once
-  int64_t blocksize = 1;
-  int n_shared_idxs = 0;
-  for (int i = num_axes - 1; i >= 0; --i) {
-    if (transposed_axes[i] == i) {
-      blocksize *= new_dims[i];
-      ++n_shared_idxs;
-    } else {
-      break;
-    }
+    keep_axis[HandleNegativeAxis(axis, static_cast<int64_t>(ndim))] = false;
   }
 
-  const T* from_data = input.template Data<T>();
-  size_t count = input.Shape().Size();
-
   //set to-be-reduced axes to one. squeeze is keepdims_ is false
-  int64_t first_dim = 1;
   std::vector<int64_t> reduced_dims;
-  reduced_dims.reserve(in_dims.size());
+  reduced_dims.reserve(ndim);
 
-  for (size_t i = 0; i < in_dims.size(); i++) {
+  for (size_t i = 0; i < ndim; i++) {
     const auto in_dim = in_dims[i];
     if (keep_axis[i]) {
       reduced_dims.push_back(in_dim);
+    } else if (keepdims_) {
+      reduced_dims.push_back(in_dim == 0 ? 0 : 1);
     } else {
-      first_dim *= in_dim;
-      if (keepdims_) {
-        reduced_dims.push_back(in_dim == 0 ? 0 : 1);
-      } else {
-        // as we are reducing on this axis and not keeping a dim for it, we can't drop a dim value of 0.
-        // e.g. if input was {3, 0, 2} and we reduced on axis 1 without keeping it, the output shape would be
-        // {3, 2} which is invalid given the input was empty.
-        // note that if we do keep the dim the output shape will have a 0 in it,
-        // which is still valid for an empty tensor, so allow that.
-        ORT_ENFORCE(in_dim != 0,
-                    "Can't reduce on dim with value of 0 if 'keepdims' is false. "
-                    "Invalid output shape would be produced. input_shape:",
-                    input.Shape());
-      }
+      // as we are reducing on this axis and not keeping a dim for it, we can't drop a dim value of 0.
+      // e.g. if input was {3, 0, 2} and we reduced on axis 1 without keeping it, the output shape would be
+      // {3, 2} which is invalid given the input was empty.
+      // note that if we do keep the dim the output shape will have a 0 in it,
+      // which is still valid for an empty tensor, so allow that.
+      ORT_ENFORCE(in_dim != 0,
+                  "Can't reduce on dim with value of 0 if 'keepdims' is false. "
+                  "Invalid output shape would be produced. input_shape:",
+                  input.Shape());
     }
   }
 
   *reducedTensor = ctx->Output(0, std::move(reduced_dims));
-  auto num_elements = input.Shape().Size();
+  const int64_t num_elements = input.Shape().Size();
 
   // edge case. one or more input dims with value of 0.
   if (num_elements == 0) {
-    block_size = blocks = 0;
-    return true;
+    return;
   }
 
-  block_size = num_elements / first_dim;
-  blocks = first_dim;
+  plan.output_size = (*reducedTensor)->Shape().Size();
+  plan.reduce_size = num_elements / plan.output_size;
 
-  if (!need_copy && check_no_transpose) {
-    return true;
+  // Merge adjacent axes sharing the same status, ignoring axes of size 1.
+  std::vector<std::pair<int64_t, bool>> segments;
+  for (size_t i = 0; i < ndim; i++) {
+    if (in_dims[i] == 1) {
+      continue;
+    }
+    const bool reduced = !keep_axis[i];
+    if (!segments.empty() && segments.back().second == reduced) {
+      segments.back().first *= in_dims[i];
+    } else {
+      segments.emplace_back(in_dims[i], reduced);
+    }
   }
 
-  transposedInputData.resize(input.Shape().Size(), 0);
-  T* to_data = &transposedInputData[0];
-  if (num_axes < 2 || n_shared_idxs == num_axes) {
-    memcpy(to_data, from_data, count * sizeof(T));
-    return false;
+  if (segments.empty()) {
+    return;
   }
 
-  int itr_axes = num_axes - n_shared_idxs;
+  plan.inner_reduced = segments.back().second;
+  plan.inner_size = segments.back().first;
 
-  // Calculate strides
-  std::vector<int64_t> stride_x(itr_axes, 0);
-  for (size_t i = 0; static_cast<int>(i) < itr_axes; i++) {
-    stride_x[i] = 1;
-    for (size_t j = transposed_axes[i] + 1; static_cast<int>(j) < itr_axes; j++) {
-      stride_x[i] *= in_dims[j];
+  int64_t stride = plan.inner_size;
+  for (auto it = segments.rbegin() + 1; it != segments.rend(); ++it) {
+    if (it->second) {
+      plan.reduced.insert(plan.reduced.begin(), ReducePlan::Segment{it->first, stride});
+      plan.reduced_count *= it->first;
+    } else {
+      plan.kept.insert(plan.kept.begin(), ReducePlan::Segment{it->first, stride});
+      plan.kept_count *= it->first;
     }
+    stride *= it->first;
   }
+}
 
-  std::vector<int64_t> itr_idxs(itr_axes, 0);
-
-  // Branch here to avoid branching within the loop
-  if (blocksize > 1) {
-    for (size_t index = 0; index < (count / blocksize); index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
-
-      memcpy(
-          to_data + blocksize * index,
-          from_data + blocksize * from_index,
-          blocksize * sizeof(T));
+// Reduces the input described by plan using an aggregator providing:
+//   T Init()                                   initial accumulator value
+//   void Inner(T& acc, const T* data, n, o)    accumulates n contiguous elements into output o
+//   void Outer(T* acc, const T* data, n, o)    accumulates n contiguous elements into outputs [o, o + n)
+//   T Finalize(T acc, o)                       produces output o from its accumulator
+// Inner and Outer are expected to use vectorized Eigen expressions. Work is split across outputs
+// when the innermost segment is reduced, and across groups and column blocks of the outputs
+// otherwise, so whichever of the kept dimensions is large provides the parallelism.
+template <typename T, typename TAggregator>
+void ReduceInPlace(const T* input, T* output, const ReducePlan& plan, const TAggregator& agg,
+                   concurrency::ThreadPool* tp, double cycles_per_element = 1.0) {
+  if (plan.output_size == 0) {
+    return;
+  }
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
+  if (plan.inner_reduced) {
+    const TensorOpCost cost{static_cast<double>(plan.reduce_size * sizeof(T)), static_cast<double>(sizeof(T)),
+                            static_cast<double>(plan.reduce_size) * cycles_per_element};
+    concurrency::ThreadPool::TryParallelFor(tp, plan.output_size, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t o = first; o < last; ++o) {
+        const T* base = input + ReducePlan::Offset(plan.kept, o);
+        T acc = agg.Init();
+        for (int64_t j = 0; j < plan.reduced_count; ++j) {
+          agg.Inner(acc, base + ReducePlan::Offset(plan.reduced, j), plan.inner_size, o);
         }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
+        output[o] = agg.Finalize(acc, o);
       }
-    }
+    });
   } else {
-    for (size_t index = 0; index < count; index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
-
-      *(to_data + index) = *(from_data + from_index);
-
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
+    const int64_t inner_size = plan.inner_size;
+    const int64_t column_block = std::min(inner_size, kReduceColumnBlock);
+    const int64_t column_blocks = (inner_size + column_block - 1) / column_block;
+    const int64_t block_elements = column_block * plan.reduced_count;
+    const TensorOpCost cost{static_cast<double>(block_elements * sizeof(T)), static_cast<double>(column_block * sizeof(T)),
+                            static_cast<double>(block_elements) * cycles_per_element};
+    concurrency::ThreadPool::TryParallelFor(tp, plan.kept_count * column_blocks, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t u = first; u < last; ++u) {
+        const int64_t group = u / column_blocks;
+        const int64_t column = (u % column_blocks) * column_block;
+        const int64_t n = std::min(column_block, inner_size - column);
+        const int64_t o = group * inner_size + column;
+        const T* base = input + ReducePlan::Offset(plan.kept, group) + column;
+        T* acc = output + o;
+        std::fill_n(acc, n, agg.Init());
+        for (int64_t j = 0; j < plan.reduced_count; ++j) {
+          agg.Outer(acc, base + ReducePlan::Offset(plan.reduced, j), n, o);
+        }
+        for (int64_t k = 0; k < n; ++k) {
+          acc[k] = agg.Finalize(acc[k], o + k);
         }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
       }
-    }
+    });
   }
-  return false;
 }
 
 template <typename T>
-Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+struct ReduceAggregatorSum {
+  T Init() const { return 0; }
+  void Inner(T& acc, const T* data, int64_t n, int64_t) const {
+    acc += ConstEigenVectorMap<T>(data, n).sum();
+  }
+  void Outer(T* acc, const T* data, int64_t n, int64_t) const {
+    EigenVectorMap<T>(acc, n) += ConstEigenVectorMap<T>(data, n);
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  explicit ReduceAggregatorMean(int64_t reduce_size) : reduce_size_(reduce_size) {}
+  T Finalize(T acc, int64_t) const { return acc / static_cast<T>(reduce_size_); }
+  int64_t reduce_size_;
+};
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+template <typename T>
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  T Finalize(T acc, int64_t) const { return static_cast<T>(std::log(acc)); }
+};
 
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).cwiseAbs().sum();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+template <typename T>
+struct ReduceAggregatorL1 : ReduceAggregatorSum<T> {
+  void Inner(T& acc, const T* data, int64_t n, int64_t) const {
+    acc += ConstEigenVectorMap<T>(data, n).cwiseAbs().sum();
   }
+  void Outer(T* acc, const T* data, int64_t n, int64_t) const {
+    EigenVectorMap<T>(acc, n) += ConstEigenVectorMap<T>(data, n).cwiseAbs();
+  }
+};
 
-  return Status::OK();
-}
+template <typename T>
+struct ReduceAggregatorSumSquare : ReduceAggregatorSum<T> {
+  void Inner(T& acc, const T* data, int64_t n, int64_t) const {
+    acc += ConstEigenVectorMap<T>(data, n).squaredNorm();
+  }
+  void Outer(T* acc, const T* data, int64_t n, int64_t) const {
+    EigenVectorMap<T>(acc, n) += ConstEigenVectorMap<T>(data, n).cwiseAbs2();
+  }
+};
 
 template <typename T>
-Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  T Finalize(T acc, int64_t) const { return static_cast<T>(std::sqrt(acc)); }
+};
 
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+template <typename T>
+struct ReduceAggregatorProd {
+  T Init() const { return 1; }
+  void Inner(T& acc, const T* data, int64_t n, int64_t) const {
+    acc *= ConstEigenVectorMap<T>(data, n).prod();
+  }
+  void Outer(T* acc, const T* data, int64_t n, int64_t) const {
+    EigenVectorArrayMap<T>(acc, n) *= ConstEigenVectorArrayMap<T>(data, n);
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorMax {
+  T Init() const { return std::numeric_limits<T>::lowest(); }
+  void Inner(T& acc, const T* data, int64_t n, int64_t) const {
+    acc = std::max(acc, ConstEigenVectorMap<T>(data, n).maxCoeff());
+  }
+  void Outer(T* acc, const T* data, int64_t n, int64_t) const {
+    EigenVectorArrayMap<T> acc_vec(acc, n);
+    acc_vec = acc_vec.max(ConstEigenVectorArrayMap<T>(data, n));
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+template <typename T>
+struct ReduceAggregatorMin {
+  T Init() const { return std::numeric_limits<T>::max(); }
+  void Inner(T& acc, const T* data, int64_t n, int64_t) const {
+    acc = std::min(acc, ConstEigenVectorMap<T>(data, n).minCoeff());
+  }
+  void Outer(T* acc, const T* data, int64_t n, int64_t) const {
+    EigenVectorArrayMap<T> acc_vec(acc, n);
+    acc_vec = acc_vec.min(ConstEigenVectorArrayMap<T>(data, n));
+  }
+  T Finalize(T acc, int64_t) const { return acc; }
+};
 
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).norm();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+template <typename T>
+T SumExp(const T* data, int64_t n, T max_value) {
+  T sum = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    sum += static_cast<T>(std::exp(data[i] - max_value));
   }
+  return sum;
+}
 
-  return Status::OK();
+float SumExp(const float* data, int64_t n, float max_value) {
+  return (ConstEigenVectorArrayMap<float>(data, n) - max_value).exp().sum();
 }
 
 template <typename T>
-Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+void AccumulateExp(T* acc, const T* data, const T* max_values, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) {
+    acc[i] += static_cast<T>(std::exp(data[i] - max_values[i]));
+  }
+}
 
-  T* output_data = reduced->template MutableData<T>();
+void AccumulateExp(float* acc, const float* data, const float* max_values, int64_t n) {
+  EigenVectorArrayMap<float>(acc, n) +=
+      (ConstEigenVectorArrayMap<float>(data, n) - ConstEigenVectorArrayMap<float>(max_values, n)).exp();
+}
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+// Second pass of ReduceLogSumExp, given the maximum of each output from a first ReduceAggregatorMax pass.
+template <typename T>
+struct ReduceAggregatorLogSumExp : ReduceAggregatorSum<T> {
+  explicit ReduceAggregatorLogSumExp(const T* max_values) : max_values_(max_values) {}
+  void Inner(T& acc, const T* data, int64_t n, int64_t o) const {
+    acc += SumExp(data, n, max_values_[o]);
+  }
+  void Outer(T* acc, const T* data, int64_t n, int64_t o) const {
+    AccumulateExp(acc, data, max_values_ + o, n);
+  }
+  T Finalize(T acc, int64_t o) const { return static_cast<T>(std::log(acc) + max_values_[o]); }
+  const T* max_values_;
+};
+
+// ArgMax/ArgMin reduce a single axis, so the plan has at most one reduced segment and the linear
+// index over the reduced elements is the index along that axis.
+template <typename T, bool is_max>
+void ArgReduceInPlace(const T* input, int64_t* output, const ReducePlan& plan, bool select_last_index,
+                      concurrency::ThreadPool* tp) {
+  if (plan.output_size == 0) {
+    return;
+  }
 
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
+  auto better = [select_last_index](T value, T best) {
+    if (is_max) {
+      return select_last_index ? value >= best : value > best;
     }
+    return select_last_index ? value <= best : value < best;
+  };
+
+  if (plan.inner_reduced) {
+    const TensorOpCost cost{static_cast<double>(plan.reduce_size * sizeof(T)), static_cast<double>(sizeof(int64_t)),
+                            static_cast<double>(plan.reduce_size)};
+    concurrency::ThreadPool::TryParallelFor(tp, plan.output_size, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t o = first; o < last; ++o) {
+        const T* base = input + ReducePlan::Offset(plan.kept, o);
+        if (!select_last_index && plan.reduced_count == 1) {
+          Eigen::Index index;
+          if (is_max) {
+            ConstEigenVectorMap<T>(base, plan.inner_size).maxCoeff(&index);
+          } else {
+            ConstEigenVectorMap<T>(base, plan.inner_size).minCoeff(&index);
+          }
+          output[o] = index;
+          continue;
+        }
+        int64_t best_index = 0;
+        T best = *base;
+        for (int64_t j = 0; j < plan.reduced_count; ++j) {
+          const T* data = base + ReducePlan::Offset(plan.reduced, j);
+          for (int64_t k = 0; k < plan.inner_size; ++k) {
+            if (better(data[k], best)) {
+              best = data[k];
+              best_index = j * plan.inner_size + k;
+            }
+          }
+        }
+        output[o] = best_index;
+      }
+    });
   } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
+    const int64_t inner_size = plan.inner_size;
+    const int64_t column_block = std::min(inner_size, kReduceColumnBlock);
+    const int64_t column_blocks = (inner_size + column_block - 1) / column_block;
+    const int64_t block_elements = column_block * plan.reduced_count;
+    const TensorOpCost cost{static_cast<double>(block_elements * sizeof(T)), static_cast<double>(column_block * sizeof(int64_t)),
+                            static_cast<double>(block_elements)};
+    concurrency::ThreadPool::TryParallelFor(tp, plan.kept_count * column_blocks, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      std::vector<T> best(column_block);
+      for (std::ptrdiff_t u = first; u < last; ++u) {
+        const int64_t group = u / column_blocks;
+        const int64_t column = (u % column_blocks) * column_block;
+        const int64_t n = std::min(column_block, inner_size - column);
+        const T* base = input + ReducePlan::Offset(plan.kept, group) + column;
+        int64_t* best_index = output + group * inner_size + column;
+        std::copy_n(base, n, best.begin());
+        std::fill_n(best_index, n, 0);
+        for (int64_t j = 1; j < plan.reduced_count; ++j) {
+          const T* data = base + ReducePlan::Offset(plan.reduced, j);
+          for (int64_t k = 0; k < n; ++k) {
+            if (better(data[k], best[k])) {
+              best[k] = data[k];
+              best_index[k] = j;
+            }
+          }
+        }
+      }
+    });
   }
+}
 
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
-  }
+}  // namespace
 
+template <typename T>
+Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
+  ReducePlan plan;
+  Tensor* reduced;
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorL1<T>(), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
-Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
+  ReducePlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  for (int j = 0; j < block_size; ++j) {
-    T max_value = std::numeric_limits<T>::lowest();
-    for (int i = 0; i < blocks; ++i) {
-      max_value = std::max(max_value, transposedInputData[i * block_size + j]);
-    }
-    T scaled_exp_sum = 0;
-    for (int i = 0; i < blocks; ++i) {
-      scaled_exp_sum += static_cast<T>(std::exp(transposedInputData[i * block_size + j] - max_value));
-    }
-    *(output_data++) = static_cast<T>(std::log(scaled_exp_sum) + max_value);
-  }
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorL2<T>(), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
-Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+  ReducePlan plan;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorLogSum<T>(), ctx->GetOperatorThreadPool());
+  return Status::OK();
+}
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
+  ReducePlan plan;
+  Tensor* reduced;
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
 
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).maxCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
-  }
+  // The maximum of each output keeps the exponentials from overflowing.
+  FastAllocVector<T> max_values(static_cast<size_t>(plan.output_size), GetAllocator<T>(*ctx));
+  ReduceInPlace(input_data, max_values.data(), plan, ReduceAggregatorMax<T>(), tp);
+  ReduceInPlace(input_data, reduced->template MutableData<T>(), plan,
+                ReduceAggregatorLogSumExp<T>(max_values.data()), tp, 16.0);
+  return Status::OK();
+}
 
+template <typename T>
+Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
+  ReducePlan plan;
+  Tensor* reduced;
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorMax<T>(), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+  ReducePlan plan;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-    auto lambda = [input_data, blocks, output_data](ptrdiff_t i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    };
-    concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), block_size, lambda, 0);
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
-  }
-
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorMean<T>(plan.reduce_size), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+  ReducePlan plan;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).minCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
-  }
-
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorMin<T>(), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+  ReducePlan plan;
   Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).prod();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
-  }
-
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorProd<T>(), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+  ReducePlan plan;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-    auto lambda = [input_data, blocks, output_data](ptrdiff_t i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    };
-    concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), block_size, lambda, 0);
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
-
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorSum<T>(), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+  ReducePlan plan;
   Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).squaredNorm();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
-  }
-
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ReduceInPlace(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), plan,
+                ReduceAggregatorSumSquare<T>(), ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+  ReducePlan plan;
   Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-  Eigen::MatrixXf::Index maxIndex;
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-    if (select_last_index_) {
-      assert(blocks > 0);
-      for (int64_t i = 0; i < block_size; ++i) {
-        gsl::span<const T> row(input_data, blocks);
-        auto first = row.cbegin();
-        auto const end = row.cend();
-        auto max_el = first;
-        while (++first < end) {
-          if (*first >= *max_el) {
-            max_el = first;
-          }
-        }
-        *(output_data++) = max_el - row.cbegin();
-        input_data += blocks;
-      }
-    } else {
-      for (int64_t i = 0; i < block_size; ++i) {
-        ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).maxCoeff(&maxIndex);
-        *(output_data++) = maxIndex;
-      }
-    }
-  } else {
-    auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-    if (select_last_index_) {
-      for (int i = 0; i < block_size; ++i) {
-        int idx = 0;
-        T max_val = matrixData(i, 0);
-        for (int c = 1; c < blocks; ++c) {
-          auto val = matrixData(i, c);
-          if (val >= max_val) {
-            idx = c;
-            max_val = val;
-          }
-        }
-        *(output_data++) = idx;
-      }
-    } else {
-      for (int i = 0; i < block_size; ++i) {
-        matrixData.row(i).maxCoeff(&maxIndex);
-        *(output_data++) = maxIndex;
-      }
-    }
-  }
-
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ArgReduceInPlace<T, true>(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<int64_t>(), plan,
+                            select_last_index_, ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
+  ReducePlan plan;
   Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-  Eigen::MatrixXf::Index minIndex;
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-    if (select_last_index_) {
-      assert(blocks > 0);
-      for (int64_t i = 0; i < block_size; ++i) {
-        gsl::span<const T> row(input_data, blocks);
-        auto first = row.cbegin();
-        auto const end = row.cend();
-        auto min_el = first;
-        while (++first < end) {
-          if (*first <= *min_el) {
-            min_el = first;
-          }
-        }
-        *(output_data++) = min_el - row.cbegin();
-        input_data += blocks;
-      }
-    } else {
-      for (int64_t i = 0; i < block_size; ++i) {
-        ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).minCoeff(&minIndex);
-        *(output_data++) = minIndex;
-      }
-    }
-  } else {
-    auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-    if (select_last_index_) {
-      for (int i = 0; i < block_size; ++i) {
-        int idx = 0;
-        T min_val = matrixData(i, 0);
-        for (int c = 1; c < blocks; ++c) {
-          auto val = matrixData(i, c);
-          if (val <= min_val) {
-            idx = c;
-            min_val = val;
-          }
-        }
-        *(output_data++) = idx;
-      }
-    } else {
-      for (int i = 0; i < block_size; ++i) {
-        matrixData.row(i).minCoeff(&minIndex);
-        *(output_data++) = minIndex;
-      }
-    }
-  }
-
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
+  ArgReduceInPlace<T, false>(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<int64_t>(), plan,
+                             select_last_index_, ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
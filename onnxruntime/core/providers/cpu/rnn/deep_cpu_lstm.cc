@@ -18,6 +18,9 @@
 #include "core/framework/allocator.h"
 #include "core/platform/threadpool.h"
 
+#include <exception>
+#include <mutex>
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -175,64 +178,31 @@ static inline void ExecuteLambdaInParallel(TLambda lambda, int max, int step,
   }
 #else
 
-  // ORT_ENFORCE may and does throw at times from within the tasks that run
-  // on a thread-pool. Without propagating exceptions the process exits silently
-  // which will make diagnosing bugs more difficult.
-
-  // \! UGLY
-  // We have a problem here with the current thread-pool is that it takes std::function
-  // by value and copies it more than once (even though it is movable).
-  //
-  // To report status and exceptions properly it's better to use
-  // futures and promises but they are not copyable, so we can't come up with a functor
-  // with a promise member and we are downgrading to C++11 where we can't have captures that moved in.
-  //
-  // At the same time promises MUST live in the child thread so if we throw from the main thread
-  // we don't destroy any promises that are on the main thread stack which children threads may still be using.
-  //
-  // The only solution with the current Eigen that comes to mind is to have shared_ptr to with std::promise.
+  // The tasks run through TryBatchParallelFor instead of being scheduled and waited on with futures, as the
+  // calling thread runs the pending tasks of the pool while it waits. The pool also runs the nodes of the parallel
+  // executor, so a thread of it blocked on a task queued behind it could deadlock.
   //
+  // ORT_ENFORCE may and does throw at times from within the tasks. Without propagating exceptions the process
+  // exits silently, so the first exception is stored and re-thrown once all of the tasks have finished.
   const int total_tasks = max / (step > 0 ? step : 1) + (max % step > 0 ? 1 : 0);
-  std::vector<std::future<void> > futures;
-  futures.reserve(total_tasks);
-
-  if (ttp != nullptr) {
-    for (int i = 0, t = 0; i < max; i += step, ++t) {
-      auto p_ptr = std::make_shared<std::promise<void> >();
-      futures.push_back(p_ptr->get_future());
-      ttp->Schedule([p_ptr, lambda, i]() {
+  std::mutex exception_mutex;
+  std::exception_ptr pending_exception;
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ttp, total_tasks,
+      [&](std::ptrdiff_t t) {
         try {
-          lambda(i);
-          p_ptr->set_value();
+          lambda(static_cast<int>(t) * step);
         } catch (...) {
-          p_ptr->set_exception(std::current_exception());
-        }
-      });
-    }
-
-    // We'd like to wait until all of the tasks have finished
-    // even though one or more have already thrown. We will store
-    // the first exception and then will re-throw at the end.
-    std::exception_ptr pending_exception;
-    for (auto& fut : futures) {
-      try {
-        // get() will re-throw any exceptions
-        // the running task may throw
-        fut.get();
-      } catch (...) {
-        if (!pending_exception) {
-          pending_exception = std::current_exception();
+          std::lock_guard<std::mutex> lock(exception_mutex);
+          if (!pending_exception) {
+            pending_exception = std::current_exception();
+          }
         }
-      }
-    }
+      },
+      0);
 
-    if (pending_exception) {
-      std::rethrow_exception(pending_exception);
-    }
-  } else {
-    for (int i = 0; i < max; i += step) {
-      std::bind(lambda, i)();
-    }
+  if (pending_exception) {
+    std::rethrow_exception(pending_exception);
   }
 
 #endif
@@ -2,7 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/transpose.h"
+
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
+
 namespace onnxruntime {
 
 /* A permutation [a,b,c,...] indicates that 
@@ -34,13 +40,6 @@ static inline void IncrementIndex(std::vector<int64_t>& index, const std::vector
 
 // DoTransposeSingleBlock: specialization of DoTranspose for the num_blocks=1 case.
 // copies source tensor to target, transposing elements.
-static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const void* source, void* target,
-                                          size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  // copy
-  memcpy(target, source, blocksize);
-}
-
 static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::string* source, std::string* target) {
   const std::string* end = source + num_elts_in_block;
   std::copy(source, end, target);
@@ -48,25 +47,6 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 
 // DoTranspose: copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
-static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
-                            size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const uint8_t* source, uint8_t* target, size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
-    // convert target_index into an offset in source data
-    size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-    // copy
-    memcpy(target, source + source_offset * element_size, blocksize);
-
-    // increment target_index:
-    IncrementIndex(target_index, target_dims, num_axes);
-    target += blocksize;
-  }
-}
-
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
                             const std::string* source, std::string* target) {
@@ -85,78 +65,9 @@ static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target
   }
 }
 
-template <class T>
-inline void CopyPrim(uint8_t* target, const uint8_t* source) {
-  *reinterpret_cast<T*>(target) = *reinterpret_cast<const T*>(source);
-}
-
 // DoTransposeEltWise: specialization of DoTranspose for the num_elts_in_block=1 case.
 // copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
-static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
-                               const std::vector<size_t>& stride, const uint8_t* source, uint8_t* target,
-                               size_t element_size) {
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-
-  switch (element_size) {
-    case sizeof(uint64_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint64_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint32_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint32_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint16_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint16_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint8_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        *target = *(source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    default:
-      assert(false);
-  }
-}
-
 static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
                                const std::vector<size_t>& stride, const std::string* source, std::string* target) {
   // index used to iterate over target iteration-space
@@ -174,14 +85,11 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
   }
 }
 
-static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+static Status DoTransposeString(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
   const auto& input_shape = input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
 
-  const auto element_size = input.DataType()->Size();
-  const bool is_string_type = input.IsDataTypeString();
-
   std::vector<size_t> stride(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
@@ -209,345 +117,246 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     }
   }
 
-  if (is_string_type) {
-    const auto* input_data = input.template Data<std::string>();
-    auto* output_data = output.template MutableData<std::string>();
-    if (1 == prefix_blocksize) {
-      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
-    } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data);
-    } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data);
-    }
+  const auto* input_data = input.template Data<std::string>();
+  auto* output_data = output.template MutableData<std::string>();
+  if (1 == prefix_blocksize) {
+    DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
+  } else if (1 == suffix_blocksize) {
+    DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+                       input_data, output_data);
   } else {
-    const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-    auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-    if (1 == prefix_blocksize) {
-      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
-    } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data, element_size);
-    } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
-    }
+    DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
+                    input_data, output_data);
   }
 
   return Status::OK();
 }
 
 /*
-Optimizations for moving a single axis either inwards or outwards.
-
-If moving outwards we can use a single reader and multiple writers. The number of writers is equal to the value of 
-the axis being moved.
-
-  e.g. if the input is NHWC with shape {N, 300, 300, 3}, we can transpose to NCHW by reading once and having
-       one writer for each of the 3 channels at a different offset in the output, updating the offset for each item
-       in the batch of N.
-
-Similarly if one axis is moving inwards we can use a single writer and multiple readers. The number of readers is equal
-to the value of the axis being moved.
-
-  e.g. if the input is NCHW with shape {N, 3, 300, 300}, we can transpose to NHWC by writing once using one reader for
-       each of the 3 channels at a different offset in the input, updating the read offset for each item in the batch
-       of N.
-
-This can be generalized for any input where only one axis is being moved, with the block size for each read/write
-being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
-
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits. 
-We use memcpy if the block size is larger.
-
-We fall back to the default implementation in all other cases, and if the input is std::string.
+Transposes of all other types first collapse the permutation: axes of size 1 are dropped and input axes that stay
+adjacent in the output are merged into one. e.g. NCHW -> NHWC becomes {N, C, H*W} with permutation [0, 2, 1], and
+[B, S, H, D] -> [B, H, S, D] keeps D innermost on both sides.
+
+If the innermost axis is unchanged after collapsing, the tensor is copied as contiguous blocks. Otherwise the innermost
+input axis and the innermost output axis form a 2D plane that is transposed in tiles small enough to stay in cache,
+using the MLAS register blocked kernels for 8 and 32-bit elements. Both cases are split across the thread pool over the
+outer axes and the tiles.
 */
 
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
-template <typename T>
-static void SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                              int64_t num_loops, int64_t num_writers,
-                                              int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    T* output_for_first_writer = output_data;
-
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      T* output_for_current_writer = output_for_first_writer;
-
-      for (int64_t w = 0; w < num_writers; ++w) {
-        *output_for_current_writer = *input_data++;
-
-        // skip to output position for next writer
-        output_for_current_writer += writes_per_writer_per_loop;
-      }
-
-      ++output_for_first_writer;
+// Edge of the square tiles the transposed plane is processed in.
+static constexpr int64_t kTransposeTileSize = 64;
+
+// CollapseTranspose: removes size 1 axes and merges input axes that remain adjacent in the output.
+// dims receives the collapsed input shape and perm the permutation between the collapsed axes.
+static void CollapseTranspose(const std::vector<int64_t>& input_dims, const std::vector<size_t>& permutations,
+                              std::vector<int64_t>& dims, std::vector<size_t>& perm) {
+  const size_t rank = input_dims.size();
+
+  // position of each input axis when size 1 axes are ignored
+  std::vector<size_t> position(rank, 0);
+  size_t num_positions = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[i] != 1) {
+      position[i] = num_positions++;
     }
-
-    output_data += writes_per_loop;
   }
-}
-
-static void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                        int64_t from, int64_t to) {
-  ORT_UNUSED_PARAMETER(permutations);
-
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
 
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-
-  auto num_loops = input_shape.SizeToDimension(to);
-  auto num_writers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(from + 1);
-  auto writes_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
-  const int64_t bytes_per_write = block_size * element_size;
-
-  switch (bytes_per_write) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
+  // runs of input axes (first, last) that are adjacent in both input and output, in output order
+  std::vector<std::pair<size_t, size_t>> runs;
+  for (size_t i = 0; i < rank; ++i) {
+    size_t axis = permutations[i];
+    if (input_dims[axis] == 1) {
+      continue;
     }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
+    if (!runs.empty() && position[runs.back().second] + 1 == position[axis]) {
+      runs.back().second = axis;
+    } else {
+      runs.emplace_back(axis, axis);
     }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        uint8_t* output_for_first_writer = output_data;
-
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          uint8_t* output_for_current_writer = output_for_first_writer;
-
-          for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(output_for_current_writer, input_data, bytes_per_write);
-            // skip to output position for next writer
-            output_for_current_writer += (writes_per_writer_per_loop * bytes_per_write);
-            input_data += bytes_per_write;
-          }
-
-          output_for_first_writer += bytes_per_write;
-        }
+  }
 
-        output_data += writes_per_loop * bytes_per_write;
-      }
+  // the collapsed input axes are the runs sorted by their position in the input
+  std::vector<size_t> order(runs.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(), [&runs](size_t a, size_t b) { return runs[a].first < runs[b].first; });
+
+  dims.resize(runs.size());
+  perm.resize(runs.size());
+  for (size_t j = 0; j < order.size(); ++j) {
+    const auto& run = runs[order[j]];
+    int64_t size = 1;
+    for (size_t axis = run.first; axis <= run.second; ++axis) {
+      size *= input_dims[axis];
     }
+    dims[j] = size;
+    perm[order[j]] = j;
   }
 }
 
 template <typename T>
-static void SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                             int64_t num_loops, int64_t num_readers,
-                                             int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    const T* input_for_first_reader = input_data;
-
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      const T* input_for_current_reader = input_for_first_reader;
-
-      for (int64_t r = 0; r < num_readers; ++r) {
-        *output_data++ = *input_for_current_reader;
-        // skip to input position for next reader
-        input_for_current_reader += reads_per_reader_per_loop;
-      }
-
-      ++input_for_first_reader;
+static void TransposeTileScalar(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output,
+                                size_t rows, size_t cols) {
+  const T* input_data = reinterpret_cast<const T*>(input);
+  T* output_data = reinterpret_cast<T*>(output);
+  for (size_t m = 0; m < rows; ++m) {
+    for (size_t n = 0; n < cols; ++n) {
+      output_data[n * ld_output + m] = input_data[m * ld_input + n];
     }
-
-    input_data += reads_per_loop;
   }
 }
 
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
-static void TransposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                       int64_t from, int64_t to) {
-  ORT_UNUSED_PARAMETER(permutations);
-
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
-
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-
-  auto num_loops = input_shape.SizeToDimension(from);
-  auto num_readers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(to + 1);
-  auto reads_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
-  const int64_t bytes_per_read = block_size * element_size;
-
-  switch (bytes_per_read) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+// TransposeTile: transposes a rows x cols matrix with leading dimension ld_input into a cols x rows matrix
+// with leading dimension ld_output. Leading dimensions are in elements.
+static void TransposeTile(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output,
+                          size_t rows, size_t cols, size_t element_size) {
+  switch (element_size) {
+    case sizeof(uint8_t):
+      MlasTranspose(rows, cols, input, ld_input, output, ld_output);
       break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint16_t):
+      TransposeTileScalar<uint16_t>(input, ld_input, output, ld_output, rows, cols);
       break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint32_t):
+      MlasTranspose(rows, cols, reinterpret_cast<const uint32_t*>(input), ld_input,
+                    reinterpret_cast<uint32_t*>(output), ld_output);
       break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint64_t):
+      TransposeTileScalar<uint64_t>(input, ld_input, output, ld_output, rows, cols);
       break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        const uint8_t* input_for_first_reader = input_data;
-
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          const uint8_t* input_for_current_reader = input_for_first_reader;
-
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, input_for_current_reader, bytes_per_read);
-            output_data += bytes_per_read;
-
-            // skip to input position for next reader
-            input_for_current_reader += (reads_per_reader_per_loop * bytes_per_read);
-          }
-
-          input_for_first_reader += bytes_per_read;
+    default:
+      for (size_t m = 0; m < rows; ++m) {
+        for (size_t n = 0; n < cols; ++n) {
+          memcpy(output + (n * ld_output + m) * element_size, input + (m * ld_input + n) * element_size,
+                 element_size);
         }
-
-        input_data += reads_per_loop * bytes_per_read;
       }
-    }
   }
 }
 
-static void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                size_t from, size_t to) {
-  if (from > to) {
-    TransposeSingleAxisOutwards(permutations, input, output, from, to);
-  } else {
-    TransposeSingleAxisInwards(permutations, input, output, from, to);
+static void DoTransposeCollapsed(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                 concurrency::ThreadPool* tp) {
+  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
+  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  const size_t element_size = input.DataType()->Size();
+  const int64_t total = input.Shape().Size();
+
+  std::vector<int64_t> dims;
+  std::vector<size_t> perm;
+  CollapseTranspose(input.Shape().GetDims(), permutations, dims, perm);
+  const size_t rank = dims.size();
+
+  // nothing is moved once the permutation is collapsed
+  if (rank <= 1) {
+    memcpy(output_data, input_data, total * element_size);
+    return;
   }
-}
 
-static bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t& from, size_t& to) {
-  // if a single axis moved to an outer dimension, the values should be one lower than the index until the slot the
-  // axis was moved from, and equal to the index after that.
-  // e.g. axis 3 moves out to 1 would be: 0, 3, 1, 2, 4
-  auto check_moved_outwards = [&permutations](size_t cur, size_t moved_from) {
-    // we start processing with the slot after the moved one, so the expected value is one less than the index
-    size_t expected = cur - 1;
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        return false;
-      }
-
-      // we are at the slot the axis moved from, so do an additional increment before checking the next value
-      if (cur == moved_from) {
-        ++expected;
-      }
+  // input strides are indexed by input axis, output strides by output axis
+  std::vector<int64_t> input_strides(rank, 1);
+  std::vector<int64_t> output_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * dims[i];
+    output_strides[i - 1] = output_strides[i] * dims[perm[i]];
+  }
 
-      ++expected;
+  // computes the input and output offsets for a linear index over the given output axes
+  auto compute_offsets = [&](int64_t index, const std::vector<size_t>& axes, int64_t& input_offset,
+                             int64_t& output_offset) {
+    input_offset = 0;
+    output_offset = 0;
+    for (auto it = axes.rbegin(); it != axes.rend(); ++it) {
+      const int64_t dim = dims[perm[*it]];
+      const int64_t i = index % dim;
+      index /= dim;
+      input_offset += i * input_strides[perm[*it]];
+      output_offset += i * output_strides[*it];
     }
-
-    return true;
   };
 
-  // if a single axis moved to an inner dimension, the values should be one higher than the index until the slot the
-  // axis was moved to, and equal to the index after that.
-  // e.g. axis 1 moves inwards to 3 would be: 0, 2, 3, 1, 4
-  auto check_moved_inwards = [&permutations](size_t cur, size_t& moved_to) {
-    size_t started_at = cur;
-    size_t expected = cur + 1;
-    moved_to = std::numeric_limits<size_t>::max();
-
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        // if a single axis moved it must have come from the location we started at
-        if (started_at != permutations[cur]) {
-          return false;
-        }
-
-        moved_to = cur;
-      } else {
-        ++expected;
-      }
-    }
-
-    return moved_to != std::numeric_limits<size_t>::max();
-  };
-
-  bool single_axis_moved = false;
-  // check axis moving outwards (earlier entry in permutations)
-  for (size_t i = 0, end = permutations.size(); i < end; ++i) {
-    size_t axis = permutations[i];
-
-    if (axis != i) {
-      if (check_moved_outwards(i + 1, axis)) {
-        single_axis_moved = true;
-        to = i;
-        from = axis;
-      } else if (check_moved_inwards(i, to)) {
-        single_axis_moved = true;
-        from = i;
+  const size_t inner = rank - 1;
+
+  if (perm[inner] == inner) {
+    // the innermost axis is unchanged, so copy contiguous blocks of it
+    const int64_t block_size = dims[inner];
+    const size_t block_bytes = block_size * element_size;
+    std::vector<size_t> outer_axes(inner);
+    std::iota(outer_axes.begin(), outer_axes.end(), size_t{0});
+
+    const TensorOpCost cost{static_cast<double>(block_bytes), static_cast<double>(block_bytes),
+                            static_cast<double>(block_size)};
+    concurrency::ThreadPool::TryParallelFor(tp, total / block_size, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t block = first; block < last; ++block) {
+        int64_t input_offset, output_offset;
+        compute_offsets(block, outer_axes, input_offset, output_offset);
+        memcpy(output_data + output_offset * element_size, input_data + input_offset * element_size, block_bytes);
       }
+    });
+    return;
+  }
 
-      break;
+  // transpose the plane formed by the input axis that is innermost in the output (rows, contiguous in the output)
+  // and the innermost input axis (columns, contiguous in the input)
+  const size_t row_axis = perm[inner];
+  const size_t column_position = static_cast<size_t>(std::find(perm.begin(), perm.end(), inner) - perm.begin());
+  const int64_t rows = dims[row_axis];
+  const int64_t columns = dims[inner];
+  const int64_t ld_input = input_strides[row_axis];
+  const int64_t ld_output = output_strides[column_position];
+
+  std::vector<size_t> outer_axes;
+  for (size_t i = 0; i < inner; ++i) {
+    if (i != column_position) {
+      outer_axes.push_back(i);
     }
   }
 
-  return single_axis_moved;
+  const int64_t row_tiles = (rows + kTransposeTileSize - 1) / kTransposeTileSize;
+  const int64_t column_tiles = (columns + kTransposeTileSize - 1) / kTransposeTileSize;
+  const int64_t num_tiles = (total / (rows * columns)) * row_tiles * column_tiles;
+  const double tile_elements = static_cast<double>(std::min(rows, kTransposeTileSize) *
+                                                    std::min(columns, kTransposeTileSize));
+
+  const TensorOpCost cost{tile_elements * element_size, tile_elements * element_size, tile_elements};
+  concurrency::ThreadPool::TryParallelFor(tp, num_tiles, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t tile = first; tile < last; ++tile) {
+      const int64_t column_start = (tile % column_tiles) * kTransposeTileSize;
+      const int64_t row_start = ((tile / column_tiles) % row_tiles) * kTransposeTileSize;
+      int64_t input_offset, output_offset;
+      compute_offsets(tile / (column_tiles * row_tiles), outer_axes, input_offset, output_offset);
+
+      input_offset += row_start * ld_input + column_start;
+      output_offset += column_start * ld_output + row_start;
+
+      TransposeTile(input_data + input_offset * element_size, static_cast<size_t>(ld_input),
+                    output_data + output_offset * element_size, static_cast<size_t>(ld_output),
+                    static_cast<size_t>(std::min(kTransposeTileSize, rows - row_start)),
+                    static_cast<size_t>(std::min(kTransposeTileSize, columns - column_start)),
+                    element_size);
+    }
+  });
 }
 
-Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
-  Status status = Status::OK();
-
+Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                  concurrency::ThreadPool* tp) {
   auto input_type = input.DataType();
   auto output_type = output.DataType();
 
   if (input_type != output_type) {
-    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
-                             input_type, " != ", output_type);
-  } else {
-    size_t from = 0, to = 0;
-    bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
+                           input_type, " != ", output_type);
+  }
 
-    if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to);
-    } else {
-      // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output);
-    }
+  // The collapsed path divides by the sizes of the axes
+  if (input.Shape().Size() == 0) {
+    return Status::OK();
   }
 
-  return status;
+  if (input.IsDataTypeString()) {
+    return DoTransposeString(permutations, input, output);
+  }
+
+  DoTransposeCollapsed(permutations, input, output, tp);
+  return Status::OK();
 }
 
 Status Transpose::Compute(OpKernelContext* ctx) const {
@@ -571,17 +380,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_KERNEL(
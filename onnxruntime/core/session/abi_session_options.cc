@@ -96,6 +96,23 @@ ORT_API_STATUS_IMPL(OrtApis::DisableCpuMemArena, _In_ OrtSessionOptions* options
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SetCpuMemArenaOptions, _Inout_ OrtSessionOptions* options, size_t max_mem,
+                    OrtArenaExtendStrategy extend_strategy, int shrink_interval_runs, size_t shrink_above_bytes) {
+  if (extend_strategy != ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO && extend_strategy != ORT_ARENA_EXTEND_SAME_AS_REQUESTED) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Unknown arena extend strategy");
+  }
+  if (shrink_interval_runs < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "shrink_interval_runs must not be negative");
+  }
+
+  auto& arena_options = options->value.cpu_mem_arena;
+  arena_options.max_mem = max_mem;
+  arena_options.extend_strategy = static_cast<onnxruntime::ArenaExtendStrategy>(extend_strategy);
+  arena_options.shrink_interval_runs = shrink_interval_runs;
+  arena_options.shrink_above_bytes = shrink_above_bytes;
+  return nullptr;
+}
+
 ///< logger id to use for session output
 ORT_API_STATUS_IMPL(OrtApis::SetSessionLogId, _In_ OrtSessionOptions* options, const char* logid) {
   options->value.session_logid = logid;
@@ -160,3 +177,8 @@ ORT_API_STATUS_IMPL(OrtApis::DisablePerSessionThreads, _In_ OrtSessionOptions* o
   options->value.use_per_session_threads = false;
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtApis::EnableEnvSharedInitializers, _Inout_ OrtSessionOptions* options) {
+  options->value.use_env_shared_initializers = true;
+  return nullptr;
+}
@@ -2,7 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/session/environment.h"
+
+#include <algorithm>
+#include <thread>
+
 #include "core/framework/allocatormgr.h"
+#include "core/framework/shared_weights.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
 #include "onnx/defs/operator_sets.h"
@@ -40,12 +45,28 @@ Status Environment::Create(std::unique_ptr<logging::LoggingManager> logging_mana
   return status;
 }
 
+Environment::~Environment() = default;
+
+concurrency::ThreadPool* Environment::GetRunAsyncThreadPool() const {
+  std::call_once(run_async_thread_pool_once_, [this]() {
+    OrtThreadPoolParams to;
+    // a pool of a single thread isn't created by CreateThreadPool
+    to.thread_pool_size = std::max(2, static_cast<int>(std::thread::hardware_concurrency() / 2));
+    // the threads wait for requests rather than for the next piece of a parallel loop, so they don't spin
+    to.allow_spinning = false;
+    to.name = ORT_TSTR("run-async");
+    run_async_thread_pool_ = concurrency::CreateThreadPool(&Env::Default(), to, nullptr);
+  });
+  return run_async_thread_pool_.get();
+}
+
 Status Environment::Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
                                const OrtThreadingOptions* tp_options,
                                bool create_global_thread_pools) {
   auto status = Status::OK();
 
   logging_manager_ = std::move(logging_manager);
+  shared_weights_ = std::make_shared<SharedWeights>();
 
   // create thread pools
   if (create_global_thread_pools) {
@@ -185,7 +185,14 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, nullptr);
     }
-    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
+    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL &&
+        session_options_.inter_op_param.thread_pool_size == 0 && thread_pool_ != nullptr) {
+      // Without an explicit inter-op size the parallel executor schedules nodes on the intra-op pool.
+      // Nodes and the loops inside them then share one set of workers, and a thread waiting for a
+      // parallel loop runs queued nodes instead of oversubscribing the cores with a second pool.
+      LOGS(*session_logger_, INFO) << "Using the intra-op thread pool to run nodes in parallel";
+      inter_op_uses_intra_op_thread_pool_ = true;
+    } else if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
       OrtThreadPoolParams to = session_options_.inter_op_param;
       // If the thread pool can use all the processors, then
       // we set thread affinity.
@@ -209,6 +216,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
   }
 
+  session_env_ = &session_env;
+
   session_state_ = onnxruntime::make_unique<SessionState>(execution_providers_,
                                                           session_options_.enable_mem_pattern &&
                                                               session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL,
@@ -216,6 +225,11 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                                                           GetInterOpThreadPoolToUse());
   session_state_->SetLogger(*session_logger_);
   session_state_->SetDataTransferMgr(&data_transfer_mgr_);
+  session_state_->SetMemoryPatternCacheOptions(session_options_.mem_pattern_cache);
+  if (session_options_.use_env_shared_initializers) {
+    shared_weights_ = session_env.GetSharedWeights();
+    session_state_->SetSharedWeights(shared_weights_.get());
+  }
   session_profiler_.Initialize(session_logger_);
   session_state_->SetProfiler(session_profiler_);
   if (session_options_.enable_profiling) {
@@ -292,6 +306,12 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 }
 
 InferenceSession::~InferenceSession() {
+  {
+    // the pending runs use the session, so they must complete before it's destroyed
+    std::unique_lock<OrtMutex> lock(async_runs_mutex_);
+    async_runs_done_.wait(lock, [this]() { return num_pending_async_runs_ == 0; });
+  }
+
   if (session_options_.enable_profiling) {
     try {
       EndProfiling();
@@ -707,6 +727,8 @@ common::Status InferenceSession::CreateSubgraphSessionState(Graph& graph, Sessio
                                                  session_state.GetThreadPool(), session_state.GetInterOpThreadPool());
       subgraph_session_state->SetProfiler(session_profiler_);
       subgraph_session_state->SetLogger(*session_logger_);
+      subgraph_session_state->SetMemoryPatternCacheOptions(session_state.GetMemoryPatternCacheOptions());
+      subgraph_session_state->SetSharedWeights(session_state.GetSharedWeights());
       // Pass data transfer manager to subgraph.
       subgraph_session_state->SetDataTransferMgr(&session_state.GetDataTransferMgr());
       // Pass fused function manager to subgraph
@@ -842,6 +864,8 @@ common::Status InferenceSession::Initialize() {
     if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.arena_max_mem = session_options_.cpu_mem_arena.max_mem;
+      epi.arena_extend_strategy = session_options_.cpu_mem_arena.extend_strategy;
       auto p_cpu_exec_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -928,6 +952,57 @@ common::Status InferenceSession::Initialize() {
   return status;
 }
 
+size_t InferenceSession::ShrinkMemoryArenas() {
+  return ShrinkMemoryArenas(0);
+}
+
+size_t InferenceSession::ShrinkMemoryArenas(size_t keep_bytes, bool return_cached_chunks) {
+  size_t released_bytes = 0;
+  for (const auto& xp : execution_providers_) {
+    for (const auto* allocator : xp->GetAllocators()) {
+      const auto& info = allocator->Info();
+      auto* arena = dynamic_cast<IArenaAllocator*>(xp->GetAllocator(info.id, info.mem_type).get());
+      if (arena != nullptr && arena->AllocatedBytes() > keep_bytes) {
+        released_bytes += arena->Shrink(keep_bytes, return_cached_chunks);
+      }
+    }
+  }
+
+  if (released_bytes > 0) {
+    LOGS(*session_logger_, INFO) << "Released " << released_bytes << " bytes of unused arena memory.";
+  }
+  return released_bytes;
+}
+
+std::vector<std::pair<OrtMemoryInfo, AllocatorStats>> InferenceSession::GetArenaStats() const {
+  std::vector<std::pair<OrtMemoryInfo, AllocatorStats>> arena_stats;
+  for (const auto& xp : execution_providers_) {
+    for (const auto* allocator : xp->GetAllocators()) {
+      const auto& info = allocator->Info();
+      auto* arena = dynamic_cast<IArenaAllocator*>(xp->GetAllocator(info.id, info.mem_type).get());
+      if (arena != nullptr) {
+        AllocatorStats stats;
+        arena->GetStats(&stats);
+        arena_stats.emplace_back(arena->Info(), stats);
+      }
+    }
+  }
+  return arena_stats;
+}
+
+void InferenceSession::ShrinkMemoryArenasAfterRun(const RunOptions& run_options) {
+  const auto& arena_options = session_options_.cpu_mem_arena;
+  const int64_t num_completed_runs = ++num_completed_runs_;
+  if (run_options.shrink_memory_arenas ||
+      (arena_options.shrink_interval_runs > 0 && num_completed_runs % arena_options.shrink_interval_runs == 0)) {
+    ShrinkMemoryArenas(0);
+  } else if (arena_options.shrink_above_bytes > 0) {
+    // This runs after every Run while the arenas are above the threshold, so the chunks the threads cache for
+    // their next Run are kept.
+    ShrinkMemoryArenas(arena_options.shrink_above_bytes, false);
+  }
+}
+
 int InferenceSession::GetCurrentNumRuns() const {
   return current_num_runs_.load();
 }
@@ -1157,6 +1232,7 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
   }
 
   --current_num_runs_;
+  ShrinkMemoryArenasAfterRun(run_options);
 
   // keep track of telemetry
   ++telemetry_.total_runs_since_last_;
@@ -1188,6 +1264,38 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
   return retval;
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                          const std::vector<OrtValue>& feeds,
+                                          const std::vector<std::string>& output_names, RunAsyncCallback callback) {
+  if (!callback) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "RunAsync requires a callback");
+  }
+  concurrency::ThreadPool* thread_pool = session_env_->GetRunAsyncThreadPool();
+  if (thread_pool == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The thread pool to run asynchronously could not be created");
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+    ++num_pending_async_runs_;
+  }
+  thread_pool->Schedule([this, &run_options, feed_names, feeds, output_names, callback]() {
+    std::vector<OrtValue> fetches;
+    Status status = Run(run_options, feed_names, feeds, output_names, &fetches);
+    if (!status.IsOK()) {
+      fetches.clear();
+    }
+    {
+      // the session may be destroyed as soon as the count drops, including by the callback
+      std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+      --num_pending_async_runs_;
+      async_runs_done_.notify_all();
+    }
+    callback(status, fetches);
+  });
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
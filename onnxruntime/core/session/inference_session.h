@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -240,6 +241,22 @@ class InferenceSession {
                      const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
                      std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
 
+  using RunAsyncCallback = std::function<void(const common::Status& status, std::vector<OrtValue>& fetches)>;
+
+  /**
+    * Enqueues a Run on the thread pool of the environment (see Environment::GetRunAsyncThreadPool) and returns
+    * without waiting for it. callback is invoked on a thread of that pool with the status of the Run and, if it
+    * succeeded, the outputs in the order specified by output_names. The outputs are allocated by the session.
+    * The feeds and names are copied. run_options is referenced and must stay valid until callback is invoked;
+    * setting its terminate flag cancels the Run, which then completes with an error status.
+    * The destructor waits for the pending runs of the session, but not for the callbacks, so the session can be
+    * destroyed from a callback.
+    * @return OK if the Run was enqueued, in which case callback is invoked exactly once.
+    */
+  common::Status RunAsync(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                          const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                          RunAsyncCallback callback) ORT_MUST_USE_RESULT;
+
   /**
     * Run a pre-loaded and pre-intialized model.
     * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -307,6 +324,19 @@ class InferenceSession {
     */
   int GetCurrentNumRuns() const;
 
+  /**
+    * Return the memory held by the arenas of the execution providers that isn't used by any allocation to the
+    * system. Run calls in progress are not affected.
+    * @return the number of bytes released.
+    */
+  size_t ShrinkMemoryArenas();
+
+  /**
+    * Get the statistics of the arenas of the execution providers.
+    * @return the memory info of each arena with its statistics.
+    */
+  std::vector<std::pair<OrtMemoryInfo, AllocatorStats>> GetArenaStats() const;
+
   /**
     * Get the names of registered Execution Providers. The returned vector is ordered by Execution Provider
     * priority. The first provider in the vector has the highest priority.
@@ -412,6 +442,13 @@ class InferenceSession {
 
   void InitLogger(logging::LoggingManager* logging_manager);
 
+  // Shrinks the arenas holding more than keep_bytes to at most keep_bytes if possible. The arenas are only locked
+  // if they hold more than keep_bytes.
+  size_t ShrinkMemoryArenas(size_t keep_bytes, bool return_cached_chunks = true);
+
+  // Applies RunOptions::shrink_memory_arenas and the shrink policy of SessionOptions::cpu_mem_arena.
+  void ShrinkMemoryArenasAfterRun(const RunOptions& run_options);
+
   common::Status CheckShapes(const std::string& input_name, const TensorShape& input_shape,
                              const TensorShape& expected_shape) const ORT_MUST_USE_RESULT;
 
@@ -450,6 +487,10 @@ class InferenceSession {
   // The list of execution providers.
   ExecutionProviders execution_providers_;
 
+  // The initializers shared through the environment when session_options_.use_env_shared_initializers is set.
+  // Kept alive for the kernels in session_state_ that use their prepacked forms.
+  std::shared_ptr<SharedWeights> shared_weights_;
+
  protected:
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
@@ -463,7 +504,10 @@ class InferenceSession {
   }
 
   onnxruntime::concurrency::ThreadPool* GetInterOpThreadPoolToUse() const {
-    return session_options_.use_per_session_threads ? inter_op_thread_pool_.get() : inter_op_thread_pool_from_env_;
+    if (!session_options_.use_per_session_threads) {
+      return inter_op_thread_pool_from_env_;
+    }
+    return inter_op_uses_intra_op_thread_pool_ ? thread_pool_.get() : inter_op_thread_pool_.get();
   }
 
  private:
@@ -471,6 +515,8 @@ class InferenceSession {
   // when use_per_session_threads is true.
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
+  // true when the parallel executor schedules nodes on thread_pool_ instead of inter_op_thread_pool_
+  bool inter_op_uses_intra_op_thread_pool_ = false;
 
   // Global threadpools. These are intialized and used when use_per_session_threads is false *and*
   // the environment is created with create_global_thread_pools = true.
@@ -505,6 +551,16 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // Number of completed Run calls, to apply CpuMemArenaOptions::shrink_interval_runs
+  std::atomic<int64_t> num_completed_runs_{0};
+
+  // The environment the session was created with, which owns the thread pool that RunAsync uses.
+  const Environment* session_env_ = nullptr;
+  // Number of runs enqueued by RunAsync that haven't completed yet, which the destructor waits for.
+  int num_pending_async_runs_ = 0;  // GUARDED_BY(async_runs_mutex_)
+  onnxruntime::OrtMutex async_runs_mutex_;
+  onnxruntime::OrtCondVar async_runs_done_;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -22,6 +22,7 @@
 #include "core/framework/callback.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/onnxruntime_typeinfo.h"
+#include "core/framework/shared_weights.h"
 #include "core/session/inference_session.h"
 #include "core/session/ort_apis.h"
 #include "core/session/ort_env.h"
@@ -519,6 +520,52 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  if (callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "callback cannot be null");
+  }
+
+  std::vector<std::string> feed_names(input_len);
+  std::vector<OrtValue> feeds(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    feed_names[i] = input_names[i];
+    feeds[i] = *reinterpret_cast<const ::OrtValue*>(input[i]);
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  static const OrtRunOptions default_run_options;
+  auto on_complete = [callback, user_data](const Status& status, std::vector<OrtValue>& fetches) {
+    if (!status.IsOK()) {
+      callback(user_data, nullptr, 0, ToOrtStatus(status));
+      return;
+    }
+    std::vector<OrtValue*> outputs(fetches.size());
+    for (size_t i = 0; i != fetches.size(); ++i) {
+      outputs[i] = new OrtValue(std::move(fetches[i]));
+    }
+    callback(user_data, outputs.data(), outputs.size(), nullptr);
+  };
+  return ToOrtStatus(session->RunAsync(run_options == nullptr ? default_run_options : *run_options, feed_names,
+                                       feeds, output_names, on_complete));
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::IsTensor, _In_ const OrtValue* value, _Out_ int* out) {
   auto v = reinterpret_cast<const ::OrtValue*>(value);
   *out = v->IsTensor() ? 1 : 0;
@@ -691,6 +738,49 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionShrinkMemoryArenas, _Inout_ OrtSession* sess) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  session->ShrinkMemoryArenas();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetArenaStats, _In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                    _Out_ OrtArenaStats* out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  for (const auto& arena_stats : session->GetArenaStats()) {
+    if (arena_stats.first == *mem_info) {
+      const auto& stats = arena_stats.second;
+      out->num_allocs = stats.num_allocs;
+      out->bytes_in_use = stats.bytes_in_use;
+      out->total_allocated_bytes = stats.total_allocated_bytes;
+      out->max_bytes_in_use = stats.max_bytes_in_use;
+      out->max_alloc_size = stats.max_alloc_size;
+      out->bytes_limit = stats.bytes_limit;
+      out->num_regions = stats.num_regions;
+      out->largest_free_block_bytes = stats.largest_free_block_bytes;
+      return nullptr;
+    }
+  }
+  return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "The session has no arena for the given memory info.");
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::AddSharedInitializer, _Inout_ OrtEnv* env, _In_z_ const char* name,
+                    _In_ const OrtValue* val) {
+  API_IMPL_BEGIN
+  if (name == nullptr || val == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "name and val must not be null");
+  }
+  if (!val->IsTensor() || strcmp(val->Get<Tensor>().Location().name, onnxruntime::CPU) != 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "A shared initializer must be a CPU tensor");
+  }
+  return ToOrtStatus(env->GetEnvironment().GetSharedWeights()->AddInitializer(name, *val));
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -1565,7 +1655,14 @@ static constexpr OrtApi ort_api_1_to_3 = {
     &OrtApis::DisablePerSessionThreads,
     &OrtApis::CreateThreadingOptions,
     &OrtApis::ReleaseThreadingOptions,
-    &OrtApis::ModelMetadataGetCustomMetadataMapKeys};
+    &OrtApis::ModelMetadataGetCustomMetadataMapKeys,
+    &OrtApis::SetCpuMemArenaOptions,
+    &OrtApis::RunOptionsSetShrinkMemoryArenas,
+    &OrtApis::SessionShrinkMemoryArenas,
+    &OrtApis::SessionGetArenaStats,
+    &OrtApis::AddSharedInitializer,
+    &OrtApis::EnableEnvSharedInitializers,
+    &OrtApis::RunAsync};
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
 // If this assert hits, read the above 'Rules on how to add a new Ort API version'
@@ -195,4 +195,18 @@ ORT_API(void, ReleaseThreadingOptions, _Frees_ptr_opt_ OrtThreadingOptions*);
 ORT_API_STATUS_IMPL(ModelMetadataGetCustomMetadataMapKeys, _In_ const OrtModelMetadata* model_metadata,
                     _Inout_ OrtAllocator* allocator, _Outptr_result_buffer_maybenull_(*num_keys) char*** keys, _Out_ int64_t* num_keys);
 
+ORT_API_STATUS_IMPL(SetCpuMemArenaOptions, _Inout_ OrtSessionOptions* options, size_t max_mem,
+                    OrtArenaExtendStrategy extend_strategy, int shrink_interval_runs, size_t shrink_above_bytes);
+ORT_API_STATUS_IMPL(RunOptionsSetShrinkMemoryArenas, _Inout_ OrtRunOptions* options, int shrink);
+ORT_API_STATUS_IMPL(SessionShrinkMemoryArenas, _Inout_ OrtSession* sess);
+ORT_API_STATUS_IMPL(SessionGetArenaStats, _In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                    _Out_ OrtArenaStats* out);
+ORT_API_STATUS_IMPL(AddSharedInitializer, _Inout_ OrtEnv* env, _In_z_ const char* name, _In_ const OrtValue* val);
+ORT_API_STATUS_IMPL(EnableEnvSharedInitializers, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+
 }  // namespace OrtApis
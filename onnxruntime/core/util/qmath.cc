@@ -60,4 +60,82 @@ void QGemmu8u8_s32(
   GemmlowpMultiplyu8u8_s32(lhs_data, rhs_data, result_data, lhs_offset, rhs_offset, M, N, K, thread_pool);
 #endif
 }
+
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+static void QGemmBatchu8x8_s32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    const std::vector<size_t>& lhs_offsets,
+    const uint8_t lhs_offset,
+    const void* rhs_data,
+    const std::vector<size_t>& rhs_offsets,
+    const uint8_t rhs_offset,
+    bool rhs_signed,
+    int32_t* result_data,
+    const std::vector<size_t>& result_offsets,
+    concurrency::ThreadPool* thread_pool) {
+  const size_t batch_size = result_offsets.size();
+  std::vector<MLAS_GEMM_U8X8_DATA_PARAMS> gemm_params(batch_size);
+  for (size_t i = 0; i < batch_size; i++) {
+    auto& params = gemm_params[i];
+    params.A = lhs_data + lhs_offsets[i];
+    params.lda = static_cast<size_t>(K);
+    params.B = static_cast<const uint8_t*>(rhs_data) + rhs_offsets[i];
+    params.ldb = static_cast<size_t>(N);
+    params.C = result_data + result_offsets[i];
+    params.ldc = static_cast<size_t>(N);
+  }
+  MlasGemmBatch(M, N, K, gemm_params.data(), batch_size, lhs_offset, rhs_offset, rhs_signed, thread_pool);
+}
+#endif
+
+void QGemmBatchu8s8_s32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    const std::vector<size_t>& lhs_offsets,
+    const uint8_t lhs_offset,
+    const int8_t* rhs_data,
+    const std::vector<size_t>& rhs_offsets,
+    const int8_t rhs_offset,
+    int32_t* result_data,
+    const std::vector<size_t>& result_offsets,
+    concurrency::ThreadPool* thread_pool) {
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  QGemmBatchu8x8_s32(M, N, K, lhs_data, lhs_offsets, lhs_offset, rhs_data, rhs_offsets,
+                     static_cast<uint8_t>(rhs_offset), true, result_data, result_offsets, thread_pool);
+#else
+  for (size_t i = 0; i < result_offsets.size(); i++) {
+    QGemmu8s8_s32(M, N, K, lhs_data + lhs_offsets[i], K, lhs_offset, rhs_data + rhs_offsets[i], N, rhs_offset,
+                  result_data + result_offsets[i], N, thread_pool);
+  }
+#endif
+}
+
+void QGemmBatchu8u8_s32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    const std::vector<size_t>& lhs_offsets,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    const std::vector<size_t>& rhs_offsets,
+    const uint8_t rhs_offset,
+    int32_t* result_data,
+    const std::vector<size_t>& result_offsets,
+    concurrency::ThreadPool* thread_pool) {
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  QGemmBatchu8x8_s32(M, N, K, lhs_data, lhs_offsets, lhs_offset, rhs_data, rhs_offsets,
+                     rhs_offset, false, result_data, result_offsets, thread_pool);
+#else
+  for (size_t i = 0; i < result_offsets.size(); i++) {
+    QGemmu8u8_s32(M, N, K, lhs_data + lhs_offsets[i], K, lhs_offset, rhs_data + rhs_offsets[i], N, rhs_offset,
+                  result_data + result_offsets[i], N, thread_pool);
+  }
+#endif
+}
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "core/platform/threadpool.h"
 
 #if defined(_M_AMD64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
@@ -39,4 +41,35 @@ void QGemmu8u8_s32(
     int ldc,
     concurrency::ThreadPool* thread_pool);
 
+// Batched variants of the above for a stack of row major matrices with leading
+// dimensions of K, N and N. The matrices of each batch entry begin at the given
+// element offsets from lhs_data, rhs_data and result_data.
+void QGemmBatchu8s8_s32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    const std::vector<size_t>& lhs_offsets,
+    const uint8_t lhs_offset,
+    const int8_t* rhs_data,
+    const std::vector<size_t>& rhs_offsets,
+    const int8_t rhs_offset,
+    int32_t* result_data,
+    const std::vector<size_t>& result_offsets,
+    concurrency::ThreadPool* thread_pool);
+
+void QGemmBatchu8u8_s32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    const std::vector<size_t>& lhs_offsets,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    const std::vector<size_t>& rhs_offsets,
+    const uint8_t rhs_offset,
+    int32_t* result_data,
+    const std::vector<size_t>& result_offsets,
+    concurrency::ThreadPool* thread_pool);
+
 }  // namespace onnxruntime
@@ -7,21 +7,15 @@
 #include "Featurizers/CountVectorizerFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace NS = Microsoft::Featurizer;
 
 namespace onnxruntime {
 namespace featurizers {
 
-void CountVectorizerTransformerImpl(OpKernelContext* ctx) {
-  // Create the transformer
-  Microsoft::Featurizer::Featurizers::CountVectorizerTransformer transformer(
-      [ctx]() {
-        const auto* state_tensor(ctx->Input<Tensor>(0));
-        const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-        Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-        return Microsoft::Featurizer::Featurizers::CountVectorizerTransformer(archive);
-      }());
+void CountVectorizerTransformerImpl(OpKernelContext* ctx, const TransformerCache& cache) {
+  using TransformerT = Microsoft::Featurizer::Featurizers::CountVectorizerTransformer;
 
   // Get the input
   const auto* input_tensor = ctx->Input<Tensor>(1);
@@ -41,20 +35,25 @@ void CountVectorizerTransformerImpl(OpKernelContext* ctx) {
       output_data[el.Index] = el.Value;
     }
   };
-  transformer.execute(*input_data, callback);
-  // The flush() does nothing but shows Featurizers concept
-  callback_allow = false;
-  transformer.flush(callback);
+  cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+    transformer.execute(*input_data, callback);
+    // The flush() does nothing but shows Featurizers concept
+    callback_allow = false;
+    transformer.flush(callback);
+  });
 };
 
 class CountVectorizerTransformer final : public OpKernel {
  public:
-  explicit CountVectorizerTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit CountVectorizerTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
   Status Compute(OpKernelContext* ctx) const override {
-    CountVectorizerTransformerImpl(ctx);
+    CountVectorizerTransformerImpl(ctx, cache_);
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
@@ -9,24 +9,20 @@
 #include "Featurizers/ForecastingPivotFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace NS = Microsoft::Featurizer;
 namespace onnxruntime {
 namespace featurizers {
 
 template <typename T>
 struct ForecastingPivotTransformerImpl {
-  void operator()(OpKernelContext* ctx) const {
+  void operator()(OpKernelContext* ctx, const TransformerCache& cache) const {
     using MatrixT = NS::RowMajMatrix<typename NS::Traits<T>::nullable_type>;
     using InputType = std::vector<Eigen::Map<const MatrixT>>;
     using OutputType = std::vector<T>;
     using TransformerT = Microsoft::Featurizer::Featurizers::ForecastingPivotTransformer<std::tuple<typename InputType::iterator, typename InputType::iterator>>;
 
-    //Get the transformer
-    const auto* state_tensor(ctx->Input<Tensor>(0));
-    const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-    Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-    TransformerT transformer(archive);
-
     // Get the Number of Rows
     const auto* input_tensor_temp(ctx->Input<Tensor>(1));
     const int64_t row_num = input_tensor_temp->Shape()[0];
@@ -44,33 +40,35 @@ struct ForecastingPivotTransformerImpl {
     InputType input;
     input.reserve(input_node_1_count);
     std::unordered_map<int, std::tuple<const T*,int64_t, int64_t>> dataPtrMap;
-    for (int64_t row_idx = 0; row_idx < row_num; ++row_idx) {
-      //Prepare Input and Output
-      input.clear();
-      for (int index = input_node_0_count; index < input_node_0_count + input_node_1_count; ++index) {
-        if (row_idx == 0) {
-          //Get the Input
-          const auto* input_tensor(ctx->Input<Tensor>(index));
-          const T* input_data(input_tensor->template Data<T>());
-          // Matrix Eigen raw buffer mapping
-          const int64_t input_dim_1 = input_tensor->Shape()[1];
-          const int64_t input_dim_2 = input_tensor->Shape()[2];
-          //store data pointer and dimension information
-          std::tuple<const T*,int64_t, int64_t> info_tuple(input_data, input_dim_1, input_dim_2);
-          dataPtrMap.insert(std::pair<int, std::tuple<const T*,int64_t, int64_t>>(index, info_tuple));
+    cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+      for (int64_t row_idx = 0; row_idx < row_num; ++row_idx) {
+        //Prepare Input and Output
+        input.clear();
+        for (int index = input_node_0_count; index < input_node_0_count + input_node_1_count; ++index) {
+          if (row_idx == 0) {
+            //Get the Input
+            const auto* input_tensor(ctx->Input<Tensor>(index));
+            const T* input_data(input_tensor->template Data<T>());
+            // Matrix Eigen raw buffer mapping
+            const int64_t input_dim_1 = input_tensor->Shape()[1];
+            const int64_t input_dim_2 = input_tensor->Shape()[2];
+            //store data pointer and dimension information
+            std::tuple<const T*,int64_t, int64_t> info_tuple(input_data, input_dim_1, input_dim_2);
+            dataPtrMap.insert(std::pair<int, std::tuple<const T*,int64_t, int64_t>>(index, info_tuple));
+          }
+          std::tuple<const T*,int64_t, int64_t> &inputTuple(dataPtrMap.at(index));
+          const T* input_data(std::get<0>(inputTuple));
+          const int64_t input_dim_1(std::get<1>(inputTuple));
+          const int64_t input_dim_2(std::get<2>(inputTuple));
+          input.push_back(typename InputType::value_type(input_data, input_dim_1, input_dim_2));
+          //Increment data pointer
+          input_data += input_dim_1 * input_dim_2;
         }
-        std::tuple<const T*,int64_t, int64_t> &inputTuple(dataPtrMap.at(index));
-        const T* input_data(std::get<0>(inputTuple));
-        const int64_t input_dim_1(std::get<1>(inputTuple));
-        const int64_t input_dim_2(std::get<2>(inputTuple));
-        input.push_back(typename InputType::value_type(input_data, input_dim_1, input_dim_2));
-        //Increment data pointer
-        input_data += input_dim_1 * input_dim_2;
+        //Execute
+        transformer.execute(std::make_tuple(input.begin(), input.end()), callback_fn);
       }
-      //Execute
-      transformer.execute(std::make_tuple(input.begin(), input.end()), callback_fn);
-    }
-    transformer.flush(callback_fn);
+      transformer.flush(callback_fn);
+    });
 
     // Prepare the Output
     TensorShape output_shape({static_cast<int64_t>(output.size()), static_cast<int64_t>(output[0].size())});
@@ -84,16 +82,19 @@ struct ForecastingPivotTransformerImpl {
 
 class ForecastingPivotTransformer final : public OpKernel {
  public:
-  explicit ForecastingPivotTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit ForecastingPivotTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
     utils::MLTypeCallDispatcher<ForecastingPivotTransformerImpl, float, double>
         t_disp(ctx->Input<Tensor>(1)->GetElementType());
-    t_disp.Invoke(ctx);
+    t_disp.Invoke(ctx, cache_);
 
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
@@ -9,21 +9,15 @@
 #include "Featurizers/FromStringFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace onnxruntime {
 namespace featurizers {
 
 template <typename T>
 struct FromStringTransformerImpl {
-  void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
-    Microsoft::Featurizer::Featurizers::FromStringTransformer<T> transformer(
-        [ctx]() {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-          return Microsoft::Featurizer::Featurizers::FromStringTransformer<T>(archive);
-        }());
+  void operator()(OpKernelContext* ctx, const TransformerCache& cache) const {
+    using TransformerT = Microsoft::Featurizer::Featurizers::FromStringTransformer<T>;
 
     const auto* input_tensor(ctx->Input<Tensor>(1));
     const std::string* input_data(input_tensor->Data<std::string>());
@@ -34,15 +28,15 @@ struct FromStringTransformerImpl {
 
     // Execute
     const int64_t length(input_tensor->Shape().Size());
-    for (int64_t i = 0; i < length; ++i) {
-      output_data[i] = transformer.execute(input_data[i]);
-    }
+    cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+      ExecuteBatch(transformer, input_data, length, output_data);
+    });
   }
 };
 
 template <>
 struct FromStringTransformerImpl<std::string> {
-  void operator()(OpKernelContext* ctx) const {
+  void operator()(OpKernelContext* ctx, const TransformerCache& /*cache*/) const {
     const auto* input_tensor(ctx->Input<Tensor>(1));
     const std::string* input_data(input_tensor->Data<std::string>());
     const int64_t num_items = input_tensor->Shape().Size();
@@ -57,7 +51,8 @@ struct FromStringTransformerImpl<std::string> {
 class FromStringTransformer final : public OpKernel {
  public:
   explicit FromStringTransformer(const OpKernelInfo& info) : OpKernel(info),
-                                                             result_type_(ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UNDEFINED) {
+                                                             result_type_(ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UNDEFINED),
+                                                             cache_(info) {
     int64_t result_type;
     ORT_ENFORCE(info.GetAttr<int64_t>("result_type", &result_type).IsOK(), "result_type is a mandatory attribute");
     ORT_ENFORCE(ONNX_NAMESPACE::TensorProto::DataType_IsValid(static_cast<int>(result_type)), "Invalid result_type value");
@@ -68,12 +63,13 @@ class FromStringTransformer final : public OpKernel {
     utils::MLTypeCallDispatcher<FromStringTransformerImpl, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t,
                                 int64_t, uint64_t, float, double, bool, std::string>
         t_disp(result_type_);
-    t_disp.Invoke(ctx);
+    t_disp.Invoke(ctx, cache_);
     return Status::OK();
   }
 
  private:
   ONNX_NAMESPACE::TensorProto::DataType result_type_;
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
@@ -9,21 +9,15 @@
 #include "Featurizers/HashOneHotVectorizerFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace onnxruntime {
 namespace featurizers {
 
 template <typename InputT>
 struct HashOneHotVectorizerTransformerImpl {
-  void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
-    Microsoft::Featurizer::Featurizers::HashOneHotVectorizerTransformer<InputT> transformer(
-        [ctx](void) {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-          return Microsoft::Featurizer::Featurizers::HashOneHotVectorizerTransformer<InputT>(archive);
-        }());
+  void operator()(OpKernelContext* ctx, const TransformerCache& cache) const {
+    using TransformerT = Microsoft::Featurizer::Featurizers::HashOneHotVectorizerTransformer<InputT>;
 
     // Get the input
     const auto* input_tensor(ctx->Input<Tensor>(1));
@@ -41,28 +35,33 @@ struct HashOneHotVectorizerTransformerImpl {
     // Execute
     const int64_t length(input_tensor->Shape().Size());
 
-    for (int64_t i = 0; i < length; ++i) {
-      auto result(transformer.execute(input_data[i]));
+    cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+      for (int64_t i = 0; i < length; ++i) {
+        auto result(transformer.execute(input_data[i]));
 
-      NumElements_data[i] = std::move(result.NumElements);
-      Value_data[i] = std::move(result.Value);
-      Index_data[i] = std::move(result.Index);
-    }
+        NumElements_data[i] = std::move(result.NumElements);
+        Value_data[i] = std::move(result.Value);
+        Index_data[i] = std::move(result.Index);
+      }
+    });
   }
 };
 
 class HashOneHotVectorizerTransformer final : public OpKernel {
  public:
-  explicit HashOneHotVectorizerTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit HashOneHotVectorizerTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
     utils::MLTypeCallDispatcher<HashOneHotVectorizerTransformerImpl, int8_t, uint8_t, int16_t, uint16_t, int32_t,
                                 uint32_t, int64_t, uint64_t, float, double, bool, std::string>
         t_disp(ctx->Input<Tensor>(1)->GetElementType());
-    t_disp.Invoke(ctx);
+    t_disp.Invoke(ctx, cache_);
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
@@ -9,21 +9,15 @@
 #include "Featurizers/LabelEncoderFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace onnxruntime {
 namespace featurizers {
 
 template <typename InputT>
 struct LabelEncoderTransformerImpl {
-  void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
-    Microsoft::Featurizer::Featurizers::LabelEncoderTransformer<InputT> transformer(
-        [ctx](void) {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-          return Microsoft::Featurizer::Featurizers::LabelEncoderTransformer<InputT>(archive);
-        }());
+  void operator()(OpKernelContext* ctx, const TransformerCache& cache) const {
+    using TransformerT = Microsoft::Featurizer::Featurizers::LabelEncoderTransformer<InputT>;
 
     // Get the input
     const auto* input_tensor(ctx->Input<Tensor>(1));
@@ -36,24 +30,27 @@ struct LabelEncoderTransformerImpl {
     // Execute
     const int64_t length(input_tensor->Shape().Size());
 
-    for (int64_t i = 0; i < length; ++i) {
-      output_data[i] = transformer.execute(input_data[i]);
-    }
+    cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+      ExecuteBatch(transformer, input_data, length, output_data);
+    });
   }
 };
 
 class LabelEncoderTransformer final : public OpKernel {
  public:
-  explicit LabelEncoderTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit LabelEncoderTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
     utils::MLTypeCallDispatcher<LabelEncoderTransformerImpl, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t,
                                 int64_t, uint64_t, float, double, bool, std::string>
         t_disp(ctx->Input<Tensor>(1)->GetElementType());
-    t_disp.Invoke(ctx);
+    t_disp.Invoke(ctx, cache_);
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
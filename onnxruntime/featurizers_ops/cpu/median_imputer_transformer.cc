@@ -9,6 +9,8 @@
 #include "Featurizers/MedianImputerFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace onnxruntime {
 namespace featurizers {
 
@@ -43,16 +45,8 @@ struct MedianImputerTransformerT : public FeatDetails::MedianImputerEstimatorImp
 
 template <typename InputT>
 struct MedianImputerTransformerImpl {
-  void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
-    MedianImputerTransformerT<InputT> transformer(
-        [ctx](void) {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-          return MedianImputerTransformerT<InputT>(archive);
-        }());
+  void operator()(OpKernelContext* ctx, const TransformerCache& cache) const {
+    using TransformerT = MedianImputerTransformerT<InputT>;
 
     // Get the input
     const auto* input_tensor(ctx->Input<Tensor>(1));
@@ -65,22 +59,26 @@ struct MedianImputerTransformerImpl {
     // Execute
     const int64_t length(input_tensor->Shape().Size());
 
-    for (int64_t i = 0; i < length; ++i) {
-      output_data[i] = transformer.execute(PreprocessOptional(input_data[i]));
-    }
+    cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+      ExecuteBatch(transformer, input_data, length, output_data,
+                   [](const InputT& value) { return PreprocessOptional(value); });
+    });
   }
 };
 
 class MedianImputerTransformer final : public OpKernel {
  public:
-  explicit MedianImputerTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit MedianImputerTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
     utils::MLTypeCallDispatcher<MedianImputerTransformerImpl, float, double, std::string> t_disp(ctx->Input<Tensor>(1)->GetElementType());
-    t_disp.Invoke(ctx);
+    t_disp.Invoke(ctx, cache_);
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
@@ -9,6 +9,8 @@
 #include "Featurizers/ModeImputerFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace onnxruntime {
 namespace featurizers {
 
@@ -38,16 +40,8 @@ struct ModeImputerTransformerT : public FeatDetails::ModeImputerEstimatorImpl<T,
 
 template <typename T>
 struct ModeImputerTransformerImpl {
-  void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
-    ModeImputerTransformerT<T> transformer(
-        [ctx]() {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-          return ModeImputerTransformerT<T>(archive);
-        }());
+  void operator()(OpKernelContext* ctx, const TransformerCache& cache) const {
+    using TransformerT = ModeImputerTransformerT<T>;
 
     // Get the input
     const auto* input_tensor(ctx->Input<Tensor>(1));
@@ -60,22 +54,26 @@ struct ModeImputerTransformerImpl {
     // Execute
     const int64_t length(input_tensor->Shape().Size());
 
-    for (int64_t i = 0; i < length; ++i) {
-      output_data[i] = transformer.execute(PreprocessOptional(input_data[i]));
-    }
+    cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+      ExecuteBatch(transformer, input_data, length, output_data,
+                   [](const T& value) { return PreprocessOptional(value); });
+    });
   }
 };
 
 class ModeImputerTransformer final : public OpKernel {
  public:
-  explicit ModeImputerTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit ModeImputerTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
     utils::MLTypeCallDispatcher<ModeImputerTransformerImpl, float, double, std::string> t_disp(ctx->Input<Tensor>(1)->GetElementType());
-    t_disp.Invoke(ctx);
+    t_disp.Invoke(ctx, cache_);
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
@@ -9,23 +9,16 @@
 #include "Featurizers/Base/NormalizeFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace onnxruntime {
 namespace featurizers {
 
 template <typename InputT>
 struct NormalizeTransformerImpl {
-  void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
+  void operator()(OpKernelContext* ctx, const TransformerCache& cache) const {
     using IterRangeT = std::pair<const InputT*, const InputT*>;
     using Transformer = Microsoft::Featurizer::Featurizers::Base::NormalizeTransformer<IterRangeT>;
-    Transformer transformer(
-        [ctx](void) {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-          return Transformer(archive);
-        }());
 
     const auto* input_tensor(ctx->Input<Tensor>(1));
     const int64_t dim_num = input_tensor->Shape().NumDimensions();
@@ -49,35 +42,40 @@ struct NormalizeTransformerImpl {
       result = std::move(val);
     };
 
-    for (int64_t row = 0; row < rows; ++row) {
-      auto row_begin = input_data + row * row_size;
-      auto input_range = std::make_pair(row_begin, row_begin + row_size);
-      result.clear();
-      // Flush is not required here
-      transformer.execute(input_range, callback);
-      ORT_ENFORCE(static_cast<int64_t>(result.size()) == row_size,
-                  "Expecting the same output size as input");
-      std::copy(result.cbegin(), result.cend(), output_data);
-      output_data += row_size;
-    }
-    // The flush() does nothing but shows Featurizers concept
-    callback_allow = false;
-    transformer.flush(callback);
+    cache.Execute<Transformer>(ctx, [&](Transformer& transformer) {
+      for (int64_t row = 0; row < rows; ++row) {
+        auto row_begin = input_data + row * row_size;
+        auto input_range = std::make_pair(row_begin, row_begin + row_size);
+        result.clear();
+        // Flush is not required here
+        transformer.execute(input_range, callback);
+        ORT_ENFORCE(static_cast<int64_t>(result.size()) == row_size,
+                    "Expecting the same output size as input");
+        std::copy(result.cbegin(), result.cend(), output_data);
+        output_data += row_size;
+      }
+      // The flush() does nothing but shows Featurizers concept
+      callback_allow = false;
+      transformer.flush(callback);
+    });
   }
 };
 
 class NormalizeTransformer final : public OpKernel {
  public:
-  explicit NormalizeTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit NormalizeTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
     utils::MLTypeCallDispatcher<NormalizeTransformerImpl, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t,
                                 int64_t, uint64_t, float, double>
         t_disp(ctx->Input<Tensor>(1)->GetElementType());
-    t_disp.Invoke(ctx);
+    t_disp.Invoke(ctx, cache_);
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
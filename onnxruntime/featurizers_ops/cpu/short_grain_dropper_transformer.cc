@@ -7,21 +7,15 @@
 #include "Featurizers/ShortGrainDropperFeaturizer.h"
 #include "Featurizers/../Archive.h"
 
+#include "featurizers_ops/cpu/transformer_cache.h"
+
 namespace NS = Microsoft::Featurizer;
 
 namespace onnxruntime {
 namespace featurizers {
 
-void ShortGrainDropperTransformerImpl(OpKernelContext* ctx) {
-  // Create the transformer
-  Microsoft::Featurizer::Featurizers::ShortGrainDropperTransformer transformer(
-      [ctx]() {
-        const auto* state_tensor(ctx->Input<Tensor>(0));
-        const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-        Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-        return Microsoft::Featurizer::Featurizers::ShortGrainDropperTransformer(archive);
-      }());
+void ShortGrainDropperTransformerImpl(OpKernelContext* ctx, const TransformerCache& cache) {
+  using TransformerT = Microsoft::Featurizer::Featurizers::ShortGrainDropperTransformer;
 
   // Get the input
   const auto* input_tensor = ctx->Input<Tensor>(1);
@@ -37,22 +31,27 @@ void ShortGrainDropperTransformerImpl(OpKernelContext* ctx) {
   // Transform
   std::vector<std::string> input_data_vec;
   input_data_vec.reserve(strings_num);
-  for (int64_t rows_idx = 0; rows_idx < input_rows_num; ++rows_idx) {
-    input_data_vec.clear();
-    std::copy(input_data, input_data + strings_num, std::back_inserter(input_data_vec));
-    output_data[rows_idx] = transformer.execute(input_data_vec);
-    input_data += strings_num;
-  }
+  cache.Execute<TransformerT>(ctx, [&](TransformerT& transformer) {
+    for (int64_t rows_idx = 0; rows_idx < input_rows_num; ++rows_idx) {
+      input_data_vec.clear();
+      std::copy(input_data, input_data + strings_num, std::back_inserter(input_data_vec));
+      output_data[rows_idx] = transformer.execute(input_data_vec);
+      input_data += strings_num;
+    }
+  });
 };
 
 class ShortGrainDropperTransformer final : public OpKernel {
  public:
-  explicit ShortGrainDropperTransformer(const OpKernelInfo& info) : OpKernel(info) {
+  explicit ShortGrainDropperTransformer(const OpKernelInfo& info) : OpKernel(info), cache_(info) {
   }
   Status Compute(OpKernelContext* ctx) const override {
-    ShortGrainDropperTransformerImpl(ctx);
+    ShortGrainDropperTransformerImpl(ctx, cache_);
     return Status::OK();
   }
+
+ private:
+  TransformerCache cache_;
 };
 
 ONNX_OPERATOR_KERNEL_EX(
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
+
+#include "Featurizers/../Archive.h"
+
+namespace onnxruntime {
+namespace featurizers {
+
+// Memoizes the featurizer transformers that a kernel deserializes from its state input (input 0).
+//
+// Deserializing the state archive dominates the cost of running a featurizer on a few rows. When
+// the state is a constant initializer, the transformers deserialized by Compute are kept in a pool
+// and reused from then on. Otherwise a transformer is deserialized on every Compute. The featurizer
+// execute and flush methods are not const, so each Compute checks a transformer out of the pool
+// and runs it without holding the lock; concurrent Computes get a transformer each, and the pool
+// grows to the number of Computes that ran at the same time. The transformer type may depend on
+// the element type dispatched by Compute, which is fixed for a given node, so the pool is type
+// erased.
+//
+// Transformers that buffer rows across execute calls (rolling window, lag/lead, time series
+// imputer) must not use this cache because the buffered history would leak between Compute calls.
+class TransformerCache {
+ public:
+  explicit TransformerCache(const OpKernelInfo& info) {
+    if (!info.TryGetConstantInput(0, &constant_state_)) {
+      constant_state_ = nullptr;
+    }
+  }
+
+  // Invokes fn(TransformerT&) with a transformer that no other Compute is using.
+  template <typename TransformerT, typename FnT>
+  void Execute(OpKernelContext* ctx, FnT&& fn) const {
+    if (constant_state_ == nullptr) {
+      const auto* state_tensor(ctx->Input<Tensor>(0));
+      Microsoft::Featurizer::Archive archive(state_tensor->Data<uint8_t>(), state_tensor->Shape().Size());
+      TransformerT transformer(archive);
+      fn(transformer);
+      return;
+    }
+
+    std::shared_ptr<void> transformer;
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      ORT_ENFORCE(transformer_type_ == nullptr || *transformer_type_ == typeid(TransformerT),
+                  "The cached featurizer transformer was created for a different input type");
+      transformer_type_ = &typeid(TransformerT);
+      if (!idle_transformers_.empty()) {
+        transformer = std::move(idle_transformers_.back());
+        idle_transformers_.pop_back();
+      }
+    }
+
+    if (transformer == nullptr) {
+      Microsoft::Featurizer::Archive archive(constant_state_->Data<uint8_t>(), constant_state_->Shape().Size());
+      transformer = std::make_shared<TransformerT>(archive);
+    }
+
+    // A transformer whose Compute threw is dropped, as it may have been left in the middle of a batch
+    fn(*static_cast<TransformerT*>(transformer.get()));
+
+    std::lock_guard<OrtMutex> lock(mutex_);
+    idle_transformers_.push_back(std::move(transformer));
+  }
+
+ private:
+  const Tensor* constant_state_;
+  mutable OrtMutex mutex_;
+  mutable std::vector<std::shared_ptr<void>> idle_transformers_;
+  mutable const std::type_info* transformer_type_ = nullptr;
+};
+
+// Executes the transformer on each of the length input elements and stores the results to output.
+// A single callback is shared by the batch instead of the callback and temporary result that the
+// single value execute overload creates per element, and each result (including strings) is moved
+// straight into the output tensor. preprocess adapts an input element to the transformer input.
+template <typename TransformerT, typename InputT, typename OutputT, typename PreprocessFnT>
+void ExecuteBatch(TransformerT& transformer,
+                  const InputT* input_data,
+                  int64_t length,
+                  OutputT* output_data,
+                  PreprocessFnT&& preprocess) {
+  typename TransformerT::CallbackFunction callback(
+      [&output_data](typename TransformerT::TransformedType value) {
+        *output_data++ = std::move(value);
+      });
+
+  for (int64_t i = 0; i < length; ++i) {
+    transformer.execute(preprocess(input_data[i]), callback);
+  }
+}
+
+template <typename TransformerT, typename InputT, typename OutputT>
+void ExecuteBatch(TransformerT& transformer,
+                  const InputT* input_data,
+                  int64_t length,
+                  OutputT* output_data) {
+  ExecuteBatch(transformer, input_data, length, output_data,
+               [](const InputT& value) -> const InputT& { return value; });
+}
+
+}  // namespace featurizers
+}  // namespace onnxruntime
@@ -15,6 +15,7 @@
 #include "core/common/logging/severity.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/session_options.h"
+#include "core/framework/shared_weights.h"
 
 #if USE_CUDA
 #define BACKEND_PROC "GPU"
@@ -110,6 +111,7 @@ std::string nuphar_settings;
 
 namespace onnxruntime {
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena);
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(const CPUExecutionProviderInfo& info);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CUDA(OrtDevice::DeviceId device_id);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Tensorrt(int device_id);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Dnnl(int use_arena);
@@ -303,7 +305,12 @@ const std::vector<std::string>& GetAvailableProviders() {
 void RegisterExecutionProviders(InferenceSession* sess, const std::vector<std::string>& provider_types) {
   for (const std::string& type : provider_types) {
     if (type == kCpuExecutionProvider) {
-      RegisterExecutionProvider(sess, *onnxruntime::CreateExecutionProviderFactory_CPU(sess->GetSessionOptions().enable_cpu_mem_arena));
+      const SessionOptions& session_options = sess->GetSessionOptions();
+      CPUExecutionProviderInfo info;
+      info.create_arena = session_options.enable_cpu_mem_arena;
+      info.arena_max_mem = session_options.cpu_mem_arena.max_mem;
+      info.arena_extend_strategy = session_options.cpu_mem_arena.extend_strategy;
+      RegisterExecutionProvider(sess, *onnxruntime::CreateExecutionProviderFactory_CPU(info));
     } else if (type == kTensorrtExecutionProvider) {
 #ifdef USE_TENSORRT
       RegisterExecutionProvider(sess, *onnxruntime::CreateExecutionProviderFactory_Tensorrt(0));
@@ -351,6 +358,45 @@ void InitializeSession(InferenceSession* sess, const std::vector<std::string>& p
   OrtPybindThrowIfError(sess->Initialize());
 }
 
+static void CreateFeeds(InferenceSession* sess, const std::map<std::string, py::object>& pyfeeds,
+                        NameMLValMap& feeds) {
+  for (auto _ : pyfeeds) {
+    OrtValue ml_value;
+    auto px = sess->GetModelInputs();
+    if (!px.first.IsOK() || !px.second) {
+      throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+    }
+    CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
+    if (PyErr_Occurred()) {
+      PyObject *ptype, *pvalue, *ptraceback;
+      PyErr_Fetch(&ptype, &pvalue, &ptraceback);
+
+      PyObject* pStr = PyObject_Str(ptype);
+      std::string sType = py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      pStr = PyObject_Str(pvalue);
+      sType += ": ";
+      sType += py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      throw std::runtime_error(sType);
+    }
+    feeds.insert(std::make_pair(_.first, ml_value));
+  }
+}
+
+static std::vector<py::object> FetchesToPyObjects(const std::vector<OrtValue>& fetches) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  for (auto _ : fetches) {
+    if (_.IsTensor()) {
+      AddTensorAsPyObj(_, rfetch);
+    } else {
+      AddNonTensorAsPyObj(_, rfetch);
+    }
+  }
+  return rfetch;
+}
+
 void addGlobalMethods(py::module& m, const Environment& env) {
   m.def("get_default_session_options", &GetDefaultCPUSessionOptions, "Return a default session_options instance.");
   m.def("get_session_initializer", &SessionObjectInitializer::Get, "Return a default session object initializer.");
@@ -365,6 +411,24 @@ void addGlobalMethods(py::module& m, const Environment& env) {
         default_logging_manager->SetDefaultLoggerSeverity(static_cast<logging::Severity>(severity));
       },
       "Sets the default logging severity. 0:Verbose, 1:Info, 2:Warning, 3:Error, 4:Fatal");
+  m.def(
+      "add_shared_initializer", [&env](const std::string& name, py::object& value) {
+        OrtValue ml_value;
+        CreateGenericMLValue(nullptr, GetAllocator(), name, value, &ml_value);
+        if (!ml_value.IsTensor() || ml_value.Get<Tensor>().IsDataTypeString()) {
+          throw std::runtime_error("A shared initializer must be a numeric numpy array");
+        }
+        // the tensor may reference the memory of the numpy array, so the environment keeps its own copy
+        const Tensor& tensor = ml_value.Get<Tensor>();
+        auto shared_tensor = onnxruntime::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), GetAllocator());
+        memcpy(shared_tensor->MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+        OrtValue shared_value;
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        shared_value.Init(shared_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+        OrtPybindThrowIfError(env.GetSharedWeights()->AddInitializer(name, shared_value));
+      },
+      "Adds a numpy array as the initializer with the given name that sessions with "
+      "SessionOptions.use_env_shared_initializers use instead of their own copy.");
   m.def(
       "get_all_providers", []() -> const std::vector<std::string>& { return GetAllProviders(); },
       "Return list of Execution Providers that this version of Onnxruntime can support.");
@@ -560,6 +624,51 @@ Set this option to false if you don't want it. Default is True.)pbdoc")
                      R"pbdoc(File path to serialize optimized model. By default, optimized model is not serialized if optimized_model_filepath is not provided.)pbdoc")
       .def_readwrite("enable_mem_pattern", &SessionOptions::enable_mem_pattern,
                      R"pbdoc(Enable the memory pattern optimization. Default is true.)pbdoc")
+      .def_property(
+          "mem_pattern_bucket_dims_to_power_of_2",
+          [](const SessionOptions* options) -> bool { return options->mem_pattern_cache.bucket_dims_to_power_of_2; },
+          [](SessionOptions* options, bool value) -> void { options->mem_pattern_cache.bucket_dims_to_power_of_2 = value; },
+          R"pbdoc(Round input dimensions up to the next power of 2 when looking up cached memory patterns,
+so that one pattern serves all the shapes in a bucket. Default is false.)pbdoc")
+      .def_property(
+          "mem_pattern_dim_buckets",
+          [](const SessionOptions* options) -> std::vector<int64_t> { return options->mem_pattern_cache.dim_buckets; },
+          [](SessionOptions* options, const std::vector<int64_t>& value) -> void {
+            options->mem_pattern_cache.dim_buckets = value;
+          },
+          R"pbdoc(Round input dimensions up to the first of these bounds when looking up cached memory patterns.
+Takes precedence over mem_pattern_bucket_dims_to_power_of_2. Default is empty.)pbdoc")
+      .def_property(
+          "mem_pattern_max_num_patterns",
+          [](const SessionOptions* options) -> size_t { return options->mem_pattern_cache.max_num_patterns; },
+          [](SessionOptions* options, size_t value) -> void { options->mem_pattern_cache.max_num_patterns = value; },
+          R"pbdoc(Maximum number of cached memory patterns, the least recently used one is evicted. 0 means no limit. Default is 128.)pbdoc")
+      .def_property(
+          "cpu_mem_arena_max_mem",
+          [](const SessionOptions* options) -> size_t { return options->cpu_mem_arena.max_mem; },
+          [](SessionOptions* options, size_t value) -> void { options->cpu_mem_arena.max_mem = value; },
+          R"pbdoc(Maximum number of bytes held by the CPU memory arena. 0 means no limit. Default is 0.)pbdoc")
+      .def_property(
+          "cpu_mem_arena_extend_same_as_requested",
+          [](const SessionOptions* options) -> bool {
+            return options->cpu_mem_arena.extend_strategy == ArenaExtendStrategy::kSameAsRequested;
+          },
+          [](SessionOptions* options, bool value) -> void {
+            options->cpu_mem_arena.extend_strategy =
+                value ? ArenaExtendStrategy::kSameAsRequested : ArenaExtendStrategy::kNextPowerOfTwo;
+          },
+          R"pbdoc(Grow the CPU memory arena by the requested size instead of doubling its regions. Default is False.)pbdoc")
+      .def_property(
+          "cpu_mem_arena_shrink_interval_runs",
+          [](const SessionOptions* options) -> int { return options->cpu_mem_arena.shrink_interval_runs; },
+          [](SessionOptions* options, int value) -> void { options->cpu_mem_arena.shrink_interval_runs = value; },
+          R"pbdoc(Return the memory the arenas don't use to the system after every this many runs. 0 means never. Default is 0.)pbdoc")
+      .def_property(
+          "cpu_mem_arena_shrink_above_bytes",
+          [](const SessionOptions* options) -> size_t { return options->cpu_mem_arena.shrink_above_bytes; },
+          [](SessionOptions* options, size_t value) -> void { options->cpu_mem_arena.shrink_above_bytes = value; },
+          R"pbdoc(After a run, return the memory an arena doesn't use to the system when it holds more than this many bytes.
+0 means never. Default is 0.)pbdoc")
       .def_readwrite("logid", &SessionOptions::session_logid,
                      R"pbdoc(Logger id to use for session output.)pbdoc")
       .def_readwrite("log_severity_level", &SessionOptions::session_log_severity_level,
@@ -582,6 +691,9 @@ Applies to session load, initialization, etc. Default is 0.)pbdoc")
           },R"pbdoc(Sets the number of threads used to parallelize the execution of the graph (across nodes). Default is 0 to let onnxruntime choose.)pbdoc")     
       .def_readwrite("execution_mode", &SessionOptions::execution_mode,
                      R"pbdoc(Sets the execution mode. Default is sequential.)pbdoc")
+      .def_readwrite("use_env_shared_initializers", &SessionOptions::use_env_shared_initializers,
+                     R"pbdoc(Use the initializers added with add_shared_initializer in place of the model initializers
+with the same name, sharing them and their prepacked forms with the other sessions doing so. Default is false.)pbdoc")
       .def_property(
           "graph_optimization_level",
           [](const SessionOptions* options) -> GraphOptimizationLevel {
@@ -636,7 +748,9 @@ Applies to a particular Run() invocation. Default is 0.)pbdoc")
                      "To identify logs generated by a particular Run() invocation.")
       .def_readwrite("terminate", &RunOptions::terminate,
                      R"pbdoc(Set to True to terminate any currently executing calls that are using this
-RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc");
+RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc")
+      .def_readwrite("shrink_memory_arenas", &RunOptions::shrink_memory_arenas,
+                     R"pbdoc(Set to True to return the memory the session arenas don't use to the system once the run completes.)pbdoc");
 
   py::class_<ModelMetadata>(m, "ModelMetadata", R"pbdoc(Pre-defined and custom metadata about the model.
 It is usually used to identify the model used to run the prediction and
@@ -731,28 +845,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           R"pbdoc(Load a model saved in ONNX format.)pbdoc")
       .def("run", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr) -> std::vector<py::object> {
         NameMLValMap feeds;
-        for (auto _ : pyfeeds) {
-          OrtValue ml_value;
-          auto px = sess->GetModelInputs();
-          if (!px.first.IsOK() || !px.second) {
-            throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-          }
-          CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
-          if (PyErr_Occurred()) {
-            PyObject *ptype, *pvalue, *ptraceback;
-            PyErr_Fetch(&ptype, &pvalue, &ptraceback);
-
-            PyObject* pStr = PyObject_Str(ptype);
-            std::string sType = py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            pStr = PyObject_Str(pvalue);
-            sType += ": ";
-            sType += py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            throw std::runtime_error(sType);
-          }
-          feeds.insert(std::make_pair(_.first, ml_value));
-        }
+        CreateFeeds(sess, pyfeeds, feeds);
 
         std::vector<OrtValue> fetches;
         common::Status status;
@@ -767,20 +860,75 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           }
         }
 
-        std::vector<py::object> rfetch;
-        rfetch.reserve(fetches.size());
-        for (auto _ : fetches) {
-          if (_.IsTensor()) {
-            AddTensorAsPyObj(_, rfetch);
-          } else {
-            AddNonTensorAsPyObj(_, rfetch);
-          }
+        return FetchesToPyObjects(fetches);
+      })
+      .def("run_async", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, py::object callback, py::object user_data, py::object run_options) {
+        NameMLValMap feeds;
+        CreateFeeds(sess, pyfeeds, feeds);
+        std::vector<std::string> feed_names;
+        std::vector<OrtValue> feed_values;
+        feed_names.reserve(feeds.size());
+        feed_values.reserve(feeds.size());
+        for (auto& feed : feeds) {
+          feed_names.push_back(feed.first);
+          feed_values.push_back(feed.second);
+        }
+
+        static const RunOptions default_run_options;
+        const RunOptions& options = run_options.is_none() ? default_run_options : *run_options.cast<RunOptions*>();
+        // The python objects are released by the completion, which holds the GIL, rather than when the last copy of
+        // the state is destroyed on a thread that doesn't. run_options and the inputs are kept alive until the run
+        // completes, as the tensors of contiguous numpy inputs point to the memory of the arrays.
+        auto state = std::make_shared<std::vector<py::object>>(std::vector<py::object>{callback, user_data, run_options});
+        state->reserve(state->size() + pyfeeds.size());
+        for (auto& feed : pyfeeds) {
+          state->push_back(feed.second);
         }
-        return rfetch;
+        auto on_complete = [state](const common::Status& status, std::vector<OrtValue>& fetches) {
+          py::gil_scoped_acquire acquire;
+          try {
+            py::list results;
+            if (status.IsOK()) {
+              for (auto& result : FetchesToPyObjects(fetches)) {
+                results.append(result);
+              }
+            }
+            (*state)[0](results, (*state)[1], status.IsOK() ? std::string() : status.ErrorMessage());
+          } catch (py::error_already_set& e) {
+            // there is no caller to raise the error to
+            e.restore();
+            PyErr_Print();
+          }
+          state->clear();
+        };
+
+        OrtPybindThrowIfError(sess->RunAsync(options, feed_names, feed_values, output_names, on_complete));
       })
       .def("end_profiling", [](InferenceSession* sess) -> std::string {
         return sess->EndProfiling();
       })
+      .def("shrink_memory_arenas", [](InferenceSession* sess) -> size_t {
+        return sess->ShrinkMemoryArenas();
+      })
+      .def("get_arena_stats", [](const InferenceSession* sess) -> py::list {
+        py::list result;
+        for (const auto& arena_stats : sess->GetArenaStats()) {
+          const auto& stats = arena_stats.second;
+          py::dict entry;
+          entry["name"] = std::string(arena_stats.first.name);
+          entry["id"] = arena_stats.first.id;
+          entry["num_allocs"] = stats.num_allocs;
+          entry["bytes_in_use"] = stats.bytes_in_use;
+          entry["total_allocated_bytes"] = stats.total_allocated_bytes;
+          entry["max_bytes_in_use"] = stats.max_bytes_in_use;
+          entry["max_alloc_size"] = stats.max_alloc_size;
+          entry["bytes_limit"] = stats.bytes_limit;
+          entry["num_regions"] = stats.num_regions;
+          entry["largest_free_block_bytes"] = stats.largest_free_block_bytes;
+          result.append(entry);
+        }
+        return result;
+      })
       .def("get_providers", [](InferenceSession* sess) -> const std::vector<std::string>& {
         return sess->GetRegisteredProviderTypes();
       })
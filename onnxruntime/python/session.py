@@ -153,6 +153,30 @@ class InferenceSession:
             else:
                 raise
 
+    def run_async(self, output_names, input_feed, callback, user_data=None, run_options=None):
+        """
+        Compute the predictions on a thread pool owned by onnxruntime and return without waiting for them.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``, whose values are kept alive until the run
+            completes
+        :param callback: called as ``callback(results, user_data, err)`` on a thread of the pool when the
+            run completes, with the list of outputs and an empty ``err``, or an empty list and the error message
+        :param user_data: passed to the callback
+        :param run_options: See :class:`onnxruntime.RunOptions`. Setting its ``terminate`` flag cancels the run.
+
+        ::
+
+            sess.run_async([output_name], {input_name: x}, lambda results, user_data, err: print(results))
+        """
+        num_required_inputs = len(self._inputs_meta)
+        num_inputs = len(input_feed)
+        if num_inputs < num_required_inputs:
+            raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        self._sess.run_async(output_names, input_feed, callback, user_data, run_options)
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -161,3 +185,20 @@ class InferenceSession:
         :meth:`onnxruntime.SessionOptions.enable_profiling`.
         """
         return self._sess.end_profiling()
+
+    def shrink_memory_arenas(self):
+        """
+        Return the memory the arenas of the session hold but don't use to the system.
+
+        :return: the number of bytes released
+        """
+        return self._sess.shrink_memory_arenas()
+
+    def get_arena_stats(self):
+        """
+        Return the statistics of the memory arenas of the session.
+
+        :return: a list with a dictionary for each arena, holding its name and device id,
+            and the statistics collected by the arena in bytes
+        """
+        return self._sess.get_arena_stats()
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -248,6 +251,37 @@ TEST(AttentionTest, AttentionNoMaskIndex) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+TEST(AttentionTest, AttentionSequenceLengthNotEqualHeadSize) {
+  int batch_size = 1;
+  int sequence_length = 3;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f,
+      -0.4f, 0.1f, 0.7f, 0.2f};
+
+  std::vector<float> weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f, 1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      0.5f, 0.1f, 0.4f, 1.6f, 1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      0.3f, 0.2f, 4.0f, 2.2f, 1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      0.2f, 0.1f, 0.4f, 1.6f, 2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  std::vector<int32_t> mask_index_data = {3L};
+
+  std::vector<float> output_data = {
+      2.864271f, 0.6007268f, 4.249767f, 5.649715f,
+      3.363332f, 0.5759873f, 4.249003f, 5.648778f,
+      5.109103f, 0.4720991f, 4.249983f, 5.649979f};
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads);
+}
+
 TEST(AttentionTest, AttentionUnidirectional) {
   int batch_size = 1;
   int sequence_length = 2;
@@ -340,5 +374,108 @@ TEST(AttentionTest, AttentionUnidirectional) {
                    batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional);
 }
 
+// Computes the expected output of Attention with straightforward loops, for inputs too large to list inline.
+static std::vector<float> ComputeReferenceAttention(const std::vector<float>& input_data,
+                                                    const std::vector<float>& weights_data,
+                                                    const std::vector<float>& bias_data,
+                                                    const std::vector<int32_t>& mask_index_data,
+                                                    int batch_size, int sequence_length, int hidden_size,
+                                                    int number_of_heads, bool is_unidirectional) {
+  const int head_size = hidden_size / number_of_heads;
+
+  // qkv: [batch_size, sequence_length, 3 * hidden_size]
+  std::vector<double> qkv(static_cast<size_t>(batch_size) * sequence_length * 3 * hidden_size);
+  for (int t = 0; t < batch_size * sequence_length; t++) {
+    for (int j = 0; j < 3 * hidden_size; j++) {
+      double sum = bias_data[j];
+      for (int k = 0; k < hidden_size; k++) {
+        sum += input_data[t * hidden_size + k] * weights_data[k * 3 * hidden_size + j];
+      }
+      qkv[t * 3 * hidden_size + j] = sum;
+    }
+  }
+
+  std::vector<float> output_data(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  std::vector<double> scores(sequence_length);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int i = 0; i < sequence_length; i++) {
+        const double* q = &qkv[(b * sequence_length + i) * 3 * hidden_size + n * head_size];
+        for (int j = 0; j < sequence_length; j++) {
+          const double* k = &qkv[(b * sequence_length + j) * 3 * hidden_size + hidden_size + n * head_size];
+          double score = 0;
+          for (int h = 0; h < head_size; h++) {
+            score += q[h] * k[h];
+          }
+          score /= std::sqrt(static_cast<double>(head_size));
+          if ((is_unidirectional && j > i) || (!mask_index_data.empty() && j >= mask_index_data[b])) {
+            score -= 10000.0;
+          }
+          scores[j] = score;
+        }
+
+        const double max_score = *std::max_element(scores.begin(), scores.end());
+        double sum = 0;
+        for (auto& score : scores) {
+          score = std::exp(score - max_score);
+          sum += score;
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          double value = 0;
+          for (int j = 0; j < sequence_length; j++) {
+            value += scores[j] * qkv[(b * sequence_length + j) * 3 * hidden_size + 2 * hidden_size + n * head_size + h];
+          }
+          output_data[(b * sequence_length + i) * hidden_size + n * head_size + h] = static_cast<float>(value / sum);
+        }
+      }
+    }
+  }
+
+  return output_data;
+}
+
+static void RunAttentionLongSequenceTest(const std::vector<int32_t>& mask_index_data, bool is_unidirectional) {
+  // several query blocks and key tiles, with partial ones at the end
+  int batch_size = 2;
+  int sequence_length = 150;
+  int hidden_size = 8;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>(static_cast<int>(i % 13) - 6) * 0.1f;
+  }
+
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.2f;
+  }
+
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.1f;
+  }
+
+  std::vector<float> output_data = ComputeReferenceAttention(input_data, weight_data, bias_data, mask_index_data,
+                                                             batch_size, sequence_length, hidden_size,
+                                                             number_of_heads, is_unidirectional);
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional);
+}
+
+TEST(AttentionTest, AttentionLongSequence) {
+  RunAttentionLongSequenceTest({150, 97}, false);
+}
+
+TEST(AttentionTest, AttentionLongSequenceNoMaskIndex) {
+  RunAttentionLongSequenceTest({}, false);
+}
+
+TEST(AttentionTest, AttentionLongSequenceUnidirectional) {
+  RunAttentionLongSequenceTest({}, true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
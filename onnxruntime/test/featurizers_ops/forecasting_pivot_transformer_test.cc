@@ -51,6 +51,32 @@ TEST(FeaturizersTests, ForecastingPivotTransformer_2_Inputs) {
   test.Run();
 }
 
+TEST(FeaturizersTests, ForecastingPivotTransformer_2_Inputs_initializer_state) {
+  auto stream = GetStream<float>();
+  auto dim = static_cast<int64_t>(stream.size());
+  OpTester test("ForecastingPivotTransformer", 1, onnxruntime::kMSFeaturizersDomain);
+  // A constant state lets the kernel reuse the transformer, which is flushed by every run
+  test.AddInput<uint8_t>("State", {dim}, stream, true);
+  test.AddInput<double>("Input_1", {2, 3, 4}, {1, 6, 3, 9,
+                                              2, 4, 5, 8,
+                                              NS::Traits<float>::CreateNullValue(), NS::Traits<float>::CreateNullValue(), 7, 10,
+                                              1, 6, 3, 9,
+                                              2, 4, 5, 8,
+                                              NS::Traits<float>::CreateNullValue(), NS::Traits<float>::CreateNullValue(), 7, 10});
+  test.AddInput<double>("Input_2", {2, 2, 4}, {2, NS::Traits<float>::CreateNullValue(), 5, 6,
+                                              2, NS::Traits<float>::CreateNullValue(), 3, 4,
+                                              2, NS::Traits<float>::CreateNullValue(), 5, 6,
+                                              2, NS::Traits<float>::CreateNullValue(), 3, 4});
+  // The output of the last run, with the reused transformer, matches the one of a fresh transformer
+  test.AddOutput<double>("Output", {4, 5}, {3, 5, 7, 5, 3,
+                                            9, 8, 10, 6, 4,
+                                            3, 5, 7, 5, 3,
+                                            9, 8, 10, 6, 4});
+
+  test.SetNumRunCalls(3);
+  test.Run();
+}
+
 TEST(FeaturizersTests, ForecastingPivotTransformer_3_Inputs) {
   auto stream = GetStream<float>();
   auto dim = static_cast<int64_t>(stream.size());
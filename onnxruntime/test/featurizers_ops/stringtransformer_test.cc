@@ -39,6 +39,24 @@ TEST(FeaturizersTests, StringTransformer_integer_values) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(FeaturizersTests, StringTransformer_integer_values_initializer_state) {
+  OpTester test("StringTransformer", 1, onnxruntime::kMSFeaturizersDomain);
+
+  // A constant state lets the kernel reuse the deserialized transformer across runs
+  auto stream = GetStream<int64_t>();
+  auto dim = static_cast<int64_t>(stream.size());
+  test.AddInput<uint8_t>("State", {dim}, stream, true);
+
+  test.AddInput<int64_t>("Input", {5}, {1, 3, 5, 7, 9});
+
+  // Expected output.
+  test.AddOutput<std::string>("Output", {5}, {"1", "3", "5", "7", "9"});
+
+  // The output of the last run, which uses the transformer cached by the first one, is verified
+  test.SetNumRunCalls(2);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(FeaturizersTests, StringTransformer_double_values) {
   OpTester test("StringTransformer", 1, onnxruntime::kMSFeaturizersDomain);
 
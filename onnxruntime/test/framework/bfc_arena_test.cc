@@ -3,7 +3,9 @@
 
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
+#include <atomic>
 #include <cstdlib>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -234,5 +236,187 @@ TEST(BFCArenaTest, TestReserve) {
   a.GetStats(&stats);
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
+
+TEST(BFCArenaTest, ThreadCachesReturnedBeforeExtend) {
+  // Configure a 1MiB byte limit, all of it is used by the first region
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 20);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 16; ++i) {
+    void* raw = a.Alloc(1 << 16);
+    ASSERT_NE(nullptr, raw);
+    ptrs.push_back(raw);
+  }
+  for (void* raw : ptrs) {
+    a.Free(raw);
+  }
+  CheckStats(&a, 16, 0, 1 << 20, 1 << 16);
+
+  // the freed chunks are cached and can't be coalesced until they are returned to the bins
+  void* large_ptr = a.Alloc(1 << 19);
+  EXPECT_NE(nullptr, large_ptr);
+  a.Free(large_ptr);
+  CheckStats(&a, 17, 0, 1 << 20, 1 << 19);
+}
+
+TEST(BFCArenaTest, ConcurrentAllocationsAndDeallocations) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+  constexpr int num_threads = 8;
+  constexpr int num_iterations = 1000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < num_iterations; ++i) {
+        // mostly sizes that are served by the thread caches
+        size_t size = (i % 10 == 0) ? (1 << 20) : static_cast<size_t>(256 * ((i + t) % 64 + 1));
+        ptrs.push_back(a.Alloc(size));
+        if (ptrs.size() == 4) {
+          for (void* raw : ptrs) {
+            a.Free(raw);
+          }
+          ptrs.clear();
+        }
+      }
+      for (void* raw : ptrs) {
+        a.Free(raw);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, num_threads * num_iterations);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(a.Used(), 0u);
+}
+
+// the region views replaced by extending and shrinking the arena are freed while other threads free to their caches
+TEST(BFCArenaTest, ConcurrentDeallocationsWhileShrinking) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+  constexpr int num_threads = 4;
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&a, &done]() {
+      while (!done.load()) {
+        a.Free(a.Alloc(1 << 10));
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i) {
+    a.Free(a.Alloc(1 << 22));
+    a.Shrink(0, false);
+  }
+  done = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(a.Used(), 0u);
+  a.Shrink();
+  EXPECT_EQ(a.AllocatedBytes(), 0u);
+}
+
+TEST(BFCArenaTest, ShrinkReleasesUnusedRegions) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  // the first region is 1MiB, the large allocations need regions of their own
+  void* small_ptr = a.Alloc(1 << 10);
+  void* first_ptr = a.Alloc(1 << 21);
+  void* second_ptr = a.Alloc(1 << 22);
+  a.Free(first_ptr);
+  a.Free(second_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  const int64_t allocated_bytes = stats.total_allocated_bytes;
+
+  // keep_bytes is only undercut by releasing the largest unused region
+  size_t released_bytes = a.Shrink(static_cast<size_t>(allocated_bytes) - 1);
+  a.GetStats(&stats);
+  EXPECT_GT(released_bytes, 0u);
+  EXPECT_EQ(stats.total_allocated_bytes, allocated_bytes - static_cast<int64_t>(released_bytes));
+  EXPECT_LT(static_cast<size_t>(stats.total_allocated_bytes), static_cast<size_t>(allocated_bytes) - 1);
+
+  // the region with the live allocation is kept
+  a.Shrink();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  EXPECT_EQ(a.RequestedSize(small_ptr), 1u << 10);
+
+  a.Free(small_ptr);
+  EXPECT_EQ(a.Shrink(), 1u << 20);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+
+  // the arena grows again after it was emptied
+  void* ptr = a.Alloc(1 << 10);
+  EXPECT_NE(nullptr, ptr);
+  a.Free(ptr);
+  EXPECT_EQ(a.Shrink(), 1u << 20);
+}
+
+TEST(BFCArenaTest, ShrinkKeepsThreadCaches) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  // the freed chunk is cached by this thread, so the region is still in use unless the caches are returned
+  a.Free(a.Alloc(1 << 10));
+  EXPECT_EQ(a.AllocatedBytes(), 1u << 20);
+  EXPECT_EQ(a.Shrink(0, false), 0u);
+  EXPECT_EQ(a.AllocatedBytes(), 1u << 20);
+
+  EXPECT_EQ(a.Shrink(), 1u << 20);
+  EXPECT_EQ(a.AllocatedBytes(), 0u);
+}
+
+TEST(BFCArenaTest, ExtendSameAsRequested) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30,
+             ArenaExtendStrategy::kSameAsRequested);
+
+  void* first_ptr = a.Alloc(1000);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024);
+
+  // the region for the second allocation isn't rounded up to a power of 2 either
+  void* second_ptr = a.Alloc(3 << 20);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024 + (3 << 20));
+
+  a.Free(first_ptr);
+  a.Free(second_ptr);
+}
+
+TEST(BFCArenaTest, RegionAndFragmentationStats) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  // the first region is 1MiB and the second one 2MiB
+  void* first_ptr = a.Alloc(1 << 19);
+  void* second_ptr = a.Alloc(1 << 19);
+  void* third_ptr = a.Alloc(1 << 20);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 3 << 20);
+  EXPECT_EQ(stats.largest_free_block_bytes, 1 << 20);
+
+  // the free half of the first region isn't contiguous with the rest of the free memory
+  a.Free(first_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes - stats.bytes_in_use, 3 << 19);
+  EXPECT_EQ(stats.largest_free_block_bytes, 1 << 20);
+
+  a.Free(second_ptr);
+  a.Free(third_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.largest_free_block_bytes, 2 << 20);
+}
 }  // namespace test
 }  // namespace onnxruntime
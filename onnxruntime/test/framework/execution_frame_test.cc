@@ -111,6 +111,58 @@ TEST_F(ExecutionFrameTest, TensorAllocationTest) {
   ASSERT_EQ(tensor2->template Data<float>(), p_tensor->template Data<float>());
 }
 
+TEST_F(ExecutionFrameTest, MemoryAccountingTest) {
+  onnxruntime::Model model("test", false, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  onnxruntime::Node* node = &graph.AddNode("node1", "Relu", "Relu operator", ArgMap{&input_def}, ArgMap{&output_def});
+  node->SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_typ, std::move(cpu_xp));
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  SessionState state{execution_providers, true, &tp_, nullptr};
+  ASSERT_STATUS_OK(state.SetGraphAndCreateKernels(graph, kernel_registry_manager));
+
+  std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan;
+  SequentialPlannerContext context(ExecutionMode::ORT_SEQUENTIAL);
+  ASSERT_STATUS_OK(SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph), {}, execution_providers, kernel_registry_manager,
+                                                 state.GetOrtValueNameIdxMap(), context, p_seq_exec_plan));
+  state.SetExecutionPlan(std::move(p_seq_exec_plan));
+
+  vector<OrtValue> outputs;
+  ExecutionFrame frame({}, {}, {}, outputs, {}, state);
+  frame.EnableMemoryAccounting();
+
+  const auto& cpu_info = execution_providers.Get(xp_typ)->GetAllocator(0, OrtMemTypeDefault)->Info();
+  int start_index = frame.GetNodeOffset(node->Index());
+  OrtValue& mlvalue0 = *frame.GetMutableNodeInputOrOutputMLValue(start_index);
+  ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(mlvalue0, start_index, DataTypeImpl::GetType<float>(),
+                                                            cpu_info, TensorShape({2, 3})));
+
+  // the reused buffer isn't counted
+  OrtValue& mlvalue1 = *frame.GetMutableNodeInputOrOutputMLValue(start_index + 1);
+  ASSERT_STATUS_OK(frame.AllocateMLValueTensorPreAllocateBuffer(mlvalue1, start_index, DataTypeImpl::GetType<float>(),
+                                                                cpu_info, TensorShape({3, 2})));
+  EXPECT_EQ(frame.AllocatedBytes(), 64u);
+  EXPECT_EQ(frame.PeakLiveBytes(), 64u);
+
+  ASSERT_STATUS_OK(frame.ReleaseMLValue(start_index));
+  OrtValue& mlvalue2 = *frame.GetMutableNodeInputOrOutputMLValue(start_index);
+  ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(mlvalue2, start_index, DataTypeImpl::GetType<float>(),
+                                                            cpu_info, TensorShape({4, 8})));
+  EXPECT_EQ(frame.AllocatedBytes(), 64u + 128u);
+  EXPECT_EQ(frame.PeakLiveBytes(), 128u);
+}
+
 TEST_F(ExecutionFrameTest, FeedInDataTest) {
   onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
                            std::unordered_map<std::string, int>{{"", 10}}, {},
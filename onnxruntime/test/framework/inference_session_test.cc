@@ -20,6 +20,7 @@
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_weights.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -2349,5 +2350,86 @@ TEST(InferenceSessionTests, InvalidSessionEnvCombination) {
   }
 }
 
+// Sessions created with use_env_shared_initializers use the initializers added to the env, and share their
+// prepacked forms, instead of holding their own copies.
+TEST(InferenceSessionTests, UseEnvSharedInitializers) {
+  auto logging_manager = onnxruntime::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kWARNING, false,
+      LoggingManager::InstanceType::Temporal);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  // matmul_1.onnx computes Y = X * W with the initializer W = [[1], [2]]. share W = [[2], [3]] instead.
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  OrtValue shared_w;
+  CreateMLValue<float>(allocator, {2, 1}, {2.0f, 3.0f}, &shared_w);
+  SharedWeights& shared_weights = *env->GetSharedWeights();
+  ASSERT_STATUS_OK(shared_weights.AddInitializer("W", shared_w));
+  ASSERT_FALSE(shared_weights.AddInitializer("W", shared_w).IsOK());
+
+  SessionOptions so;
+  so.use_env_shared_initializers = true;
+  std::vector<std::unique_ptr<InferenceSessionTestGlobalThreadPools>> sessions;
+  for (int i = 0; i < 2; ++i) {
+    so.session_logid = "UseEnvSharedInitializers" + std::to_string(i);
+    sessions.push_back(onnxruntime::make_unique<InferenceSessionTestGlobalThreadPools>(so, *env));
+    auto& session_object = *sessions.back();
+    ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    const SessionState& session_state = session_object.GetSessionState();
+    int w_idx;
+    ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("W", w_idx));
+    EXPECT_EQ(session_state.GetInitializedTensors().at(w_idx).Get<Tensor>().DataRaw(),
+              shared_w.Get<Tensor>().DataRaw());
+
+    OrtValue x;
+    CreateMLValue<float>(allocator, {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+    NameMLValMap feeds{{"X", x}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"Y"}, &fetches));
+    VerifyOutputs(fetches, {3, 1}, {8.0f, 18.0f, 28.0f});
+  }
+
+#ifndef USE_MKLML_FOR_BLAS
+  // both MatMul kernels use the same packed W
+  EXPECT_EQ(shared_weights.NumPrepackedBuffers(), static_cast<size_t>(1));
+#endif
+
+  // a session that doesn't opt in uses the initializer of the model
+  so.use_env_shared_initializers = false;
+  InferenceSession session_object{so, *env};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  OrtValue x;
+  CreateMLValue<float>(allocator, {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+  NameMLValMap feeds{{"X", x}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"Y"}, &fetches));
+  VerifyOutputs(fetches, {3, 1}, {5.0f, 11.0f, 17.0f});
+}
+
+// A shared initializer that doesn't match the shape of the initializer in the model fails the session.
+TEST(InferenceSessionTests, UseEnvSharedInitializersShapeMismatch) {
+  auto logging_manager = onnxruntime::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kWARNING, false,
+      LoggingManager::InstanceType::Temporal);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  OrtValue shared_w;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2}, {2.0f, 3.0f},
+                       &shared_w);
+  ASSERT_STATUS_OK(env->GetSharedWeights()->AddInitializer("W", shared_w));
+
+  SessionOptions so;
+  so.use_env_shared_initializers = true;
+  InferenceSession session_object{so, *env};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+  auto status = session_object.Initialize();
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("does not match the type or shape"));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
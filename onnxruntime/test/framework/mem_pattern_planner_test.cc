@@ -34,5 +34,33 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+TEST(MemPatternPlannerTest, StaticMemPatternTest) {
+  // step:  0    1    2    3
+  // 0:     [------]              256
+  // 1:     [---]                 1024
+  // 2:          [---------]      1024
+  // 3:               [----]      512
+  StaticMemPatternPlanner planner;
+  planner.AddAllocation(0, 256, 0, 1);
+  planner.AddAllocation(1, 1024, 0, 0);
+  planner.AddAllocation(2, 1024, 1, 3);
+  planner.AddAllocation(3, 512, 2, 3);
+
+  auto trace_order = planner.GenerateTraceOrderMemPattern();
+  EXPECT_EQ(trace_order.PeakSize(), 256u + 1024u + 512u);
+  EXPECT_EQ(trace_order.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(trace_order.GetBlock(1)->offset_, 256u);
+  EXPECT_EQ(trace_order.GetBlock(2)->offset_, 256u);
+  EXPECT_EQ(trace_order.GetBlock(3)->offset_, 256u + 1024u);
+
+  auto greedy_by_size = planner.GenerateGreedyBySizeMemPattern();
+  EXPECT_EQ(greedy_by_size.PeakSize(), 1024u + 512u);
+  EXPECT_EQ(greedy_by_size.GetBlock(1)->offset_, 0u);
+  EXPECT_EQ(greedy_by_size.GetBlock(2)->offset_, 0u);
+  EXPECT_EQ(greedy_by_size.GetBlock(3)->offset_, 1024u);
+  EXPECT_EQ(greedy_by_size.GetBlock(0)->offset_, 1024u);
+  EXPECT_EQ(greedy_by_size.GetBlock(0)->size_, 256u);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -138,6 +138,16 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
   status = session_initializer.CreatePlan(nullptr, nullptr, ExecutionMode::ORT_SEQUENTIAL);
   ASSERT_TRUE(status.IsOK()) << status;
 
+  // every node of the plan has its execution record resolved
+  const auto& exec_plan = session_state.GetExecutionPlan()->execution_plan;
+  const auto& node_records = session_state.GetNodeExecutionRecords();
+  ASSERT_EQ(exec_plan.size(), node_records.size());
+  for (size_t i = 0; i < exec_plan.size(); ++i) {
+    EXPECT_EQ(exec_plan[i].node_index, node_records[i].node_index);
+    EXPECT_EQ(session_state.GetKernel(exec_plan[i].node_index), node_records[i].kernel);
+    EXPECT_EQ(session_state.GetNodeIndexInfo().GetNodeOffset(exec_plan[i].node_index), node_records[i].node_offset);
+  }
+
   const auto& initialized_tensors = session_state.GetInitializedTensors();
   const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
 
@@ -166,5 +176,53 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
 }
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateTestP, testing::ValuesIn(param_list));
+
+// Test that memory patterns are shared within a bucket of input shapes and evicted least recently used first
+TEST(SessionStateTest, MemoryPatternCacheBucketing) {
+  ExecutionProviders execution_providers;
+  SessionState s{execution_providers, true, nullptr, nullptr};
+  MemoryPatternCacheOptions options;
+  options.bucket_dims_to_power_of_2 = true;
+  options.max_num_patterns = 2;
+  s.SetMemoryPatternCacheOptions(options);
+
+  auto lookup = [&s](int64_t sequence_length, bool& needs_trace) {
+    TensorShape shape({1, sequence_length});
+    std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+    return s.GetMemoryPatternGroup(input_shapes, needs_trace) != nullptr;
+  };
+  auto update = [&s](int64_t sequence_length) {
+    TensorShape shape({1, sequence_length});
+    std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+    ASSERT_STATUS_OK(s.UpdateMemoryPatternGroupCache(input_shapes, onnxruntime::make_unique<MemoryPatternGroup>()));
+  };
+
+  bool needs_trace = false;
+  EXPECT_FALSE(lookup(65, needs_trace));
+  EXPECT_TRUE(needs_trace);
+  update(65);
+  // 65 and 100 are both in the bucket of 128
+  EXPECT_TRUE(lookup(100, needs_trace));
+  EXPECT_FALSE(needs_trace);
+
+  EXPECT_FALSE(lookup(129, needs_trace));
+  update(129);
+  // evicts the bucket of 128, the least recently used one
+  update(10);
+  EXPECT_FALSE(lookup(70, needs_trace));
+  EXPECT_TRUE(lookup(200, needs_trace));
+
+  // a run that outgrew the pattern of its bucket makes the next one retrace it
+  TensorShape shape({1, 250});
+  s.MarkMemoryPatternGroupOutgrown({std::cref(shape)});
+  EXPECT_TRUE(lookup(180, needs_trace));
+  EXPECT_TRUE(needs_trace);
+
+  auto stats = s.GetMemoryPatternCacheStats();
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.num_patterns, 2u);
+}
 }  // namespace test
 }  // namespace onnxruntime
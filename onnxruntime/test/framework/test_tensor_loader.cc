@@ -136,6 +136,81 @@ TEST(CApiTensorTest, load_float_tensor_with_external_data) {
   run_external_data_test<false>();
 }
 
+TEST(CApiTensorTest, load_float_tensor_in_place) {
+  const float test_data[] = {1.0f, 2.2f, 3.5f};
+  OrtMemoryInfo cpu_memory_info(onnxruntime::CPU, OrtDeviceAllocator, OrtDevice(), 0, OrtMemTypeDefault);
+
+  // raw_data is moved into the tensor
+  {
+    onnx::TensorProto p;
+    p.mutable_dims()->Add(3);
+    p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+    p.set_raw_data(test_data, sizeof(test_data));
+    ASSERT_TRUE(utils::CanUseTensorProtoDataInPlace(p));
+    OrtValue value;
+    OrtCallback deleter;
+    auto st = utils::TensorProtoToMLValueInPlace(Env::Default(), nullptr, p, cpu_memory_info, value, deleter);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    ASSERT_TRUE(p.raw_data().empty());
+    const float* real_output = value.Get<Tensor>().Data<float>();
+    ASSERT_EQ(real_output[0], 1.0f);
+    ASSERT_EQ(real_output[1], 2.2f);
+    ASSERT_EQ(real_output[2], 3.5f);
+    ASSERT_NE(deleter.f, nullptr);
+    deleter.f(deleter.param);
+  }
+
+  // external data is mapped from its file
+  {
+    FILE* fp;
+    std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+    CreateTestFile(fp, filename);
+    std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                           DeleteFileFromDisk);
+    ASSERT_EQ(sizeof(test_data), fwrite(test_data, 1, sizeof(test_data), fp));
+    ASSERT_EQ(0, fclose(fp));
+    onnx::TensorProto p;
+    onnx::StringStringEntryProto* location = p.mutable_external_data()->Add();
+    location->set_key("location");
+    location->set_value(ToMBString(filename));
+    p.mutable_dims()->Add(3);
+    p.set_data_location(onnx::TensorProto_DataLocation_EXTERNAL);
+    p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+    ASSERT_TRUE(utils::CanUseTensorProtoDataInPlace(p));
+    OrtValue value;
+    OrtCallback deleter;
+    auto st = utils::TensorProtoToMLValueInPlace(Env::Default(), nullptr, p, cpu_memory_info, value, deleter);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    const float* real_output = value.Get<Tensor>().Data<float>();
+    ASSERT_EQ(real_output[0], 1.0f);
+    ASSERT_EQ(real_output[1], 2.2f);
+    ASSERT_EQ(real_output[2], 3.5f);
+    ASSERT_NE(deleter.f, nullptr);
+    deleter.f(deleter.param);
+  }
+
+  // data that doesn't match the shape is rejected
+  {
+    onnx::TensorProto p;
+    p.mutable_dims()->Add(4);
+    p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+    p.set_raw_data(test_data, sizeof(test_data));
+    OrtValue value;
+    OrtCallback deleter;
+    ASSERT_FALSE(utils::TensorProtoToMLValueInPlace(Env::Default(), nullptr, p, cpu_memory_info, value, deleter).IsOK());
+    ASSERT_EQ(deleter.f, nullptr);
+  }
+
+  // string tensors are always copied
+  {
+    onnx::TensorProto p;
+    p.mutable_dims()->Add(1);
+    p.set_data_type(onnx::TensorProto_DataType_STRING);
+    p.add_string_data("a");
+    ASSERT_FALSE(utils::CanUseTensorProtoDataInPlace(p));
+  }
+}
+
 #if defined(__amd64__) || defined(_M_X64)
 #ifndef __ANDROID__
 #ifdef NDEBUG
@@ -17,8 +17,12 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -255,8 +259,28 @@ private:
                 printf("mismatch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, float(C[f]), float(CReference[f]));
             }
         }
+
+        TestPackedB(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, CReference, ldc);
     }
 
+    void
+    TestPackedB(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const T* A,
+        size_t lda,
+        const T* B,
+        size_t ldb,
+        float beta,
+        T* C,
+        T* CReference,
+        size_t ldc
+        );
+
     void
     ReferenceGemm(
         CBLAS_TRANSPOSE TransA,
@@ -370,6 +394,7 @@ private:
     MatrixGuardBuffer<T> BufferB;
     MatrixGuardBuffer<T> BufferC;
     MatrixGuardBuffer<T> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
 
 public:
     void
@@ -464,6 +489,167 @@ public:
     }
 };
 
+template<typename T>
+void
+MlasFgemmTest<T>::TestPackedB(
+    CBLAS_TRANSPOSE,
+    CBLAS_TRANSPOSE,
+    size_t,
+    size_t,
+    size_t,
+    float,
+    const T*,
+    size_t,
+    const T*,
+    size_t,
+    float,
+    T*,
+    T*,
+    size_t
+    )
+{
+    //
+    // Packing matrix B is only supported for single precision.
+    //
+}
+
+template<>
+void
+MlasFgemmTest<float>::TestPackedB(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    float* CReference,
+    size_t ldc
+    )
+{
+    size_t PackedBSize = MlasGemmPackBSize(N, K);
+    void* PackedB = BufferBPacked.GetBuffer(PackedBSize);
+
+    MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+
+    std::fill_n(C, M * N, -0.5f);
+    std::fill_n(CReference, M * N, -0.5f);
+
+    MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, threadpool);
+    ReferenceGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, ldc);
+
+    for (size_t f = 0; f < M * N; f++) {
+        // Sensitive to comparing positive/negative zero.
+        if (C[f] != CReference[f]) {
+            printf("mismatch PackedB TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, float(C[f]), float(CReference[f]));
+        }
+    }
+}
+
+class MlasSgemmBatchTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        const float* A = BufferA.GetBuffer(K * M * BatchSize);
+        const float* B = BufferB.GetBuffer(N * K * BatchSize);
+        float* C = BufferC.GetBuffer(N * M * BatchSize);
+        float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+        Test(CblasNoTrans, CblasNoTrans, BatchSize, M, N, K, alpha, A, K, B, N, beta, C, CReference, N);
+        Test(CblasNoTrans, CblasTrans, BatchSize, M, N, K, alpha, A, K, B, K, beta, C, CReference, N);
+        Test(CblasTrans, CblasNoTrans, BatchSize, M, N, K, alpha, A, M, B, N, beta, C, CReference, N);
+        Test(CblasTrans, CblasTrans, BatchSize, M, N, K, alpha, A, M, B, K, beta, C, CReference, N);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        float* CReference,
+        size_t ldc
+        )
+    {
+        std::fill_n(C, M * N * BatchSize, -0.5f);
+        std::fill_n(CReference, M * N * BatchSize, -0.5f);
+
+        std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+
+        for (size_t i = 0; i < BatchSize; i++) {
+            Data[i].A = A + M * K * i;
+            Data[i].lda = lda;
+            Data[i].B = B + N * K * i;
+            Data[i].ldb = ldb;
+            Data[i].C = C + M * N * i;
+            Data[i].ldc = ldc;
+            Data[i].alpha = alpha;
+            Data[i].beta = beta;
+        }
+
+        MlasGemmBatch(TransA, TransB, M, N, K, Data.data(), BatchSize, threadpool);
+
+        for (size_t i = 0; i < BatchSize; i++) {
+            MlasGemm(TransA, TransB, M, N, K, alpha, A + M * K * i, lda, B + N * K * i,
+                ldb, beta, CReference + M * N * i, ldc, nullptr);
+        }
+
+        for (size_t f = 0; f < M * N * BatchSize; f++) {
+            // Sensitive to comparing positive/negative zero.
+            if (C[f] != CReference[f]) {
+                printf("mismatch Batch TransA=%d, TransB=%d, BatchSize=%zd, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, BatchSize, M, N, K, alpha, beta, C[f], CReference[f]);
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        static const size_t batches[] = { 1, 2, 3, 7, 16, 33 };
+
+        for (size_t i = 0; i < _countof(batches); i++) {
+            for (size_t b = 1; b < 16; b++) {
+                Test(batches[i], b, b, b, 1.0f, 0.0f);
+            }
+            Test(batches[i], 1, 160, 64, 1.0f, 0.0f);
+            Test(batches[i], 160, 1, 64, 0.5f, 1.0f);
+            Test(batches[i], 64, 64, 64, -1.0f, 0.25f);
+            Test(batches[i], 128, 256, 32, 1.0f, 0.0f);
+        }
+    }
+};
+
 #ifdef MLAS_HAS_QGEMM_U8X8
 
 template <typename xint8_t>
@@ -516,6 +702,133 @@ private:
         }
     }
 
+    void
+    TestBatch(
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        uint8_t offa,
+        uint8_t offb
+        )
+    {
+        const uint8_t* A = BufferA.GetBuffer(K * M * BatchSize);
+        const xint8_t* B = BufferB.GetBuffer(N * K * BatchSize);
+        int32_t* C = BufferC.GetBuffer(N * M * BatchSize);
+        int32_t* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+        std::fill_n(C, M * N * BatchSize, -1);
+        std::fill_n(CReference, M * N * BatchSize, -1);
+
+        std::vector<MLAS_GEMM_U8X8_DATA_PARAMS> Data(BatchSize);
+
+        for (size_t i = 0; i < BatchSize; i++) {
+            Data[i].A = A + M * K * i;
+            Data[i].lda = K;
+            Data[i].B = B + N * K * i;
+            Data[i].ldb = N;
+            Data[i].C = C + M * N * i;
+            Data[i].ldc = N;
+        }
+
+        MlasGemmBatch(M, N, K, Data.data(), BatchSize, offa, offb,
+            std::is_signed<xint8_t>::value, threadpool);
+
+        for (size_t i = 0; i < BatchSize; i++) {
+            ReferenceQgemm(M, N, K, A + M * K * i, K, offa, B + N * K * i, N,
+                xint8_t(offb), CReference + M * N * i, N);
+        }
+
+        for (size_t f = 0; f < M * N * BatchSize; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch Batch BatchSize=%zd, M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", BatchSize, M, N, K, (int)offa, (int)offb);
+            }
+        }
+    }
+
+    void
+    TestPackedAndPerColumn(
+        size_t M,
+        size_t N,
+        size_t K,
+        uint8_t offa,
+        bool PackB,
+        bool PerColumnZeroPoints
+        )
+    {
+        const uint8_t* A = BufferA.GetBuffer(K * M);
+        const xint8_t* B = BufferB.GetBuffer(N * K);
+        int32_t* C = BufferC.GetBuffer(N * M);
+        int32_t* CReference = BufferCReference.GetBuffer(N * M);
+        uint8_t* Output = BufferOutput.GetBuffer(N * M);
+
+        std::fill_n(C, M * N, -1);
+        std::fill_n(CReference, M * N, -1);
+
+        std::vector<uint8_t> ZeroPointB(N);
+        std::vector<int32_t> Bias(N);
+        std::vector<float> Scale(N);
+
+        for (size_t n = 0; n < N; n++) {
+            ZeroPointB[n] = uint8_t(n * 37 + 11);
+            Bias[n] = int32_t(n * 97 % 1001) - 500;
+            Scale[n] = 0.0005f * float(n % 13 + 1);
+        }
+
+        std::vector<uint8_t> PackedB;
+
+        MLAS_GEMM_U8X8_DATA_PARAMS Data;
+
+        Data.A = A;
+        Data.lda = K;
+        Data.C = C;
+        Data.ldc = N;
+
+        if (PackB) {
+            PackedB.resize(MlasGemmPackBSize(N, K, std::is_signed<xint8_t>::value));
+            MlasGemmPackB(N, K, (const uint8_t*)B, N, std::is_signed<xint8_t>::value, PackedB.data());
+            Data.B = PackedB.data();
+            Data.BIsPacked = true;
+        } else {
+            Data.B = B;
+            Data.ldb = N;
+        }
+
+        if (PerColumnZeroPoints) {
+            Data.ZeroPointB = ZeroPointB.data();
+        }
+
+        MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR OutputProcessor(Output, N, Bias.data(),
+            Scale.data(), true, 29);
+
+        Data.OutputProcessor = &OutputProcessor;
+
+        const uint8_t offb = 5;
+
+        MlasGemmBatch(M, N, K, &Data, 1, offa, offb, std::is_signed<xint8_t>::value, threadpool);
+
+        for (size_t n = 0; n < N; n++) {
+            xint8_t zp = xint8_t(PerColumnZeroPoints ? ZeroPointB[n] : offb);
+            ReferenceQgemm(M, 1, K, A, K, offa, B + n, N, zp, CReference + n, N);
+        }
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                size_t f = m * N + n;
+                if (C[f] != CReference[f]) {
+                    printf("mismatch PackB=%d, PerColumn=%d, M=%zd, N=%zd, K=%zd, offa=%d!\n", int(PackB), int(PerColumnZeroPoints), M, N, K, (int)offa);
+                    return;
+                }
+                float Value = std::nearbyint(float(CReference[f] + Bias[n]) * Scale[n]) + 29.0f;
+                Value = std::min(std::max(Value, 0.0f), 255.0f);
+                if (Output[f] != uint8_t(Value)) {
+                    printf("mismatch requantize PackB=%d, PerColumn=%d, M=%zd, N=%zd, K=%zd, offa=%d!\n", int(PackB), int(PerColumnZeroPoints), M, N, K, (int)offa);
+                    return;
+                }
+            }
+        }
+    }
+
     void
     ReferenceQgemm(
         size_t M,
@@ -555,6 +868,7 @@ private:
     MatrixGuardBuffer<xint8_t> BufferB;
     MatrixGuardBuffer<int32_t> BufferC;
     MatrixGuardBuffer<int32_t> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferOutput;
 
 public:
     void
@@ -565,6 +879,19 @@ public:
         for (size_t b = 1; b < 16; b++) {
             Test(b, b, b, 14, 211);
         }
+        static const size_t PackedShapes[][3] = {
+            { 1, 1, 1 }, { 1, 31, 127 }, { 5, 17, 3 }, { 16, 16, 16 }, { 7, 255, 129 },
+            { 33, 300, 257 }, { 64, 257, 400 }, { 2, 1000, 66 },
+        };
+        for (size_t i = 0; i < _countof(PackedShapes); i++) {
+            const size_t M = PackedShapes[i][0];
+            const size_t N = PackedShapes[i][1];
+            const size_t K = PackedShapes[i][2];
+            TestPackedAndPerColumn(M, N, K, 0, true, false);
+            TestPackedAndPerColumn(M, N, K, 91, true, false);
+            TestPackedAndPerColumn(M, N, K, 91, false, true);
+            TestPackedAndPerColumn(M, N, K, 203, true, true);
+        }
         for (size_t b = 16; b <= 256; b <<= 1) {
             Test(b, b, b, 34, 1);
         }
@@ -576,6 +903,10 @@ public:
             Test(1, 32, b, 0, 0);
             Test(1, b, b, 0, 0);
         }
+        for (size_t b = 1; b < 40; b += 3) {
+            TestBatch(b, 17, 48, 32, 12, 159);
+            TestBatch(b, 64, 3, 19, 200, 7);
+        }
     }
 
     void
@@ -1967,6 +2298,180 @@ public:
     }
 };
 
+class MlasSoftmaxTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t N,
+        size_t D,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N * D);
+        float* Output = BufferOutput.GetBuffer(N * D);
+        float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+
+        std::default_random_engine generator(static_cast<unsigned>(N * D));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            Input[nd] = distribution(generator);
+        }
+
+        Test(Input, Output, OutputReference, N, D, false);
+        Test(Input, Output, OutputReference, N, D, true);
+    }
+
+    void
+    Test(
+        const float* Input,
+        float* Output,
+        float* OutputReference,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        MlasComputeSoftmax(Input, Output, N, D, LogSoftmax, threadpool);
+        ReferenceSoftmax(Input, OutputReference, N, D, LogSoftmax);
+
+        constexpr float AbsoluteTolerance = 1e-6f;
+        constexpr float RelativeTolerance = 1e-6f;
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            float diff = std::fabs(Output[nd] - OutputReference[nd]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[nd]) * RelativeTolerance) {
+                printf("mismatch softmax LogSoftmax=%d, N=%zd, D=%zd, nd=%zd  %f %f!\n", int(LogSoftmax), N, D, nd, Output[nd], OutputReference[nd]);
+            }
+        }
+    }
+
+    void
+    ReferenceSoftmax(
+        const float* Input,
+        float* Output,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        for (size_t n = 0; n < N; n++) {
+
+            float MaximumValue = std::numeric_limits<float>::lowest();
+
+            for (size_t d = 0; d < D; d++) {
+                MaximumValue = (std::max)(MaximumValue, Input[d]);
+            }
+
+            double Sum = 0.0;
+
+            for (size_t d = 0; d < D; d++) {
+                double e = std::exp(double(Input[d]) - double(MaximumValue));
+                Sum += e;
+                Output[d] = float(e);
+            }
+
+            if (LogSoftmax) {
+
+                float Scale = float(std::log(Sum));
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] = Input[d] - MaximumValue - Scale;
+                }
+
+            } else {
+
+                float Scale = float(Sum);
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] /= Scale;
+                }
+            }
+
+            Input += D;
+            Output += D;
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t d = 1; d < 128; d++) {
+            Test(1, d, -10.f, 10.f);
+        }
+
+        Test(3, 128, 20.f, 30.f);
+        Test(63, 95, -150.f, 190.f);
+        Test(16, 211, 20.f, 30.f);
+        Test(1, 32000, -10.f, 10.f);
+    }
+};
+
+template<typename ElementType>
+class MlasTransposeTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<ElementType> BufferInput;
+    MatrixGuardBuffer<ElementType> BufferOutput;
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t ldInput,
+        size_t ldOutput
+        )
+    {
+        ElementType* Input = BufferInput.GetBuffer(M * ldInput);
+        ElementType* Output = BufferOutput.GetBuffer(N * ldOutput);
+
+        for (size_t i = 0; i < M * ldInput; i++) {
+            Input[i] = ElementType(i * 7 + 3);
+        }
+
+        std::fill_n(Output, N * ldOutput, ElementType(0xA5));
+
+        MlasTranspose(M, N, Input, ldInput, Output, ldOutput);
+
+        for (size_t n = 0; n < N; n++) {
+            for (size_t m = 0; m < ldOutput; m++) {
+                ElementType Expected = (m < M) ? Input[m * ldInput + n] : ElementType(0xA5);
+                if (Output[n * ldOutput + m] != Expected) {
+                    printf("mismatch Transpose: M=%zd, N=%zd, ldInput=%zd, ldOutput=%zd, n=%zd, m=%zd\n",
+                        M, N, ldInput, ldOutput, n, m);
+                    return;
+                }
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t m = 1; m <= 19; m++) {
+            for (size_t n = 1; n <= 19; n++) {
+                Test(m, n, n, m);
+                Test(m, n, n + 3, m + 5);
+            }
+        }
+
+        Test(64, 64, 64, 64);
+        Test(128, 96, 512, 768);
+    }
+};
+
 class MlasReorderOutputTest : public MlasTestBase
 {
 private:
@@ -2081,6 +2586,7 @@ main(
 
         printf("SGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<float>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasSgemmBatchTest>()->ExecuteShort();
 #ifdef MLAS_HAS_DGEMM
         printf("DGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<double>>()->ExecuteShort();
@@ -2107,6 +2613,13 @@ main(
         printf("Pool3D tests.\n");
         onnxruntime::make_unique<MlasPool3DTest>()->ExecuteShort();
 
+        printf("Softmax tests.\n");
+        onnxruntime::make_unique<MlasSoftmaxTest>()->ExecuteShort();
+
+        printf("Transpose tests.\n");
+        onnxruntime::make_unique<MlasTransposeTest<uint32_t>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasTransposeTest<uint8_t>>()->ExecuteShort();
+
         printf("Done.\n");
 #if !defined(MLAS_NO_ONNXRUNTIME_THREADPOOL)
         if (threadpool != nullptr)
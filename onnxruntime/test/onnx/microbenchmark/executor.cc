@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <chrono>
+#include <string>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_SKIP_ON_ERROR(expr)                                 \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// A chain of num_nodes Identity nodes on a single float, so that running the model costs
+// little more than the per node work of the executor.
+static std::string CreateIdentityChainModel(int num_nodes) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(11);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("identity_chain");
+  auto add_value_info = [](ONNX_NAMESPACE::ValueInfoProto* value_info, const std::string& name) {
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(1);
+  };
+
+  for (int i = 0; i < num_nodes; ++i) {
+    auto* node = graph->add_node();
+    node->set_op_type("Identity");
+    node->set_name("identity_" + std::to_string(i));
+    node->add_input("v" + std::to_string(i));
+    node->add_output("v" + std::to_string(i + 1));
+  }
+  add_value_info(graph->add_input(), "v0");
+  add_value_info(graph->add_output(), "v" + std::to_string(num_nodes));
+
+  return model.SerializeAsString();
+}
+
+// Reports the framework overhead per node of a sequential Run in the ns_per_node counter.
+static void BM_SequentialExecutorPerNodeOverhead(benchmark::State& state) {
+  const int num_nodes = static_cast<int>(state.range(0));
+  const std::string model_data = CreateIdentityChainModel(num_nodes);
+
+  OrtSessionOptions* session_options;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_SKIP_ON_ERROR(g_ort->SetSessionGraphOptimizationLevel(session_options, ORT_DISABLE_ALL));
+  ORT_SKIP_ON_ERROR(g_ort->SetSessionExecutionMode(session_options, ORT_SEQUENTIAL));
+  ORT_SKIP_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, 1));
+  OrtSession* session;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options, &session));
+  g_ort->ReleaseSessionOptions(session_options);
+
+  OrtMemoryInfo* memory_info;
+  ORT_SKIP_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  float input_data = 1.f;
+  const int64_t input_shape[] = {1};
+  OrtValue* input;
+  ORT_SKIP_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &input_data, sizeof(input_data), input_shape, 1,
+                                                          ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input));
+  g_ort->ReleaseMemoryInfo(memory_info);
+
+  const std::string output_name_str = "v" + std::to_string(num_nodes);
+  const char* input_name = "v0";
+  const char* output_name = output_name_str.c_str();
+
+  std::chrono::nanoseconds elapsed{0};
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    auto start = std::chrono::high_resolution_clock::now();
+    ORT_SKIP_ON_ERROR(g_ort->Run(session, nullptr, &input_name, &input, 1, &output_name, 1, &output));
+    elapsed += std::chrono::high_resolution_clock::now() - start;
+    g_ort->ReleaseValue(output);
+  }
+
+  state.counters["ns_per_node"] =
+      static_cast<double>(elapsed.count()) / static_cast<double>(state.iterations() * num_nodes);
+  g_ort->ReleaseValue(input);
+  g_ort->ReleaseSession(session);
+}
+BENCHMARK(BM_SequentialExecutorPerNodeOverhead)->Arg(100)->Arg(1000)->Arg(5000);
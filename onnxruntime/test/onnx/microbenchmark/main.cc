@@ -11,6 +11,7 @@
 #include <core/common/logging/sinks/clog_sink.h>
 #include <core/graph/model.h>
 #include <core/graph/graph.h>
+#include <core/framework/bfc_arena.h>
 #include <core/framework/kernel_def_builder.h>
 #include <core/session/onnxruntime_c_api.h>
 #include <core/session/onnxruntime_cxx_api.h>
@@ -33,6 +34,36 @@ static void BM_CPUAllocator(benchmark::State& state) {
 }
 BENCHMARK(BM_CPUAllocator)->Arg(4)->Arg(sizeof(Tensor));
 
+// Alloc/Free throughput of an arena shared by all the benchmark threads, with the thread caches disabled (0) or
+// enabled (1). Each thread keeps a few allocations of mixed small sizes alive, as the kernels of concurrent runs do.
+static BFCArena* bfc_arena_for_benchmark = nullptr;
+static void BM_BFCArenaConcurrentAllocFree(benchmark::State& state) {
+  if (state.thread_index == 0) {
+    bfc_arena_for_benchmark = new BFCArena(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30,
+                                           ArenaExtendStrategy::kNextPowerOfTwo, state.range(0) != 0);
+  }
+
+  constexpr int kNumLiveAllocations = 4;
+  void* ptrs[kNumLiveAllocations];
+  size_t iteration = static_cast<size_t>(state.thread_index);
+  for (auto _ : state) {
+    for (int i = 0; i < kNumLiveAllocations; ++i) {
+      ptrs[i] = bfc_arena_for_benchmark->Alloc(256 * ((iteration + i) % 64 + 1));
+    }
+    for (int i = 0; i < kNumLiveAllocations; ++i) {
+      bfc_arena_for_benchmark->Free(ptrs[i]);
+    }
+    ++iteration;
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLiveAllocations);
+
+  if (state.thread_index == 0) {
+    delete bfc_arena_for_benchmark;
+    bfc_arena_for_benchmark = nullptr;
+  }
+}
+BENCHMARK(BM_BFCArenaConcurrentAllocFree)->Arg(0)->Arg(1)->ThreadRange(1, 32)->UseRealTime();
+
 static void BM_ResolveGraph(benchmark::State& state) {
   std::shared_ptr<onnxruntime::Model> model_copy;
   auto logger = env->GetLoggingManager()->CreateLogger("test");
@@ -1,6 +1,7 @@
 #include "ort_test_session.h"
 #include <core/session/onnxruntime_cxx_api.h>
 #include <assert.h>
+#include <sstream>
 #include "providers.h"
 #include "TestCase.h"
 
@@ -136,6 +137,30 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
   }
 }
 
+std::string OnnxRuntimeTestSession::GetMemoryReport() {
+  OrtArenaStats stats;
+  try {
+    stats = session_.GetArenaStats(Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault));
+  } catch (const Ort::Exception& ex) {
+    return std::string("CPU arena statistics are not available: ") + ex.what();
+  }
+
+  const int64_t free_bytes = stats.total_allocated_bytes - stats.bytes_in_use;
+  std::ostringstream oss;
+  oss << "CPU arena bytes in use:" << stats.bytes_in_use << std::endl
+      << "CPU arena peak bytes in use:" << stats.max_bytes_in_use << std::endl
+      << "CPU arena total allocated bytes:" << stats.total_allocated_bytes << std::endl
+      << "CPU arena largest allocation:" << stats.max_alloc_size << " bytes" << std::endl
+      << "CPU arena allocations:" << stats.num_allocs << std::endl
+      << "CPU arena regions:" << stats.num_regions << std::endl
+      << "CPU arena largest free block:" << stats.largest_free_block_bytes << " bytes" << std::endl
+      // the share of the free memory that can't serve an allocation of the largest free block size
+      << "CPU arena fragmentation:"
+      << (free_bytes > 0 ? 100.0 * static_cast<double>(free_bytes - stats.largest_free_block_bytes) / free_bytes : 0.0)
+      << " %";
+  return oss.str();
+}
+
 bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData()
 {
   // iterate over all input nodes
@@ -33,6 +33,7 @@ class OnnxRuntimeTestSession : public TestSession {
     }
   }
   std::chrono::duration<double> Run() override;
+  std::string GetMemoryReport() override;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
@@ -80,6 +80,14 @@ Status PerformanceRunner::Run() {
             << "Average inference time cost:" << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms" << std::endl
             // Time between start and end of run. Less than Total time cost when running requests in parallel.
             << "Total inference run time:" << inference_duration.count() << " s" << std::endl;
+
+  if (performance_test_config_.run_config.f_memory_report) {
+    std::cout << "Peak working set size:" << performance_result_.peak_workingset_size << " bytes" << std::endl;
+    const std::string memory_report = session_->GetMemoryReport();
+    if (!memory_report.empty()) {
+      std::cout << memory_report << std::endl;
+    }
+  }
   return Status::OK();
 }
 
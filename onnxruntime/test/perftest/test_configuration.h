@@ -42,6 +42,7 @@ struct RunConfig {
   size_t concurrent_session_runs{1};
   bool f_dump_statistics{false};
   bool f_verbose{false};
+  bool f_memory_report{false};
   bool enable_memory_pattern{true};
   bool enable_cpu_mem_arena{true};
   bool generate_model_input_binding{false};
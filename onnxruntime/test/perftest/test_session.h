@@ -3,6 +3,7 @@
 
 #pragma once
 #include <stdlib.h>
+#include <string>
 
 #include "OrtValueList.h"
 
@@ -16,6 +17,8 @@ class TestSession {
   // Please measure the perf at a higher level.
   void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, OrtValue* value) = 0;
+  // Describes the memory held by the session, empty if the backend can't tell.
+  virtual std::string GetMemoryReport() { return std::string(); }
 
   virtual ~TestSession() = default;
 };
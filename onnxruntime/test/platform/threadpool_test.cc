@@ -102,6 +102,20 @@ TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_81_Task_20_Batch) {
   TestBatchParallelFor("TestBatchParallelFor_2_Thread_81_Task_20_Batch", 2, 81, 20);
 }
 
+// Every worker of the pool waits for a nested loop scheduled in the same pool, which only
+// completes because waiting threads run the queued iterations themselves.
+TEST(ThreadPoolTest, TestNestedParallelFor_2_Thread_8_Outer_50_Inner) {
+  constexpr int num_outer = 8;
+  constexpr int num_inner = 50;
+  auto test_data = CreateTestData(num_outer * num_inner);
+  CreateThreadPoolAndTest("TestNestedParallelFor_2_Thread_8_Outer_50_Inner", 2, [&](ThreadPool* tp) {
+    tp->SimpleParallelFor(num_outer, [&](std::ptrdiff_t i) {
+      tp->SimpleParallelFor(num_inner, [&](std::ptrdiff_t j) { IncrementElement(*test_data, i * num_inner + j); });
+    });
+  });
+  ValidateTestData(*test_data);
+}
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestStackSize) {
   ThreadOptions to;
@@ -276,6 +276,34 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
 #endif
 }
 
+// Spans longer than a single parallel piece, for both the scalar-per-span and the general case
+TEST(MathOpTest, Add_Broadcast_Large) {
+  const int64_t rows = 3, cols = 40000;
+  std::vector<float> a(rows * cols), b(rows), c(rows * cols), d(rows * cols);
+  for (int64_t i = 0; i < rows * cols; i++) {
+    a[i] = static_cast<float>(i % 251);
+  }
+  for (int64_t r = 0; r < rows; r++) {
+    b[r] = static_cast<float>(1000 * (r + 1));
+    for (int64_t i = 0; i < cols; i++) {
+      c[r * cols + i] = a[r * cols + i] + b[r];
+      d[r * cols + i] = 2 * a[r * cols + i];
+    }
+  }
+
+  OpTester test("Add");
+  test.AddInput<float>("A", {rows, cols}, a);
+  test.AddInput<float>("B", {rows, 1}, b);
+  test.AddOutput<float>("C", {rows, cols}, c);
+  test.Run();
+
+  OpTester test_same_shape("Add");
+  test_same_shape.AddInput<float>("A", {rows, cols}, a);
+  test_same_shape.AddInput<float>("B", {rows, cols}, a);
+  test_same_shape.AddOutput<float>("C", {rows, cols}, d);
+  test_same_shape.Run();
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
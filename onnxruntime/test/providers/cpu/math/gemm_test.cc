@@ -106,6 +106,44 @@ TEST(GemmOpTest, GemmTrans) {
   test.Run();
 }
 
+TEST(GemmOpTest, GemmInitializerB) {
+  // A constant B is prepacked when the kernel is created.
+  auto run_test = [](bool trans_b) {
+    OpTester test("Gemm");
+
+    test.AddAttribute("transA", (int64_t)0);
+    test.AddAttribute("transB", (int64_t)(trans_b ? 1 : 0));
+    test.AddAttribute("alpha", 0.5f);
+    test.AddAttribute("beta", 2.0f);
+
+    test.AddInput<float>("A", {2, 4},
+                         {1.0f, 2.0f, 3.0f, 4.0f,
+                          -1.0f, -2.0f, -3.0f, -4.0f});
+    if (trans_b) {
+      test.AddInput<float>("B", {3, 4},
+                           {1.0f, 1.0f, 1.0f, 1.0f,
+                            2.0f, 2.0f, 2.0f, 2.0f,
+                            3.0f, 3.0f, 3.0f, 3.0f},
+                           true);
+    } else {
+      test.AddInput<float>("B", {4, 3},
+                           {1.0f, 2.0f, 3.0f,
+                            1.0f, 2.0f, 3.0f,
+                            1.0f, 2.0f, 3.0f,
+                            1.0f, 2.0f, 3.0f},
+                           true);
+    }
+    test.AddInput<float>("C", {3}, {1.0f, 2.0f, 3.0f});
+    test.AddOutput<float>("Y", {2, 3},
+                          {7.0f, 14.0f, 21.0f,
+                           -3.0f, -6.0f, -9.0f});
+    test.Run();
+  };
+
+  run_test(false);
+  run_test(true);
+}
+
 TEST(GemmOpTest, GemmAlphaBeta) {
   OpTester test("Gemm");
 
@@ -46,6 +46,13 @@ TEST(HardmaxOperator, LargeNumber) {
   RunTest(x_vals, expected_vals, dimensions);
 }
 
+TEST(HardmaxOperator, EmptyAxis) {
+  OpTester test("Hardmax");
+  test.AddInput<float>("X", {2, 0}, {});
+  test.AddOutput<float>("Y", {2, 0}, {});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  // TensorRT doesn't support empty dimension
+}
+
 //np.random.seed(123) # Use a seed so we can replicate the input and expected values here and in python
 //x = np.abs(np.random.randn(3, 4, 5).astype(np.float32))
 static std::vector<int64_t> three_dimensions = {3, 4, 5};
@@ -4,11 +4,14 @@
 #include "gtest/gtest.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/util/qmath.h"
 
+#include <limits>
 #include <random>
 
 namespace onnxruntime {
@@ -299,5 +302,58 @@ TEST(MatmulIntegerOpTest, MatMulInteger_Uint8_Int8_GEMM) {
   RunMatMulIntegerU8S8Test(4, 8, 68);
 }
 
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+// Per column B zero points are handled by the MLAS path of the CPU kernel, with
+// B either an initializer (prepacked at kernel creation) or a graph input.
+template <typename T2>
+void RunMatMulIntegerPerColumnZeroPointTest(const int M, const int N, const int K, bool is_b_initializer) {
+  OpTester test("MatMulInteger", 10);
+  static std::default_random_engine e(456);
+  std::uniform_int_distribution<int> n_a(0, 255);
+  std::uniform_int_distribution<int> n_b(std::numeric_limits<T2>::min(), std::numeric_limits<T2>::max());
+
+  std::vector<uint8_t> a(M * K);
+  std::vector<T2> b(K * N);
+  std::vector<T2> b_zero_point(N);
+  for (auto& v : a) v = static_cast<uint8_t>(n_a(e));
+  for (auto& v : b) v = static_cast<T2>(n_b(e));
+  for (auto& v : b_zero_point) v = static_cast<T2>(n_b(e));
+  const uint8_t a_zero_point = 97;
+
+  std::vector<int32_t> y(M * N);
+  for (int m = 0; m < M; m++) {
+    for (int n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int k = 0; k < K; k++) {
+        sum += (static_cast<int32_t>(a[m * K + k]) - a_zero_point) *
+               (static_cast<int32_t>(b[k * N + n]) - static_cast<int32_t>(b_zero_point[n]));
+      }
+      y[m * N + n] = sum;
+    }
+  }
+
+  test.AddInput<uint8_t>("T1", {M, K}, a);
+  test.AddInput<T2>("T2", {K, N}, b, is_b_initializer);
+  test.AddInput<uint8_t>("a_zero_point", {}, {a_zero_point});
+  test.AddInput<T2>("b_zero_point", {N}, b_zero_point);
+  test.AddOutput<int32_t>("T3", {M, N}, y);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MatmulIntegerOpTest, MatMulInteger_PerColumnZeroPoint) {
+  for (bool is_b_initializer : {false, true}) {
+    RunMatMulIntegerPerColumnZeroPointTest<uint8_t>(1, 33, 150, is_b_initializer);
+    RunMatMulIntegerPerColumnZeroPointTest<uint8_t>(7, 17, 3, is_b_initializer);
+    RunMatMulIntegerPerColumnZeroPointTest<uint8_t>(37, 70, 260, is_b_initializer);
+    RunMatMulIntegerPerColumnZeroPointTest<int8_t>(1, 33, 150, is_b_initializer);
+    RunMatMulIntegerPerColumnZeroPointTest<int8_t>(7, 17, 3, is_b_initializer);
+    RunMatMulIntegerPerColumnZeroPointTest<int8_t>(37, 70, 260, is_b_initializer);
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
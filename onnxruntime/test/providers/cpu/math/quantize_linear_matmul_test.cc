@@ -3,6 +3,12 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+#include "core/util/qmath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
 
 namespace onnxruntime {
 namespace test {
@@ -58,5 +64,67 @@ TEST(QuantizeLinearMatmulOpTest, QLinearMatMul) {
   test.AddOutput<uint8_t>("T3", {2, 3}, {168, 115, 255, 1, 66, 151});
   test.Run();
 }
+
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+// Per column weight scales and zero points are handled by the MLAS path of the
+// CPU kernel, with B either an initializer (prepacked at kernel creation) or a
+// graph input.
+static void RunQLinearMatMulPerColumnTest(const int M, const int N, const int K, bool is_b_initializer) {
+  OpTester test("QLinearMatMul", 10);
+  static std::default_random_engine e(789);
+  std::uniform_int_distribution<int> n_u8(0, 255);
+
+  std::vector<uint8_t> a(M * K);
+  std::vector<uint8_t> b(K * N);
+  std::vector<uint8_t> b_zero_point(N);
+  std::vector<float> b_scale(N);
+  for (auto& v : a) v = static_cast<uint8_t>(n_u8(e));
+  for (auto& v : b) v = static_cast<uint8_t>(n_u8(e));
+  for (auto& v : b_zero_point) v = static_cast<uint8_t>(n_u8(e));
+  for (int n = 0; n < N; n++) b_scale[n] = 0.002f * static_cast<float>(n % 5 + 1);
+
+  const float a_scale = 0.01f;
+  const uint8_t a_zero_point = 121;
+  const float y_scale = 1.5f;
+  const uint8_t y_zero_point = 131;
+
+  std::vector<uint8_t> y(M * N);
+  for (int m = 0; m < M; m++) {
+    for (int n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int k = 0; k < K; k++) {
+        sum += (static_cast<int32_t>(a[m * K + k]) - a_zero_point) *
+               (static_cast<int32_t>(b[k * N + n]) - b_zero_point[n]);
+      }
+      const float multiplier = (a_scale * b_scale[n]) / y_scale;
+      float value = std::nearbyint(static_cast<float>(sum) * multiplier) + y_zero_point;
+      y[m * N + n] = static_cast<uint8_t>(std::min(std::max(value, 0.f), 255.f));
+    }
+  }
+
+  test.AddInput<uint8_t>("T1", {M, K}, a);
+  test.AddInput<float>("a_scale", {}, {a_scale});
+  test.AddInput<uint8_t>("a_zero_point", {}, {a_zero_point});
+  test.AddInput<uint8_t>("T2", {K, N}, b, is_b_initializer);
+  test.AddInput<float>("b_scale", {N}, b_scale);
+  test.AddInput<uint8_t>("b_zero_point", {N}, b_zero_point);
+  test.AddInput<float>("y_scale", {}, {y_scale});
+  test.AddInput<uint8_t>("y_zero_point", {}, {y_zero_point});
+  test.AddOutput<uint8_t>("T3", {M, N}, y);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMulPerColumn) {
+  for (bool is_b_initializer : {false, true}) {
+    RunQLinearMatMulPerColumnTest(1, 19, 64, is_b_initializer);
+    RunQLinearMatMulPerColumnTest(5, 40, 7, is_b_initializer);
+    RunQLinearMatMulPerColumnTest(30, 65, 300, is_b_initializer);
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
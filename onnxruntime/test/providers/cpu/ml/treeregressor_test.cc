@@ -8,7 +8,7 @@ namespace onnxruntime {
 namespace test {
 
 template <typename T>
-void GenTreeAndRunTest(const std::vector<T>& X, const std::vector<float>& base_values, const std::vector<float>& results, const std::string& aggFunction, bool one_obs = false) {
+void GenTreeAndRunTest(const std::vector<T>& X, const std::vector<float>& base_values, const std::vector<float>& results, const std::string& aggFunction, bool one_obs = false, int64_t n_tree_copies = 1) {
   OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
 
   //tree
@@ -26,6 +26,27 @@ void GenTreeAndRunTest(const std::vector<T>& X, const std::vector<float>& base_v
   std::vector<float> target_weights = {1.5f, 27.5f, 2.25f, 20.75f, 2.f, 23.f, 3.f, 14.f, 0.f, 41.f, 1.83333333f, 24.5f, 0.f, 41.f, 2.75f, 16.25f, 2.f, 23.f, 3.f, 14.f, 2.66666667f, 17.f, 2.f, 23.f, 3.f, 14.f};
   std::vector<int64_t> classes = {0, 1};
 
+  // repeat the trees, which does not change the average, min or max of their predictions
+  const size_t n_nodes = treeids.size();
+  const size_t n_targets = target_treeids.size();
+  for (int64_t copy = 1; copy < n_tree_copies; ++copy) {
+    for (size_t i = 0; i < n_nodes; ++i) {
+      lefts.push_back(lefts[i]);
+      rights.push_back(rights[i]);
+      treeids.push_back(treeids[i] + copy * 3);
+      nodeids.push_back(nodeids[i]);
+      featureids.push_back(featureids[i]);
+      thresholds.push_back(thresholds[i]);
+      modes.push_back(modes[i]);
+    }
+    for (size_t i = 0; i < n_targets; ++i) {
+      target_treeids.push_back(target_treeids[i] + copy * 3);
+      target_nodeids.push_back(target_nodeids[i]);
+      target_classids.push_back(target_classids[i]);
+      target_weights.push_back(target_weights[i]);
+    }
+  }
+
   //add attributes
   test.AddAttribute("nodes_truenodeids", lefts);
   test.AddAttribute("nodes_falsenodeids", rights);
@@ -59,8 +80,9 @@ void GenTreeAndRunTest(const std::vector<T>& X, const std::vector<float>& base_v
     test.AddInput<T>("X", {1, 3}, X1);
     test.AddOutput<float>("Y", {1, 2}, results1);
   } else {
-    test.AddInput<T>("X", {8, 3}, X);
-    test.AddOutput<float>("Y", {8, 2}, results);
+    const auto N = static_cast<int64_t>(X.size() / 3);
+    test.AddInput<T>("X", {N, 3}, X);
+    test.AddOutput<float>("Y", {N, 2}, results);
   }
   test.Run();
 }  // namespace test
@@ -97,6 +119,24 @@ TEST(MLOpTest, TreeRegressorMultiTargetMaxDouble) {
   GenTreeAndRunTest<double>(X, base_values, results, "MAX", true);
 }
 
+TEST(MLOpTest, TreeRegressorMultiTargetLargeEnsemble) {
+  // enough rows and trees to split the evaluation between threads, with a partial block of rows
+  std::vector<float> X1 = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<float> results1 = {1.33333333f, 29.f, 3.f, 14.f, 2.f, 23.f, 2.f, 23.f, 2.f, 23.f, 2.66666667f, 17.f, 2.f, 23.f, 3.f, 14.f};
+  std::vector<float> X;
+  std::vector<float> results;
+  for (int i = 0; i < 13; ++i) {
+    X.insert(X.end(), X1.begin(), X1.end());
+    results.insert(results.end(), results1.begin(), results1.end());
+  }
+  X.insert(X.end(), X1.begin(), X1.begin() + 9);
+  results.insert(results.end(), results1.begin(), results1.begin() + 6);
+  std::vector<float> base_values{0.f, 0.f};
+  GenTreeAndRunTest<float>(X, base_values, results, "AVERAGE", false, 40);
+  GenTreeAndRunTest<float>(X, base_values, results, "AVERAGE", true, 40);
+  GenTreeAndRunTest<float>(X1, base_values, results1, "AVERAGE", false, 40);
+}
+
 void GenTreeAndRunTest1(const std::string& aggFunction, bool one_obs) {
   OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
 
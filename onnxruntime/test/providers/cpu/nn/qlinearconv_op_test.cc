@@ -3,6 +3,10 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+#include "core/util/qmath.h"
+
+#include <cmath>
 
 namespace onnxruntime {
 namespace test {
@@ -239,6 +243,70 @@ TEST(QLinearConvTest, WithGroup_2D) {
                     {kNGraphExecutionProvider});
 }
 
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+// Per output channel filter scales are handled by the MLAS path of the CPU kernel,
+// which requantizes each output channel with its own multiplier.
+TEST(QLinearConvTest, PerChannelScale_2D) {
+  const int64_t C = 3, H = 5, W = 6, M = 4, KH = 3, KW = 3;
+  const uint8_t x_zero_point = 118, w_zero_point = 128, y_zero_point = 103;
+  const float x_scale = 0.02f, y_scale = 0.05f;
+
+  std::vector<uint8_t> x(C * H * W);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+  }
+  std::vector<uint8_t> w(M * C * KH * KW);
+  for (size_t i = 0; i < w.size(); i++) {
+    w[i] = static_cast<uint8_t>((i * 89 + 5) % 256);
+  }
+  const std::vector<float> w_scale{0.01f, 0.0025f, 0.004f, 0.0075f};
+  const std::vector<int32_t> bias{-1200, 350, 0, 4100};
+
+  // Reference convolution with a padding of one and a stride of one.
+  std::vector<uint8_t> y(M * H * W);
+  for (int64_t m = 0; m < M; m++) {
+    const float multiplier = (x_scale * w_scale[m]) / y_scale;
+    for (int64_t oh = 0; oh < H; oh++) {
+      for (int64_t ow = 0; ow < W; ow++) {
+        int32_t sum = bias[m];
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t kh = 0; kh < KH; kh++) {
+            for (int64_t kw = 0; kw < KW; kw++) {
+              const int64_t ih = oh + kh - 1;
+              const int64_t iw = ow + kw - 1;
+              if (ih < 0 || ih >= H || iw < 0 || iw >= W) {
+                continue;
+              }
+              sum += (static_cast<int32_t>(x[(c * H + ih) * W + iw]) - x_zero_point) *
+                     (static_cast<int32_t>(w[((m * C + c) * KH + kh) * KW + kw]) - w_zero_point);
+            }
+          }
+        }
+        float value = std::nearbyint(static_cast<float>(sum) * multiplier) + y_zero_point;
+        y[(m * H + oh) * W + ow] = static_cast<uint8_t>(std::min(std::max(value, 0.f), 255.f));
+      }
+    }
+  }
+
+  OpTester test("QLinearConv", 10);
+  test.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<uint8_t>("x", {1, C, H, W}, x);
+  test.AddInput<float>("x_scale", {}, {x_scale});
+  test.AddInput<uint8_t>("x_zero_point", {}, {x_zero_point});
+  test.AddInput<uint8_t>("w", {M, C, KH, KW}, w);
+  test.AddInput<float>("w_scale", {M}, w_scale);
+  test.AddInput<uint8_t>("w_zero_point", {M}, std::vector<uint8_t>(M, w_zero_point));
+  test.AddInput<float>("y_scale", {}, {y_scale});
+  test.AddInput<uint8_t>("y_zero_point", {}, {y_zero_point});
+  test.AddInput<int32_t>("b", {M}, bias);
+  test.AddOutput<uint8_t>("y", {1, M, H, W}, y);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+#endif
+
 }  // namespace
 }  // namespace test
 }  // namespace onnxruntime
@@ -1021,6 +1021,78 @@ TEST(ReductionOpTest, ReduceSum_int32) {
   test.Run();
 }
 
+// reduce a strided middle axis with more kept inner elements than a single column block
+TEST(ReductionOpTest, ReduceSum_middle_axis_wide) {
+  const int64_t outer = 3, reduced = 5, inner = 2500;
+  std::vector<float> input(outer * reduced * inner);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 13) - 6.0f;
+  }
+  std::vector<float> expected(outer * inner, 0.0f);
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t r = 0; r < reduced; ++r) {
+      for (int64_t i = 0; i < inner; ++i) {
+        expected[o * inner + i] += input[(o * reduced + r) * inner + i];
+      }
+    }
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {outer, reduced, inner}, input);
+  test.AddOutput<float>("reduced", {outer, 1, inner}, expected);
+  test.Run();
+}
+
+// alternating reduced and kept axes, with a size 1 axis in between
+TEST(ReductionOpTest, ReduceMax_alternating_axes) {
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 3});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {2, 2, 1, 2, 2},
+                       {1.0f, 9.0f,
+                        3.0f, 4.0f,
+
+                        5.0f, 6.0f,
+                        7.0f, 8.0f,
+
+                        -1.0f, 2.0f,
+                        13.0f, 0.0f,
+
+                        15.0f, 0.5f,
+                        2.0f, 16.0f});
+  test.AddOutput<float>("reduced", {2, 1, 2}, {13.0f, 9.0f, 15.0f, 16.0f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_axis0_wide) {
+  const int64_t reduced = 3, inner = 1500;
+  std::vector<float> input(reduced * inner);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 7) * 20.0f - 60.0f;
+  }
+  std::vector<float> expected(inner);
+  for (int64_t i = 0; i < inner; ++i) {
+    float max_value = input[i];
+    for (int64_t r = 1; r < reduced; ++r) {
+      max_value = std::max(max_value, input[r * inner + i]);
+    }
+    double sum = 0.0;
+    for (int64_t r = 0; r < reduced; ++r) {
+      sum += std::exp(static_cast<double>(input[r * inner + i] - max_value));
+    }
+    expected[i] = static_cast<float>(std::log(sum) + max_value);
+  }
+
+  OpTester test("ReduceLogSumExp");
+  test.AddAttribute("axes", std::vector<int64_t>{0});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {reduced, inner}, input);
+  test.AddOutput<float>("reduced", {inner}, expected);
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceSum_apex_reduction) {
   OpTester test("ReduceSum");
   test.AddAttribute("keepdims", (int64_t)0);
@@ -436,6 +436,54 @@ TEST(LSTMTest, LargeBatchNoClipping) {
   LargeBatchWithClip(Y_h_data);
 }
 
+// The rows of a large batch are run on the intra-op pool, which also runs the nodes of the parallel executor.
+// Waiting for them must not block a thread of a pool that has fewer threads than rows.
+TEST(LSTMTest, LargeBatchParallelExecutorSmallThreadPool) {
+  const int64_t seq_length = 2;
+  const int64_t batch_size = 32;
+  const int64_t input_size = 1;
+  const int64_t hidden_size = 3;
+
+  OpTester test("LSTM");
+  test.AddAttribute<std::vector<string>>("activations", {"sigmoid", "tanh", "tanh"});
+  test.AddAttribute("direction", "forward");
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("input_forget", 0);
+  test.AddAttribute<float>("clip", 9999.f);
+
+  // every row of the batch is the first row of LargeBatchNoClipping, so has the same Y_h
+  std::vector<float> X_data(batch_size, 1.f);
+  X_data.insert(X_data.end(), batch_size, 33.f);
+  std::vector<float> W_data{0.1f, 0.2f, 0.3f, 0.4f,
+                            1.f, 2.f, 3.f, 4.f,
+                            10.f, 11.f, 12.f, 13.f};
+  std::vector<float> R_data(4 * hidden_size * hidden_size, 0.1f);
+  std::vector<float> Y_h_data;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    Y_h_data.insert(Y_h_data.end(), {0.90387899f, 0.9135572f, 0.91772245f});
+  }
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, X_data);
+  test.AddInput<float>("W", {1, 4 * hidden_size, input_size}, W_data);
+  test.AddInput<float>("R", {1, 4 * hidden_size, hidden_size}, R_data);
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<int>();
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalOutput<float>();
+  test.AddOutput<float>("Y_h", {1, batch_size, hidden_size}, Y_h_data);
+  test.AddMissingOptionalOutput<float>();
+
+  SessionOptions so;
+  so.session_logid = "LSTMTest";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.intra_op_param.thread_pool_size = 2;
+
+  // TensorRT failed on LSTM tests
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 // make sure GateComputations with clipping works correctly if batch_parallel_ is true due to large batch size
 TEST(LSTMTest, LargeBatchWithClip) {
   std::vector<float> Y_h_data = {
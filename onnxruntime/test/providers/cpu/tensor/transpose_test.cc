@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/providers/cpu/tensor/transpose.h"
+#include "test/framework/test_utils.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
@@ -414,5 +416,93 @@ TEST(TransposeOpTest, SingleAxisMovingInwardsBlockCopy) {
 
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals, false, false);
 }
+
+// Transposes input_vals with a straightforward loop over the output to produce the expected values.
+template <typename T>
+static void LargeTransposeTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+
+  const int64_t size = input_strides[0] * input_shape[0];
+  std::vector<T> input_vals(size);
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i % 251);
+  }
+
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals;
+  expected_vals.reserve(size);
+  std::vector<int64_t> index(rank, 0);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t offset = 0;
+    for (size_t j = 0; j < rank; ++j) {
+      offset += index[j] * input_strides[perm[j]];
+    }
+    expected_vals.push_back(input_vals[offset]);
+    for (size_t j = rank; j-- > 0;) {
+      if (++index[j] < expected_shape[j]) break;
+      index[j] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+// sizes that are not multiples of the tile or register block sizes cover the partial tiles
+TEST(TransposeOpTest, NCHW2NHWC_Large) {
+  LargeTransposeTest<float>({2, 67, 9, 15}, {0, 2, 3, 1});
+  LargeTransposeTest<uint8_t>({2, 67, 9, 15}, {0, 2, 3, 1});
+  LargeTransposeTest<int16_t>({2, 67, 9, 15}, {0, 2, 3, 1});
+  LargeTransposeTest<double>({2, 67, 9, 15}, {0, 2, 3, 1});
+}
+
+TEST(TransposeOpTest, NHWC2NCHW_Large) {
+  LargeTransposeTest<float>({2, 9, 15, 67}, {0, 3, 1, 2});
+  LargeTransposeTest<uint8_t>({2, 9, 15, 67}, {0, 3, 1, 2});
+}
+
+TEST(TransposeOpTest, TwoDim_Large) {
+  LargeTransposeTest<float>({130, 77}, {1, 0});
+  LargeTransposeTest<int8_t>({130, 77}, {1, 0});
+}
+
+// [batch, sequence, heads, head size] to [batch, heads, sequence, head size] and the transposed key layout
+TEST(TransposeOpTest, MultiHeadAttentionLayouts) {
+  LargeTransposeTest<float>({2, 33, 4, 16}, {0, 2, 1, 3});
+  LargeTransposeTest<float>({2, 4, 33, 16}, {0, 2, 1, 3});
+  LargeTransposeTest<float>({2, 33, 4, 16}, {0, 2, 3, 1});
+}
+
+// size 1 axes and axes that remain adjacent are collapsed before transposing
+TEST(TransposeOpTest, CollapsedAxes) {
+  LargeTransposeTest<int32_t>({1, 5, 1, 7, 3, 1}, {4, 2, 0, 1, 5, 3});
+  LargeTransposeTest<int64_t>({3, 4, 5, 6}, {2, 3, 0, 1});
+  LargeTransposeTest<float>({3, 4, 5, 6}, {0, 1, 2, 3});
+}
+
+TEST(TransposeOpTest, EmptyTensor) {
+  std::vector<int64_t> input_shape({2, 0, 3});
+  std::vector<float> input_vals = {};
+  std::vector<int64_t> perm = {2, 0, 1};
+  std::initializer_list<float> expected_vals = {};
+  TransposeTest(input_shape, input_vals, &perm, {3, 2, 0}, expected_vals, false);
+
+  // Other kernels transpose through DoTranspose without checking for empty tensors
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  Tensor input(DataTypeImpl::GetType<float>(), TensorShape({2, 0, 3}), allocator);
+  Tensor output(DataTypeImpl::GetType<float>(), TensorShape({3, 2, 0}), allocator);
+  EXPECT_TRUE(TransposeBase::DoTranspose({2, 0, 1}, input, output).IsOK());
+}
 }  // namespace test
 }  // namespace onnxruntime
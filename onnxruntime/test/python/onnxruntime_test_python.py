@@ -7,6 +7,7 @@ import os
 import numpy as np
 import onnxruntime as onnxrt
 import threading
+import uuid
 
 
 class TestInferenceSession(unittest.TestCase):
@@ -115,6 +116,43 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[5.0], [11.0], [17.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelAsync(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+
+        completed = threading.Event()
+        results = []
+
+        def callback(res, user_data, err):
+            results.append((res, user_data, err))
+            completed.set()
+
+        sess.run_async(["Y"], {"X": x}, callback, "user data")
+        self.assertTrue(completed.wait(60))
+        res, user_data, err = results[0]
+        self.assertEqual(err, "")
+        self.assertEqual(user_data, "user data")
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        # a terminated run completes with an error
+        completed.clear()
+        ro = onnxrt.RunOptions()
+        ro.terminate = True
+        sess.run_async(["Y"], {"X": x}, callback, None, ro)
+        self.assertTrue(completed.wait(60))
+        res, user_data, err = results[1]
+        self.assertEqual(res, [])
+        self.assertTrue("terminate" in err)
+
+        # the inputs are kept alive until the run completes, even if the caller drops them
+        completed.clear()
+        sess.run_async(["Y"], {"X": x.copy()}, callback)
+        self.assertTrue(completed.wait(60))
+        res, user_data, err = results[2]
+        self.assertEqual(err, "")
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
     def testRunModel2Contiguous(self):
         sess = onnxrt.InferenceSession(self.get_name("matmul_1.onnx"))
         x = np.array([[2.0, 1.0], [4.0, 3.0], [6.0, 5.0]], dtype=np.float32)[:, [1, 0]]
@@ -404,6 +442,50 @@ class TestInferenceSession(unittest.TestCase):
                 for tag in tags:
                     self.assertTrue(tag in lines[i])
             self.assertTrue(']' in lines[8])
+            self.assertTrue('peak_live_bytes' in ''.join(lines))
+
+    def testArenaStats(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        sess.run([], {'X': x})
+        arena_stats = sess.get_arena_stats()
+        self.assertTrue(len(arena_stats) > 0)
+        cpu_stats = [stats for stats in arena_stats if stats['name'] == 'Cpu'][0]
+        self.assertTrue(cpu_stats['num_allocs'] > 0)
+        self.assertTrue(cpu_stats['total_allocated_bytes'] >= cpu_stats['bytes_in_use'])
+        self.assertTrue(cpu_stats['max_bytes_in_use'] >= cpu_stats['bytes_in_use'])
+        self.assertEqual(cpu_stats['total_allocated_bytes'] - sess.shrink_memory_arenas(),
+                         sess.get_arena_stats()[arena_stats.index(cpu_stats)]['total_allocated_bytes'])
+
+    def testEnvSharedInitializers(self):
+        from onnx import helper, numpy_helper, TensorProto
+        # The shared initializers live as long as the process, so the test uses a name no other test or run uses
+        name = "W_" + uuid.uuid4().hex
+        w = np.array([[1.0], [2.0]], dtype=np.float32)
+        graph = helper.make_graph([helper.make_node("MatMul", ["X", name], ["Y"])], "matmul",
+                                  [helper.make_tensor_value_info("X", TensorProto.FLOAT, [3, 2])],
+                                  [helper.make_tensor_value_info("Y", TensorProto.FLOAT, [3, 1])],
+                                  [numpy_helper.from_array(w, name)])
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 9)]).SerializeToString()
+
+        onnxrt.add_shared_initializer(name, np.array([[2.0], [3.0]], dtype=np.float32))
+        with self.assertRaises(Exception):
+            onnxrt.add_shared_initializer(name, np.array([[2.0], [3.0]], dtype=np.float32))
+
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        so = onnxrt.SessionOptions()
+        self.assertFalse(so.use_env_shared_initializers)
+        so.use_env_shared_initializers = True
+        for _ in range(2):
+            sess = onnxrt.InferenceSession(model, so)
+            res = sess.run(["Y"], {"X": x})
+            output_expected = np.array([[8.0], [18.0], [28.0]], dtype=np.float32)
+            np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        sess = onnxrt.InferenceSession(model)
+        res = sess.run(["Y"], {"X": x})
+        output_expected = np.array([[5.0], [11.0], [17.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
     def testDictVectorizer(self):
         sess = onnxrt.InferenceSession(self.get_name("pipeline_vectorize.onnx"))
@@ -11,6 +11,8 @@
 #include <fstream>
 #include <sstream>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <gtest/gtest.h>
 #include "test_allocator.h"
 #include "test_fixture.h"
@@ -389,6 +391,74 @@ TEST(CApiTest, create_session_without_session_option) {
 }
 #endif
 
+namespace {
+// Collects the results of RunAsync calls.
+struct RunAsyncResults {
+  std::mutex mutex;
+  std::condition_variable completed;
+  size_t num_completed = 0;
+  size_t num_failed = 0;
+  std::vector<std::vector<float>> outputs;
+
+  static void ORT_API_CALL Callback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatus* status) {
+    auto* results = static_cast<RunAsyncResults*>(user_data);
+    std::lock_guard<std::mutex> lock(results->mutex);
+    if (status != nullptr) {
+      Ort::GetApi().ReleaseStatus(status);
+      ++results->num_failed;
+    } else {
+      for (size_t i = 0; i < num_outputs; ++i) {
+        Ort::Value output(outputs[i]);
+        const float* data = output.GetTensorMutableData<float>();
+        results->outputs.emplace_back(data, data + output.GetTensorTypeAndShapeInfo().GetElementCount());
+      }
+    }
+    ++results->num_completed;
+    results->completed.notify_all();
+  }
+
+  void Wait(size_t num_runs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    completed.wait(lock, [this, num_runs]() { return num_completed == num_runs; });
+  }
+};
+}  // namespace
+
+TEST(CApiTest, run_async) {
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  Ort::Value x = Ort::Value::CreateTensor<float>(info, x_values.data(), x_values.size(), x_dims.data(), x_dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  constexpr size_t num_runs = 8;
+  RunAsyncResults results;
+  Ort::RunOptions run_options;
+  for (size_t i = 0; i < num_runs; ++i) {
+    session.RunAsync(run_options, input_names, &x, 1, output_names, 1, RunAsyncResults::Callback, &results);
+  }
+  results.Wait(num_runs);
+  ASSERT_EQ(results.num_failed, 0u);
+  ASSERT_EQ(results.outputs.size(), num_runs);
+  for (const auto& output : results.outputs) {
+    ASSERT_EQ(output, std::vector<float>({1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f}));
+  }
+
+  // a run whose RunOptions is terminated completes with an error
+  RunAsyncResults terminated_results;
+  Ort::RunOptions terminated_run_options;
+  terminated_run_options.SetTerminate();
+  session.RunAsync(terminated_run_options, input_names, &x, 1, output_names, 1, RunAsyncResults::Callback,
+                   &terminated_results);
+  terminated_results.Wait(1);
+  ASSERT_EQ(terminated_results.num_failed, 1u);
+  ASSERT_TRUE(terminated_results.outputs.empty());
+}
+
 TEST(CApiTest, create_tensor) {
   const char* s[] = {"abc", "kmp"};
   int64_t expected_len = 2;
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "admission_control.h"
+
+namespace onnxruntime {
+namespace server {
+
+constexpr std::chrono::hours AdmissionController::kMaxTimeout;
+
+AdmissionController::AdmissionController(const AdmissionOptions& options) : options_(options) {}
+
+AdmissionController::Clock::time_point AdmissionController::DeadlineAfter(std::chrono::milliseconds timeout) {
+  if (timeout > kMaxTimeout) {
+    return Clock::time_point::max();
+  }
+  return Clock::now() + timeout;
+}
+
+AdmissionController::Result AdmissionController::Admit(Clock::time_point deadline) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (Clock::now() >= deadline) {
+    ++stats_.num_expired;
+    return Result::DeadlineExceeded;
+  }
+
+  if (options_.max_concurrent_requests > 0 && num_running_ >= options_.max_concurrent_requests) {
+    if (num_queued_ >= options_.max_queued_requests) {
+      ++stats_.num_rejected;
+      return Result::QueueFull;
+    }
+
+    ++num_queued_;
+    auto can_run = [this] { return num_running_ < options_.max_concurrent_requests; };
+    bool admitted = true;
+    if (deadline == Clock::time_point::max()) {
+      slot_available_.wait(lock, can_run);
+    } else {
+      admitted = slot_available_.wait_until(lock, deadline, can_run);
+    }
+    --num_queued_;
+
+    if (!admitted) {
+      ++stats_.num_expired;
+      return Result::DeadlineExceeded;
+    }
+  }
+
+  ++num_running_;
+  ++stats_.num_admitted;
+  return Result::Admitted;
+}
+
+void AdmissionController::Release() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --num_running_;
+  }
+  slot_available_.notify_one();
+}
+
+void AdmissionController::RecordExpired() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.num_expired;
+}
+
+AdmissionStats AdmissionController::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  AdmissionStats stats = stats_;
+  stats.num_running = num_running_;
+  stats.num_queued = num_queued_;
+  return stats;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
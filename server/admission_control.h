@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace onnxruntime {
+namespace server {
+
+struct AdmissionOptions {
+  // The maximum number of requests to a model that run at the same time. 0 doesn't limit them.
+  int max_concurrent_requests = 0;
+  // The maximum number of requests that wait for one of the running requests to complete. The requests beyond it
+  // are rejected.
+  int max_queued_requests = 0;
+};
+
+struct AdmissionStats {
+  uint64_t num_admitted = 0;
+  uint64_t num_rejected = 0;  // Requests rejected as the queue was full
+  uint64_t num_expired = 0;   // Requests whose deadline passed before they were run
+  int num_running = 0;
+  int num_queued = 0;
+};
+
+// Bounds the requests to a model that run at the same time and the requests that wait for them, so that under
+// overload requests are rejected right away instead of queueing up in the threads of the frontends, and requests
+// whose deadline passed while they waited are dropped instead of run.
+class AdmissionController {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Result {
+    Admitted,
+    QueueFull,
+    DeadlineExceeded
+  };
+
+  explicit AdmissionController(const AdmissionOptions& options);
+  AdmissionController(const AdmissionController&) = delete;
+  AdmissionController& operator=(const AdmissionController&) = delete;
+
+  // Waits until the request can run or its deadline passes. A request that is Admitted must call Release once it
+  // completes.
+  Result Admit(Clock::time_point deadline);
+  void Release();
+
+  // Records a request that was admitted but dropped as its deadline passed before it was run.
+  void RecordExpired();
+
+  // The deadline of a request that times out after timeout. Timeouts longer than kMaxTimeout mean no deadline
+  // (time_point::max()), as adding them to the clock could overflow it.
+  static Clock::time_point DeadlineAfter(std::chrono::milliseconds timeout);
+  static constexpr std::chrono::hours kMaxTimeout{24};
+
+  AdmissionStats GetStats() const;
+
+ private:
+  const AdmissionOptions options_;
+  mutable std::mutex mutex_;
+  std::condition_variable slot_available_;
+  int num_running_ = 0;
+  int num_queued_ = 0;
+  AdmissionStats stats_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,421 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace {
+
+// Returns the size of an element of type, or 0 for the types whose tensors can't be concatenated or split by
+// copying their data.
+size_t ElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128:
+      return 16;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED:
+    default:
+      return 0;
+  }
+}
+
+std::vector<Ort::Value> RunSession(Ort::Session& session, const Ort::RunOptions& run_options,
+                                   const std::vector<std::string>& input_names,
+                                   const std::vector<const OrtValue*>& input_values,
+                                   const std::vector<std::string>& output_names) {
+  std::vector<const char*> input_ptrs{};
+  input_ptrs.reserve(input_names.size());
+  for (const auto& input : input_names) {
+    input_ptrs.push_back(input.data());
+  }
+  std::vector<const char*> output_ptrs{};
+  output_ptrs.reserve(output_names.size());
+  for (const auto& output : output_names) {
+    output_ptrs.push_back(output.data());
+  }
+
+  std::vector<OrtValue*> output_values(output_names.size(), nullptr);
+  Ort::ThrowOnError(Ort::GetApi().Run(session, const_cast<Ort::RunOptions&>(run_options),
+                                      input_ptrs.data(), input_values.data(), input_values.size(),
+                                      output_ptrs.data(), output_ptrs.size(), output_values.data()));
+
+  std::vector<Ort::Value> outputs{};
+  outputs.reserve(output_values.size());
+  for (auto* value : output_values) {
+    outputs.emplace_back(value);
+  }
+  return outputs;
+}
+
+uint64_t ToMicroseconds(std::chrono::steady_clock::duration duration) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+}  // namespace
+
+struct Batcher::Request {
+  // The inputs of the request, in the order of the input names of its batch
+  std::vector<const OrtValue*> inputs;
+  int64_t rows = 0;
+  std::chrono::steady_clock::time_point enqueue_time;
+  std::chrono::steady_clock::time_point deadline;
+
+  std::vector<Ort::Value> outputs;
+  std::unique_ptr<Ort::Exception> error;
+  // Set if the request was dropped from its batch as its deadline passed
+  bool expired = false;
+};
+
+struct Batcher::Batch {
+  std::vector<std::string> input_names;
+  std::vector<std::string> output_names;
+  std::vector<Request*> requests;
+  int64_t rows = 0;
+
+  // Set once the batch stops accepting requests and once its outputs have been set to its requests
+  bool closed = false;
+  bool done = false;
+  // Set if running the batch threw an exception, so the requests without an error didn't get all of their outputs
+  bool failed = false;
+  std::condition_variable cv;
+};
+
+Batcher::Batcher(Ort::Session& session, const BatchingOptions& options, std::shared_ptr<spdlog::logger> logger)
+    : session_(session), options_(options), logger_(std::move(logger)), enabled_(options.max_batch_size > 1) {
+  if (!enabled_) {
+    return;
+  }
+
+  // The run of a batch can only be split back into the runs of its requests if the model takes any number of rows.
+  const size_t input_count = session_.GetInputCount();
+  enabled_ = input_count > 0;
+  for (size_t i = 0; enabled_ && i < input_count; ++i) {
+    auto type_info = session_.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      enabled_ = false;
+      break;
+    }
+
+    // A symbolic or unknown dimension is -1
+    auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+    enabled_ = !shape.empty() && shape[0] < 0;
+  }
+
+  if (enabled_) {
+    logger_->info("Batching requests up to {} rows with a maximum queue delay of {} us",
+                  options_.max_batch_size, options_.max_queue_delay.count());
+  } else {
+    logger_->warn("Batching is disabled as not all of the model inputs are tensors with a symbolic leading dimension");
+  }
+}
+
+std::vector<Ort::Value> Batcher::Run(const Ort::RunOptions& run_options,
+                                     const std::vector<std::string>& input_names,
+                                     const std::vector<Ort::Value>& input_values,
+                                     const std::vector<std::string>& output_names,
+                                     std::chrono::steady_clock::time_point deadline) {
+  // The order of the inputs of a request follows the map of its PredictRequest, so the inputs are ordered by name
+  // to batch the requests that have the same inputs.
+  std::vector<size_t> order(input_names.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&input_names](size_t a, size_t b) { return input_names[a] < input_names[b]; });
+
+  bool batchable = enabled_ && !input_values.empty();
+  int64_t rows = -1;
+  std::ostringstream signature;
+  for (size_t i : order) {
+    const auto& value = input_values[i];
+    if (!batchable || !value.IsTensor()) {
+      batchable = false;
+      break;
+    }
+
+    auto info = value.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    auto type = info.GetElementType();
+    if (shape.empty() || shape[0] < 1 || (rows != -1 && shape[0] != rows) || ElementSize(type) == 0) {
+      batchable = false;
+      break;
+    }
+
+    rows = shape[0];
+    signature << input_names[i].size() << ':' << input_names[i] << ':' << type;
+    for (size_t d = 1; d < shape.size(); ++d) {
+      signature << ',' << shape[d];
+    }
+    signature << ';';
+  }
+  batchable = batchable && rows <= options_.max_batch_size;
+
+  if (!batchable) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.num_bypassed_requests;
+    }
+    std::vector<const OrtValue*> inputs{};
+    inputs.reserve(input_values.size());
+    for (const auto& value : input_values) {
+      inputs.push_back(const_cast<Ort::Value&>(value));
+    }
+    return RunSession(session_, run_options, input_names, inputs, output_names);
+  }
+
+  signature << '|';
+  for (const auto& name : output_names) {
+    signature << name.size() << ':' << name << ';';
+  }
+  const std::string key = signature.str();
+
+  Request request{};
+  request.rows = rows;
+  request.enqueue_time = std::chrono::steady_clock::now();
+  request.deadline = deadline;
+  request.inputs.reserve(order.size());
+  for (size_t i : order) {
+    request.inputs.push_back(const_cast<Ort::Value&>(input_values[i]));
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = open_batches_.find(key);
+  if (it != open_batches_.end() && it->second->rows + rows > options_.max_batch_size) {
+    // The request doesn't fit into the open batch, so that batch is run now and the request starts the next one.
+    it->second->closed = true;
+    it->second->cv.notify_all();
+    open_batches_.erase(it);
+    it = open_batches_.end();
+  }
+
+  std::shared_ptr<Batch> batch;
+  const bool leader = it == open_batches_.end();
+  if (leader) {
+    batch = std::make_shared<Batch>();
+    for (size_t i : order) {
+      batch->input_names.push_back(input_names[i]);
+    }
+    batch->output_names = output_names;
+    it = open_batches_.emplace(key, batch).first;
+  } else {
+    batch = it->second;
+  }
+
+  batch->requests.push_back(&request);
+  batch->rows += rows;
+  if (batch->rows == options_.max_batch_size) {
+    batch->closed = true;
+    batch->cv.notify_all();
+    open_batches_.erase(it);
+  }
+
+  if (leader) {
+    // Only the thread that closes a batch removes it from open_batches_
+    if (!batch->cv.wait_until(lock, request.enqueue_time + options_.max_queue_delay, [&batch] { return batch->closed; })) {
+      batch->closed = true;
+      open_batches_.erase(key);
+    }
+
+    // Wakes up the other requests of the batch however RunBatch exits, so that none of them waits forever
+    struct DoneNotifier {
+      std::unique_lock<std::mutex>& lock;
+      Batch& batch;
+      bool completed;
+      ~DoneNotifier() {
+        if (!lock.owns_lock()) {
+          lock.lock();
+        }
+        batch.failed = !completed;
+        batch.done = true;
+        batch.cv.notify_all();
+      }
+    } notifier{lock, *batch, false};
+
+    lock.unlock();
+    RunBatch(run_options, *batch);
+    notifier.completed = true;
+  } else {
+    batch->cv.wait(lock, [&batch] { return batch->done; });
+  }
+  const bool failed = batch->failed;
+  lock.unlock();
+
+  if (request.expired) {
+    throw DeadlineExceededError("Deadline exceeded while the request waited for its batch");
+  }
+  if (request.error != nullptr) {
+    throw *request.error;
+  }
+  if (failed) {
+    throw Ort::Exception("Running the batch of the request failed", ORT_RUNTIME_EXCEPTION);
+  }
+  return std::move(request.outputs);
+}
+
+void Batcher::RunBatch(const Ort::RunOptions& run_options, Batch& batch) {
+  // The requests whose deadline passed while they waited for the batch are dropped instead of run
+  const auto start = std::chrono::steady_clock::now();
+  auto& requests = batch.requests;
+  auto expired = std::stable_partition(requests.begin(), requests.end(),
+                                       [start](const Request* request) { return request->deadline > start; });
+  const auto num_expired = static_cast<size_t>(requests.end() - expired);
+  for (auto it = expired; it != requests.end(); ++it) {
+    (*it)->expired = true;
+    batch.rows -= (*it)->rows;
+  }
+  requests.erase(expired, requests.end());
+
+  RecordBatch(batch, start, num_expired);
+  if (requests.empty()) {
+    return;
+  }
+
+  try {
+    if (requests.size() == 1) {
+      requests[0]->outputs = RunSession(session_, run_options, batch.input_names, requests[0]->inputs, batch.output_names);
+      return;
+    }
+
+    // Concatenate the inputs of the requests along their leading dimension
+    Ort::AllocatorWithDefaultOptions allocator;
+    std::vector<Ort::Value> batch_inputs{};
+    std::vector<const OrtValue*> batch_input_ptrs{};
+    for (size_t i = 0, sz = batch.input_names.size(); i < sz; ++i) {
+      auto info = Ort::Unowned<Ort::Value>(const_cast<OrtValue*>(requests[0]->inputs[i])).GetTensorTypeAndShapeInfo();
+      auto shape = info.GetShape();
+      const auto type = info.GetElementType();
+      shape[0] = batch.rows;
+
+      auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+      auto* dst = value.GetTensorMutableData<uint8_t>();
+      for (auto* request : requests) {
+        Ort::Unowned<Ort::Value> input(const_cast<OrtValue*>(request->inputs[i]));
+        const size_t bytes = input.GetTensorTypeAndShapeInfo().GetElementCount() * ElementSize(type);
+        memcpy(dst, input.GetTensorMutableData<uint8_t>(), bytes);
+        dst += bytes;
+      }
+
+      batch_input_ptrs.push_back(value);
+      batch_inputs.push_back(std::move(value));
+    }
+
+    auto outputs = RunSession(session_, run_options, batch.input_names, batch_input_ptrs, batch.output_names);
+
+    // The outputs can only be split if each row of them belongs to the row of the inputs with the same index
+    bool splittable = true;
+    for (const auto& output : outputs) {
+      if (!output.IsTensor()) {
+        splittable = false;
+        break;
+      }
+      auto info = output.GetTensorTypeAndShapeInfo();
+      auto shape = info.GetShape();
+      if (shape.empty() || shape[0] != batch.rows || ElementSize(info.GetElementType()) == 0) {
+        splittable = false;
+        break;
+      }
+    }
+
+    if (!splittable) {
+      logger_->warn("The outputs of the model don't have the rows of its inputs, so the requests of the batch are run on their own");
+      for (auto* request : requests) {
+        try {
+          request->outputs = RunSession(session_, run_options, batch.input_names, request->inputs, batch.output_names);
+        } catch (const Ort::Exception& e) {
+          request->error = std::make_unique<Ort::Exception>(std::string(e.what()), e.GetOrtErrorCode());
+        }
+      }
+      return;
+    }
+
+    // Split the outputs back to the requests
+    for (auto& output : outputs) {
+      auto info = output.GetTensorTypeAndShapeInfo();
+      auto shape = info.GetShape();
+      const auto type = info.GetElementType();
+      const size_t row_bytes = info.GetElementCount() * ElementSize(type) / static_cast<size_t>(batch.rows);
+
+      const auto* src = output.GetTensorMutableData<uint8_t>();
+      for (auto* request : requests) {
+        shape[0] = request->rows;
+        auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+        const size_t bytes = row_bytes * static_cast<size_t>(request->rows);
+        memcpy(value.GetTensorMutableData<uint8_t>(), src, bytes);
+        src += bytes;
+        request->outputs.push_back(std::move(value));
+      }
+    }
+  } catch (const Ort::Exception& e) {
+    logger_->error("Running a batch of {} requests failed. Error Message: {}", requests.size(), e.what());
+    for (auto* request : requests) {
+      request->outputs.clear();
+      request->error = std::make_unique<Ort::Exception>(std::string(e.what()), e.GetOrtErrorCode());
+    }
+  } catch (const std::exception& e) {
+    logger_->error("Running a batch of {} requests failed. Error Message: {}", requests.size(), e.what());
+    for (auto* request : requests) {
+      request->outputs.clear();
+      request->error = std::make_unique<Ort::Exception>(std::string(e.what()), ORT_RUNTIME_EXCEPTION);
+    }
+  }
+}
+
+void Batcher::RecordBatch(const Batch& batch, std::chrono::steady_clock::time_point start, size_t num_expired) {
+  if (num_expired > 0) {
+    logger_->warn("Dropped {} requests of a batch as their deadline passed while they waited for it", num_expired);
+  }
+  if (batch.requests.empty()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.num_expired_requests += num_expired;
+    return;
+  }
+
+  uint64_t max_delay = 0;
+  uint64_t total_delay = 0;
+  for (const auto* request : batch.requests) {
+    const uint64_t delay = ToMicroseconds(start - request->enqueue_time);
+    max_delay = std::max(max_delay, delay);
+    total_delay += delay;
+  }
+
+  logger_->debug("Running a batch of {} requests with {} rows. Queue delay: {} us", batch.requests.size(), batch.rows, max_delay);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.num_expired_requests += num_expired;
+  ++stats_.num_batches;
+  stats_.num_batched_requests += batch.requests.size();
+  stats_.total_batch_size += static_cast<uint64_t>(batch.rows);
+  stats_.max_batch_size = std::max(stats_.max_batch_size, static_cast<uint64_t>(batch.rows));
+  stats_.total_queue_delay_us += total_delay;
+  stats_.max_queue_delay_us = std::max(stats_.max_queue_delay_us, max_delay);
+}
+
+BatchingStats Batcher::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
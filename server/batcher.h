@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+#include <spdlog/spdlog.h>
+
+namespace onnxruntime {
+namespace server {
+
+struct BatchingOptions {
+  // The maximum number of rows (the sum of the leading dimensions of the inputs of the requests) of a batch.
+  // Batching is disabled when it is less than 2.
+  int64_t max_batch_size = 0;
+  // How long the first request of a batch waits for other requests to join it before the batch is run.
+  std::chrono::microseconds max_queue_delay{1000};
+};
+
+struct BatchingStats {
+  uint64_t num_batches = 0;            // Session runs of batches of one or more requests
+  uint64_t num_batched_requests = 0;   // Requests that were run as part of a batch
+  uint64_t num_bypassed_requests = 0;  // Requests that could not be batched and were run on their own
+  uint64_t num_expired_requests = 0;   // Requests dropped as their deadline passed while they waited for their batch
+  uint64_t total_batch_size = 0;       // Sum of the rows of the batches
+  uint64_t max_batch_size = 0;
+  uint64_t total_queue_delay_us = 0;   // Sum of the time the batched requests waited for their batch to be run
+  uint64_t max_queue_delay_us = 0;
+};
+
+// Thrown by Batcher::Run if the deadline of the request passed while it waited for its batch to be run.
+class DeadlineExceededError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+// Coalesces the concurrent requests to a model into a single session run along the leading (batch) dimension of
+// its inputs, and splits the outputs of the run back to the requests.
+//
+// Requests are batched together if they have the same input and output names, and their inputs have the same
+// element types and the same dimensions but the leading one. The first request of a batch runs it once the batch
+// holds max_batch_size rows or max_queue_delay has passed, so no extra thread is involved. Requests that can't be
+// batched (string or scalar inputs, inputs with different leading dimensions, more rows than max_batch_size) and
+// requests to models whose inputs don't all have a symbolic leading dimension are run on their own.
+class Batcher {
+ public:
+  Batcher(Ort::Session& session, const BatchingOptions& options, std::shared_ptr<spdlog::logger> logger);
+  ~Batcher() = default;
+  Batcher(const Batcher&) = delete;
+  Batcher& operator=(const Batcher&) = delete;
+
+  // Whether the model can be batched at all.
+  bool IsEnabled() const { return enabled_; }
+
+  // Runs the request, possibly batched with concurrent requests, and blocks until its outputs are available.
+  // run_options is used if the request is run on its own or runs its batch. Throws Ort::Exception on failure, and
+  // DeadlineExceededError if deadline passes before the batch of the request is run.
+  std::vector<Ort::Value> Run(const Ort::RunOptions& run_options,
+                              const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names,
+                              std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+  BatchingStats GetStats() const;
+
+ private:
+  struct Request;
+  struct Batch;
+
+  void RunBatch(const Ort::RunOptions& run_options, Batch& batch);
+  void RecordBatch(const Batch& batch, std::chrono::steady_clock::time_point start, size_t num_expired);
+
+  Ort::Session& session_;
+  const BatchingOptions options_;
+  const std::shared_ptr<spdlog::logger> logger_;
+  bool enabled_;
+
+  mutable std::mutex mutex_;
+  // The batches that are still accepting requests, keyed by the signature of their requests
+  std::unordered_map<std::string, std::shared_ptr<Batch>> open_batches_;
+  BatchingStats stats_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <memory>
 #include "environment.h"
 #include "onnxruntime_cxx_api.h"
@@ -86,7 +87,8 @@ void ServerEnvironment::RegisterExecutionProviders(){
 
 }
 
-void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
+void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                                        const BatchingOptions& batching_options, const AdmissionOptions& admission_options) {
   RegisterExecutionProviders();
   auto result = sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(model_name, model_version), std::forward_as_tuple(runtime_environment_, model_path.c_str(), options_));
 
@@ -103,6 +105,17 @@ void ServerEnvironment::InitializeModel(const std::string& model_path, const std
     (iterator->second).output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (batching_options.max_batch_size > 1) {
+    auto batcher = std::make_unique<Batcher>((iterator->second).session, batching_options, default_logger_);
+    if (batcher->IsEnabled()) {
+      (iterator->second).batcher = std::move(batcher);
+    }
+  }
+
+  if (admission_options.max_concurrent_requests > 0) {
+    (iterator->second).admission_controller = std::make_unique<AdmissionController>(admission_options);
+  }
 }
 
 const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
@@ -115,6 +128,179 @@ const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std
   return it->second.output_names;
 }
 
+Batcher* ServerEnvironment::GetBatcher(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.batcher.get();
+}
+
+AdmissionController* ServerEnvironment::GetAdmissionController(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.admission_controller.get();
+}
+
+ModelMetrics& ServerEnvironment::GetModelMetrics(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return *it->second.metrics;
+}
+
+void ServerEnvironment::AddWorkerPool(const std::string& name, const WorkerPool* pool) {
+  std::lock_guard<std::mutex> lock(worker_pools_mutex_);
+  worker_pools_.emplace_back(name, pool);
+}
+
+void ServerEnvironment::RemoveWorkerPool(const std::string& name) {
+  std::lock_guard<std::mutex> lock(worker_pools_mutex_);
+  worker_pools_.erase(std::remove_if(worker_pools_.begin(), worker_pools_.end(),
+                                     [&name](const std::pair<std::string, const WorkerPool*>& pool) { return pool.first == name; }),
+                      worker_pools_.end());
+}
+
+void ServerEnvironment::WriteMetrics(std::ostream& out) const {
+  PrometheusWriter writer(out);
+  auto model_labels = [](const std::pair<std::string, std::string>& model) {
+    return PrometheusWriter::Label("model", model.first) + "," + PrometheusWriter::Label("version", model.second);
+  };
+
+  writer.Family("onnxruntime_server_requests_total", "counter", "Predict requests received.");
+  for (const auto& model : sessions_) {
+    writer.Sample("onnxruntime_server_requests_total", model_labels(model.first), model.second.metrics->requests.Value());
+  }
+
+  writer.Family("onnxruntime_server_request_errors_total", "counter", "Predict requests that failed, by status code.");
+  for (const auto& model : sessions_) {
+    for (size_t code = 1; code < kNumStatusCodes; ++code) {
+      auto errors = model.second.metrics->errors[code].Value();
+      if (errors > 0) {
+        writer.Sample("onnxruntime_server_request_errors_total",
+                      model_labels(model.first) + "," + PrometheusWriter::Label("code", StatusCodeName(code)), errors);
+      }
+    }
+  }
+
+  writer.Family("onnxruntime_server_in_flight_requests", "gauge", "Predict requests being handled.");
+  for (const auto& model : sessions_) {
+    writer.Sample("onnxruntime_server_in_flight_requests", model_labels(model.first), model.second.metrics->in_flight.Value());
+  }
+
+  writer.Family("onnxruntime_server_request_duration_seconds", "histogram", "Time to handle a predict request.");
+  for (const auto& model : sessions_) {
+    writer.HistogramSamples("onnxruntime_server_request_duration_seconds", model_labels(model.first),
+                            model.second.metrics->request_latency);
+  }
+
+  writer.Family("onnxruntime_server_phase_duration_seconds", "histogram",
+                "Time spent converting the request to tensors (parse), running the model (run) and building the response (serialize).");
+  for (const auto& model : sessions_) {
+    const auto& metrics = *model.second.metrics;
+    auto labels = model_labels(model.first) + ",";
+    writer.HistogramSamples("onnxruntime_server_phase_duration_seconds", labels + PrometheusWriter::Label("phase", "parse"), metrics.parse_latency);
+    writer.HistogramSamples("onnxruntime_server_phase_duration_seconds", labels + PrometheusWriter::Label("phase", "run"), metrics.run_latency);
+    writer.HistogramSamples("onnxruntime_server_phase_duration_seconds", labels + PrometheusWriter::Label("phase", "serialize"), metrics.serialize_latency);
+  }
+
+  writer.Family("onnxruntime_server_queued_requests", "gauge", "Admitted requests waiting for a running request to complete.");
+  for (const auto& model : sessions_) {
+    if (model.second.admission_controller) {
+      writer.Sample("onnxruntime_server_queued_requests", model_labels(model.first),
+                    model.second.admission_controller->GetStats().num_queued);
+    }
+  }
+
+  writer.Family("onnxruntime_server_rejected_requests_total", "counter", "Requests rejected as the admission queue was full.");
+  for (const auto& model : sessions_) {
+    if (model.second.admission_controller) {
+      writer.Sample("onnxruntime_server_rejected_requests_total", model_labels(model.first),
+                    static_cast<double>(model.second.admission_controller->GetStats().num_rejected));
+    }
+  }
+
+  writer.Family("onnxruntime_server_expired_requests_total", "counter", "Requests dropped as their deadline passed before they were run.");
+  for (const auto& model : sessions_) {
+    if (model.second.admission_controller) {
+      writer.Sample("onnxruntime_server_expired_requests_total", model_labels(model.first),
+                    static_cast<double>(model.second.admission_controller->GetStats().num_expired));
+    }
+  }
+
+  writer.Family("onnxruntime_server_batches_total", "counter", "Batched runs of the model.");
+  for (const auto& model : sessions_) {
+    if (model.second.batcher) {
+      writer.Sample("onnxruntime_server_batches_total", model_labels(model.first),
+                    static_cast<double>(model.second.batcher->GetStats().num_batches));
+    }
+  }
+
+  writer.Family("onnxruntime_server_batched_requests_total", "counter", "Requests run as part of a batch.");
+  for (const auto& model : sessions_) {
+    if (model.second.batcher) {
+      writer.Sample("onnxruntime_server_batched_requests_total", model_labels(model.first),
+                    static_cast<double>(model.second.batcher->GetStats().num_batched_requests));
+    }
+  }
+
+  writer.Family("onnxruntime_server_batch_queue_delay_seconds_total", "counter", "Time requests waited for their batch to be run.");
+  for (const auto& model : sessions_) {
+    if (model.second.batcher) {
+      writer.Sample("onnxruntime_server_batch_queue_delay_seconds_total", model_labels(model.first),
+                    static_cast<double>(model.second.batcher->GetStats().total_queue_delay_us) / 1e6);
+    }
+  }
+
+  // Sessions without an arena for the CPU, e.g. with the arena disabled, report no arena stats
+  auto cpu_memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<std::pair<std::string, OrtArenaStats>> arena_stats;
+  for (const auto& model : sessions_) {
+    try {
+      arena_stats.emplace_back(model_labels(model.first), model.second.session.GetArenaStats(cpu_memory_info));
+    } catch (const Ort::Exception&) {
+    }
+  }
+
+  writer.Family("onnxruntime_server_arena_bytes_in_use", "gauge", "Bytes of the CPU arena of the model in use.");
+  for (const auto& stats : arena_stats) {
+    writer.Sample("onnxruntime_server_arena_bytes_in_use", stats.first, static_cast<double>(stats.second.bytes_in_use));
+  }
+
+  writer.Family("onnxruntime_server_arena_allocated_bytes", "gauge", "Bytes the CPU arena of the model allocated.");
+  for (const auto& stats : arena_stats) {
+    writer.Sample("onnxruntime_server_arena_allocated_bytes", stats.first, static_cast<double>(stats.second.total_allocated_bytes));
+  }
+
+  std::lock_guard<std::mutex> lock(worker_pools_mutex_);
+  writer.Family("onnxruntime_server_worker_threads", "gauge", "Threads of the worker pool.");
+  for (const auto& pool : worker_pools_) {
+    writer.Sample("onnxruntime_server_worker_threads", PrometheusWriter::Label("pool", pool.first),
+                  static_cast<double>(pool.second->NumThreads()));
+  }
+
+  writer.Family("onnxruntime_server_busy_worker_threads", "gauge", "Threads of the worker pool running a request.");
+  for (const auto& pool : worker_pools_) {
+    writer.Sample("onnxruntime_server_busy_worker_threads", PrometheusWriter::Label("pool", pool.first),
+                  static_cast<double>(pool.second->NumBusy()));
+  }
+
+  writer.Family("onnxruntime_server_worker_queue_depth", "gauge", "Requests waiting for a thread of the worker pool.");
+  for (const auto& pool : worker_pools_) {
+    writer.Sample("onnxruntime_server_worker_queue_depth", PrometheusWriter::Label("pool", pool.first),
+                  static_cast<double>(pool.second->NumQueued()));
+  }
+}
+
 OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
   return severity_;
 }
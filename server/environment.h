@@ -4,6 +4,8 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <ostream>
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"
@@ -11,6 +13,11 @@
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
 
+#include "admission_control.h"
+#include "batcher.h"
+#include "metrics.h"
+#include "worker_pool.h"
+
 namespace onnxruntime {
 namespace server {
 
@@ -23,8 +30,20 @@ class ServerEnvironment {
   OrtLoggingLevel GetLogSeverity() const;
 
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
-  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
+  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                       const BatchingOptions& batching_options = {}, const AdmissionOptions& admission_options = {});
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
+  // Returns the batcher of the model, or nullptr if batching isn't enabled for it.
+  Batcher* GetBatcher(const std::string& model_name, const std::string& model_version) const;
+  // Returns the admission controller of the model, or nullptr if the requests to it aren't limited.
+  AdmissionController* GetAdmissionController(const std::string& model_name, const std::string& model_version) const;
+  // Returns the request counts and latencies of the model.
+  ModelMetrics& GetModelMetrics(const std::string& model_name, const std::string& model_version) const;
+  // Adds the utilization of a pool of threads serving requests to the metrics, until it is removed.
+  void AddWorkerPool(const std::string& name, const WorkerPool* pool);
+  void RemoveWorkerPool(const std::string& name);
+  // Writes the metrics of the server in the Prometheus text exposition format.
+  void WriteMetrics(std::ostream& out) const;
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
   void UnloadModel(const std::string& model_name, const std::string& model_version);
@@ -42,6 +61,9 @@ class ServerEnvironment {
   struct SessionHolder {
     Ort::Session session;
     std::vector<std::string> output_names;
+    std::unique_ptr<Batcher> batcher;
+    std::unique_ptr<AdmissionController> admission_controller;
+    std::unique_ptr<ModelMetrics> metrics = std::make_unique<ModelMetrics>();
     explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
       session = Ort::Session(env, path.c_str(), options);
     };
@@ -52,6 +74,9 @@ class ServerEnvironment {
   };
 
   std::unordered_map<std::pair<std::string, std::string>, ServerEnvironment::SessionHolder, boost::hash<std::pair<std::string, std::string>>> sessions_;
+
+  mutable std::mutex worker_pools_mutex_;
+  std::vector<std::pair<std::string, const WorkerPool*>> worker_pools_;
 };
 
 }  // namespace server
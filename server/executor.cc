@@ -23,6 +23,17 @@ protobufutil::Status Executor::SetMLValue(const onnx::TensorProto& input_tensor,
                                           /* out */ Ort::Value& ml_value) {
   auto logger = env_->GetLogger(request_id_);
 
+  // Use the raw_data of the request as the tensor data when possible instead of copying it into a new buffer.
+  // The request outlives the run.
+  try {
+    if (onnxruntime::server::TryWrapRawDataAsMLValue(input_tensor, *cpu_memory_info, ml_value)) {
+      return protobufutil::Status::OK;
+    }
+  } catch (const Ort::Exception& e) {
+    logger->error("TryWrapRawDataAsMLValue() failed. Message: {}", e.what());
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
   size_t cpu_tensor_length = 0;
   try {
     onnxruntime::server::GetSizeInBytesFromTensorProto<0>(input_tensor, &cpu_tensor_length);
@@ -100,14 +111,67 @@ std::vector<Ort::Value> Run(const Ort::Session& session, const Ort::RunOptions&
 protobufutil::Status Executor::Predict(const std::string& model_name,
                                        const std::string& model_version,
                                        const onnxruntime::server::PredictRequest& request,
-                                       /* out */ onnxruntime::server::PredictResponse& response) {
+                                       /* out */ onnxruntime::server::PredictResponse& response,
+                                       std::chrono::steady_clock::time_point deadline) {
+  ModelMetrics* metrics = nullptr;
+  try {
+    metrics = &env_->GetModelMetrics(model_name, model_version);
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  metrics->requests.Add();
+  metrics->in_flight.Add(1);
+  auto status = PredictImpl(model_name, model_version, request, response, deadline, *metrics);
+  metrics->in_flight.Add(-1);
+  metrics->request_latency.Observe(std::chrono::steady_clock::now() - start);
+  if (!status.ok()) {
+    const auto code = static_cast<size_t>(status.error_code());
+    metrics->errors[code < kNumStatusCodes ? code : static_cast<size_t>(protobufutil::error::Code::UNKNOWN)].Add();
+  }
+
+  return status;
+}
+
+protobufutil::Status Executor::PredictImpl(const std::string& model_name,
+                                           const std::string& model_version,
+                                           const onnxruntime::server::PredictRequest& request,
+                                           /* out */ onnxruntime::server::PredictResponse& response,
+                                           std::chrono::steady_clock::time_point deadline,
+                                           ModelMetrics& metrics) {
   auto logger = env_->GetLogger(request_id_);
 
+  // Shed the load before doing any work for the request
+  AdmissionController* admission_controller = nullptr;
+  try {
+    admission_controller = env_->GetAdmissionController(model_name, model_version);
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+  if (admission_controller != nullptr) {
+    switch (admission_controller->Admit(deadline)) {
+      case AdmissionController::Result::QueueFull:
+        logger->warn("Request rejected as too many requests are pending");
+        return protobufutil::Status(protobufutil::error::Code::RESOURCE_EXHAUSTED, "Too many pending requests");
+      case AdmissionController::Result::DeadlineExceeded:
+        logger->warn("Request dropped as its deadline passed before it could run");
+        return protobufutil::Status(protobufutil::error::Code::DEADLINE_EXCEEDED, "Deadline exceeded before the request could run");
+      case AdmissionController::Result::Admitted:
+        break;
+    }
+  }
+  // Releases the slot of the request once it completes
+  std::unique_ptr<AdmissionController, void (*)(AdmissionController*)> admission{
+      admission_controller, [](AdmissionController* controller) { controller->Release(); }};
+
   // Convert PredictRequest to NameMLValMap
   MemBufferArray buffer_array;
   std::vector<std::string> input_names;
   std::vector<Ort::Value> input_values;
+  auto phase_start = std::chrono::steady_clock::now();
   auto conversion_status = SetNameMLValueMap(input_names, input_values, request, buffer_array);
+  metrics.parse_latency.Observe(std::chrono::steady_clock::now() - phase_start);
   if (conversion_status != protobufutil::Status::OK) {
     return conversion_status;
   }
@@ -128,16 +192,45 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
     output_names = env_->GetModelOutputNames(model_name, model_version);
   }
 
+  if (std::chrono::steady_clock::now() >= deadline) {
+    if (admission_controller != nullptr) {
+      admission_controller->RecordExpired();
+    }
+    logger->warn("Request dropped as its deadline passed before it could run");
+    return protobufutil::Status(protobufutil::error::Code::DEADLINE_EXCEEDED, "Deadline exceeded before the request could run");
+  }
+
   std::vector<Ort::Value> outputs;
+  phase_start = std::chrono::steady_clock::now();
   try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    auto* batcher = env_->GetBatcher(model_name, model_version);
+    if (batcher != nullptr) {
+      outputs = batcher->Run(run_options, input_names, input_values, output_names, deadline);
+    } else {
+      outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    }
+  } catch (const DeadlineExceededError& e) {
+    if (admission_controller != nullptr) {
+      admission_controller->RecordExpired();
+    }
+    logger->warn("Request dropped as its deadline passed while it waited for its batch");
+    return protobufutil::Status(protobufutil::error::Code::DEADLINE_EXCEEDED, e.what());
   } catch (const Ort::Exception& e) {
     return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
   }
+  metrics.run_latency.Observe(std::chrono::steady_clock::now() - phase_start);
+  phase_start = std::chrono::steady_clock::now();
 
-  // Build the response
+  // Build the response. The output tensors are serialized in place in the response map instead of being copied
+  // into it.
+  auto& response_outputs = *response.mutable_outputs();
   for (size_t i = 0, sz = outputs.size(); i < sz; ++i) {
-    onnx::TensorProto output_tensor{};
+    if (response_outputs.count(output_names[i]) != 0) {
+      logger->error("SetNameMLValueMap() failed. Output name: {}. Trying to overwrite existing output value", output_names[i]);
+      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "SetNameMLValueMap() failed: Cannot have two outputs with the same name");
+    }
+
+    onnx::TensorProto& output_tensor = response_outputs[output_names[i]];
     try {
       MLValueToTensorProto(outputs[i], using_raw_data_, logger, output_tensor);
     } catch (const Ort::Exception& e) {
@@ -146,13 +239,10 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
       return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
     }
 
-    auto insertion_result = response.mutable_outputs()->insert({output_names[i], output_tensor});
-
-    if (!insertion_result.second) {
-      logger->error("SetNameMLValueMap() failed. Output name: {}. Trying to overwrite existing output value", output_names[i]);
-      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "SetNameMLValueMap() failed: Cannot have two outputs with the same name");
-    }
+    // The output values are released as soon as they are serialized, so that at most one copy of each output is held
+    outputs[i] = Ort::Value{nullptr};
   }
+  metrics.serialize_latency.Observe(std::chrono::steady_clock::now() - phase_start);
 
   return protobufutil::Status::OK;
 }
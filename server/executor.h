@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <google/protobuf/stubs/status.h>
 
 #include "environment.h"
@@ -20,16 +21,26 @@ class Executor {
                                                                     using_raw_data_(true) {}
 
   // Prediction method
+  // The request fails with DEADLINE_EXCEEDED instead of being run if deadline passes before it is run, and with
+  // RESOURCE_EXHAUSTED if the model already has as many requests as it admits.
   google::protobuf::util::Status Predict(const std::string& model_name,
                                          const std::string& model_version,
                                          const onnxruntime::server::PredictRequest& request,
-                                         /* out */ onnxruntime::server::PredictResponse& response);
+                                         /* out */ onnxruntime::server::PredictResponse& response,
+                                         std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
 
  private:
   ServerEnvironment* env_;
   const std::string request_id_;
   bool using_raw_data_;
 
+  google::protobuf::util::Status PredictImpl(const std::string& model_name,
+                                             const std::string& model_version,
+                                             const onnxruntime::server::PredictRequest& request,
+                                             /* out */ onnxruntime::server::PredictResponse& response,
+                                             std::chrono::steady_clock::time_point deadline,
+                                             ModelMetrics& metrics);
+
   google::protobuf::util::Status SetMLValue(const onnx::TensorProto& input_tensor,
                                             MemBufferArray& buffers,
                                             OrtMemoryInfo* cpu_memory_info,
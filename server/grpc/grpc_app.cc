@@ -9,20 +9,112 @@ namespace onnx_grpc = onnxruntime::server::grpc;
 
 namespace onnxruntime {
 namespace server {
-GRPCApp::GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port) : prediction_service_implementation_(env) {
+
+namespace {
+// The state of a Predict call. Its address is the tag of the operations of the call on its completion queue.
+class PredictCallData {
+ public:
+  PredictCallData(PredictionService::AsyncService* service, ::grpc::ServerCompletionQueue* cq,
+                  onnx_grpc::PredictionServiceImpl* handler, WorkerPool* inference_workers)
+      : service_(service), cq_(cq), handler_(handler), inference_workers_(inference_workers), responder_(&context_) {
+    service_->RequestPredict(&context_, &request_, &responder_, cq_, cq_, this);
+  }
+
+  // Advances the call once its pending operation completed.
+  void Proceed(bool ok) {
+    if (accepted_) {
+      // The response was sent or the call was cancelled
+      delete this;
+      return;
+    }
+
+    if (!ok) {
+      // The server is shutting down
+      delete this;
+      return;
+    }
+
+    accepted_ = true;
+    // Wait for the next call while this one is handled
+    new PredictCallData(service_, cq_, handler_, inference_workers_);
+
+    if (!inference_workers_->TrySchedule([this]() { Predict(); })) {
+      responder_.FinishWithError(::grpc::Status(::grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many pending requests"), this);
+    }
+  }
+
+ private:
+  void Predict() {
+    auto status = handler_->Predict(&context_, &request_, &response_);
+    if (status.ok()) {
+      responder_.Finish(response_, status, this);
+    } else {
+      responder_.FinishWithError(status, this);
+    }
+  }
+
+  PredictionService::AsyncService* service_;
+  ::grpc::ServerCompletionQueue* cq_;
+  onnx_grpc::PredictionServiceImpl* handler_;
+  WorkerPool* inference_workers_;
+
+  ::grpc::ServerContext context_;
+  PredictRequest request_;
+  PredictResponse response_;
+  ::grpc::ServerAsyncResponseWriter<PredictResponse> responder_;
+  bool accepted_ = false;
+};
+}  // namespace
+
+GRPCApp::GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port,
+                 int num_completion_queue_threads, int num_inference_threads, size_t max_pending_requests)
+    : env_(env),
+      prediction_service_implementation_(env),
+      inference_workers_(std::make_unique<WorkerPool>(num_inference_threads, max_pending_requests)) {
+  env_->AddWorkerPool("grpc_inference", inference_workers_.get());
   ::grpc::EnableDefaultHealthCheckService(true);
   ::grpc::channelz::experimental::InitChannelzService();
   ::grpc::reflection::InitProtoReflectionServerBuilderPlugin();
   ::grpc::ServerBuilder builder;
-  builder.RegisterService(&prediction_service_implementation_);
+  builder.RegisterService(&async_service_);
   builder.AddListeningPort(host + ":" + std::to_string(port), ::grpc::InsecureServerCredentials());
+  for (int i = 0; i < num_completion_queue_threads; ++i) {
+    completion_queues_.push_back(builder.AddCompletionQueue());
+  }
 
   server_ = builder.BuildAndStart();
   server_->GetHealthCheckService()->SetServingStatus(PredictionService::service_full_name(), true);
+
+  for (auto& cq : completion_queues_) {
+    new PredictCallData(&async_service_, cq.get(), &prediction_service_implementation_, inference_workers_.get());
+    completion_queue_threads_.emplace_back([this, cq = cq.get()]() { HandleCalls(cq); });
+  }
+}
+
+GRPCApp::~GRPCApp() {
+  // Shutting down the server waits for the calls in flight, whose responses are sent by the completion queue threads
+  server_->Shutdown();
+  env_->RemoveWorkerPool("grpc_inference");
+  inference_workers_.reset();
+  for (auto& cq : completion_queues_) {
+    cq->Shutdown();
+  }
+  for (auto& thread : completion_queue_threads_) {
+    thread.join();
+  }
 }
 
 void GRPCApp::Run() {
   server_->Wait();
 }
+
+void GRPCApp::HandleCalls(::grpc::ServerCompletionQueue* cq) {
+  void* tag = nullptr;
+  bool ok = false;
+  // Next returns false once the queue is shut down and drained
+  while (cq->Next(&tag, &ok)) {
+    static_cast<PredictCallData*>(tag)->Proceed(ok);
+  }
+}
 }  // namespace server
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -2,16 +2,23 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <thread>
+#include <vector>
 #include <grpcpp/grpcpp.h>
 #include "prediction_service_impl.h"
 #include "environment.h"
+#include "worker_pool.h"
 
 namespace onnxruntime {
 namespace server {
+// Serves PredictionService with the async gRPC API. A few threads drive the completion queues and hand the calls
+// to a pool of inference threads, so an in-flight call doesn't hold a thread while it waits to be run. Calls are
+// rejected with RESOURCE_EXHAUSTED once max_pending_requests of them are waiting for an inference thread.
 class GRPCApp {
  public:
-  GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port);
-  ~GRPCApp() = default;
+  GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port,
+          int num_completion_queue_threads, int num_inference_threads, size_t max_pending_requests);
+  ~GRPCApp();
   GRPCApp(const GRPCApp& other) = delete;
   GRPCApp(GRPCApp&& other) = delete;
 
@@ -21,8 +28,15 @@ class GRPCApp {
   void Run();
 
  private:
+  void HandleCalls(::grpc::ServerCompletionQueue* cq);
+
+  std::shared_ptr<onnxruntime::server::ServerEnvironment> env_;
   grpc::PredictionServiceImpl prediction_service_implementation_;
+  PredictionService::AsyncService async_service_;
+  std::unique_ptr<WorkerPool> inference_workers_;
+  std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> completion_queues_;
+  std::vector<std::thread> completion_queue_threads_;
   std::unique_ptr<::grpc::Server> server_;
 };
 }  // namespace server
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -12,9 +12,17 @@ PredictionServiceImpl::PredictionServiceImpl(const std::shared_ptr<onnxruntime::
 
 ::grpc::Status PredictionServiceImpl::Predict(::grpc::ServerContext* context, const ::onnxruntime::server::PredictRequest* request, ::onnxruntime::server::PredictResponse* response) {
   auto request_id = SetRequestContext(context);
+
+  // The deadline of the client, which is infinite if it didn't set one
+  auto deadline = std::chrono::steady_clock::time_point::max();
+  if (context->deadline() != std::chrono::system_clock::time_point::max()) {
+    deadline = AdmissionController::DeadlineAfter(
+        std::chrono::duration_cast<std::chrono::milliseconds>(context->deadline() - std::chrono::system_clock::now()));
+  }
+
   onnxruntime::server::Executor executor(environment_.get(), request_id);
   //TODO: (csteegz) Add modelspec for both paths.
-  auto status = executor.Predict("default", "1", *request, *response);  // Currently only support one model so hard coded.
+  auto status = executor.Predict("default", "1", *request, *response, deadline);  // Currently only support one model so hard coded.
   if (!status.ok()) {
     return ::grpc::Status(::grpc::StatusCode(status.error_code()), status.error_message());
   }
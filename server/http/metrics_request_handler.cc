@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+
+#include "metrics_request_handler.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace http = boost::beast::http;
+
+void Metrics(/* in, out */ HttpContext& context,
+             const std::shared_ptr<ServerEnvironment>& env) {
+  std::ostringstream body;
+  env->WriteMetrics(body);
+
+  context.response.insert(util::MS_REQUEST_ID_HEADER, context.request_id);
+  if (!context.client_request_id.empty()) {
+    context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
+  }
+  context.response.set(http::field::content_type, "text/plain; version=0.0.4");
+  context.response.body() = body.str();
+  context.response.result(http::status::ok);
+}
+
+}  // namespace server
+}  // namespace onnxruntime
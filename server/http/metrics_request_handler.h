@@ -0,0 +1,19 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+
+#include "environment.h"
+#include "http_server.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Responds with the metrics of the server in the Prometheus text exposition format.
+void Metrics(/* in, out */ HttpContext& context,
+             const std::shared_ptr<ServerEnvironment>& env);
+
+}  // namespace server
+}  // namespace onnxruntime
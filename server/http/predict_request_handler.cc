@@ -54,7 +54,7 @@ void Predict(const std::string& name,
   }
 
   // Deserialize the payload
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   PredictRequest predict_request{};
   http::status error_code;
   std::string error_message;
@@ -64,10 +64,28 @@ void Predict(const std::string& name,
     return;
   }
 
+  // The deadline of the client, if it set a timeout
+  auto deadline = std::chrono::steady_clock::time_point::max();
+  auto timeout_header = context.request.find(util::MS_REQUEST_TIMEOUT_HEADER);
+  if (timeout_header != context.request.end()) {
+    long long timeout_ms = 0;
+    try {
+      timeout_ms = std::stoll(timeout_header->value().to_string());
+    } catch (const std::exception&) {
+      timeout_ms = 0;
+    }
+    if (timeout_ms <= 0) {
+      GenerateErrorResponse(logger, http::status::bad_request,
+                            "The '" + util::MS_REQUEST_TIMEOUT_HEADER + "' header field must be a positive number of milliseconds", context);
+      return;
+    }
+    deadline = AdmissionController::DeadlineAfter(std::chrono::milliseconds(timeout_ms));
+  }
+
   // Run Prediction
   Executor executor(env.get(), context.request_id);
   PredictResponse predict_response{};
-  auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
+  auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response, deadline);
   if (!status.ok()) {
     GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
     return;
@@ -96,12 +114,12 @@ void Predict(const std::string& name,
   if (!context.client_request_id.empty()) {
     context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
   }
-  context.response.body() = response_body;
+  context.response.body() = std::move(response_body);
   context.response.result(http::status::ok);
 };
 
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   protobufutil::Status status;
   switch (request_type) {
     case SupportedContentType::Json: {
@@ -24,8 +24,6 @@ boost::beast::http::status GetHttpStatusCode(const protobufutil::Status& status)
       return boost::beast::http::status::ok;
 
     case protobufutil::error::Code::UNKNOWN:
-    case protobufutil::error::Code::DEADLINE_EXCEEDED:
-    case protobufutil::error::Code::RESOURCE_EXHAUSTED:
     case protobufutil::error::Code::ABORTED:
     case protobufutil::error::Code::UNIMPLEMENTED:
     case protobufutil::error::Code::INTERNAL:
@@ -49,6 +47,12 @@ boost::beast::http::status GetHttpStatusCode(const protobufutil::Status& status)
     case protobufutil::error::Code::UNAUTHENTICATED:
       return boost::beast::http::status::unauthorized;
 
+    case protobufutil::error::Code::RESOURCE_EXHAUSTED:
+      return boost::beast::http::status::too_many_requests;
+
+    case protobufutil::error::Code::DEADLINE_EXCEEDED:
+      return boost::beast::http::status::gateway_timeout;
+
     default:
       return boost::beast::http::status::internal_server_error;
   }
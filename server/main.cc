@@ -3,6 +3,7 @@
 
 #include "environment.h"
 #include "http_server.h"
+#include "metrics_request_handler.h"
 #include "predict_request_handler.h"
 #include "server_configuration.h"
 #include "grpc/grpc_app.h"
@@ -63,9 +64,16 @@ int main(int argc, char* argv[]) {
   logger->info("Model path: {}, ", config.model_path);
   logger->info("Model name: {}", config.model_name);
   logger->info("Model version: {}", config.model_version);
+  logger->info("Max batch size: {}", config.max_batch_size);
 
   try {
-    env->InitializeModel(config.model_path, config.model_name, config.model_version);
+    server::BatchingOptions batching_options{};
+    batching_options.max_batch_size = config.max_batch_size;
+    batching_options.max_queue_delay = std::chrono::microseconds(config.batch_timeout_microseconds);
+    server::AdmissionOptions admission_options{};
+    admission_options.max_concurrent_requests = config.max_concurrent_requests;
+    admission_options.max_queued_requests = config.max_queued_requests;
+    env->InitializeModel(config.model_path, config.model_name, config.model_version, batching_options, admission_options);
     logger->debug("Initialize Model Successfully!");
   } catch (const Ort::Exception& ex) {
     logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
@@ -76,7 +84,8 @@ int main(int argc, char* argv[]) {
   auto const grpc_address = config.address;
   auto const grpc_port = config.grpc_port;
 
-  server::GRPCApp grpc_app{env, grpc_address, grpc_port};
+  server::GRPCApp grpc_app{env, grpc_address, grpc_port, config.num_grpc_threads, config.num_inference_threads,
+                           static_cast<size_t>(config.max_pending_requests)};
 
   logger->info("GRPC Listening at: {}:{}", grpc_address, grpc_port);
 
@@ -118,6 +127,12 @@ int main(int argc, char* argv[]) {
       }
   );
 
+  app.RegisterGet(
+      R"(/metrics()()())",
+      [&env](const auto& /*name*/, const auto& /*version*/, const auto& /*action*/, auto& context) -> void {
+        server::Metrics(context, env);
+      });
+
   app.Bind(boost_address, config.http_port)
       .NumThreads(config.num_http_threads)
       .Run();
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "metrics.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace {
+
+// The shard of the calling thread. Threads are assigned to the shards in turn.
+size_t ThisThreadShard() {
+  static std::atomic<size_t> next_shard{0};
+  thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kNumMetricShards;
+  return shard;
+}
+
+}  // namespace
+
+void Counter::Add(int64_t value) {
+  shards_[ThisThreadShard()].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+int64_t Counter::Value() const {
+  int64_t value = 0;
+  for (const auto& shard : shards_) {
+    value += shard.value.load(std::memory_order_relaxed);
+  }
+  return value;
+}
+
+const std::array<double, Histogram::kNumBuckets>& Histogram::LatencyBuckets() {
+  static const std::array<double, kNumBuckets> buckets{0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+                                                       0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+  return buckets;
+}
+
+void Histogram::Observe(std::chrono::steady_clock::duration duration) {
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  const double seconds = static_cast<double>(ns) / 1e9;
+  const auto& buckets = LatencyBuckets();
+  size_t bucket = 0;
+  while (bucket < kNumBuckets && seconds > buckets[bucket]) {
+    ++bucket;
+  }
+
+  auto& shard = shards_[ThisThreadShard()];
+  shard.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+  shard.sum_ns.fetch_add(static_cast<uint64_t>(ns > 0 ? ns : 0), std::memory_order_relaxed);
+}
+
+std::array<uint64_t, Histogram::kNumBuckets + 1> Histogram::CumulativeCounts() const {
+  std::array<uint64_t, kNumBuckets + 1> counts{};
+  for (const auto& shard : shards_) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+      counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+    }
+  }
+  for (size_t i = 1; i < counts.size(); ++i) {
+    counts[i] += counts[i - 1];
+  }
+  return counts;
+}
+
+double Histogram::SumSeconds() const {
+  uint64_t sum_ns = 0;
+  for (const auto& shard : shards_) {
+    sum_ns += shard.sum_ns.load(std::memory_order_relaxed);
+  }
+  return static_cast<double>(sum_ns) / 1e9;
+}
+
+const char* StatusCodeName(size_t code) {
+  static const char* const names[kNumStatusCodes] = {
+      "OK", "CANCELLED", "UNKNOWN", "INVALID_ARGUMENT", "DEADLINE_EXCEEDED", "NOT_FOUND", "ALREADY_EXISTS",
+      "PERMISSION_DENIED", "RESOURCE_EXHAUSTED", "FAILED_PRECONDITION", "ABORTED", "OUT_OF_RANGE",
+      "UNIMPLEMENTED", "INTERNAL", "UNAVAILABLE", "DATA_LOSS", "UNAUTHENTICATED"};
+  return code < kNumStatusCodes ? names[code] : "UNKNOWN";
+}
+
+void PrometheusWriter::Family(const std::string& name, const std::string& type, const std::string& help) {
+  out_ << "# HELP " << name << ' ' << help << '\n'
+       << "# TYPE " << name << ' ' << type << '\n';
+}
+
+void PrometheusWriter::Sample(const std::string& name, const std::string& labels, double value) {
+  out_ << name;
+  if (!labels.empty()) {
+    out_ << '{' << labels << '}';
+  }
+  out_ << ' ';
+  // Print the counts as integers rather than in scientific notation
+  if (std::floor(value) == value && std::fabs(value) < 1e15) {
+    out_ << static_cast<int64_t>(value);
+  } else {
+    out_ << std::setprecision(9) << value;
+  }
+  out_ << '\n';
+}
+
+void PrometheusWriter::HistogramSamples(const std::string& name, const std::string& labels, const Histogram& histogram) {
+  const auto counts = histogram.CumulativeCounts();
+  const auto& buckets = Histogram::LatencyBuckets();
+  const std::string separator = labels.empty() ? "" : ",";
+  for (size_t i = 0; i < Histogram::kNumBuckets; ++i) {
+    std::ostringstream bound;
+    bound << buckets[i];
+    Sample(name + "_bucket", labels + separator + Label("le", bound.str()), static_cast<double>(counts[i]));
+  }
+  Sample(name + "_bucket", labels + separator + Label("le", "+Inf"), static_cast<double>(counts[Histogram::kNumBuckets]));
+  Sample(name + "_sum", labels, histogram.SumSeconds());
+  Sample(name + "_count", labels, static_cast<double>(counts[Histogram::kNumBuckets]));
+}
+
+std::string PrometheusWriter::Label(const std::string& name, const std::string& value) {
+  std::string label = name + "=\"";
+  for (char c : value) {
+    switch (c) {
+      case '\\':
+        label += "\\\\";
+        break;
+      case '"':
+        label += "\\\"";
+        break;
+      case '\n':
+        label += "\\n";
+        break;
+      default:
+        label += c;
+    }
+  }
+  label += '"';
+  return label;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
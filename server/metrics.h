@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace onnxruntime {
+namespace server {
+
+// The number of shards of a Counter or Histogram. The threads of the server are spread over them.
+constexpr size_t kNumMetricShards = 16;
+
+// A value that threads add to without contending for a cache line: each thread adds to its own shard with a
+// relaxed atomic, and reading the value sums the shards. Gauges such as the in-flight requests add negative values.
+class Counter {
+ public:
+  Counter() = default;
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  void Add(int64_t value = 1);
+  int64_t Value() const;
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value{0};
+  };
+  std::array<Shard, kNumMetricShards> shards_;
+};
+
+// A histogram of durations with the fixed buckets of LatencyBuckets(), sharded like Counter.
+class Histogram {
+ public:
+  static constexpr size_t kNumBuckets = 14;
+  // The upper bounds in seconds of the buckets, excluding the +Inf one.
+  static const std::array<double, kNumBuckets>& LatencyBuckets();
+
+  Histogram() = default;
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  void Observe(std::chrono::steady_clock::duration duration);
+
+  // Cumulative counts of the buckets, the last one being +Inf, i.e. the number of observations.
+  std::array<uint64_t, kNumBuckets + 1> CumulativeCounts() const;
+  double SumSeconds() const;
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, kNumBuckets + 1> counts{};
+    std::atomic<uint64_t> sum_ns{0};
+  };
+  std::array<Shard, kNumMetricShards> shards_;
+};
+
+// The status codes of google::protobuf::util::error::Code, which Predict returns.
+constexpr size_t kNumStatusCodes = 17;
+
+struct ModelMetrics {
+  Counter requests;
+  std::array<Counter, kNumStatusCodes> errors;  // By status code
+  Counter in_flight;
+  Histogram request_latency;
+  Histogram parse_latency;      // Converting the request inputs to tensors
+  Histogram run_latency;        // Running the session, including the wait for a batch
+  Histogram serialize_latency;  // Converting the outputs to the response
+};
+
+// The name of a status code, e.g. RESOURCE_EXHAUSTED.
+const char* StatusCodeName(size_t code);
+
+// Writes metric families in the Prometheus text exposition format.
+// All the samples of a family must be written right after the family.
+class PrometheusWriter {
+ public:
+  explicit PrometheusWriter(std::ostream& out) : out_(out) {}
+
+  void Family(const std::string& name, const std::string& type, const std::string& help);
+  // labels is a comma separated list of name="value", which can be empty.
+  void Sample(const std::string& name, const std::string& labels, double value);
+  void HistogramSamples(const std::string& name, const std::string& labels, const Histogram& histogram);
+
+  // Formats a label, escaping its value.
+  static std::string Label(const std::string& name, const std::string& value);
+
+ private:
+  std::ostream& out_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
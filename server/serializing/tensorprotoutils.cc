@@ -378,6 +378,37 @@ void TensorProtoToMLValue(const onnx::TensorProto& tensor_proto, const MemBuffer
   value = Ort::Value::CreateTensor(&allocator, tensor_data, m.GetLen(), tensor_shape_vec.data(), tensor_shape_vec.size(), (ONNXTensorElementDataType)tensor_proto.data_type());
   return;
 }
+bool TryWrapRawDataAsMLValue(const onnx::TensorProto& tensor_proto, const OrtMemoryInfo& memory_info, Ort::Value& value) {
+  if (!tensor_proto.has_raw_data() || !IsLittleEndianOrder() ||
+      tensor_proto.data_location() == onnx::TensorProto_DataLocation::TensorProto_DataLocation_EXTERNAL ||
+      tensor_proto.data_type() == onnx::TensorProto_DataType::TensorProto_DataType_STRING) {
+    return false;
+  }
+
+  size_t expected_size = 0;
+  GetSizeInBytesFromTensorProto<0>(tensor_proto, &expected_size);
+  const std::string& raw_data = tensor_proto.raw_data();
+  // Leave the reporting of a size mismatch to TensorProtoToMLValue
+  if (raw_data.size() != expected_size) {
+    return false;
+  }
+
+  // The kernels expect the data of a tensor to be aligned for its element type
+  size_t element_count = 1;
+  for (auto dim : tensor_proto.dims()) {
+    element_count *= static_cast<size_t>(dim);
+  }
+  if (element_count != 0 && reinterpret_cast<uintptr_t>(raw_data.data()) % (expected_size / element_count) != 0) {
+    return false;
+  }
+
+  std::vector<int64_t> tensor_shape_vec = GetTensorShapeFromTensorProto(tensor_proto);
+  // The session doesn't write to its inputs, so the const_cast is safe.
+  value = Ort::Value::CreateTensor(&memory_info, const_cast<char*>(raw_data.data()), raw_data.size(),
+                                   tensor_shape_vec.data(), tensor_shape_vec.size(), GetTensorElementType(tensor_proto));
+  return true;
+}
+
 template void GetSizeInBytesFromTensorProto<256>(const onnx::TensorProto& tensor_proto,
                                                  size_t* out);
 template void GetSizeInBytesFromTensorProto<0>(const onnx::TensorProto& tensor_proto, size_t* out);
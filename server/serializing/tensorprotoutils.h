@@ -27,6 +27,14 @@ void GetSizeInBytesFromTensorProto(const onnx::TensorProto& tensor_proto, size_t
  */
 void TensorProtoToMLValue(const onnx::TensorProto& input, const server::MemBuffer& m, /* out */ Ort::Value& value);
 
+/**
+ * Wraps the raw_data of a TensorProto into value without copying it. Returns false if the raw data can't be used as
+ * the tensor data as is: the TensorProto has no raw_data or holds strings, the platform is big endian, or the data
+ * has an unexpected size or isn't aligned for the element type. TensorProtoToMLValue has to be used then.
+ * value refers to the memory of input, which must outlive it.
+ */
+bool TryWrapRawDataAsMLValue(const onnx::TensorProto& input, const OrtMemoryInfo& memory_info, /* out */ Ort::Value& value);
+
 template <typename T>
 void UnpackTensor(const onnx::TensorProto& tensor, const void* raw_data, size_t raw_data_len,
                   /*out*/ T* p_data, int64_t expected_size);
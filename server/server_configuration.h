@@ -46,6 +46,13 @@ class ServerConfiguration {
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
   OrtLoggingLevel logging_level{};
+  int num_grpc_threads = 2;
+  int num_inference_threads = std::thread::hardware_concurrency();
+  int max_pending_requests = 1024;
+  int max_concurrent_requests = 0;
+  int max_queued_requests = 100;
+  int max_batch_size = 0;
+  int batch_timeout_microseconds = 1000;
 
   ServerConfiguration() {
     desc.add_options()("help,h", "Shows a help message and exits");
@@ -57,6 +64,13 @@ class ServerConfiguration {
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("num_grpc_threads", po::value(&num_grpc_threads)->default_value(num_grpc_threads), "Number of threads polling the GRPC completion queues");
+    desc.add_options()("num_inference_threads", po::value(&num_inference_threads)->default_value(num_inference_threads), "Number of threads running GRPC requests");
+    desc.add_options()("max_pending_requests", po::value(&max_pending_requests)->default_value(max_pending_requests), "Maximum number of GRPC requests waiting for an inference thread. 0 only accepts requests when a thread is idle");
+    desc.add_options()("max_concurrent_requests", po::value(&max_concurrent_requests)->default_value(max_concurrent_requests), "Maximum number of requests to the model that run at the same time. 0 doesn't limit them");
+    desc.add_options()("max_queued_requests", po::value(&max_queued_requests)->default_value(max_queued_requests), "Maximum number of requests waiting for one of the max_concurrent_requests running ones. Further requests are rejected");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Maximum number of rows that concurrent requests are batched into. 0 disables batching");
+    desc.add_options()("batch_timeout_microseconds", po::value(&batch_timeout_microseconds)->default_value(batch_timeout_microseconds), "Maximum time a request waits for others to batch with");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,6 +117,27 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
+    } else if (num_grpc_threads <= 0) {
+      PrintHelp(std::cerr, "num_grpc_threads must be greater than 0");
+      return Result::ExitFailure;
+    } else if (num_inference_threads <= 0) {
+      PrintHelp(std::cerr, "num_inference_threads must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_pending_requests < 0) {
+      PrintHelp(std::cerr, "max_pending_requests must not be negative");
+      return Result::ExitFailure;
+    } else if (max_concurrent_requests < 0) {
+      PrintHelp(std::cerr, "max_concurrent_requests must not be negative");
+      return Result::ExitFailure;
+    } else if (max_queued_requests < 0) {
+      PrintHelp(std::cerr, "max_queued_requests must not be negative");
+      return Result::ExitFailure;
+    } else if (max_batch_size < 0) {
+      PrintHelp(std::cerr, "max_batch_size must not be negative");
+      return Result::ExitFailure;
+    } else if (batch_timeout_microseconds < 0) {
+      PrintHelp(std::cerr, "batch_timeout_microseconds must not be negative");
+      return Result::ExitFailure;
     } else if (!file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <future>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "admission_control.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+using Clock = AdmissionController::Clock;
+
+TEST(AdmissionControlTests, RejectsWhenQueueIsFull) {
+  AdmissionOptions options{};
+  options.max_concurrent_requests = 1;
+  options.max_queued_requests = 0;
+  AdmissionController controller(options);
+
+  EXPECT_EQ(controller.Admit(Clock::time_point::max()), AdmissionController::Result::Admitted);
+  EXPECT_EQ(controller.Admit(Clock::time_point::max()), AdmissionController::Result::QueueFull);
+  controller.Release();
+  EXPECT_EQ(controller.Admit(Clock::time_point::max()), AdmissionController::Result::Admitted);
+  controller.Release();
+
+  auto stats = controller.GetStats();
+  EXPECT_EQ(stats.num_admitted, 2u);
+  EXPECT_EQ(stats.num_rejected, 1u);
+}
+
+TEST(AdmissionControlTests, DropsRequestsWhoseDeadlinePassedInQueue) {
+  AdmissionOptions options{};
+  options.max_concurrent_requests = 1;
+  options.max_queued_requests = 1;
+  AdmissionController controller(options);
+
+  EXPECT_EQ(controller.Admit(Clock::time_point::max()), AdmissionController::Result::Admitted);
+  EXPECT_EQ(controller.Admit(Clock::now() + std::chrono::milliseconds(10)), AdmissionController::Result::DeadlineExceeded);
+  EXPECT_EQ(controller.Admit(Clock::now() - std::chrono::milliseconds(1)), AdmissionController::Result::DeadlineExceeded);
+  controller.Release();
+
+  EXPECT_EQ(controller.GetStats().num_expired, 2u);
+}
+
+TEST(AdmissionControlTests, TimeoutsBeyondMaxTimeoutHaveNoDeadline) {
+  EXPECT_EQ(AdmissionController::DeadlineAfter(std::chrono::milliseconds(std::numeric_limits<int64_t>::max())), Clock::time_point::max());
+  EXPECT_EQ(AdmissionController::DeadlineAfter(std::chrono::milliseconds(10000000000000)), Clock::time_point::max());
+
+  const auto before = Clock::now();
+  const auto deadline = AdmissionController::DeadlineAfter(AdmissionController::kMaxTimeout);
+  EXPECT_GE(deadline, before + AdmissionController::kMaxTimeout);
+  EXPECT_LE(deadline, Clock::now() + AdmissionController::kMaxTimeout);
+}
+
+TEST(AdmissionControlTests, AdmitsQueuedRequestOnRelease) {
+  AdmissionOptions options{};
+  options.max_concurrent_requests = 1;
+  options.max_queued_requests = 1;
+  AdmissionController controller(options);
+
+  EXPECT_EQ(controller.Admit(Clock::time_point::max()), AdmissionController::Result::Admitted);
+  auto queued = std::async(std::launch::async, [&controller]() { return controller.Admit(Clock::time_point::max()); });
+  EXPECT_EQ(queued.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+
+  controller.Release();
+  EXPECT_EQ(queued.get(), AdmissionController::Result::Admitted);
+  controller.Release();
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,231 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "batcher.h"
+#include "onnx-ml.pb.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+// Y = X * X with X of shape [batch_dim, 2]
+static std::string CreateSquareModel(int64_t batch_dim) {
+  onnx::ModelProto model;
+  model.set_ir_version(onnx::IR_VERSION);
+  model.add_opset_import()->set_version(7);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("square");
+  auto* node = graph->add_node();
+  node->set_op_type("Mul");
+  node->add_input("X");
+  node->add_input("X");
+  node->add_output("Y");
+
+  auto add_value_info = [batch_dim](onnx::ValueInfoProto* value_info, const std::string& name) {
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(onnx::TensorProto_DataType_FLOAT);
+    auto* shape = tensor_type->mutable_shape();
+    if (batch_dim < 0) {
+      shape->add_dim()->set_dim_param("N");
+    } else {
+      shape->add_dim()->set_dim_value(batch_dim);
+    }
+    shape->add_dim()->set_dim_value(2);
+  };
+  add_value_info(graph->add_input(), "X");
+  add_value_info(graph->add_output(), "Y");
+
+  return model.SerializeAsString();
+}
+
+class BatcherTest : public ::testing::Test {
+ protected:
+  Ort::Session CreateSession(int64_t batch_dim) {
+    const std::string model = CreateSquareModel(batch_dim);
+    return Ort::Session(env_, model.data(), model.size(), Ort::SessionOptions{});
+  }
+
+  Ort::Env env_{ORT_LOGGING_LEVEL_WARNING, "BatcherTest"};
+  Ort::MemoryInfo memory_info_ = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+};
+
+TEST_F(BatcherTest, BatchesConcurrentRequests) {
+  Ort::Session session = CreateSession(-1);
+  BatchingOptions options{};
+  options.max_batch_size = 4;
+  options.max_queue_delay = std::chrono::seconds(10);
+  Batcher batcher(session, options, ServerEnv()->GetAppLogger());
+  ASSERT_TRUE(batcher.IsEnabled());
+
+  // The four requests fill a batch, so it is run without waiting for max_queue_delay
+  constexpr int num_requests = 4;
+  std::vector<std::vector<float>> results(num_requests);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([this, &batcher, &results, i]() {
+      std::vector<float> data{static_cast<float>(i), static_cast<float>(i + 1)};
+      const int64_t shape[] = {1, 2};
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(Ort::Value::CreateTensor<float>(memory_info_, data.data(), data.size(), shape, 2));
+
+      auto outputs = batcher.Run(Ort::RunOptions{}, {"X"}, inputs, {"Y"});
+      ASSERT_EQ(outputs.size(), 1u);
+      ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>({1, 2}));
+      const float* output_data = outputs[0].GetTensorMutableData<float>();
+      results[i].assign(output_data, output_data + 2);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < num_requests; ++i) {
+    EXPECT_EQ(results[i], std::vector<float>({static_cast<float>(i * i), static_cast<float>((i + 1) * (i + 1))}));
+  }
+
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_batches, 1u);
+  EXPECT_EQ(stats.num_batched_requests, 4u);
+  EXPECT_EQ(stats.num_bypassed_requests, 0u);
+  EXPECT_EQ(stats.max_batch_size, 4u);
+}
+
+TEST_F(BatcherTest, RunsSingleRequestAfterQueueDelay) {
+  Ort::Session session = CreateSession(-1);
+  BatchingOptions options{};
+  options.max_batch_size = 8;
+  options.max_queue_delay = std::chrono::microseconds(100);
+  Batcher batcher(session, options, ServerEnv()->GetAppLogger());
+
+  std::vector<float> data{1, 2, 3, 4};
+  const int64_t shape[] = {2, 2};
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(Ort::Value::CreateTensor<float>(memory_info_, data.data(), data.size(), shape, 2));
+
+  auto outputs = batcher.Run(Ort::RunOptions{}, {"X"}, inputs, {"Y"});
+  ASSERT_EQ(outputs.size(), 1u);
+  const float* output_data = outputs[0].GetTensorMutableData<float>();
+  EXPECT_EQ(std::vector<float>(output_data, output_data + 4), std::vector<float>({1, 4, 9, 16}));
+
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_batches, 1u);
+  EXPECT_EQ(stats.num_batched_requests, 1u);
+  EXPECT_EQ(stats.total_batch_size, 2u);
+}
+
+TEST_F(BatcherTest, BypassesRequestsLargerThanMaxBatchSize) {
+  Ort::Session session = CreateSession(-1);
+  BatchingOptions options{};
+  options.max_batch_size = 2;
+  Batcher batcher(session, options, ServerEnv()->GetAppLogger());
+
+  std::vector<float> data{1, 2, 3, 4, 5, 6};
+  const int64_t shape[] = {3, 2};
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(Ort::Value::CreateTensor<float>(memory_info_, data.data(), data.size(), shape, 2));
+
+  auto outputs = batcher.Run(Ort::RunOptions{}, {"X"}, inputs, {"Y"});
+  ASSERT_EQ(outputs.size(), 1u);
+  EXPECT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>({3, 2}));
+
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_batches, 0u);
+  EXPECT_EQ(stats.num_bypassed_requests, 1u);
+}
+
+TEST_F(BatcherTest, DropsRequestsWhoseDeadlinePassedInQueue) {
+  Ort::Session session = CreateSession(-1);
+  BatchingOptions options{};
+  options.max_batch_size = 2;
+  options.max_queue_delay = std::chrono::seconds(10);
+  Batcher batcher(session, options, ServerEnv()->GetAppLogger());
+
+  // The deadline of the first request passes before the batch is full, so only the second one is run
+  constexpr int num_requests = 2;
+  std::vector<std::vector<float>> results(num_requests);
+  std::vector<bool> expired(num_requests, false);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([this, &batcher, &results, &expired, i]() {
+      std::vector<float> data{static_cast<float>(i), static_cast<float>(i + 1)};
+      const int64_t shape[] = {1, 2};
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(Ort::Value::CreateTensor<float>(memory_info_, data.data(), data.size(), shape, 2));
+
+      const auto deadline = i == 0 ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point::max();
+      try {
+        auto outputs = batcher.Run(Ort::RunOptions{}, {"X"}, inputs, {"Y"}, deadline);
+        ASSERT_EQ(outputs.size(), 1u);
+        const float* output_data = outputs[0].GetTensorMutableData<float>();
+        results[i].assign(output_data, output_data + 2);
+      } catch (const DeadlineExceededError&) {
+        expired[i] = true;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(expired[0]);
+  EXPECT_FALSE(expired[1]);
+  EXPECT_EQ(results[1], std::vector<float>({1, 4}));
+
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_batches, 1u);
+  EXPECT_EQ(stats.num_batched_requests, 1u);
+  EXPECT_EQ(stats.num_expired_requests, 1u);
+  EXPECT_EQ(stats.total_batch_size, 1u);
+}
+
+TEST_F(BatcherTest, FailsEveryRequestOfAFailedBatch) {
+  Ort::Session session = CreateSession(-1);
+  BatchingOptions options{};
+  options.max_batch_size = 4;
+  options.max_queue_delay = std::chrono::seconds(10);
+  Batcher batcher(session, options, ServerEnv()->GetAppLogger());
+
+  // The model has no output Z, so the run of the batch fails and each of its requests gets the error
+  constexpr int num_requests = 4;
+  std::vector<int> failed(num_requests, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([this, &batcher, &failed, i]() {
+      std::vector<float> data{static_cast<float>(i), static_cast<float>(i + 1)};
+      const int64_t shape[] = {1, 2};
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(Ort::Value::CreateTensor<float>(memory_info_, data.data(), data.size(), shape, 2));
+
+      try {
+        batcher.Run(Ort::RunOptions{}, {"X"}, inputs, {"Z"});
+      } catch (const Ort::Exception&) {
+        failed[i] = 1;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(failed, std::vector<int>(num_requests, 1));
+  EXPECT_EQ(batcher.GetStats().num_batched_requests, 4u);
+}
+
+TEST_F(BatcherTest, DisabledForFixedBatchDimension) {
+  Ort::Session session = CreateSession(3);
+  BatchingOptions options{};
+  options.max_batch_size = 4;
+  Batcher batcher(session, options, ServerEnv()->GetAppLogger());
+  EXPECT_FALSE(batcher.IsEnabled());
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <iostream>
+#include <sstream>
 
 #include "gtest/gtest.h"
 
@@ -52,6 +53,77 @@ TEST_F(ExecutorTest, TestMul_1) {
   EXPECT_EQ(expected, body);
 }
 
+TEST_F(ExecutorTest, TestDeadlineExceeded) {
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  auto protostatus = onnxruntime::server::GetRequestFromJson(input_json, request);
+  EXPECT_TRUE(protostatus.ok());
+
+  auto prediction_res = executor.Predict("Name", "version", request, response,
+                                         std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+  EXPECT_EQ(prediction_res.error_code(), google::protobuf::util::error::Code::DEADLINE_EXCEEDED);
+  EXPECT_TRUE(response.outputs().empty());
+}
+
+TEST_F(ExecutorTest, TestMetrics) {
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  auto protostatus = onnxruntime::server::GetRequestFromJson(input_json, request);
+  EXPECT_TRUE(protostatus.ok());
+
+  EXPECT_TRUE(executor.Predict("Name", "version", request, response).ok());
+  onnxruntime::server::PredictResponse expired_response{};
+  executor.Predict("Name", "version", request, expired_response, std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+
+  const auto& metrics = env->GetModelMetrics("Name", "version");
+  EXPECT_EQ(metrics.requests.Value(), 2);
+  EXPECT_EQ(metrics.in_flight.Value(), 0);
+  EXPECT_EQ(metrics.errors[static_cast<size_t>(google::protobuf::util::error::Code::DEADLINE_EXCEEDED)].Value(), 1);
+  EXPECT_EQ(metrics.request_latency.CumulativeCounts().back(), 2u);
+  EXPECT_EQ(metrics.run_latency.CumulativeCounts().back(), 1u);
+  EXPECT_EQ(metrics.serialize_latency.CumulativeCounts().back(), 1u);
+
+  std::ostringstream out;
+  env->WriteMetrics(out);
+  EXPECT_NE(out.str().find(R"(onnxruntime_server_requests_total{model="Name",version="version"} 2)"), std::string::npos);
+  EXPECT_NE(out.str().find(R"(onnxruntime_server_request_errors_total{model="Name",version="version",code="DEADLINE_EXCEEDED"} 1)"), std::string::npos);
+}
+
+TEST_F(ExecutorTest, TestMul_1_RawData) {
+  const std::vector<float> data{1, 2, 3, 4, 5, 6};
+  onnxruntime::server::PredictRequest request{};
+  auto& input = (*request.mutable_inputs())["X"];
+  input.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  input.add_dims(3);
+  input.add_dims(2);
+  input.set_raw_data(data.data(), data.size() * sizeof(float));
+  request.add_output_filter("Y");
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictResponse response{};
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  ASSERT_TRUE(prediction_res.ok());
+
+  const auto& output = response.outputs().at("Y");
+  ASSERT_EQ(output.raw_data().size(), data.size() * sizeof(float));
+  std::vector<float> result(data.size());
+  memcpy(result.data(), output.raw_data().data(), output.raw_data().size());
+  EXPECT_EQ(result, std::vector<float>({1, 4, 9, 16, 25, 36}));
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
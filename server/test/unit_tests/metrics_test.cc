@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "metrics.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+TEST(MetricsTests, CounterSumsAcrossThreads) {
+  Counter counter;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&counter]() {
+      for (int j = 0; j < 1000; ++j) {
+        counter.Add();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.Value(), 8000);
+
+  counter.Add(-8000);
+  EXPECT_EQ(counter.Value(), 0);
+}
+
+TEST(MetricsTests, HistogramCountsObservationsInBuckets) {
+  Histogram histogram;
+  histogram.Observe(std::chrono::microseconds(100));
+  histogram.Observe(std::chrono::milliseconds(3));
+  histogram.Observe(std::chrono::seconds(20));
+
+  const auto counts = histogram.CumulativeCounts();
+  // The buckets are 0.5ms, 1ms, 2.5ms, 5ms...
+  EXPECT_EQ(counts[0], 1u);
+  EXPECT_EQ(counts[1], 1u);
+  EXPECT_EQ(counts[2], 1u);
+  EXPECT_EQ(counts[3], 2u);
+  EXPECT_EQ(counts[Histogram::kNumBuckets - 1], 2u);
+  EXPECT_EQ(counts[Histogram::kNumBuckets], 3u);
+  EXPECT_DOUBLE_EQ(histogram.SumSeconds(), 20.0031);
+}
+
+TEST(MetricsTests, WritesPrometheusTextFormat) {
+  Histogram histogram;
+  histogram.Observe(std::chrono::milliseconds(1));
+
+  std::ostringstream out;
+  PrometheusWriter writer(out);
+  writer.Family("requests_total", "counter", "Requests.");
+  writer.Sample("requests_total", PrometheusWriter::Label("model", "a\"b\\c"), 3);
+  writer.Sample("duration_seconds_total", "", 0.25);
+  writer.HistogramSamples("latency_seconds", PrometheusWriter::Label("model", "m"), histogram);
+
+  const auto text = out.str();
+  EXPECT_NE(text.find("# HELP requests_total Requests.\n# TYPE requests_total counter\n"), std::string::npos);
+  EXPECT_NE(text.find("requests_total{model=\"a\\\"b\\\\c\"} 3\n"), std::string::npos);
+  EXPECT_NE(text.find("duration_seconds_total 0.25\n"), std::string::npos);
+  EXPECT_NE(text.find("latency_seconds_bucket{model=\"m\",le=\"0.0005\"} 0\n"), std::string::npos);
+  EXPECT_NE(text.find("latency_seconds_bucket{model=\"m\",le=\"0.001\"} 1\n"), std::string::npos);
+  EXPECT_NE(text.find("latency_seconds_bucket{model=\"m\",le=\"+Inf\"} 1\n"), std::string::npos);
+  EXPECT_NE(text.find("latency_seconds_sum{model=\"m\"} 0.001\n"), std::string::npos);
+  EXPECT_NE(text.find("latency_seconds_count{model=\"m\"} 1\n"), std::string::npos);
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -49,6 +49,42 @@ TEST(ConfigParsingTests, Defaults) {
   EXPECT_EQ(config.http_port, 8001);
   EXPECT_EQ(config.num_http_threads, 3);
   EXPECT_EQ(config.logging_level, ORT_LOGGING_LEVEL_INFO);
+  EXPECT_EQ(config.num_grpc_threads, 2);
+  EXPECT_EQ(config.max_pending_requests, 1024);
+  EXPECT_EQ(config.max_concurrent_requests, 0);
+  EXPECT_EQ(config.max_queued_requests, 100);
+  EXPECT_EQ(config.max_batch_size, 0);
+  EXPECT_EQ(config.batch_timeout_microseconds, 1000);
+}
+
+TEST(ConfigParsingTests, GrpcThreads) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--num_grpc_threads"), const_cast<char*>("4"),
+      const_cast<char*>("--num_inference_threads"), const_cast<char*>("8"),
+      const_cast<char*>("--max_pending_requests"), const_cast<char*>("16")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(9, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.num_grpc_threads, 4);
+  EXPECT_EQ(config.num_inference_threads, 8);
+  EXPECT_EQ(config.max_pending_requests, 16);
+}
+
+TEST(ConfigParsingTests, Batching) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("16"),
+      const_cast<char*>("--batch_timeout_microseconds"), const_cast<char*>("500")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(7, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.max_batch_size, 16);
+  EXPECT_EQ(config.batch_timeout_microseconds, 500);
 }
 
 TEST(ConfigParsingTests, Help) {
@@ -98,6 +134,17 @@ TEST(ConfigParsingTests, WrongLoggingLevel) {
   EXPECT_EQ(res, Result::ExitFailure);
 }
 
+TEST(ConfigParsingTests, NegativeMaxBatchSize) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("-1")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(5, test_argv);
+  EXPECT_EQ(res, Result::ExitFailure);
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
\ No newline at end of file
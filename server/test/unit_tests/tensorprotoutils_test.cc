@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "serializing/tensorprotoutils.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+TEST(TensorProtoUtilsTests, WrapRawDataWithoutCopy) {
+  const std::vector<float> data{1, 2, 3, 4, 5, 6};
+  onnx::TensorProto tensor_proto{};
+  tensor_proto.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  tensor_proto.add_dims(3);
+  tensor_proto.add_dims(2);
+  tensor_proto.set_raw_data(data.data(), data.size() * sizeof(float));
+
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value value{nullptr};
+  ASSERT_TRUE(TryWrapRawDataAsMLValue(tensor_proto, *memory_info, value));
+
+  auto info = value.GetTensorTypeAndShapeInfo();
+  EXPECT_EQ(info.GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+  EXPECT_EQ(info.GetShape(), std::vector<int64_t>({3, 2}));
+  EXPECT_EQ(static_cast<const void*>(value.GetTensorMutableData<float>()),
+            static_cast<const void*>(tensor_proto.raw_data().data()));
+}
+
+TEST(TensorProtoUtilsTests, WrapRawDataSizeMismatch) {
+  const std::vector<float> data{1, 2, 3, 4};
+  onnx::TensorProto tensor_proto{};
+  tensor_proto.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  tensor_proto.add_dims(3);
+  tensor_proto.add_dims(2);
+  tensor_proto.set_raw_data(data.data(), data.size() * sizeof(float));
+
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value value{nullptr};
+  EXPECT_FALSE(TryWrapRawDataAsMLValue(tensor_proto, *memory_info, value));
+}
+
+TEST(TensorProtoUtilsTests, WrapTypedDataNotSupported) {
+  onnx::TensorProto tensor_proto{};
+  tensor_proto.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  tensor_proto.add_dims(2);
+  tensor_proto.add_float_data(1);
+  tensor_proto.add_float_data(2);
+
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value value{nullptr};
+  EXPECT_FALSE(TryWrapRawDataAsMLValue(tensor_proto, *memory_info, value));
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
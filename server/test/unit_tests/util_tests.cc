@@ -116,6 +116,13 @@ TEST(ContentTypeTests, ContentTypeMissing) {
   EXPECT_EQ(result, SupportedContentType::PbByteArray);
 }
 
+TEST(HttpStatusCodeTests, LoadSheddingStatus) {
+  EXPECT_EQ(GetHttpStatusCode(protobufutil::Status(protobufutil::error::Code::RESOURCE_EXHAUSTED, "")),
+            http::status::too_many_requests);
+  EXPECT_EQ(GetHttpStatusCode(protobufutil::Status(protobufutil::error::Code::DEADLINE_EXCEEDED, "")),
+            http::status::gateway_timeout);
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
\ No newline at end of file
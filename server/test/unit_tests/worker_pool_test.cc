@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "worker_pool.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+TEST(WorkerPoolTests, RunsScheduledWork) {
+  std::atomic<int> count{0};
+  {
+    WorkerPool pool(2, 100);
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_TRUE(pool.TrySchedule([&count]() { ++count; }));
+    }
+  }
+  // The queued work is run before the pool is destroyed
+  EXPECT_EQ(count, 100);
+}
+
+TEST(WorkerPoolTests, RejectsWorkWhenQueueIsFull) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> started;
+
+  WorkerPool pool(1, 1);
+  // Block the only thread, then fill the queue
+  EXPECT_TRUE(pool.TrySchedule([&started, released]() {
+    started.set_value();
+    released.wait();
+  }));
+  started.get_future().wait();
+  EXPECT_TRUE(pool.TrySchedule([]() {}));
+  EXPECT_EQ(pool.NumQueued(), 1u);
+
+  EXPECT_FALSE(pool.TrySchedule([]() {}));
+
+  release.set_value();
+}
+
+TEST(WorkerPoolTests, HandsWorkToIdleThreadsWithoutQueue) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> started;
+
+  WorkerPool pool(1, 0);
+  // The thread takes the work once it is idle, even though nothing can be queued
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  bool scheduled = false;
+  while (!scheduled && std::chrono::steady_clock::now() < deadline) {
+    scheduled = pool.TrySchedule([&started, released]() {
+      started.set_value();
+      released.wait();
+    });
+    std::this_thread::yield();
+  }
+  ASSERT_TRUE(scheduled);
+  started.get_future().wait();
+
+  // The only thread is busy
+  EXPECT_FALSE(pool.TrySchedule([]() {}));
+  EXPECT_EQ(pool.NumQueued(), 0u);
+
+  release.set_value();
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
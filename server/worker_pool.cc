@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "worker_pool.h"
+
+namespace onnxruntime {
+namespace server {
+
+WorkerPool::WorkerPool(int num_threads, size_t max_queue_size) : max_queue_size_(max_queue_size) {
+  threads_.reserve(static_cast<size_t>(num_threads));
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+bool WorkerPool::TrySchedule(std::function<void()> work) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Each idle thread takes one of the queued work before the queue counts against max_queue_size_
+    if (shutdown_ || queue_.size() >= max_queue_size_ + num_idle_) {
+      return false;
+    }
+    queue_.push_back(std::move(work));
+  }
+  work_available_.notify_one();
+  return true;
+}
+
+size_t WorkerPool::NumQueued() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+void WorkerPool::WorkerLoop() {
+  for (;;) {
+    std::function<void()> work;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ++num_idle_;
+      work_available_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+      --num_idle_;
+      // The queued work is still run on shutdown, as it has to complete the requests it belongs to
+      if (queue_.empty()) {
+        return;
+      }
+      work = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    num_busy_.fetch_add(1, std::memory_order_relaxed);
+    work();
+    num_busy_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
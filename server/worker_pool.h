@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace onnxruntime {
+namespace server {
+
+// A fixed number of threads that run the inference requests handed to them from a bounded queue.
+// Requests are rejected instead of queued once max_queue_size requests are waiting beyond the idle threads, which
+// pushes back on the frontend that accepts them. With a max_queue_size of 0 work is only handed to idle threads.
+class WorkerPool {
+ public:
+  WorkerPool(int num_threads, size_t max_queue_size);
+  // Runs the queued work and joins the threads.
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Queues work to be run by one of the threads. Returns false without queueing it if no thread is idle and the
+  // queue is full.
+  bool TrySchedule(std::function<void()> work);
+
+  size_t NumQueued() const;
+  size_t NumThreads() const { return threads_.size(); }
+  // The number of threads running work.
+  size_t NumBusy() const { return num_busy_.load(std::memory_order_relaxed); }
+
+ private:
+  void WorkerLoop();
+
+  const size_t max_queue_size_;
+  mutable std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::deque<std::function<void()>> queue_;
+  bool shutdown_ = false;
+  size_t num_idle_ = 0;
+  std::atomic<size_t> num_busy_{0};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime